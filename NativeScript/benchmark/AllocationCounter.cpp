@@ -0,0 +1,34 @@
+#include "AllocationCounter.h"
+
+#include <cstddef>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+
+namespace {
+thread_local uint64_t allocations = 0;
+}  // namespace
+
+extern "C" void* malloc(size_t size) noexcept {
+  allocations++;
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept {
+  allocations++;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) noexcept {
+  allocations++;
+  return __libc_realloc(pointer, size);
+}
+
+namespace v8host {
+
+uint64_t Allocations() { return allocations; }
+
+}  // namespace v8host
@@ -0,0 +1,17 @@
+#ifndef AllocationCounter_h
+#define AllocationCounter_h
+
+// Counts malloc, calloc and realloc calls by wrapping glibc's allocator, so
+// whatever links AllocationCounter.cpp builds on Linux only.
+
+#include <cstdint>
+
+namespace v8host {
+
+// The calls made so far on this thread, which leaves V8's own platform
+// threads out.
+uint64_t Allocations();
+
+}  // namespace v8host
+
+#endif /* AllocationCounter_h */
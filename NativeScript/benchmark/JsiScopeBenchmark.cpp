@@ -0,0 +1,91 @@
+// Times a small JSI call (reading a property) on V8Runtime made three ways:
+// from native code that has not entered the runtime, so every call takes the
+// isolate's Locker and enters the isolate and context itself; the same calls
+// inside a V8Runtime::BatchScope; and from a host function called by
+// JavaScript, which already runs inside all of them. The last two only open a
+// HandleScope per call.
+//
+// Usage: jsi-scope-benchmark [calls (1000000)] [runs (5)]
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "V8Host.h"
+
+namespace jsi = facebook::jsi;
+
+namespace {
+
+void PrintRate(const std::string& name, size_t calls, double seconds,
+               double baseline) {
+  std::cout << "  " << std::left << std::setw(24) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10)
+            << seconds * 1e9 / calls << " ns/call";
+  if (baseline != seconds) {
+    std::cout << "  (" << baseline / seconds << "x)";
+  }
+  std::cout << std::endl;
+}
+
+double ReadProperty(jsi::Runtime& runtime, const jsi::Object& object,
+                    const jsi::PropNameID& name, unsigned calls) {
+  double sum = 0;
+  for (unsigned i = 0; i < calls; i++) {
+    sum += object.getProperty(runtime, name).asNumber();
+  }
+  return sum;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  unsigned calls = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000000;
+  unsigned runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+  v8host::Platform platform(argv[0]);
+  std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+  double expected = static_cast<double>(calls);
+  bool consistent = true;
+  double coldTime;
+  double batchTime;
+  double hostFunctionTime;
+  {
+    jsi::Runtime& rt = *runtime;
+    jsi::Object object(rt);
+    jsi::PropNameID name = jsi::PropNameID::forAscii(rt, "value");
+    object.setProperty(rt, name, 1);
+
+    coldTime = v8host::BestOf(runs, [&]() {
+      consistent &= ReadProperty(rt, object, name, calls) == expected;
+    });
+    batchTime = v8host::BestOf(runs, [&]() {
+      rnv8::V8Runtime::BatchScope batch(*runtime);
+      consistent &= ReadProperty(rt, object, name, calls) == expected;
+    });
+
+    jsi::Function hostFunction = jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, "readProperty"), 0,
+        [&](jsi::Runtime& hostRuntime, const jsi::Value&, const jsi::Value*,
+            size_t) {
+          return jsi::Value(ReadProperty(hostRuntime, object, name, calls));
+        });
+    hostFunctionTime = v8host::BestOf(runs, [&]() {
+      consistent &= hostFunction.call(rt).asNumber() == expected;
+    });
+  }
+  runtime.reset();
+
+  std::cout << "Best of " << runs << ", " << calls << " calls:" << std::endl;
+  PrintRate("entering each call", calls, coldTime, coldTime);
+  PrintRate("inside a BatchScope", calls, batchTime, coldTime);
+  PrintRate("inside a host function", calls, hostFunctionTime, coldTime);
+
+  if (!consistent) {
+    std::cerr << "error: a call read the wrong value" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,144 @@
+// Times the ways V8Runtime can start and run a bundle: compiling it cold in a
+// new isolate, compiling it from a code cache createCodeCache took from an
+// earlier run (what an app does from its second launch on), and, once it is
+// loaded, evaluating the same PreparedJavaScript again against
+// evaluateJavaScript on the same source, which compiles it every time (from
+// the isolate's compilation cache after the first).
+//
+// The bundle is synthetic: `functions` functions, of which the top level calls
+// every fourth, so that most of them are only ever parsed lazily.
+//
+// Usage: prepared-javascript-benchmark [functions (2000)] [runs (5)]
+//     [evaluations (200)]
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "V8Host.h"
+
+namespace jsi = facebook::jsi;
+
+namespace {
+
+using Status = rnv8::V8PreparedJavaScript::CodeCacheStatus;
+
+std::string Bundle(unsigned functions) {
+  std::ostringstream bundle;
+  bundle << "(function () {\n";
+  for (unsigned i = 0; i < functions; i++) {
+    bundle << "  function f" << i << "(a) {\n"
+           << "    const values = [a, " << i << ", a * " << i << "];\n"
+           << "    let sum = 0;\n"
+           << "    for (const value of values) { sum += value % 7; }\n"
+           << "    return { id: " << i << ", sum, name: 'f" << i << "' }.sum;\n"
+           << "  }\n";
+  }
+  bundle << "  let total = 0;\n";
+  for (unsigned i = 0; i < functions; i += 4) {
+    bundle << "  total += f" << i << "(" << i % 13 << ");\n";
+  }
+  bundle << "  return total;\n})()\n";
+  return bundle.str();
+}
+
+void PrintTime(const char* name, double seconds, double baseline) {
+  std::cout << "  " << std::left << std::setw(32) << name << std::right
+            << std::fixed << std::setprecision(3) << std::setw(10)
+            << seconds * 1e3 << " ms";
+  if (baseline != seconds) {
+    std::cout << "  (" << std::setprecision(1) << baseline / seconds << "x)";
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  unsigned functions = argc > 1 ? std::max(4, std::atoi(argv[1])) : 2000;
+  unsigned runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+  unsigned evaluations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 200;
+
+  v8host::Platform platform(argv[0]);
+  std::shared_ptr<const jsi::Buffer> source =
+      std::make_shared<jsi::StringBuffer>(Bundle(functions));
+  bool consistent = true;
+
+  // The value every evaluation must give, and the cache a first launch leaves.
+  double expected;
+  std::shared_ptr<const jsi::Buffer> codeCache;
+  {
+    std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+    std::shared_ptr<const rnv8::V8PreparedJavaScript> prepared =
+        runtime->prepareJavaScriptWithCodeCache(source, "bundle.js", nullptr);
+    expected = runtime->evaluatePreparedJavaScript(prepared).asNumber();
+    codeCache = runtime->createCodeCache(prepared);
+  }
+  if (codeCache == nullptr) {
+    std::cerr << "error: V8 gave no code cache" << std::endl;
+    return 1;
+  }
+
+  // A new isolate per run, so that its compilation cache starts empty.
+  auto launch = [&](const std::shared_ptr<const jsi::Buffer>& cache) {
+    double best = 0;
+    for (unsigned run = 0; run < runs; run++) {
+      std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+      v8host::Stopwatch stopwatch;
+      std::shared_ptr<const rnv8::V8PreparedJavaScript> prepared =
+          runtime->prepareJavaScriptWithCodeCache(source, "bundle.js", cache);
+      consistent &=
+          runtime->evaluatePreparedJavaScript(prepared).asNumber() == expected;
+      double seconds = stopwatch.Seconds();
+      consistent &= prepared->codeCacheStatus() ==
+                    (cache ? Status::kAccepted : Status::kNone);
+      best = run == 0 ? seconds : std::min(best, seconds);
+    }
+    return best;
+  };
+  double coldTime = launch(nullptr);
+  double cachedTime = launch(codeCache);
+
+  double preparedTime;
+  double evaluateTime;
+  {
+    std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+    std::shared_ptr<const rnv8::V8PreparedJavaScript> prepared =
+        runtime->prepareJavaScriptWithCodeCache(source, "bundle.js", nullptr);
+    preparedTime = v8host::BestOf(runs, [&]() {
+      for (unsigned i = 0; i < evaluations; i++) {
+        consistent &=
+            runtime->evaluatePreparedJavaScript(prepared).asNumber() ==
+            expected;
+      }
+    });
+    evaluateTime = v8host::BestOf(runs, [&]() {
+      for (unsigned i = 0; i < evaluations; i++) {
+        consistent &=
+            runtime->evaluateJavaScript(source, "bundle.js").asNumber() ==
+            expected;
+      }
+    });
+  }
+
+  std::cout << "Best of " << runs << ", " << functions << " functions ("
+            << source->size() / 1024 << " KiB, cache "
+            << codeCache->size() / 1024 << " KiB):" << std::endl;
+  std::cout << " Launch, prepare and evaluate once:" << std::endl;
+  PrintTime("cold compile", coldTime, coldTime);
+  PrintTime("from the code cache", cachedTime, coldTime);
+  std::cout << " Loaded, " << evaluations << " evaluations:" << std::endl;
+  PrintTime("evaluateJavaScript", evaluateTime, evaluateTime);
+  PrintTime("evaluatePreparedJavaScript", preparedTime, evaluateTime);
+
+  if (!consistent) {
+    std::cerr << "error: an evaluation gave the wrong value or a cache was "
+                 "not accepted"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Checks V8Runtime's prepared JavaScript and the validation of its code caches
+// against a V8 build. A cache taken from a prepared bundle must be accepted
+// for the same source and refused, with the reason reported, for another
+// source of the same length, for another V8 version or flag set (standing in
+// for which the tag in its header is changed), for a buffer that is not a
+// cache at all and for a cache whose V8 data V8 rejects. Every prepared bundle
+// must still evaluate to its value.
+//
+// Usage: prepared-javascript-test
+//
+// Prints each failed check and exits with 1 when there is one.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "V8Host.h"
+
+namespace jsi = facebook::jsi;
+
+namespace {
+
+using Status = rnv8::V8PreparedJavaScript::CodeCacheStatus;
+
+// The same length, so that only the source hash tells the two apart.
+const char* const kSource =
+    "(function () { function twice(a) { return a * 2; } return twice(21); })()";
+const char* const kOtherSource =
+    "(function () { function twice(a) { return a * 3; } return twice(21); })()";
+// Magic, CachedDataVersionTag, source hash.
+const size_t kHeaderSize = 16;
+
+unsigned failures = 0;
+
+void Check(bool condition, const char* expression, int line) {
+  if (!condition) {
+    std::cerr << "PreparedJavaScriptTest.cpp:" << line
+              << ": check failed: " << expression << std::endl;
+    failures++;
+  }
+}
+
+#define CHECK(condition) Check(condition, #condition, __LINE__)
+
+std::shared_ptr<const jsi::Buffer> ToBuffer(std::string bytes) {
+  return std::make_shared<jsi::StringBuffer>(std::move(bytes));
+}
+
+std::string ToBytes(const jsi::Buffer& buffer) {
+  return std::string(reinterpret_cast<const char*>(buffer.data()),
+                     buffer.size());
+}
+
+// Prepares `source` with `codeCache`, checks that it evaluates to `value` and
+// returns how the cache was taken.
+Status Prepare(rnv8::V8Runtime& runtime,
+               const std::shared_ptr<const jsi::Buffer>& source,
+               const std::shared_ptr<const jsi::Buffer>& codeCache,
+               double value) {
+  std::shared_ptr<const rnv8::V8PreparedJavaScript> prepared =
+      runtime.prepareJavaScriptWithCodeCache(source, "bundle.js", codeCache);
+  Status status = prepared->codeCacheStatus();
+  CHECK(prepared->codeCacheRejected() ==
+        (status != Status::kNone && status != Status::kAccepted));
+  CHECK(runtime.evaluatePreparedJavaScript(prepared).asNumber() == value);
+  return status;
+}
+
+}  // namespace
+
+int main(int, const char** argv) {
+  v8host::Platform platform(argv[0]);
+  std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+  std::shared_ptr<const jsi::Buffer> source = ToBuffer(kSource);
+  std::shared_ptr<const jsi::Buffer> otherSource = ToBuffer(kOtherSource);
+
+  CHECK(rnv8::V8PreparedJavaScript::HashSource(*source) ==
+        rnv8::V8PreparedJavaScript::HashSource(*ToBuffer(kSource)));
+  CHECK(rnv8::V8PreparedJavaScript::HashSource(*source) !=
+        rnv8::V8PreparedJavaScript::HashSource(*otherSource));
+
+  // Compiled once, evaluated as often as needed.
+  std::shared_ptr<const rnv8::V8PreparedJavaScript> prepared =
+      runtime->prepareJavaScriptWithCodeCache(source, "bundle.js", nullptr);
+  CHECK(prepared->codeCacheStatus() == Status::kNone);
+  CHECK(!prepared->codeCacheRejected());
+  CHECK(runtime->evaluatePreparedJavaScript(prepared).asNumber() == 42);
+  CHECK(runtime->evaluatePreparedJavaScript(prepared).asNumber() == 42);
+
+  std::shared_ptr<const jsi::Buffer> codeCache =
+      runtime->createCodeCache(prepared);
+  CHECK(codeCache != nullptr && codeCache->size() > kHeaderSize);
+  if (codeCache == nullptr || codeCache->size() <= kHeaderSize) {
+    return 1;
+  }
+  {
+    rnv8::V8Runtime::BatchScope batch(*runtime);
+    CHECK(runtime->createCodeCache(prepared) != nullptr);
+  }
+
+  CHECK(Prepare(*runtime, source, codeCache, 42) == Status::kAccepted);
+  CHECK(Prepare(*runtime, otherSource, codeCache, 63) ==
+        Status::kSourceMismatch);
+
+  std::string otherFlags = ToBytes(*codeCache);
+  otherFlags[4] ^= 1;
+  CHECK(Prepare(*runtime, source, ToBuffer(otherFlags), 42) ==
+        Status::kFlagsMismatch);
+
+  CHECK(Prepare(*runtime, source, ToBuffer(kSource), 42) ==
+        Status::kInvalidHeader);
+  CHECK(Prepare(*runtime, source,
+                ToBuffer(ToBytes(*codeCache).substr(0, kHeaderSize)), 42) ==
+        Status::kInvalidHeader);
+
+  // V8's own header starts with its magic number, which V8 checks before
+  // anything else.
+  std::string corrupt = ToBytes(*codeCache);
+  corrupt[kHeaderSize] ^= 1;
+  CHECK(Prepare(*runtime, source, ToBuffer(corrupt), 42) == Status::kRejected);
+
+  // Another runtime parses the source again and has no cache to give for it.
+  std::unique_ptr<rnv8::V8Runtime> otherRuntime = v8host::NewRuntime();
+  CHECK(otherRuntime->evaluatePreparedJavaScript(prepared).asNumber() == 42);
+  CHECK(otherRuntime->createCodeCache(prepared) == nullptr);
+
+  prepared.reset();
+  otherRuntime.reset();
+  runtime.reset();
+
+  if (failures != 0) {
+    std::cerr << failures << " checks failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,154 @@
+// Times what V8PropNameTable and the V8PointerValue pool are for: making a
+// PropNameID per call with PropNameID::forAscii and forUtf8, as native modules
+// do for the names they read, and getting and setting a property of a
+// HostObject from JavaScript, where every access hands the HostObject a
+// PropNameID for the same name. Prints the best time and the allocations
+// (malloc, calloc and realloc calls on the benchmark's thread) per operation.
+//
+// CMake builds this once per combination of NATIVESCRIPT_V8_NO_PROP_NAME_TABLE
+// and NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL; run-prop-name-benchmarks runs them
+// all one after the other.
+//
+// Usage: prop-name-benchmark [operations (1000000)] [runs (5)]
+
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "AllocationCounter.h"
+#include "V8Host.h"
+
+namespace jsi = facebook::jsi;
+
+namespace {
+
+struct Result {
+  double seconds = 0;
+  uint64_t allocations = 0;
+};
+
+template <class Function>
+Result Measure(unsigned runs, const Function& function) {
+  Result best;
+  for (unsigned run = 0; run < runs; run++) {
+    uint64_t before = v8host::Allocations();
+    v8host::Stopwatch stopwatch;
+    function();
+    double seconds = stopwatch.Seconds();
+    uint64_t count = v8host::Allocations() - before;
+    best.seconds = run == 0 ? seconds : std::min(best.seconds, seconds);
+    best.allocations = run == 0 ? count : std::min(best.allocations, count);
+  }
+  return best;
+}
+
+void PrintResult(const char* name, unsigned operations, const Result& result) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10)
+            << result.seconds * 1e9 / operations << " ns/op" << std::setw(8)
+            << std::setprecision(2)
+            << static_cast<double>(result.allocations) / operations
+            << " allocs/op" << std::endl;
+}
+
+// Keeps the last value set, so that a read sees the write before it.
+class Counter : public jsi::HostObject {
+ public:
+  jsi::Value get(jsi::Runtime& runtime, const jsi::PropNameID& name) override {
+    return name.utf8(runtime) == "value" ? jsi::Value(value_)
+                                         : jsi::Value::undefined();
+  }
+
+  void set(jsi::Runtime& runtime, const jsi::PropNameID& name,
+           const jsi::Value& value) override {
+    if (name.utf8(runtime) == "value") {
+      value_ = value.asNumber();
+    }
+  }
+
+ private:
+  double value_ = 0;
+};
+
+const char* const kHostObjectLoop =
+    "(function (counter, operations) {"
+    "  for (let i = 0; i < operations; i += 2) {"
+    "    counter.value = counter.value + 1;"
+    "  }"
+    "  return counter.value;"
+    "})";
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  unsigned operations = argc > 1 ? std::max(2, std::atoi(argv[1])) : 1000000;
+  unsigned runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+  operations -= operations % 2;
+
+  v8host::Platform platform(argv[0]);
+  std::unique_ptr<rnv8::V8Runtime> runtime = v8host::NewRuntime();
+  bool consistent = true;
+  Result ascii;
+  Result utf8;
+  Result hostObject;
+  {
+    jsi::Runtime& rt = *runtime;
+    rnv8::V8Runtime::BatchScope batch(*runtime);
+    jsi::PropNameID value = jsi::PropNameID::forAscii(rt, "value");
+
+    ascii = Measure(runs, [&]() {
+      for (unsigned i = 0; i < operations; i++) {
+        consistent &= jsi::PropNameID::compare(
+            rt, jsi::PropNameID::forAscii(rt, "value", 5), value);
+      }
+    });
+    const uint8_t* name = reinterpret_cast<const uint8_t*>("value");
+    utf8 = Measure(runs, [&]() {
+      for (unsigned i = 0; i < operations; i++) {
+        consistent &= jsi::PropNameID::compare(
+            rt, jsi::PropNameID::forUtf8(rt, name, 5), value);
+      }
+    });
+
+    jsi::Object counter =
+        jsi::Object::createFromHostObject(rt, std::make_shared<Counter>());
+    jsi::Function loop = rt.evaluateJavaScript(
+                               std::make_shared<jsi::StringBuffer>(
+                                   kHostObjectLoop),
+                               "prop-name-benchmark.js")
+                             .asObject(rt)
+                             .asFunction(rt);
+    double expected = 0;
+    hostObject = Measure(runs, [&]() {
+      expected += operations / 2;
+      consistent &= loop.call(rt, counter, static_cast<double>(operations))
+                         .asNumber() == expected;
+    });
+  }
+  runtime.reset();
+
+  std::cout << "Best of " << runs << ", " << operations << " operations, "
+#ifdef NATIVESCRIPT_V8_NO_PROP_NAME_TABLE
+            << "without the name table, "
+#else
+            << "with the name table, "
+#endif
+#ifdef NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL
+            << "without the value pool:"
+#else
+            << "with the value pool:"
+#endif
+            << std::endl;
+  PrintResult("PropNameID::forAscii", operations, ascii);
+  PrintResult("PropNameID::forUtf8", operations, utf8);
+  PrintResult("HostObject get and set", operations, hostObject);
+
+  if (!consistent) {
+    std::cerr << "error: an operation gave the wrong result" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,304 @@
+// Round-trips a corpus of message shapes through the runtime's structured
+// serialization the ways a message can go: V8's ValueSerializer with buffers
+// from V8's allocator, as every message did before the fast path;
+// ValueSerializer writing into SerializationBufferPool, as the runtime's
+// delegate does; and the fast path of FastSerialization.cpp, falling back to
+// the pooled serializer for shapes it does not cover, as SerializedValue does,
+// with and without the pool. Prints the best time per message of each and the
+// allocations (malloc, calloc and realloc calls on the benchmark's thread) per
+// message, and exits with 1 when a message does not come back as it was sent.
+//
+// Usage: serialization-benchmark [messages per shape (20000)] [runs (3)]
+//
+// Allocations are counted by AllocationCounter.cpp, so this builds on Linux
+// only.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "FastSerialization.h"
+#include "SerializationBufferPool.h"
+#include "V8Host.h"
+
+namespace {
+
+using tns::serialization::PlainPrototypes;
+using tns::serialization::SerializationBufferPool;
+
+// The values messages mostly carry, and one (nesting) the fast path leaves to
+// ValueSerializer.
+struct Shape {
+  const char* name;
+  const char* source;
+};
+
+const Shape kCorpus[] = {
+    {"number", "42.5"},
+    {"short string", "'message-' + 12345"},
+    {"two-byte string", "'h\\u00e9llo \\u2603 '.repeat(8)"},
+    {"flat object",
+     "({ id: 7, type: 'update', name: 'progress', done: false, value: 0.25 })"},
+    {"array of numbers", "Array.from({ length: 64 }, (_, i) => i * 1.5)"},
+    {"Float64Array", "new Float64Array(1024).map((_, i) => i / 3)"},
+    {"Uint8Array (16 KiB)", "new Uint8Array(16 * 1024).map((_, i) => i)"},
+    {"nested object",
+     "({ user: { id: 1, name: 'a' }, tags: ['x', 'y'], at: 3 })"},
+};
+
+enum class Path {
+  kV8Allocator,
+  kPool,
+  kFastPath,
+  kFastPathWithoutPool,
+};
+
+const char* const kPathNames[] = {
+    "ValueSerializer",
+    "ValueSerializer, pooled",
+    "fast path, pooled",
+    "fast path, no pool",
+};
+
+// What the runtime's delegate does for a value without transfers or host
+// objects.
+class Delegate : public v8::ValueSerializer::Delegate {
+ public:
+  Delegate(v8::Isolate* isolate, bool pooled)
+      : isolate_(isolate), pooled_(pooled) {}
+
+  size_t Capacity() const { return capacity_; }
+
+  void ThrowDataCloneError(v8::Local<v8::String> message) override {
+    isolate_->ThrowException(v8::Exception::Error(message));
+  }
+
+  void* ReallocateBufferMemory(void* oldBuffer, size_t size,
+                               size_t* actualSize) override {
+    if (!pooled_) {
+      return v8::ValueSerializer::Delegate::ReallocateBufferMemory(
+          oldBuffer, size, actualSize);
+    }
+    uint8_t* buffer =
+        oldBuffer == nullptr
+            ? SerializationBufferPool::Acquire(size, actualSize)
+            : SerializationBufferPool::Grow(static_cast<uint8_t*>(oldBuffer),
+                                            size, actualSize);
+    if (buffer != nullptr) {
+      capacity_ = *actualSize;
+    }
+    return buffer;
+  }
+
+  void FreeBufferMemory(void* buffer) override {
+    if (!pooled_) {
+      v8::ValueSerializer::Delegate::FreeBufferMemory(buffer);
+      return;
+    }
+    SerializationBufferPool::Release(static_cast<uint8_t*>(buffer), capacity_);
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  bool pooled_;
+  size_t capacity_ = 0;
+};
+
+v8::MaybeLocal<v8::Value> RoundTripWithValueSerializer(
+    v8::Isolate* isolate, v8::Local<v8::Context> context,
+    v8::Local<v8::Value> value, bool pooled) {
+  Delegate delegate(isolate, pooled);
+  v8::ValueSerializer serializer(isolate, &delegate);
+  serializer.WriteHeader();
+  bool written = serializer.WriteValue(context, value).FromMaybe(false);
+  std::pair<uint8_t*, size_t> data = serializer.Release();
+
+  v8::MaybeLocal<v8::Value> result;
+  if (written) {
+    v8::ValueDeserializer deserializer(isolate, data.first, data.second);
+    if (deserializer.ReadHeader(context).FromMaybe(false)) {
+      result = deserializer.ReadValue(context);
+    }
+  }
+  if (pooled) {
+    SerializationBufferPool::Release(data.first, delegate.Capacity());
+  } else {
+    std::free(data.first);
+  }
+  return result;
+}
+
+v8::MaybeLocal<v8::Value> RoundTrip(v8::Isolate* isolate,
+                                    v8::Local<v8::Context> context,
+                                    const PlainPrototypes& prototypes,
+                                    v8::Local<v8::Value> value, Path path) {
+  if (path == Path::kV8Allocator) {
+    return RoundTripWithValueSerializer(isolate, context, value, false);
+  }
+  if (path == Path::kFastPath || path == Path::kFastPathWithoutPool) {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    v8::Maybe<bool> fast = tns::serialization::TryFastSerialize(
+        isolate, context, prototypes, value, &data, &size, &capacity);
+    if (fast.IsNothing()) {
+      return v8::MaybeLocal<v8::Value>();
+    }
+    if (fast.FromJust()) {
+      v8::MaybeLocal<v8::Value> result = tns::serialization::FastDeserialize(
+          isolate, context, prototypes, data, size);
+      SerializationBufferPool::Release(data, capacity);
+      return result;
+    }
+  }
+  return RoundTripWithValueSerializer(isolate, context, value, true);
+}
+
+// More blocks than the pool keeps.
+const size_t kPoolBlocks = 64;
+
+// Swaps the pool's blocks for ones too small for any request, so that every
+// Acquire mallocs and every Release, finding the pool full, frees: how buffers
+// went before there was a pool.
+void DisablePool() {
+  size_t capacity;
+  for (size_t i = 0; i < kPoolBlocks; i++) {
+    std::free(SerializationBufferPool::Acquire(1, &capacity));
+  }
+  for (size_t i = 0; i < kPoolBlocks; i++) {
+    SerializationBufferPool::Release(static_cast<uint8_t*>(std::malloc(1)), 0);
+  }
+}
+
+void EnablePool() {
+  size_t capacity;
+  for (size_t i = 0; i < kPoolBlocks; i++) {
+    std::free(SerializationBufferPool::Acquire(0, &capacity));
+  }
+}
+
+bool SameValue(v8::Local<v8::Context> context, v8::Local<v8::Value> sent,
+               v8::Local<v8::Value> received) {
+  v8::Local<v8::String> sentJson;
+  v8::Local<v8::String> receivedJson;
+  if (!v8::JSON::Stringify(context, sent).ToLocal(&sentJson) ||
+      !v8::JSON::Stringify(context, received).ToLocal(&receivedJson)) {
+    return false;
+  }
+  return sentJson->StringEquals(receivedJson) &&
+         sent->IsTypedArray() == received->IsTypedArray() &&
+         sent->IsArray() == received->IsArray();
+}
+
+struct Result {
+  double seconds = 0;
+  uint64_t allocations = 0;
+};
+
+template <class Function>
+Result BestOf(unsigned runs, unsigned messages, const Function& message,
+              bool& consistent) {
+  Result best;
+  for (unsigned run = 0; run < runs; run++) {
+    uint64_t before = v8host::Allocations();
+    v8host::Stopwatch stopwatch;
+    for (unsigned i = 0; i < messages; i++) {
+      consistent &= message();
+    }
+    double seconds = stopwatch.Seconds();
+    uint64_t count = v8host::Allocations() - before;
+    best.seconds = run == 0 ? seconds : std::min(best.seconds, seconds);
+    best.allocations = run == 0 ? count : std::min(best.allocations, count);
+  }
+  return best;
+}
+
+void PrintResult(const char* name, unsigned messages, const Result& result,
+                 const Result& baseline) {
+  std::cout << "    " << std::left << std::setw(26) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10)
+            << result.seconds * 1e9 / messages << " ns/msg" << std::setw(12)
+            << std::setprecision(0) << messages / result.seconds << " msg/sec"
+            << std::setw(8) << std::setprecision(2)
+            << static_cast<double>(result.allocations) / messages
+            << " allocs/msg";
+  if (&result != &baseline) {
+    std::cout << "  (" << std::setprecision(1)
+              << baseline.seconds / result.seconds << "x)";
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  unsigned messages = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+  unsigned runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+  v8host::Platform platform(argv[0]);
+  v8::Isolate* isolate = v8host::NewIsolate();
+  bool consistent = true;
+  {
+    v8::Locker locker(isolate);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope handleScope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope contextScope(context);
+    PlainPrototypes prototypes;
+    prototypes.object = v8::Object::New(isolate)->GetPrototype();
+    prototypes.array = v8::Array::New(isolate)->GetPrototype();
+
+    std::cout << "Best of " << runs << ", " << messages
+              << " messages per shape:" << std::endl;
+    for (const Shape& shape : kCorpus) {
+      v8::HandleScope shapeScope(isolate);
+      v8::Local<v8::String> source =
+          v8::String::NewFromUtf8(isolate, shape.source).ToLocalChecked();
+      v8::Local<v8::Value> value = v8::Script::Compile(context, source)
+                                       .ToLocalChecked()
+                                       ->Run(context)
+                                       .ToLocalChecked();
+
+      std::cout << "  " << shape.name << std::endl;
+      Result results[4];
+      for (Path path : {Path::kV8Allocator, Path::kPool, Path::kFastPath,
+                        Path::kFastPathWithoutPool}) {
+        int index = static_cast<int>(path);
+        if (path == Path::kFastPathWithoutPool) {
+          DisablePool();
+        }
+        results[index] = BestOf(
+            runs, messages,
+            [&]() {
+              v8::HandleScope messageScope(isolate);
+              v8::Local<v8::Value> received;
+              return RoundTrip(isolate, context, prototypes, value, path)
+                  .ToLocal(&received);
+            },
+            consistent);
+
+        v8::HandleScope checkScope(isolate);
+        v8::Local<v8::Value> received;
+        if (!RoundTrip(isolate, context, prototypes, value, path)
+                 .ToLocal(&received) ||
+            !SameValue(context, value, received)) {
+          std::cerr << "error: " << shape.name << " did not survive the "
+                    << kPathNames[index] << " round trip" << std::endl;
+          consistent = false;
+        }
+        if (path == Path::kFastPathWithoutPool) {
+          EnablePool();
+        }
+        PrintResult(kPathNames[index], messages, results[index], results[0]);
+      }
+    }
+  }
+  isolate->Dispose();
+
+  return consistent ? 0 : 1;
+}
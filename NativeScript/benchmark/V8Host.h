@@ -0,0 +1,89 @@
+#ifndef V8Host_h
+#define V8Host_h
+
+// V8 for the benchmarks and tests that run the runtime's V8 code on a build
+// host, and the timing they share.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "libplatform/libplatform.h"
+#include "v8.h"
+#include "v8runtime/V8Runtime.h"
+
+namespace v8host {
+
+// Initializes V8 for as long as it lives; create one first thing in main.
+class Platform {
+ public:
+  explicit Platform(const char* executablePath) {
+    v8::V8::InitializeICUDefaultLocation(executablePath);
+    v8::V8::InitializeExternalStartupData(executablePath);
+    platform_ = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform_.get());
+    v8::V8::Initialize();
+  }
+
+  ~Platform() {
+    v8::V8::Dispose();
+    v8::V8::DisposePlatform();
+  }
+
+  Platform(const Platform&) = delete;
+  Platform& operator=(const Platform&) = delete;
+
+ private:
+  std::unique_ptr<v8::Platform> platform_;
+};
+
+// A new isolate, which the caller disposes.
+inline v8::Isolate* NewIsolate() {
+  static std::unique_ptr<v8::ArrayBuffer::Allocator> allocator(
+      v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+  v8::Isolate::CreateParams params;
+  params.array_buffer_allocator = allocator.get();
+  return v8::Isolate::New(params);
+}
+
+// A JSI runtime over a new isolate and context, left without the isolate
+// entered on any thread. The runtime disposes the isolate.
+inline std::unique_ptr<rnv8::V8Runtime> NewRuntime() {
+  v8::Isolate* isolate = NewIsolate();
+  v8::Locker locker(isolate);
+  v8::Isolate::Scope isolateScope(isolate);
+  v8::HandleScope handleScope(isolate);
+  v8::Context::Scope contextScope(v8::Context::New(isolate));
+  return std::make_unique<rnv8::V8Runtime>(isolate);
+}
+
+// Wall time since construction.
+class Stopwatch {
+ public:
+  double Seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_ =
+      std::chrono::steady_clock::now();
+};
+
+// The shortest of `runs` runs of `function`, in seconds.
+template <class Function>
+double BestOf(unsigned runs, const Function& function) {
+  double best = 0;
+  for (unsigned run = 0; run < runs; run++) {
+    Stopwatch stopwatch;
+    function();
+    double seconds = stopwatch.Seconds();
+    best = run == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+}  // namespace v8host
+
+#endif /* V8Host_h */
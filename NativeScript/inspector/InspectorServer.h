@@ -5,19 +5,28 @@
 #include <sys/types.h>
 
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace v8_inspector {
 
 class InspectorServer {
  public:
-  static in_port_t Init(
-      std::function<void(std::function<void(const std::string&)>)>
-          onClientConnected,
-      std::function<void(const std::string&)> onMessage);
+  // Queues a message on the connection's socket; never blocks.
+  using Sender = std::function<void(const std::string&)>;
+  // Blocks the caller until at most maxPendingBytes of what the sender queued
+  // are still waiting for the socket. Returns false once the connection has
+  // closed. Must not be called on the server's own queue.
+  using Drain = std::function<bool(size_t maxPendingBytes)>;
+
+  static in_port_t Init(std::function<void(Sender, Drain)> onClientConnected,
+                        std::function<void(const std::string&)> onMessage);
 
  private:
+  struct PendingWrites;
+
   static void Send(dispatch_io_t channel, dispatch_queue_t queue,
+                   const std::shared_ptr<PendingWrites>& pending,
                    const std::string& message);
 };
 
@@ -3,11 +3,50 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace v8_inspector {
 
-in_port_t InspectorServer::Init(
-    std::function<void(std::function<void(const std::string&)>)> onClientConnected,
-    std::function<void(const std::string&)> onMessage) {
+// Bytes handed to dispatch_io_write that the socket has not taken yet. The
+// channel queues writes without limit, so a sender producing faster than the
+// frontend reads (a heap snapshot) uses this to wait instead of buffering.
+struct InspectorServer::PendingWrites {
+  std::mutex mutex;
+  std::condition_variable drained;
+  size_t bytes = 0;
+  bool closed = false;
+
+  void Add(size_t size) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->bytes += size;
+  }
+
+  void Remove(size_t size) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->bytes -= size;
+    }
+    this->drained.notify_all();
+  }
+
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->closed = true;
+    }
+    this->drained.notify_all();
+  }
+
+  bool WaitUntilBelow(size_t maxBytes) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->drained.wait(lock, [&] { return this->closed || this->bytes <= maxBytes; });
+    return !this->closed;
+  }
+};
+
+in_port_t InspectorServer::Init(std::function<void(Sender, Drain)> onClientConnected,
+                                std::function<void(const std::string&)> onMessage) {
   in_port_t listenPort = 18183;
 
   int serverSocket = -1;
@@ -44,15 +83,21 @@ in_port_t InspectorServer::Init(
 
       // Wait for a client to connect
       if ((clientSocket = accept(serverSocket, (struct sockaddr*)&echoClntAddr, &clntLen)) >= 0) {
+        std::shared_ptr<PendingWrites> pending = std::make_shared<PendingWrites>();
         dispatch_io_t channel =
             dispatch_io_create(DISPATCH_IO_STREAM, clientSocket, q, ^(int error) {
               if (error) {
                 NSLog(@"InspectorServer channel cleanup error: %s", strerror(error));
               }
               close(clientSocket);
+              pending->Close();
             });
 
-        onClientConnected([channel, q](std::string message) { Send(channel, q, message); });
+        onClientConnected(
+            [channel, q, pending](const std::string& message) {
+              Send(channel, q, pending, message);
+            },
+            [pending](size_t maxPendingBytes) { return pending->WaitUntilBelow(maxPendingBytes); });
 
         __block dispatch_io_handler_t receiver = ^(bool done, dispatch_data_t data, int error) {
           if (error) {
@@ -122,6 +167,7 @@ in_port_t InspectorServer::Init(
 }
 
 void InspectorServer::Send(dispatch_io_t channel, dispatch_queue_t queue,
+                           const std::shared_ptr<PendingWrites>& pending,
                            const std::string& message) {
   NSString* str = [NSString stringWithUTF8String:message.c_str()];
   NSUInteger length = [str lengthOfBytesUsingEncoding:NSUTF16LittleEndianStringEncoding];
@@ -142,10 +188,16 @@ void InspectorServer::Send(dispatch_io_t channel, dispatch_queue_t queue,
     free(buffer);
   });
 
+  size_t size = length + sizeof(uint32_t);
+  pending->Add(size);
+  std::shared_ptr<PendingWrites> writes = pending;
   dispatch_io_write(channel, 0, data, queue, ^(bool done, dispatch_data_t data, int error) {
     if (error) {
       NSLog(@"InspectorServer::Send error: %s", strerror(error));
     }
+    if (done) {
+      writes->Remove(size);
+    }
   });
 }
 
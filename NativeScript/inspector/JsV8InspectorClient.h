@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "InspectorServer.h"
 #include "include/v8-inspector.h"
 #include "ns-v8-tracing-agent-impl.h"
 #include "runtime/Runtime.h"
@@ -37,6 +38,11 @@ class JsV8InspectorClient : V8InspectorClient, V8Inspector::Channel {
   // scan and copy it costs) for payloads that cannot contain a sourceMapURL.
   void SendRawToFrontend(const std::string& message);
 
+  // Blocks until at most maxPendingBytes sent to the frontend are still
+  // waiting for the socket. Returns false when no frontend is connected (or
+  // it went away while waiting). Never call it on the socket thread.
+  bool WaitForFrontendDrain(size_t maxPendingBytes);
+
   // Worker targets (Chrome DevTools Target domain, flat-session mode).
   // Register/Unregister are called on the worker's own thread.
   void RegisterWorkerTarget(int workerId, WorkerInspectorClient* client);
@@ -76,7 +82,8 @@ class JsV8InspectorClient : V8InspectorClient, V8Inspector::Channel {
   dispatch_queue_t messagesQueue_;
   dispatch_queue_t messageLoopQueue_;
   dispatch_semaphore_t messageArrived_;
-  std::function<void(const std::string&)> sender_;
+  InspectorServer::Sender sender_;
+  InspectorServer::Drain drain_;
   bool isWaitingForDebugger_;
   bool hasScheduledDebugBreak_;
 
@@ -126,7 +133,8 @@ class JsV8InspectorClient : V8InspectorClient, V8Inspector::Channel {
   void createInspectorSession();
   void notify(std::unique_ptr<StringBuffer> message);
   void notify(const std::string& message);
-  void onFrontendConnected(std::function<void(const std::string&)> sender);
+  void onFrontendConnected(InspectorServer::Sender sender,
+                           InspectorServer::Drain drain);
   void onFrontendMessageReceived(const std::string& message);
   std::string PumpMessage();
   static void registerDomainDispatcherCallback(
@@ -147,6 +155,12 @@ class JsV8InspectorClient : V8InspectorClient, V8Inspector::Channel {
   void HandleIOClose(int msgId, const std::string& handle,
                      const std::string& sessionId);
 
+  // HeapProfiler.takeHeapSnapshot, answered on the main thread in place of
+  // V8's own handler, which queues every chunk on the socket at once (see
+  // the definition).
+  void TakeHeapSnapshot(long long msgId, bool reportProgress,
+                        bool exposeInternals, bool captureNumericValue);
+
   // {N} specific helpers
   bool CallDomainHandlerFunction(v8::Local<v8::Context> context,
                                  v8::Local<v8::Function> domainMethodFunc,
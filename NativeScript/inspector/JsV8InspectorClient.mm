@@ -18,6 +18,7 @@
 #include "RuntimeConfig.h"
 #include "WorkerInspectorClient.h"
 #include "include/libplatform/libplatform.h"
+#include "include/v8-profiler.h"
 #include "third_party/json.hpp"
 #include "utils.h"
 
@@ -170,8 +171,8 @@ void JsV8InspectorClient::enableInspector(int argc, char** argv) {
       NOTIFICATION("AttachRequest"), &attachRequestSubscription, dispatch_get_main_queue(),
       ^(int token) {
         in_port_t listenPort = InspectorServer::Init(
-            [this](std::function<void(const std::string&)> sender) {
-              this->onFrontendConnected(sender);
+            [this](InspectorServer::Sender sender, InspectorServer::Drain drain) {
+              this->onFrontendConnected(sender, drain);
             },
             [this](const std::string& message) { this->onFrontendMessageReceived(message); });
 
@@ -205,7 +206,8 @@ void JsV8InspectorClient::enableInspector(int argc, char** argv) {
   notify_cancel(waitForDebuggerSubscription);
 }
 
-void JsV8InspectorClient::onFrontendConnected(std::function<void(const std::string&)> sender) {
+void JsV8InspectorClient::onFrontendConnected(InspectorServer::Sender sender,
+                                              InspectorServer::Drain drain) {
   if (this->isWaitingForDebugger_) {
     this->isWaitingForDebugger_ = NO;
     CFRunLoopRef runloop = CFRunLoopGetMain();
@@ -219,6 +221,7 @@ void JsV8InspectorClient::onFrontendConnected(std::function<void(const std::stri
   {
     std::lock_guard<std::mutex> lock(this->senderMutex_);
     this->sender_ = sender;
+    this->drain_ = drain;
   }
 
   // this triggers a reconnection from the devtools so Debugger.scriptParsed etc. are all fired
@@ -568,6 +571,15 @@ void JsV8InspectorClient::SendRawToFrontend(const std::string& message) {
   }
 }
 
+bool JsV8InspectorClient::WaitForFrontendDrain(size_t maxPendingBytes) {
+  InspectorServer::Drain drain;
+  {
+    std::lock_guard<std::mutex> lock(this->senderMutex_);
+    drain = this->drain_;
+  }
+  return drain && drain(maxPendingBytes);
+}
+
 void JsV8InspectorClient::dispatchMessage(const std::string& message) {
   auto json_message = json::parse(message);
   std::string method = json_message["method"];
@@ -631,6 +643,17 @@ void JsV8InspectorClient::dispatchMessage(const std::string& message) {
     return;
   }
 
+  if (method == "HeapProfiler.takeHeapSnapshot") {
+    json params = json_message.value("params", json::object());
+    auto flag = [&params](const char* key) {
+      return params.is_object() && params.contains(key) && params[key].is_boolean() &&
+             params[key].get<bool>();
+    };
+    this->TakeHeapSnapshot(json_message["id"].get<long long>(), flag("reportProgress"),
+                           flag("exposeInternals"), flag("captureNumericValue"));
+    return;
+  }
+
   // parse incoming message as JSON
   Local<Value> arg;
   success = v8::JSON::Parse(context, tns::ToV8String(isolate, message)).ToLocal(&arg);
@@ -721,7 +744,8 @@ void JsV8InspectorClient::HandleLoadNetworkResource(int msgId, const std::string
       NSString* urlPath = [NSString stringWithUTF8String:path.c_str()];
       if (urlPath != nil) {
         // Script urls are built by stripping RuntimeConfig.BaseDir (see
-        // ModuleInternal::LoadClassicScript), so map the url path back to
+        // ModuleInternal::LoadCommonJsFunction for CommonJS modules and
+        // LoadClassicScript for the rest), so map the url path back to
         // disk; fall back to the raw path for absolute urls, and to
         // percent-decoded variants for urls the frontend encoded.
         NSString* basePath = [NSString stringWithUTF8String:RuntimeConfig.BaseDir.c_str()];
@@ -812,6 +836,110 @@ void JsV8InspectorClient::HandleIOClose(int msgId, const std::string& handle,
   this->SendToFrontend(WithSessionId(response, sessionId).dump());
 }
 
+namespace {
+// Bytes of snapshot chunks allowed to wait for the socket before the
+// serializer is paused: the ceiling on what streaming a snapshot to the
+// frontend adds to the process, however large the heap.
+constexpr size_t kMaxPendingSnapshotBytes = 4 * 1024 * 1024;
+
+// Sends each chunk as HeapProfiler.addHeapSnapshotChunk as soon as V8 has
+// serialized it, then waits for the socket to drain below the ceiling. The
+// chunk is snapshot JSON (ASCII), so it skips the source map rewrite.
+class FrontendSnapshotStream : public v8::OutputStream {
+ public:
+  explicit FrontendSnapshotStream(JsV8InspectorClient* client) : client_(client) {}
+
+  void EndOfStream() override {}
+  int GetChunkSize() override { return 64 * 1024; }
+
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    json chunk = {{"method", "HeapProfiler.addHeapSnapshotChunk"},
+                  {"params", {{"chunk", std::string(data, size)}}}};
+    this->client_->SendRawToFrontend(chunk.dump());
+    if (!this->client_->WaitForFrontendDrain(kMaxPendingSnapshotBytes)) {
+      this->aborted_ = true;
+      return kAbort;
+    }
+    return kContinue;
+  }
+
+  bool aborted() const { return aborted_; }
+
+ private:
+  JsV8InspectorClient* client_;
+  bool aborted_ = false;
+};
+
+class FrontendSnapshotProgress : public v8::ActivityControl {
+ public:
+  explicit FrontendSnapshotProgress(JsV8InspectorClient* client) : client_(client) {}
+
+  ControlOption ReportProgressValue(uint32_t done, uint32_t total) override {
+    this->done_ = done;
+    this->total_ = total;
+    this->Send(false);
+    return kContinue;
+  }
+
+  void Finish() { this->Send(true); }
+
+ private:
+  void Send(bool finished) {
+    json params = {{"done", this->done_}, {"total", this->total_}};
+    if (finished) {
+      params["finished"] = true;
+    }
+    json progress = {{"method", "HeapProfiler.reportHeapSnapshotProgress"}, {"params", params}};
+    this->client_->SendRawToFrontend(progress.dump());
+  }
+
+  JsV8InspectorClient* client_;
+  uint32_t done_ = 0;
+  uint32_t total_ = 0;
+};
+}  // namespace
+
+// V8's HeapProfiler agent serializes the whole snapshot in one go and hands
+// every chunk to sendNotification, which widens it to UTF-16 and queues it on
+// the socket without limit: a large heap ends up in memory several times over
+// before the frontend has read the first megabyte. Here the serializer waits
+// for the socket instead, so memory stays bounded by kMaxPendingSnapshotBytes
+// on top of the snapshot graph itself. The frontend sees the same protocol.
+void JsV8InspectorClient::TakeHeapSnapshot(long long msgId, bool reportProgress,
+                                           bool exposeInternals, bool captureNumericValue) {
+  Isolate* isolate = isolate_;
+  FrontendSnapshotProgress progress(this);
+  HeapProfiler::HeapSnapshotOptions options;
+  options.control = reportProgress ? &progress : nullptr;
+  options.snapshot_mode = exposeInternals ? HeapProfiler::HeapSnapshotMode::kExposeInternals
+                                          : HeapProfiler::HeapSnapshotMode::kRegular;
+  options.numerics_mode = captureNumericValue
+                              ? HeapProfiler::NumericsMode::kExposeNumericValues
+                              : HeapProfiler::NumericsMode::kHideNumericValues;
+
+  const HeapSnapshot* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(options);
+  if (snapshot == nullptr) {
+    json error = {{"id", msgId},
+                  {"error", {{"code", -32000}, {"message", "Failed to take heap snapshot"}}}};
+    this->SendRawToFrontend(error.dump());
+    return;
+  }
+  if (reportProgress) {
+    progress.Finish();
+  }
+
+  FrontendSnapshotStream stream(this);
+  snapshot->Serialize(&stream, HeapSnapshot::kJSON);
+  const_cast<HeapSnapshot*>(snapshot)->Delete();
+
+  if (stream.aborted()) {
+    // The frontend went away mid-snapshot; there is no one left to answer.
+    return;
+  }
+  json response = {{"id", msgId}, {"result", json::object()}};
+  this->SendRawToFrontend(response.dump());
+}
+
 void JsV8InspectorClient::RegisterWorkerTarget(int workerId, WorkerInspectorClient* client) {
   std::lock_guard<std::mutex> lock(this->workerTargetsMutex_);
   WorkerTarget target{workerId, client, false};
@@ -11,6 +11,8 @@
 
 #include <stdio.h>
 
+#include <fstream>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -55,6 +57,61 @@ class NSInMemoryTraceWriter : public TraceWriter {
   std::vector<std::string> traces_;
 };
 
+// Writes a Chrome trace JSON file ({"traceEvents": [...]}) as events arrive;
+// only the ofstream's buffer is ever held in memory. The file is complete
+// once Close() returns true.
+class NSFileTraceWriter : public TraceWriter {
+ public:
+  explicit NSFileTraceWriter(const std::string& path);
+  ~NSFileTraceWriter() override;
+
+  bool IsOpen() const { return stream_.is_open(); }
+  const std::string& path() const { return path_; }
+  void AppendTraceEvent(TraceObject* trace_event) override;
+  void Flush() override;
+  // Writes the closing brackets and closes the file. Returns false, with the
+  // partial file removed, when anything failed to write.
+  bool Close();
+
+ private:
+  std::string path_;
+  std::ofstream stream_;
+  std::unique_ptr<TraceWriter> json_trace_writer_;
+  bool closed_ = false;
+};
+
+// A TraceBuffer that hands events to its writer as chunks fill, instead of
+// keeping a ring of the newest ones the way libplatform's buffer does, so a
+// trace can run for as long as the disk allows. A filled chunk stays in
+// memory while a complete ("X") event in it may still be open - its duration
+// is only known when its scope ends - but at most kMaxHeldChunks are held:
+// past that the oldest is written regardless, and an event still open in it
+// keeps a zero duration. Called only under NSTraceBuffer's lock.
+class NSStreamingTraceBuffer : public TraceBuffer {
+ public:
+  // Takes ownership of the writer.
+  explicit NSStreamingTraceBuffer(TraceWriter* writer);
+  ~NSStreamingTraceBuffer() override;
+
+  TraceObject* AddTraceEvent(uint64_t* handle) override;
+  TraceObject* GetEventByHandle(uint64_t handle) override;
+  bool Flush() override;
+
+ private:
+  static constexpr size_t kMaxHeldChunks = 64;
+
+  void WriteChunk(TraceBufferChunk* chunk);
+  // Writes the filled chunks that have no open events left, then the oldest
+  // ones until at most kMaxHeldChunks remain.
+  void WriteSettledChunks();
+
+  std::unique_ptr<TraceWriter> writer_;
+  std::unique_ptr<TraceBufferChunk> current_;
+  // Filled chunks not yet written, by sequence number.
+  std::map<uint32_t, std::unique_ptr<TraceBufferChunk>> held_;
+  uint32_t next_seq_ = 1;
+};
+
 // Indirection between the TracingController and the ring buffer a trace
 // actually records into.
 //
@@ -94,6 +151,17 @@ class TracingAgentImpl {
   // bufferSizeInKb <= 0 means the default ring buffer size.
   bool start(const std::vector<std::string>& categories = {},
              double bufferSizeInKb = 0);
+  // Streams the trace to a Chrome trace JSON file at `path` instead of an
+  // in-memory ring. Empty categories record V8's defaults plus every ns.*
+  // runtime category. Fails, with `error` set, when a trace is already
+  // running or the file cannot be created.
+  bool startToFile(const std::string& path,
+                   const std::vector<std::string>& categories,
+                   std::string& error);
+  // Stops a trace started with startToFile, completes the file and sets
+  // `path` to it. Returns false, with `error` set, unless this agent owns the
+  // running trace and the file was written in full.
+  bool endToFile(std::string& path, std::string& error);
   // Returns false unless this agent owns the running trace.
   bool end(Result& result);
   // Stops and drops the running trace if this agent owns it; for frontend
@@ -101,12 +169,18 @@ class TracingAgentImpl {
   void stopAndDiscard();
 
  private:
+  // Requires mutex_ held and active_ == this.
+  void startLocked(const std::vector<std::string>& categories,
+                   std::unique_ptr<TraceBuffer> ring);
   // Requires mutex_ held and active_ == this; pass null to drop the trace.
-  void stopLocked(Result* result);
+  // Returns false when a file trace could not be written in full.
+  bool stopLocked(Result* result);
 
   TracingController* tracing_controller_;
   // Owned by the ring armed on buffer_; only valid while active_ == this.
   NSInMemoryTraceWriter* current_trace_writer_ = nullptr;
+  // Likewise, for a trace started with startToFile.
+  NSFileTraceWriter* current_file_writer_ = nullptr;
 
   // The TracingController is process-global, so only one agent may trace at
   // a time; a concurrent start would disarm the running trace's ring (and
@@ -7,10 +7,13 @@
 //
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <sstream>
 
 #include "Helpers.h"
 #include "Runtime.h"
+#include "Tracing.h"
 #include "ns-v8-tracing-agent-impl.h"
 
 namespace tns {
@@ -75,6 +78,118 @@ bool NSInMemoryTraceWriter::bufferWasFull() const {
   return total_traces_ >= ring_capacity_floor_;
 }
 
+NSFileTraceWriter::NSFileTraceWriter(const std::string& path)
+    : path_(path), stream_(path, std::ios::binary | std::ios::trunc) {
+  if (stream_.is_open()) {
+    json_trace_writer_.reset(TraceWriter::CreateJSONTraceWriter(stream_));
+  }
+}
+
+NSFileTraceWriter::~NSFileTraceWriter() { Close(); }
+
+void NSFileTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  if (json_trace_writer_ != nullptr) {
+    json_trace_writer_->AppendTraceEvent(trace_event);
+  }
+}
+
+void NSFileTraceWriter::Flush() {
+  if (json_trace_writer_ != nullptr) {
+    json_trace_writer_->Flush();
+    stream_.flush();
+  }
+}
+
+bool NSFileTraceWriter::Close() {
+  if (!closed_) {
+    closed_ = true;
+    // The JSON writer emits the closing brackets when destroyed.
+    json_trace_writer_.reset();
+    if (stream_.is_open()) {
+      stream_.close();
+    }
+    if (stream_.fail()) {
+      remove(path_.c_str());
+    }
+  }
+  return !stream_.fail();
+}
+
+NSStreamingTraceBuffer::NSStreamingTraceBuffer(TraceWriter* writer) : writer_(writer) {}
+
+NSStreamingTraceBuffer::~NSStreamingTraceBuffer() { Flush(); }
+
+TraceObject* NSStreamingTraceBuffer::AddTraceEvent(uint64_t* handle) {
+  if (current_ != nullptr && current_->IsFull()) {
+    uint32_t seq = current_->seq();
+    held_.emplace(seq, std::move(current_));
+    WriteSettledChunks();
+  }
+  if (current_ == nullptr) {
+    current_ = std::make_unique<TraceBufferChunk>(next_seq_++);
+  }
+  size_t index;
+  TraceObject* trace_object = current_->AddTraceEvent(&index);
+  *handle = static_cast<uint64_t>(current_->seq()) * TraceBufferChunk::kChunkSize + index;
+  return trace_object;
+}
+
+TraceObject* NSStreamingTraceBuffer::GetEventByHandle(uint64_t handle) {
+  uint32_t seq = static_cast<uint32_t>(handle / TraceBufferChunk::kChunkSize);
+  size_t index = handle % TraceBufferChunk::kChunkSize;
+  TraceBufferChunk* chunk = nullptr;
+  if (current_ != nullptr && current_->seq() == seq) {
+    chunk = current_.get();
+  } else {
+    auto it = held_.find(seq);
+    if (it != held_.end()) {
+      chunk = it->second.get();
+    }
+  }
+  // Null once the chunk has been written: the event's duration stays as it was.
+  return chunk != nullptr && index < chunk->size() ? chunk->GetEventAt(index) : nullptr;
+}
+
+bool NSStreamingTraceBuffer::Flush() {
+  for (auto& entry : held_) {
+    WriteChunk(entry.second.get());
+  }
+  held_.clear();
+  if (current_ != nullptr) {
+    WriteChunk(current_.get());
+    current_.reset();
+  }
+  writer_->Flush();
+  return true;
+}
+
+void NSStreamingTraceBuffer::WriteChunk(TraceBufferChunk* chunk) {
+  for (size_t i = 0; i < chunk->size(); i++) {
+    writer_->AppendTraceEvent(chunk->GetEventAt(i));
+  }
+}
+
+void NSStreamingTraceBuffer::WriteSettledChunks() {
+  for (auto it = held_.begin(); it != held_.end();) {
+    TraceBufferChunk* chunk = it->second.get();
+    bool settled = true;
+    for (size_t i = 0; i < chunk->size() && settled; i++) {
+      TraceObject* event = chunk->GetEventAt(i);
+      settled = event->phase() != 'X' || event->duration() != 0;
+    }
+    if (settled) {
+      WriteChunk(chunk);
+      it = held_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  while (held_.size() > kMaxHeldChunks) {
+    WriteChunk(held_.begin()->second.get());
+    held_.erase(held_.begin());
+  }
+}
+
 TraceObject* NSTraceBuffer::AddTraceEvent(uint64_t* handle) {
   std::lock_guard<std::mutex> lock(mutex_);
   if (ring_ == nullptr) {
@@ -140,6 +255,45 @@ bool TracingAgentImpl::start(const std::vector<std::string>& categories, double
                      : std::max<size_t>(static_cast<size_t>(requestedChunks), 2);
   }
 
+  current_trace_writer_ = new NSInMemoryTraceWriter(
+      R"({"method": "Tracing.dataCollected", "params":)", "}", ringChunks);
+  startLocked(categories, std::unique_ptr<TraceBuffer>(TraceBuffer::CreateTraceBufferRingBuffer(
+                              ringChunks, current_trace_writer_)));
+  return true;
+}
+
+bool TracingAgentImpl::startToFile(const std::string& path,
+                                   const std::vector<std::string>& categories,
+                                   std::string& error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (active_ != nullptr) {
+    error = "a trace is already running";
+    return false;
+  }
+
+  errno = 0;
+  auto writer = std::make_unique<NSFileTraceWriter>(path);
+  if (!writer->IsOpen()) {
+    error = "could not write '" + path + "': " + strerror(errno != 0 ? errno : EIO);
+    return false;
+  }
+  active_ = this;
+
+  std::vector<std::string> included = categories;
+  if (included.empty()) {
+    included.push_back("v8");
+    for (int i = 0; i < static_cast<int>(tns::TraceCategory::Count); i++) {
+      included.push_back(tns::Tracing::CategoryName(static_cast<tns::TraceCategory>(i)));
+    }
+  }
+
+  current_file_writer_ = writer.get();
+  startLocked(included, std::make_unique<NSStreamingTraceBuffer>(writer.release()));
+  return true;
+}
+
+void TracingAgentImpl::startLocked(const std::vector<std::string>& categories,
+                                   std::unique_ptr<TraceBuffer> ring) {
   if (buffer_ == nullptr) {
     // Handed to the controller, which owns it for the rest of the process; see
     // the NSTraceBuffer comment for why it is never replaced.
@@ -147,10 +301,7 @@ bool TracingAgentImpl::start(const std::vector<std::string>& categories, double
     tracing_controller_->Initialize(buffer_);
   }
 
-  current_trace_writer_ = new NSInMemoryTraceWriter(
-      R"({"method": "Tracing.dataCollected", "params":)", "}", ringChunks);
-  buffer_->Arm(std::unique_ptr<TraceBuffer>(
-      TraceBuffer::CreateTraceBufferRingBuffer(ringChunks, current_trace_writer_)));
+  buffer_->Arm(std::move(ring));
   // Of the CDP TraceConfig, only includedCategories and traceBufferSizeInKb
   // are honored. recordMode, excludedCategories and bufferUsage reporting
   // would need a custom TraceBuffer (libplatform's ring buffer always records
@@ -167,8 +318,6 @@ bool TracingAgentImpl::start(const std::vector<std::string>& categories, double
   }
   config->SetTraceRecordMode(TraceRecordMode::RECORD_CONTINUOUSLY);
   tracing_controller_->StartTracing(config);
-
-  return true;
 }
 
 bool TracingAgentImpl::end(Result& result) {
@@ -180,6 +329,21 @@ bool TracingAgentImpl::end(Result& result) {
   return true;
 }
 
+bool TracingAgentImpl::endToFile(std::string& path, std::string& error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (active_ != this || current_file_writer_ == nullptr) {
+    error = "no trace started with startTrace is running";
+    return false;
+  }
+  path = current_file_writer_->path();
+  errno = 0;
+  if (!stopLocked(nullptr)) {
+    error = "could not write '" + path + "': " + strerror(errno != 0 ? errno : EIO);
+    return false;
+  }
+  return true;
+}
+
 void TracingAgentImpl::stopAndDiscard() {
   std::lock_guard<std::mutex> lock(mutex_);
   if (active_ != this) {
@@ -188,24 +352,32 @@ void TracingAgentImpl::stopAndDiscard() {
   stopLocked(nullptr);
 }
 
-void TracingAgentImpl::stopLocked(Result* result) {
+bool TracingAgentImpl::stopLocked(Result* result) {
   // StopTracing flushes the ring into the writer, under the ring's own lock, and
   // is the only thing that hands events to the writer; once it returns the
   // writer belongs to this thread alone.
   tracing_controller_->StopTracing();
 
-  // Read either way so a discarded trace does not hold on to its chunks.
-  std::vector<std::string> messages = current_trace_writer_->getTrace();
-  if (result != nullptr) {
-    result->messages = std::move(messages);
-    result->dataLossOccurred = current_trace_writer_->bufferWasFull();
+  if (current_trace_writer_ != nullptr) {
+    // Read either way so a discarded trace does not hold on to its chunks.
+    std::vector<std::string> messages = current_trace_writer_->getTrace();
+    if (result != nullptr) {
+      result->messages = std::move(messages);
+      result->dataLossOccurred = current_trace_writer_->bufferWasFull();
+    }
   }
 
+  // A file trace is completed even when dropped: what it streamed is already
+  // on disk, and a valid file beats a truncated one.
+  bool written = current_file_writer_ == nullptr || current_file_writer_->Close();
+
   // Frees the ring and the writer it owns, so a finished trace stops costing
   // what it recorded.
   current_trace_writer_ = nullptr;
+  current_file_writer_ = nullptr;
   active_ = nullptr;
   buffer_->Disarm();
+  return written;
 }
 
 }  // namespace inspector
@@ -0,0 +1,28 @@
+#ifndef NapiAsyncWorkPool_h
+#define NapiAsyncWorkPool_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tns {
+
+// The process-wide pool behind napi_queue_async_work, as of the call.
+struct NapiAsyncWorkPoolStats {
+  size_t threads;              // pool threads alive
+  size_t maxThreads;           // the configured bound
+  size_t queued;               // works waiting for a thread
+  size_t executing;            // execute callbacks running now
+  uint64_t completed;          // complete callbacks run
+  uint64_t completionBatches;  // runloop entries that ran them
+  uint64_t totalQueueNs;       // summed time from queued to executing
+  uint64_t maxQueueNs;
+  uint64_t totalExecuteNs;     // summed time in execute callbacks
+  uint64_t totalCompletionNs;  // summed time from executed to completed
+};
+
+// Any thread. Defined in NodeApiEmbed.mm, next to the pool.
+void NapiGetAsyncWorkPoolStats(NapiAsyncWorkPoolStats* stats);
+
+}  // namespace tns
+
+#endif /* NapiAsyncWorkPool_h */
@@ -23,6 +23,7 @@
 namespace tns {
 
 class EventLoop;
+struct NapiAsyncWorkQueue;
 
 // The finalizer of one external buffer/arraybuffer. Its callback must run
 // exactly once, on the env's thread, while the env is alive — but V8's
@@ -82,6 +83,10 @@ class NapiEnv : public napi_env__ {
   void RunExternalFinalizer(
       const std::shared_ptr<NapiExternalFinalizer>& finalizer);
 
+  // This env's lane in the async work pool, created on first use. Env thread
+  // only. Defined in NodeApiEmbed.mm, next to the pool.
+  const std::shared_ptr<NapiAsyncWorkQueue>& AsyncWorkQueue();
+
  private:
   explicit NapiEnv(v8::Local<v8::Context> context);
   ~NapiEnv() override;
@@ -95,6 +100,7 @@ class NapiEnv : public napi_env__ {
   std::unordered_map<std::string, v8::Global<v8::Object>> moduleExports_;
   std::unordered_set<std::shared_ptr<NapiExternalFinalizer>>
       externalFinalizers_;
+  std::shared_ptr<NapiAsyncWorkQueue> asyncWorkQueue_;
 };
 
 // Runs the env's cleanup hooks, most recently added first, at the head of
@@ -1,6 +1,11 @@
 #ifndef NapiThreadSafeFunction_h
 #define NapiThreadSafeFunction_h
 
+#include <cstddef>
+#include <cstdint>
+
+struct napi_threadsafe_function__;
+
 namespace tns {
 
 class NapiEnv;
@@ -16,6 +21,30 @@ class NapiEnv;
 // being able to reach JS.
 void NapiAbortThreadSafeFunctions(NapiEnv* env);
 
+// Counters kept per threadsafe function, for addons and tests that want to see
+// how their producers and the JS thread keep up with each other.
+struct NapiThreadSafeFunctionStats {
+  size_t queueDepth;      // calls queued right now
+  size_t peakQueueDepth;  // the most ever queued at once
+  uint64_t calls;         // calls accepted
+  uint64_t delivered;     // calls handed to JS
+  uint64_t dispatches;    // runloop blocks that delivered them
+  uint64_t queueFull;     // non-blocking calls refused with napi_queue_full
+  uint64_t totalWaitNs;   // summed time from accepted to delivered
+  uint64_t maxWaitNs;
+  uint64_t blockedNs;     // summed time blocking calls waited for space
+};
+
+// Any thread, for as long as the handle is valid. False for a null argument.
+bool NapiGetThreadSafeFunctionStats(napi_threadsafe_function__* func,
+                                    NapiThreadSafeFunctionStats* stats);
+
+// Makes `func` queue its calls in the mutex-guarded deque the ring replaced,
+// so that tests can time the two against each other in one run. Only before
+// the first call, from the thread that created it. False for a null argument
+// or once a call has been made.
+bool NapiUseLockedThreadSafeFunctionQueue(napi_threadsafe_function__* func);
+
 }  // namespace tns
 
 #endif /* NapiThreadSafeFunction_h */
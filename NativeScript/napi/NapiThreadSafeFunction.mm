@@ -1,9 +1,9 @@
 // napi_threadsafe_function over CFRunLoop.
 //
 // The invariant the whole file is built around: a producer thread never enters
-// the target isolate. It takes this object's mutex, appends to the queue and
-// leaves; every step that touches JS runs in a block posted to the env's own
-// runloop. Taking the isolate's Locker from a foreign thread would reintroduce
+// the target isolate. It appends to the function's queue and leaves; every step
+// that touches JS runs in a block posted to the env's own runloop, and a run of
+// calls shares one block. Taking the isolate's Locker from a foreign thread would reintroduce
 // the cross-isolate class-initialization deadlock (issue #420).
 
 // Must precede every include: without NAPI_EXPERIMENTAL, NAPI_VERSION defaults
@@ -12,10 +12,14 @@
 #define NAPI_EXPERIMENTAL
 #define NODE_API_EXPERIMENTAL_NO_WARNING
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -30,8 +34,122 @@
 #include "runtime/NativeScriptException.h"
 #include "runtime/Runtime.h"
 
+namespace {
+
+using TsfnClock = std::chrono::steady_clock;
+
+// Bounded multi-producer, single-consumer ring with one sequence number per
+// slot (Vyukov's scheme), so producers never take a lock. A producer is
+// admitted against `size_` before it claims a slot, and the consumer releases
+// a slot before it gives the space back, so the slot a producer claims is
+// always free and pushing never spins or retries.
+class TsfnRing {
+ public:
+  // `limit` is the admission bound, at most `capacity`, a power of two.
+  TsfnRing(size_t capacity, size_t limit)
+      : slots_(new Slot[capacity]), mask_(capacity - 1), limit_(limit) {
+    for (size_t i = 0; i < capacity; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Any thread. Fails only when the ring holds `limit` items; never spuriously,
+  // which napi_queue_full must not be either. `depth` receives the size the
+  // push brought the ring to.
+  bool TryPush(void* data, TsfnClock::time_point enqueuedAt, size_t* depth) {
+    size_t size = size_.load(std::memory_order_relaxed);
+    do {
+      if (size >= limit_) {
+        return false;
+      }
+    } while (!size_.compare_exchange_weak(size, size + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed));
+    *depth = size + 1;
+
+    size_t position = tail_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[position & mask_];
+    slot.data = data;
+    slot.enqueuedAt = enqueuedAt;
+    slot.sequence.store(position + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // The consumer only. A slot claimed but not yet published reads as empty;
+  // its producer posts a dispatch once it publishes.
+  bool TryPop(void** data, TsfnClock::time_point* enqueuedAt) {
+    Slot& slot = slots_[head_ & mask_];
+    if (slot.sequence.load(std::memory_order_seq_cst) != head_ + 1) {
+      return false;
+    }
+    *data = slot.data;
+    *enqueuedAt = slot.enqueuedAt;
+    slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    size_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  // The consumer only.
+  bool HasPublished() const {
+    return slots_[head_ & mask_].sequence.load(std::memory_order_seq_cst) ==
+           head_ + 1;
+  }
+
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    void* data;
+    TsfnClock::time_point enqueuedAt;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  const size_t mask_;
+  const size_t limit_;
+  // Producers and the consumer write these; apart, they stop sharing a line.
+  alignas(64) std::atomic<size_t> size_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) size_t head_ = 0;
+};
+
+// An unbounded function still gets a fixed ring; calls that do not fit spill
+// into a locked overflow list.
+constexpr size_t kUnboundedRingCapacity = 1024;
+
+size_t RingCapacityFor(size_t maxQueueSize) {
+  size_t capacity = 1;
+  size_t wanted = maxQueueSize > 0 ? maxQueueSize : kUnboundedRingCapacity;
+  while (capacity < wanted) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+uint64_t ElapsedNs(TsfnClock::time_point since, TsfnClock::time_point now) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - since)
+          .count());
+}
+
+template <typename T>
+void UpdateMax(std::atomic<T>& max, T value) {
+  uint64_t current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
 struct napi_threadsafe_function__
     : public std::enable_shared_from_this<napi_threadsafe_function__> {
+  explicit napi_threadsafe_function__(size_t maxQueueSize)
+      : maxQueueSize(maxQueueSize),
+        ring(RingCapacityFor(maxQueueSize),
+             maxQueueSize > 0 ? maxQueueSize : kUnboundedRingCapacity) {}
+
   ~napi_threadsafe_function__() {
     if (loop != nullptr) {
       CFRelease(loop);
@@ -49,6 +167,7 @@ struct napi_threadsafe_function__
   v8::Isolate* isolate = nullptr;
   CFRunLoopRef loop = nullptr;
   std::weak_ptr<tns::EventLoop> eventLoop;
+  const size_t maxQueueSize;
 
   // Touched on the env's thread only, which is where the abort path and every
   // dispatch run.
@@ -57,17 +176,38 @@ struct napi_threadsafe_function__
   napi_finalize finalizeCb = nullptr;
   void* finalizeData = nullptr;
   void* context = nullptr;
+  TsfnClock::duration dispatchSlice{};
+
+  // The call path. A producer that finds room touches only these atomics;
+  // the mutex is taken to wait for space, to spill past the ring of an
+  // unbounded function, and for everything that is not a call. With
+  // `lockedQueue` every call goes through `overflow` under the mutex instead,
+  // as all of them did before the ring.
+  bool lockedQueue = false;
+  TsfnRing ring;
+  std::atomic<size_t> overflowSize{0};
+  std::atomic<size_t> producersInFlight{0};
+  std::atomic<size_t> waitingProducers{0};
+  std::atomic<bool> closing{false};
+  std::atomic<bool> envAlive{true};
+  std::atomic<bool> dispatchPosted{false};
 
   std::mutex mutex;
   std::condition_variable spaceAvailable;
-  std::queue<void*> queue;
-  size_t maxQueueSize = 0;
+  std::deque<std::pair<void*, TsfnClock::time_point>> overflow;
   size_t threadCount = 0;
-  bool closing = false;
-  bool envAlive = true;
-  bool dispatchPosted = false;
   bool finalized = false;
   bool refed = true;
+
+  // Relaxed counters behind NapiGetThreadSafeFunctionStats.
+  std::atomic<size_t> peakQueueDepth{0};
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> delivered{0};
+  std::atomic<uint64_t> dispatches{0};
+  std::atomic<uint64_t> queueFull{0};
+  std::atomic<uint64_t> totalWaitNs{0};
+  std::atomic<uint64_t> maxWaitNs{0};
+  std::atomic<uint64_t> blockedNs{0};
 };
 
 namespace {
@@ -118,16 +258,121 @@ void DropHandleRefIfDone(const TsfnRef& tsfn) {
   DropHandleRef(tsfn.get());
 }
 
+enum class EnqueueResult { kQueued, kFull, kClosing };
+
+// Any thread. The in-flight count is what lets the finalizer know that no
+// producer that got past the `closing` check is still about to publish.
+// `lockHeld` tells a blocking caller's retries, made under the mutex, apart.
+EnqueueResult TryEnqueue(napi_threadsafe_function__* tsfn, void* data,
+                         bool lockHeld = false) {
+  tsfn->producersInFlight.fetch_add(1, std::memory_order_seq_cst);
+  EnqueueResult result = EnqueueResult::kQueued;
+  TsfnClock::time_point now = TsfnClock::now();
+  size_t depth = 0;
+
+  if (tsfn->closing.load(std::memory_order_seq_cst)) {
+    result = EnqueueResult::kClosing;
+  } else if (tsfn->lockedQueue) {
+    std::unique_lock<std::mutex> lock(tsfn->mutex, std::defer_lock);
+    if (!lockHeld) {
+      lock.lock();
+    }
+    if (tsfn->maxQueueSize > 0 && tsfn->overflow.size() >= tsfn->maxQueueSize) {
+      result = EnqueueResult::kFull;
+    } else {
+      tsfn->overflow.emplace_back(data, now);
+      tsfn->overflowSize.fetch_add(1, std::memory_order_release);
+      depth = tsfn->overflow.size();
+    }
+  } else if (tsfn->overflowSize.load(std::memory_order_acquire) == 0 &&
+             tsfn->ring.TryPush(data, now, &depth)) {
+    // Queued.
+  } else if (tsfn->maxQueueSize == 0) {
+    // Once anything has spilled, later calls follow it until the overflow is
+    // drained, which keeps each producer's calls in order.
+    std::lock_guard<std::mutex> lock(tsfn->mutex);
+    tsfn->overflow.emplace_back(data, now);
+    tsfn->overflowSize.fetch_add(1, std::memory_order_release);
+    depth = tsfn->ring.Size() + tsfn->overflow.size();
+  } else {
+    result = EnqueueResult::kFull;
+  }
+
+  tsfn->producersInFlight.fetch_sub(1, std::memory_order_seq_cst);
+
+  if (result == EnqueueResult::kQueued) {
+    tsfn->calls.fetch_add(1, std::memory_order_relaxed);
+    UpdateMax(tsfn->peakQueueDepth, depth);
+  }
+  return result;
+}
+
+// The env's thread. Overflow entries are only ever newer than what the ring
+// holds for the same producer, so the ring goes first — and is looked at again
+// under the mutex, which makes visible a ring call published just before the
+// producer's next one spilled.
+bool Dequeue(napi_threadsafe_function__* tsfn, void** data,
+             TsfnClock::time_point* enqueuedAt) {
+  bool popped = tsfn->ring.TryPop(data, enqueuedAt);
+  if (!popped && tsfn->overflowSize.load(std::memory_order_acquire) > 0) {
+    std::lock_guard<std::mutex> lock(tsfn->mutex);
+    popped = tsfn->ring.TryPop(data, enqueuedAt);
+    if (!popped && !tsfn->overflow.empty()) {
+      *data = tsfn->overflow.front().first;
+      *enqueuedAt = tsfn->overflow.front().second;
+      tsfn->overflow.pop_front();
+      tsfn->overflowSize.fetch_sub(1, std::memory_order_release);
+      popped = true;
+    }
+  }
+
+  // A producer registers as waiting before its last look at the ring, so
+  // either it sees this slot or this sees it. Both sides put a full fence
+  // between their store and their load: the ring's size is read relaxed and
+  // released with release order, which alone would let each side miss the
+  // other's store on ARM64 and leave the producer asleep on a ring with space.
+  if (popped) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+  if (popped && tsfn->waitingProducers.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock(tsfn->mutex);
+    tsfn->spaceAvailable.notify_one();
+  }
+  return popped;
+}
+
+bool HasPending(napi_threadsafe_function__* tsfn) {
+  return tsfn->ring.HasPublished() ||
+         tsfn->overflowSize.load(std::memory_order_acquire) > 0;
+}
+
+size_t QueueDepth(napi_threadsafe_function__* tsfn) {
+  return tsfn->ring.Size() +
+         tsfn->overflowSize.load(std::memory_order_relaxed);
+}
+
 // The env's thread, with the isolate locked and a handle scope open.
 void FinalizeOnJsThread(const TsfnRef& tsfn) {
-  std::queue<void*> undelivered;
   {
     std::lock_guard<std::mutex> lock(tsfn->mutex);
     if (tsfn->finalized) {
       return;
     }
     tsfn->finalized = true;
-    undelivered.swap(tsfn->queue);
+  }
+
+  // `closing` is set by now; a producer that read it before that is at most a
+  // few stores away from publishing, and its call must be handed back below
+  // rather than left in the ring.
+  while (tsfn->producersInFlight.load(std::memory_order_seq_cst) > 0) {
+    std::this_thread::yield();
+  }
+
+  std::vector<void*> undelivered;
+  void* data = nullptr;
+  TsfnClock::time_point enqueuedAt;
+  while (Dequeue(tsfn.get(), &data, &enqueuedAt)) {
+    undelivered.push_back(data);
   }
 
   if (tsfn->callbackRef != nullptr) {
@@ -139,11 +384,10 @@ void FinalizeOnJsThread(const TsfnRef& tsfn) {
   // can still be freed; there is no JS left to run for them. This must happen
   // before the finalize callback, which is where addons free the context these
   // calls receive.
-  while (!undelivered.empty()) {
+  for (void* item : undelivered) {
     if (tsfn->callJs != nullptr) {
-      tsfn->callJs(nullptr, nullptr, tsfn->context, undelivered.front());
+      tsfn->callJs(nullptr, nullptr, tsfn->context, item);
     }
-    undelivered.pop();
   }
 
   if (tsfn->finalizeCb != nullptr) {
@@ -186,77 +430,90 @@ void CallJsOnJsThread(const TsfnRef& tsfn, void* data) {
 void PostDispatch(const TsfnRef& tsfn);
 
 // A producer that pushes faster than the callback returns would otherwise keep
-// one runloop block busy forever, starving timers, messages and the UI. Node
-// re-arms its async handle per item; this yields every so many.
-constexpr size_t kMaxCallsPerDispatch = 64;
+// one runloop block busy forever, starving timers, messages and the UI. A
+// dispatch delivers for one time slice, then yields and re-posts. The slice
+// starts short and doubles, up to the cap, while dispatches keep ending with
+// more queued than they started with; one that empties the queue resets it.
+// A steady trickle stays responsive and a flood is drained in fewer, longer
+// blocks.
+constexpr TsfnClock::duration kMinDispatchSlice = std::chrono::microseconds(500);
+constexpr TsfnClock::duration kMaxDispatchSlice = std::chrono::milliseconds(4);
 
 void RunDispatch(const TsfnRef& tsfn) {
-  size_t delivered = 0;
+  tsfn->dispatches.fetch_add(1, std::memory_order_relaxed);
+  if (tsfn->dispatchSlice == TsfnClock::duration::zero()) {
+    tsfn->dispatchSlice = kMinDispatchSlice;
+  }
+  TsfnClock::time_point deadline = TsfnClock::now() + tsfn->dispatchSlice;
+  size_t startDepth = QueueDepth(tsfn.get());
 
   for (;;) {
+    if (!tsfn->envAlive.load(std::memory_order_acquire)) {
+      tsfn->dispatchPosted.store(false, std::memory_order_seq_cst);
+      return;
+    }
+
+    bool finalize = tsfn->closing.load(std::memory_order_acquire);
     void* data = nullptr;
-    bool haveData = false;
-    bool finalize = false;
-    {
-      std::lock_guard<std::mutex> lock(tsfn->mutex);
-      if (!tsfn->envAlive) {
-        tsfn->dispatchPosted = false;
+    TsfnClock::time_point enqueuedAt;
+    if (!finalize && Dequeue(tsfn.get(), &data, &enqueuedAt)) {
+      TsfnClock::time_point now = TsfnClock::now();
+      uint64_t waitNs = ElapsedNs(enqueuedAt, now);
+      tsfn->totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+      UpdateMax(tsfn->maxWaitNs, waitNs);
+
+      CallJsOnJsThread(tsfn, data);
+      tsfn->delivered.fetch_add(1, std::memory_order_relaxed);
+
+      if (TsfnClock::now() >= deadline) {
+        tsfn->dispatchSlice =
+            QueueDepth(tsfn.get()) > startDepth
+                ? std::min(tsfn->dispatchSlice * 2, kMaxDispatchSlice)
+                : kMinDispatchSlice;
+        tsfn->dispatchPosted.store(false, std::memory_order_seq_cst);
+        PostDispatch(tsfn);
         return;
       }
+      continue;
+    }
 
-      if (tsfn->closing) {
-        finalize = true;
-      } else if (!tsfn->queue.empty()) {
-        data = tsfn->queue.front();
-        tsfn->queue.pop();
-        haveData = true;
-      } else if (tsfn->threadCount == 0) {
-        tsfn->closing = true;
+    if (!finalize) {
+      // Cleared under the mutex so that a release dropping the last thread
+      // either is seen here or sees the flag down and posts.
+      std::lock_guard<std::mutex> lock(tsfn->mutex);
+      if (tsfn->threadCount == 0) {
+        tsfn->closing.store(true, std::memory_order_seq_cst);
         finalize = true;
       } else {
-        tsfn->dispatchPosted = false;
-        return;
+        tsfn->dispatchPosted.store(false, std::memory_order_seq_cst);
       }
     }
 
-    tsfn->spaceAvailable.notify_all();
-
     if (finalize) {
       FinalizeOnJsThread(tsfn);
-      {
-        std::lock_guard<std::mutex> lock(tsfn->mutex);
-        tsfn->dispatchPosted = false;
-      }
+      tsfn->dispatchPosted.store(false, std::memory_order_seq_cst);
       DropHandleRefIfDone(tsfn);
       return;
     }
 
-    if (haveData) {
-      CallJsOnJsThread(tsfn, data);
+    tsfn->dispatchSlice = kMinDispatchSlice;
 
-      if (++delivered >= kMaxCallsPerDispatch) {
-        {
-          std::lock_guard<std::mutex> lock(tsfn->mutex);
-          tsfn->dispatchPosted = false;
-        }
-        PostDispatch(tsfn);
-        return;
-      }
+    // A producer that published after the ring looked empty saw the flag
+    // still up and did not post; take the dispatch back if nobody else has.
+    if (!HasPending(tsfn.get()) ||
+        tsfn->dispatchPosted.exchange(true, std::memory_order_seq_cst)) {
+      return;
     }
   }
 }
 
+// Called once per accepted call, so it must stay cheap while a dispatch is
+// already pending: one exchange on the flag, no lock.
 void PostDispatch(const TsfnRef& tsfn) {
-  std::weak_ptr<tns::EventLoop> weakLoop;
-  {
-    // Read under the mutex: this runs on producer threads, and teardown
-    // closes the function as soon as the env starts tearing down.
-    std::lock_guard<std::mutex> lock(tsfn->mutex);
-    if (tsfn->dispatchPosted || !tsfn->envAlive) {
-      return;
-    }
-    tsfn->dispatchPosted = true;
-    weakLoop = tsfn->eventLoop;
+  // Teardown closes the function as soon as the env starts tearing down.
+  if (!tsfn->envAlive.load(std::memory_order_acquire) ||
+      tsfn->dispatchPosted.exchange(true, std::memory_order_seq_cst)) {
+    return;
   }
 
   // The entry owns a reference: the handle may be released, and the queue
@@ -265,10 +522,9 @@ void PostDispatch(const TsfnRef& tsfn) {
   // the env dies, so no liveness re-check is needed inside.
   TsfnRef ref = tsfn;
 
-  std::shared_ptr<tns::EventLoop> loop = weakLoop.lock();
+  std::shared_ptr<tns::EventLoop> loop = tsfn->eventLoop.lock();
   if (loop == nullptr || !loop->PostInternal([ref]() { RunDispatch(ref); })) {
-    std::lock_guard<std::mutex> lock(ref->mutex);
-    ref->dispatchPosted = false;
+    ref->dispatchPosted.store(false, std::memory_order_seq_cst);
   }
 }
 
@@ -291,8 +547,8 @@ void NapiAbortThreadSafeFunctions(NapiEnv* env) {
   for (const TsfnRef& tsfn : victims) {
     {
       std::lock_guard<std::mutex> lock(tsfn->mutex);
-      tsfn->closing = true;
-      tsfn->envAlive = false;
+      tsfn->closing.store(true, std::memory_order_seq_cst);
+      tsfn->envAlive.store(false, std::memory_order_release);
     }
     // Producers blocked on a full queue have to be let go before anything
     // else: they are answered with napi_closing.
@@ -315,6 +571,33 @@ void NapiAbortThreadSafeFunctions(NapiEnv* env) {
   }
 }
 
+bool NapiGetThreadSafeFunctionStats(napi_threadsafe_function__* func,
+                                    NapiThreadSafeFunctionStats* stats) {
+  if (func == nullptr || stats == nullptr) {
+    return false;
+  }
+
+  stats->queueDepth = QueueDepth(func);
+  stats->peakQueueDepth = func->peakQueueDepth.load(std::memory_order_relaxed);
+  stats->calls = func->calls.load(std::memory_order_relaxed);
+  stats->delivered = func->delivered.load(std::memory_order_relaxed);
+  stats->dispatches = func->dispatches.load(std::memory_order_relaxed);
+  stats->queueFull = func->queueFull.load(std::memory_order_relaxed);
+  stats->totalWaitNs = func->totalWaitNs.load(std::memory_order_relaxed);
+  stats->maxWaitNs = func->maxWaitNs.load(std::memory_order_relaxed);
+  stats->blockedNs = func->blockedNs.load(std::memory_order_relaxed);
+  return true;
+}
+
+bool NapiUseLockedThreadSafeFunctionQueue(napi_threadsafe_function__* func) {
+  if (func == nullptr || func->calls.load(std::memory_order_relaxed) > 0) {
+    return false;
+  }
+
+  func->lockedQueue = true;
+  return true;
+}
+
 }  // namespace tns
 
 //=== Entry points =========================================================
@@ -347,7 +630,7 @@ napi_create_threadsafe_function(napi_env env,
   RETURN_STATUS_IF_FALSE(env, tnsEnv->RuntimeLoop() != nullptr,
                          napi_generic_failure);
 
-  TsfnRef tsfn = std::make_shared<napi_threadsafe_function__>();
+  TsfnRef tsfn = std::make_shared<napi_threadsafe_function__>(max_queue_size);
   tsfn->env = tnsEnv;
   tsfn->isolate = env->isolate;
   tsfn->loop = tnsEnv->RuntimeLoop();
@@ -357,7 +640,6 @@ napi_create_threadsafe_function(napi_env env,
   tsfn->finalizeCb = thread_finalize_cb;
   tsfn->finalizeData = thread_finalize_data;
   tsfn->context = context;
-  tsfn->maxQueueSize = max_queue_size;
   tsfn->threadCount = initial_thread_count;
 
   if (func != nullptr) {
@@ -396,28 +678,37 @@ napi_call_threadsafe_function(napi_threadsafe_function func,
     return napi_invalid_arg;
   }
 
-  {
-    std::unique_lock<std::mutex> lock(func->mutex);
-    while (!func->closing && func->maxQueueSize > 0 &&
-           func->queue.size() >= func->maxQueueSize) {
-      if (is_blocking == napi_tsfn_nonblocking) {
-        return napi_queue_full;
-      }
-      // The thread that drains the queue is the one that would have to wake
-      // this wait, so blocking on it there can only stall forever. Node blocks
-      // regardless and leaves this status unused; wedging the runloop is worse
-      // than a status an addon may not expect.
-      if (CFRunLoopGetCurrent() == func->loop) {
-        return napi_would_deadlock;
-      }
-      func->spaceAvailable.wait(lock);
+  EnqueueResult result = TryEnqueue(func, data);
+  if (result == EnqueueResult::kFull) {
+    if (is_blocking == napi_tsfn_nonblocking) {
+      func->queueFull.fetch_add(1, std::memory_order_relaxed);
+      return napi_queue_full;
+    }
+    // The thread that drains the queue is the one that would have to wake
+    // this wait, so blocking on it there can only stall forever. Node blocks
+    // regardless and leaves this status unused; wedging the runloop is worse
+    // than a status an addon may not expect.
+    if (CFRunLoopGetCurrent() == func->loop) {
+      return napi_would_deadlock;
     }
 
-    if (func->closing) {
-      return napi_closing;
+    TsfnClock::time_point blockedAt = TsfnClock::now();
+    {
+      std::unique_lock<std::mutex> lock(func->mutex);
+      func->waitingProducers.fetch_add(1, std::memory_order_seq_cst);
+      // Pairs with the fence in Dequeue (see there).
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while ((result = TryEnqueue(func, data, true)) == EnqueueResult::kFull) {
+        func->spaceAvailable.wait(lock);
+      }
+      func->waitingProducers.fetch_sub(1, std::memory_order_relaxed);
     }
+    func->blockedNs.fetch_add(ElapsedNs(blockedAt, TsfnClock::now()),
+                              std::memory_order_relaxed);
+  }
 
-    func->queue.push(data);
+  if (result == EnqueueResult::kClosing) {
+    return napi_closing;
   }
 
   PostDispatch(func->shared_from_this());
@@ -431,7 +722,7 @@ napi_acquire_threadsafe_function(napi_threadsafe_function func) {
   }
 
   std::lock_guard<std::mutex> lock(func->mutex);
-  if (func->closing) {
+  if (func->closing.load(std::memory_order_acquire)) {
     return napi_closing;
   }
 
@@ -454,9 +745,11 @@ napi_status NAPI_CDECL napi_release_threadsafe_function(
     }
 
     tsfn->threadCount--;
-    if (!tsfn->closing &&
+    if (!tsfn->closing.load(std::memory_order_acquire) &&
         (mode == napi_tsfn_abort || tsfn->threadCount == 0)) {
-      tsfn->closing = (mode == napi_tsfn_abort);
+      if (mode == napi_tsfn_abort) {
+        tsfn->closing.store(true, std::memory_order_seq_cst);
+      }
       dispatch = true;
     }
   }
@@ -10,10 +10,15 @@
 #define NODE_API_EXPERIMENTAL_NO_WARNING
 
 #include <dispatch/dispatch.h>
+#include <pthread.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -26,6 +31,7 @@
 
 #include "js_native_api_v8.h"
 
+#include "NapiAsyncWorkPool.h"
 #include "NapiEnv.h"
 #include "NapiModules.h"
 #include "runtime/Helpers.h"
@@ -492,9 +498,10 @@ struct napi_async_work__ {
 
   tns::NapiEnv* env = nullptr;
   v8::Isolate* isolate = nullptr;
-  // Goes null once the runtime shuts the loop down; a completion that finds
-  // it null is dropped, the same fate Shutdown gives already-queued entries.
-  std::weak_ptr<tns::EventLoop> eventLoop;
+  // The env's lane in the pool. Its event loop goes null once the runtime
+  // shuts the loop down; a completion that finds it null is dropped, the same
+  // fate Shutdown gives already-queued entries.
+  std::shared_ptr<tns::NapiAsyncWorkQueue> queue;
   napi_async_execute_callback execute = nullptr;
   napi_async_complete_callback complete = nullptr;
   void* data = nullptr;
@@ -502,16 +509,55 @@ struct napi_async_work__ {
   std::mutex mutex;
   State state = State::idle;
   bool cancelled = false;
+
+  // Written by the pool thread that runs the work, read by its completion.
+  std::chrono::steady_clock::time_point queuedAt;
+  std::chrono::steady_clock::time_point finishedAt;
+  napi_status status = napi_ok;
+};
+
+namespace tns {
+
+// One env's lane in the async work pool. `pending` and `inRotation` belong to
+// the pool's mutex. Completions are batched here, so however many works finish
+// during one runloop turn, the env receives a single posted entry for them.
+struct NapiAsyncWorkQueue {
+  std::weak_ptr<EventLoop> eventLoop;
+  std::deque<napi_async_work> pending;
+  bool inRotation = false;
+
+  std::mutex completionMutex;
+  std::vector<napi_async_work> completions;
+  bool completionPosted = false;
 };
 
+const std::shared_ptr<NapiAsyncWorkQueue>& NapiEnv::AsyncWorkQueue() {
+  if (asyncWorkQueue_ == nullptr) {
+    asyncWorkQueue_ = std::make_shared<NapiAsyncWorkQueue>();
+    asyncWorkQueue_->eventLoop = eventLoop_;
+  }
+  return asyncWorkQueue_;
+}
+
+}  // namespace tns
+
 namespace {
 
+using WorkClock = std::chrono::steady_clock;
+using WorkQueueRef = std::shared_ptr<tns::NapiAsyncWorkQueue>;
+
+uint64_t ElapsedNs(WorkClock::time_point since, WorkClock::time_point now) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - since)
+          .count());
+}
+
 // The env's thread. `work` belongs to the addon, which is free to delete it
 // from the complete callback, so nothing may touch it afterwards.
-// Runs as an internal-lane entry, under the loop's Locker/scopes. Shutdown
-// drops queued completions before the env dies (the addon's `data` is dropped
-// with them — the same trade Node makes at environment shutdown), so no
-// liveness check or isolate ceremony is needed here.
+// Runs inside an internal-lane entry, under the loop's Locker/scopes.
+// Shutdown drops queued completions before the env dies (the addon's `data` is
+// dropped with them — the same trade Node makes at environment shutdown), so
+// no liveness check or isolate ceremony is needed here.
 void CompleteAsyncWork(napi_async_work work, napi_status status) {
   tns::NapiEnv* env = work->env;
   {
@@ -540,8 +586,267 @@ void CompleteAsyncWork(napi_async_work work, napi_status status) {
       });
 }
 
+// Node runs async work on a fixed libuv pool (4 threads by default) and addons
+// write execute callbacks that assume a bounded worker count, so the pool is
+// bounded too. Its size and QoS come from the app's package.json:
+//
+//   "napi": { "asyncWorkThreads": 8, "asyncWorkQos": "userInitiated" }
+//
+// By default it gets one thread per core, never fewer than Node's 4, at
+// QOS_CLASS_DEFAULT. (A self-created NSOperationQueue would default to
+// Background QoS, which is CPU/IO-throttled.)
+class AsyncWorkPool {
+ public:
+  static AsyncWorkPool& Instance() {
+    static AsyncWorkPool* pool = new AsyncWorkPool();
+    return *pool;
+  }
+
+  void Submit(napi_async_work work);
+  void GetStats(tns::NapiAsyncWorkPoolStats* stats);
+
+ private:
+  // A thread that has found nothing to run for this long exits; the next
+  // submit starts a new one.
+  static constexpr auto kIdleThreadTimeout = std::chrono::seconds(30);
+
+  AsyncWorkPool();
+
+  static void* ThreadMain(void* pool);
+  void WorkerLoop();
+  void Execute(napi_async_work work);
+  void PostCompletion(napi_async_work work);
+  static void RunCompletions(const WorkQueueRef& queue);
+
+  size_t maxThreads_ = 4;
+  qos_class_t qos_ = QOS_CLASS_DEFAULT;
+
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  // Lanes with pending work. A thread takes one work from the lane at the front
+  // and moves the lane to the back, so an addon that queues a thousand works
+  // delays another env's next one by at most one work per thread.
+  std::deque<WorkQueueRef> rotation_;
+  size_t threads_ = 0;
+  size_t idle_ = 0;
+  size_t queued_ = 0;
+  size_t executing_ = 0;
+
+  std::atomic<uint64_t> completed_{0};
+  std::atomic<uint64_t> completionBatches_{0};
+  std::atomic<uint64_t> totalQueueNs_{0};
+  std::atomic<uint64_t> maxQueueNs_{0};
+  std::atomic<uint64_t> totalExecuteNs_{0};
+  std::atomic<uint64_t> totalCompletionNs_{0};
+};
+
+AsyncWorkPool::AsyncWorkPool() {
+  maxThreads_ = std::max<size_t>(4, [NSProcessInfo processInfo].activeProcessorCount);
+
+  id config = tns::Runtime::GetAppConfigValue("napi");
+  if (![config isKindOfClass:[NSDictionary class]]) {
+    return;
+  }
+
+  id threads = config[@"asyncWorkThreads"];
+  if ([threads isKindOfClass:[NSNumber class]] && [threads integerValue] > 0) {
+    maxThreads_ = static_cast<size_t>([threads integerValue]);
+  }
+
+  id qos = config[@"asyncWorkQos"];
+  if ([qos isKindOfClass:[NSString class]]) {
+    if ([qos isEqualToString:@"userInitiated"]) {
+      qos_ = QOS_CLASS_USER_INITIATED;
+    } else if ([qos isEqualToString:@"utility"]) {
+      qos_ = QOS_CLASS_UTILITY;
+    } else if ([qos isEqualToString:@"background"]) {
+      qos_ = QOS_CLASS_BACKGROUND;
+    }
+  }
+}
+
+void AsyncWorkPool::Submit(napi_async_work work) {
+  bool startThread = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const WorkQueueRef& queue = work->queue;
+    work->queuedAt = WorkClock::now();
+    queue->pending.push_back(work);
+    if (!queue->inRotation) {
+      queue->inRotation = true;
+      rotation_.push_back(queue);
+    }
+    queued_++;
+
+    if (idle_ == 0 && threads_ < maxThreads_) {
+      threads_++;
+      startThread = true;
+    }
+  }
+
+  if (!startThread) {
+    workAvailable_.notify_one();
+    return;
+  }
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  pthread_attr_set_qos_class_np(&attr, qos_, 0);
+  pthread_t thread;
+  if (pthread_create(&thread, &attr, &AsyncWorkPool::ThreadMain, this) != 0) {
+    // The threads already running will get to the work.
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_--;
+  }
+  pthread_attr_destroy(&attr);
+}
+
+void* AsyncWorkPool::ThreadMain(void* pool) {
+  pthread_setname_np("org.nativescript.napi.asyncwork");
+  static_cast<AsyncWorkPool*>(pool)->WorkerLoop();
+  return nullptr;
+}
+
+void AsyncWorkPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    idle_++;
+    bool haveWork = workAvailable_.wait_for(lock, kIdleThreadTimeout,
+                                            [this] { return !rotation_.empty(); });
+    idle_--;
+    if (!haveWork) {
+      threads_--;
+      return;
+    }
+
+    WorkQueueRef queue = std::move(rotation_.front());
+    rotation_.pop_front();
+    napi_async_work work = queue->pending.front();
+    queue->pending.pop_front();
+    if (queue->pending.empty()) {
+      queue->inRotation = false;
+    } else {
+      rotation_.push_back(std::move(queue));
+    }
+    queued_--;
+    executing_++;
+
+    lock.unlock();
+    Execute(work);
+    lock.lock();
+
+    executing_--;
+  }
+}
+
+void AsyncWorkPool::Execute(napi_async_work work) {
+  WorkClock::time_point startedAt = WorkClock::now();
+  uint64_t queueNs = ElapsedNs(work->queuedAt, startedAt);
+  totalQueueNs_.fetch_add(queueNs, std::memory_order_relaxed);
+  uint64_t maxQueueNs = maxQueueNs_.load(std::memory_order_relaxed);
+  while (queueNs > maxQueueNs &&
+         !maxQueueNs_.compare_exchange_weak(maxQueueNs, queueNs,
+                                            std::memory_order_relaxed)) {
+  }
+
+  napi_status status = napi_ok;
+  {
+    std::lock_guard<std::mutex> lock(work->mutex);
+    if (work->cancelled) {
+      status = napi_cancelled;
+    } else {
+      work->state = napi_async_work__::State::executing;
+    }
+  }
+
+  // Off the env's thread: the execute callback may not touch the isolate,
+  // which is exactly the contract Node states for it.
+  if (status == napi_ok) {
+    work->execute(work->env, work->data);
+  }
+
+  work->status = status;
+  work->finishedAt = WorkClock::now();
+  totalExecuteNs_.fetch_add(ElapsedNs(startedAt, work->finishedAt),
+                            std::memory_order_relaxed);
+  PostCompletion(work);
+}
+
+// Only the first completion since the env last ran its batch posts; the rest
+// join that entry.
+void AsyncWorkPool::PostCompletion(napi_async_work work) {
+  // Held by value: the work may be completed, and deleted by the addon, as
+  // soon as it is in the batch.
+  WorkQueueRef queue = work->queue;
+  {
+    std::lock_guard<std::mutex> lock(queue->completionMutex);
+    queue->completions.push_back(work);
+    if (queue->completionPosted) {
+      return;
+    }
+    queue->completionPosted = true;
+  }
+
+  std::shared_ptr<tns::EventLoop> loop = queue->eventLoop.lock();
+  if (loop == nullptr || !loop->PostInternal([queue]() { RunCompletions(queue); })) {
+    std::lock_guard<std::mutex> lock(queue->completionMutex);
+    queue->completions.clear();
+    queue->completionPosted = false;
+  }
+}
+
+// The env's thread, as an internal-lane entry.
+void AsyncWorkPool::RunCompletions(const WorkQueueRef& queue) {
+  std::vector<napi_async_work> batch;
+  {
+    std::lock_guard<std::mutex> lock(queue->completionMutex);
+    batch.swap(queue->completions);
+    queue->completionPosted = false;
+  }
+
+  AsyncWorkPool& pool = Instance();
+  pool.completionBatches_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i < batch.size(); i++) {
+    napi_async_work work = batch[i];
+    // Node settles microtasks after every complete callback; the entry itself
+    // only checkpoints once, after the last.
+    if (i > 0) {
+      work->isolate->PerformMicrotaskCheckpoint();
+    }
+    pool.completed_.fetch_add(1, std::memory_order_relaxed);
+    pool.totalCompletionNs_.fetch_add(ElapsedNs(work->finishedAt, WorkClock::now()),
+                                      std::memory_order_relaxed);
+    CompleteAsyncWork(work, work->status);
+  }
+}
+
+void AsyncWorkPool::GetStats(tns::NapiAsyncWorkPoolStats* stats) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats->threads = threads_;
+    stats->queued = queued_;
+    stats->executing = executing_;
+  }
+  stats->maxThreads = maxThreads_;
+  stats->completed = completed_.load(std::memory_order_relaxed);
+  stats->completionBatches = completionBatches_.load(std::memory_order_relaxed);
+  stats->totalQueueNs = totalQueueNs_.load(std::memory_order_relaxed);
+  stats->maxQueueNs = maxQueueNs_.load(std::memory_order_relaxed);
+  stats->totalExecuteNs = totalExecuteNs_.load(std::memory_order_relaxed);
+  stats->totalCompletionNs = totalCompletionNs_.load(std::memory_order_relaxed);
+}
+
 }  // namespace
 
+namespace tns {
+
+void NapiGetAsyncWorkPoolStats(NapiAsyncWorkPoolStats* stats) {
+  AsyncWorkPool::Instance().GetStats(stats);
+}
+
+}  // namespace tns
+
 napi_status NAPI_CDECL
 napi_create_async_work(napi_env env,
                        napi_value async_resource,
@@ -565,7 +870,7 @@ napi_create_async_work(napi_env env,
   napi_async_work__* work = new napi_async_work__();
   work->env = tnsEnv;
   work->isolate = env->isolate;
-  work->eventLoop = tnsEnv->GetEventLoop();
+  work->queue = tnsEnv->AsyncWorkQueue();
   work->execute = execute;
   work->complete = complete;
   work->data = data;
@@ -613,42 +918,7 @@ napi_status NAPI_CDECL napi_queue_async_work(node_api_basic_env basic_env,
     work->cancelled = false;
   }
 
-  // Node runs async work on a fixed libuv pool (4 threads by default) and
-  // addons write execute callbacks that assume a bounded worker count — an
-  // unbounded GCD queue would let N blocking callbacks spawn N threads.
-  static NSOperationQueue* workPool;
-  static dispatch_once_t once;
-  dispatch_once(&once, ^{
-    workPool = [[NSOperationQueue alloc] init];
-    workPool.name = @"org.nativescript.napi.asyncwork";
-    workPool.maxConcurrentOperationCount = 4;
-    // Self-created NSOperationQueues default to Background QoS, which is
-    // CPU/IO-throttled; keep the QOS_CLASS_DEFAULT the GCD global queue gave.
-    workPool.qualityOfService = NSQualityOfServiceDefault;
-  });
-
-  [workPool addOperationWithBlock:^{
-    napi_status status = napi_ok;
-    {
-      std::lock_guard<std::mutex> lock(work->mutex);
-      if (work->cancelled) {
-        status = napi_cancelled;
-      } else {
-        work->state = napi_async_work__::State::executing;
-      }
-    }
-
-    // Off the env's thread: the execute callback may not touch the isolate,
-    // which is exactly the contract Node states for it.
-    if (status == napi_ok) {
-      work->execute(work->env, work->data);
-    }
-
-    std::shared_ptr<tns::EventLoop> loop = work->eventLoop.lock();
-    if (loop != nullptr) {
-      loop->PostInternal([work, status]() { CompleteAsyncWork(work, status); });
-    }
-  }];
+  AsyncWorkPool::Instance().Submit(work);
 
   return napi_clear_last_error(env);
 }
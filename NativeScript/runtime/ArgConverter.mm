@@ -4,6 +4,7 @@
 #include "DictionaryAdapter.h"
 #include "Helpers.h"
 #include "Interop.h"
+#include "MetadataProfile.h"
 #include "NSExceptionSupport.h"
 #include "NativeScriptException.h"
 #include "ObjectManager.h"
@@ -195,7 +196,7 @@ id ArgConverter::ExtractEscapedException(Local<Context> context, Local<Value> va
 
   // Original NSException carried through unchanged when present.
   Local<Value> nativeExc;
-  if (payload->Get(context, tns::ToV8String(isolate, "nativeException")).ToLocal(&nativeExc) &&
+  if (payload->Get(context, tns::Keys::NativeException(isolate)).ToLocal(&nativeExc) &&
       nativeExc->IsObject()) {
     BaseDataWrapper* wrapper = tns::GetValue(isolate, nativeExc);
     if (wrapper != nullptr && wrapper->Type() == WrapperType::ObjCObject) {
@@ -837,7 +838,7 @@ Local<Value> ArgConverter::CreateJsWrapper(Local<Context> context, BaseDataWrapp
     Local<v8::Function> structCtorFunc = cache->StructCtorInitializer(context, structInfo);
     Local<Value> proto;
     bool success =
-        structCtorFunc->Get(context, tns::ToV8String(isolate, "prototype")).ToLocal(&proto);
+        structCtorFunc->Get(context, tns::Keys::Prototype(isolate)).ToLocal(&proto);
 
     if (success && !proto.IsEmpty()) {
       success = receiver->SetPrototype(context, proto).FromMaybe(false);
@@ -930,7 +931,7 @@ Local<Value> ArgConverter::CreateJsWrapper(Local<Context> context, BaseDataWrapp
 
       Local<Value> prototypeValue;
       success =
-          ctorFunc->Get(context, tns::ToV8String(isolate, "prototype")).ToLocal(&prototypeValue);
+          ctorFunc->Get(context, tns::Keys::Prototype(isolate)).ToLocal(&prototypeValue);
       tns::Assert(success, isolate);
       Local<Object> prototype = prototypeValue.As<Object>();
 
@@ -1011,10 +1012,30 @@ const Meta* ArgConverter::FindMeta(Class klass, const TypeEncoding* typeEncoding
   return nullptr;
 }
 
+// With "recordMetadataUsage" set in package.json, the JS name of every metadata entry the app
+// resolves is appended to a file, once per process since results are cached. The file is a usage
+// manifest the metadata generator accepts. The value is the file's path, or true for
+// Documents/metadata-usage.txt.
+static FILE* MetadataUsageFile() {
+  static FILE* file = nullptr;
+  static std::once_flag once;
+  std::call_once(once, []() {
+    std::string path = MetadataProfile::RecordingPath("recordMetadataUsage", "metadata-usage.txt");
+    if (!path.empty()) {
+      file = fopen(path.c_str(), "a");
+      Log(file != nullptr ? @"Recording metadata usage to %s"
+                          : @"Unable to record metadata usage to %s",
+          path.c_str());
+    }
+  });
+  return file;
+}
+
 const Meta* ArgConverter::GetMeta(const std::string& name) {
   bool found;
   const Meta* meta = Caches::Metadata->Get(name, found);
   if (meta != nullptr || found) {
+    MetadataProfile::Record(meta);
     return meta;
   }
 
@@ -1034,6 +1055,15 @@ const Meta* ArgConverter::GetMeta(const std::string& name) {
   }
 
   Caches::Metadata->Insert(name, result);
+  MetadataProfile::Record(result);
+
+  if (result != nullptr) {
+    if (FILE* usageFile = MetadataUsageFile()) {
+      // stdio locks the stream, so lines from different threads do not interleave
+      fprintf(usageFile, "%s\n", result->jsName());
+      fflush(usageFile);
+    }
+  }
 
   return result;
 }
@@ -8,6 +8,7 @@
 
 #include "Common.h"
 #include "ConcurrentMap.h"
+#include "InternedKeys.h"
 #include "Metadata.h"
 #include "robin_hood.h"
 
@@ -127,6 +128,10 @@ class Caches {
   // posts foreground tasks during Isolate::New)
   inline bool HasContext() { return context_ != nullptr; }
 
+  // Internalized runtime-internal property names and private keys; read them
+  // through the tns::Keys accessors.
+  InternedKeyTable InternedKeys;
+
   // Per-isolate unhandled promise rejection tracking. Fed by
   // NativeScriptException::OnPromiseRejected and drained once per runloop turn.
   std::unique_ptr<PromiseRejectionTracker> PromiseRejections;
@@ -66,7 +66,7 @@ void ClassBuilder::ExtendCallback(const FunctionCallbackInfo<Value>& info) {
     if (info.Length() > 1 && info[1]->IsObject()) {
       nativeSignature = info[1].As<Object>();
       Local<Value> explicitClassName;
-      tns::Assert(nativeSignature->Get(context, tns::ToV8String(isolate, "name"))
+      tns::Assert(nativeSignature->Get(context, tns::Keys::Name(isolate))
                       .ToLocal(&explicitClassName),
                   isolate);
       if (!explicitClassName.IsEmpty() && !explicitClassName->IsNullOrUndefined()) {
@@ -107,7 +107,7 @@ void ClassBuilder::ExtendCallback(const FunctionCallbackInfo<Value>& info) {
 
     Local<Value> baseProto;
     bool success =
-        baseCtorFunc->Get(context, tns::ToV8String(isolate, "prototype")).ToLocal(&baseProto);
+        baseCtorFunc->Get(context, tns::Keys::Prototype(isolate)).ToLocal(&baseProto);
     tns::Assert(success, isolate);
 
     if (!implementationObject->SetPrototype(context, baseProto).To(&success) || !success) {
@@ -126,7 +126,7 @@ void ClassBuilder::ExtendCallback(const FunctionCallbackInfo<Value>& info) {
 
     extendClassCtorFunc->SetName(tns::ToV8String(isolate, class_getName(extendedClass)));
     Local<Value> extendFuncPrototypeValue;
-    success = extendClassCtorFunc->Get(context, tns::ToV8String(isolate, "prototype"))
+    success = extendClassCtorFunc->Get(context, tns::Keys::Prototype(isolate))
                   .ToLocal(&extendFuncPrototypeValue);
     tns::Assert(success && extendFuncPrototypeValue->IsObject(), isolate);
     Local<Object> extendFuncPrototype = extendFuncPrototypeValue.As<Object>();
@@ -238,7 +238,7 @@ void ClassBuilder::RegisterNativeTypeScriptExtendsFunction(Local<Context> contex
         tns::Assert(extendedClassCtorFunc->SetPrototype(context, baseCtorFunc).ToChecked(),
                     isolate);
 
-        Local<v8::String> prototypeProp = tns::ToV8String(isolate, "prototype");
+        Local<v8::String> prototypeProp = tns::Keys::Prototype(isolate);
 
         Local<Value> extendedClassCtorFuncPrototypeValue;
         bool success = extendedClassCtorFunc->Get(context, prototypeProp)
@@ -283,7 +283,7 @@ void ClassBuilder::RegisterNativeTypeScriptExtendsFunction(Local<Context> contex
           tns::Assert(success, isolate);
 
           Local<Value> implementationObject;
-          success = extendedClassCtorFunc->Get(context, tns::ToV8String(isolate, "prototype"))
+          success = extendedClassCtorFunc->Get(context, tns::Keys::Prototype(isolate))
                         .ToLocal(&implementationObject);
           tns::Assert(success, isolate);
 
@@ -775,7 +775,7 @@ void ClassBuilder::ExposeDynamicMethods(Local<Context> context, Class extendedCl
 
     Local<Value> method;
     success = propertyDescriptor.As<Object>()
-                  ->Get(context, tns::ToV8String(isolate, "value"))
+                  ->Get(context, tns::Keys::Value(isolate))
                   .ToLocal(&method);
     tns::Assert(success, isolate);
 
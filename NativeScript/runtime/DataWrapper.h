@@ -513,11 +513,28 @@ class ExtVectorWrapper : public BaseDataWrapper {
   const TypeEncoding* InnerTypeEncoding() { return this->innerTypeEncoding_; }
   const TypeEncoding* TypeEncoding() { return this->typeEncoding_; }
 
+  // Created by the first asTypedArray() call, after which the store owns
+  // data_: views handed out keep the bytes alive past the vector itself.
+  std::shared_ptr<v8::BackingStore> GetBackingStore(v8::Isolate* isolate) {
+    if (this->backingStore_ == nullptr) {
+      this->backingStore_ = v8::ArrayBuffer::NewBackingStore(
+          this->data_, this->ffiType_->size,
+          [](void* data, size_t length, void* deleterData) { std::free(data); },
+          nullptr);
+    }
+    return this->backingStore_;
+  }
+
+  bool HasBackingStore() { return this->backingStore_ != nullptr; }
+
+  void ReleaseBackingStore() { this->backingStore_.reset(); }
+
  private:
   void* data_;
   ffi_type* ffiType_;
   const struct TypeEncoding* innerTypeEncoding_;
   const struct TypeEncoding* typeEncoding_;
+  std::shared_ptr<v8::BackingStore> backingStore_;
 };
 
 class WorkerWrapper : public BaseDataWrapper {
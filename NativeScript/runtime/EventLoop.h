@@ -168,6 +168,24 @@ class EventLoop {
    */
   void RunOrderedTask();
 
+  /**
+   * Time accounting for performance.eventLoopUtilization(): since the bind,
+   * `idleMs` is how long the runloop spent asleep waiting for a source or
+   * timer and `activeMs` is everything else. Both are 0 before the bind.
+   * Any thread that holds the isolate; it can sample while the home thread
+   * sleeps.
+   */
+  void LoopTiming(double* idleMs, double* activeMs);
+
+  /**
+   * Called on the home thread each time the runloop is about to sleep, with
+   * the length of the turn that just ended (wake-up to sleep, in ms). Runs
+   * before the wait starts being counted as idle, so the observer's own work
+   * is active time but not part of any reported turn. Home thread only; pass
+   * an empty function to unregister.
+   */
+  void SetTurnObserver(std::function<void(double turnMs)> observer);
+
   // CLOCK_MONOTONIC milliseconds - the clock every due time and token is on
   static double NowMs();
 
@@ -207,6 +225,8 @@ class EventLoop {
   static void InternalSourcePerform(void* info);
   static void InternalTimerFired(CFRunLoopTimerRef timer, void* info);
   static void OrderedTimerFired(CFRunLoopTimerRef timer, void* info);
+  static void ActivityObserved(CFRunLoopObserverRef observer,
+                               CFRunLoopActivity activity, void* info);
 
   v8::Isolate* isolate_;
   std::mutex mutex_;
@@ -222,7 +242,17 @@ class EventLoop {
   CFRunLoopSourceRef internalSource_ = nullptr;
   CFRunLoopTimerRef internalTimer_ = nullptr;
   CFRunLoopTimerRef orderedTimer_ = nullptr;
+  CFRunLoopObserverRef activityObserver_ = nullptr;
   bool stopped_ = false;
+  // idle/active accounting in NowMs() units. The home thread writes the first
+  // three under mutex_, and LoopTiming reads them under it from any thread.
+  double loopStartMs_ = 0;
+  double idleMs_ = 0;
+  // start of the current wait, or negative while the loop is awake
+  double waitStartMs_ = -1;
+  // home-thread only
+  double turnStartMs_ = 0;
+  std::function<void(double turnMs)> turnObserver_;
 };
 
 }  // namespace tns
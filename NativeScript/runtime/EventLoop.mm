@@ -7,6 +7,7 @@
 #include "Caches.h"
 #include "Helpers.h"
 #include "NativeScriptException.h"
+#include "Tracing.h"
 
 using namespace v8;
 
@@ -73,6 +74,17 @@ void EventLoop::BindToCurrentThread() {
                            kNeverFireInterval, 0, 0, &EventLoop::OrderedTimerFired, &timerContext);
   CFRunLoopAddTimer(loop_, orderedTimer_, kCFRunLoopCommonModes);
 
+  // Last in order, so at before-waiting the turn includes the other observers'
+  // work (CA commit, autorelease pool drain, the rejection drain).
+  CFRunLoopObserverContext observerContext = {0, this, nullptr, nullptr, nullptr};
+  activityObserver_ =
+      CFRunLoopObserverCreate(kCFAllocatorDefault, kCFRunLoopBeforeWaiting | kCFRunLoopAfterWaiting,
+                              /*repeats*/ true, /*order*/ std::numeric_limits<CFIndex>::max(),
+                              &EventLoop::ActivityObserved, &observerContext);
+  CFRunLoopAddObserver(loop_, activityObserver_, kCFRunLoopCommonModes);
+  loopStartMs_ = NowMs();
+  turnStartMs_ = loopStartMs_;
+
   // flush work buffered before the home thread was known
   auto now = NowMs();
   if (HasDueLocked(internal_, now)) {
@@ -117,6 +129,12 @@ void EventLoop::Shutdown() {
     CFRelease(orderedTimer_);
     orderedTimer_ = nullptr;
   }
+  if (activityObserver_ != nullptr) {
+    CFRunLoopObserverInvalidate(activityObserver_);
+    CFRelease(activityObserver_);
+    activityObserver_ = nullptr;
+  }
+  turnObserver_ = nullptr;
   loop_ = nullptr;
 }
 
@@ -259,6 +277,28 @@ void EventLoop::PostV8Task(std::unique_ptr<Task> task, bool nestable, double del
   PostInternalLocked(Entry{std::move(task), nullptr, nestable, false, 0}, delaySeconds * 1000.0);
 }
 
+void EventLoop::LoopTiming(double* idleMs, double* activeMs) {
+  // script entered from another thread can sample while the home thread
+  // sleeps; the wait so far is idle time all the same
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (loopStartMs_ == 0) {
+    *idleMs = 0;
+    *activeMs = 0;
+    return;
+  }
+  double now = NowMs();
+  double idle = idleMs_;
+  if (waitStartMs_ >= 0) {
+    idle += now - waitStartMs_;
+  }
+  *idleMs = idle;
+  *activeMs = now - loopStartMs_ - idle;
+}
+
+void EventLoop::SetTurnObserver(std::function<void(double turnMs)> observer) {
+  turnObserver_ = std::move(observer);
+}
+
 bool EventLoop::IsStopped() {
   std::lock_guard<std::mutex> lock(mutex_);
   return stopped_;
@@ -390,6 +430,7 @@ void EventLoop::RunOneInternal() {
     // leftover signal: the work it announced ran early from a nested drain
     return;
   }
+  TraceScope trace(TraceCategory::EventLoop, "internalTask");
   if (entry->bare) {
     RunEntry(*entry);
     return;
@@ -419,6 +460,7 @@ void EventLoop::RunNestableV8Tasks() {
     }
     // the pause loops call this from inside v8 inspector frames - a C++
     // exception must not unwind through them
+    TraceScope trace(TraceCategory::EventLoop, "nestableV8Task");
     RunGuarded([&] { RunEntry(*entry); });
   }
 }
@@ -438,6 +480,9 @@ void EventLoop::RunOrderedTask() {
     }
     entryDue = PeekDueLocked(ordered_, now);
   }
+  // Leftover tokens show up as near-empty events; they are cheap but real
+  // runloop passes.
+  TraceScope trace(TraceCategory::EventLoop, "orderedTask");
   if (timerSource_ != nullptr && timerSource_->RunIfEarliest(now, entryDue)) {
     return;
   }
@@ -498,4 +543,32 @@ void EventLoop::OrderedTimerFired(CFRunLoopTimerRef timer, void* info) {
   }
 }
 
+void EventLoop::ActivityObserved(CFRunLoopObserverRef observer, CFRunLoopActivity activity,
+                                 void* info) {
+  auto self = static_cast<EventLoop*>(info);
+  if (activity == kCFRunLoopAfterWaiting) {
+    auto now = NowMs();
+    {
+      std::lock_guard<std::mutex> lock(self->mutex_);
+      if (self->waitStartMs_ >= 0) {
+        self->idleMs_ += now - self->waitStartMs_;
+        self->waitStartMs_ = -1;
+      }
+    }
+    self->turnStartMs_ = now;
+    return;
+  }
+
+  // kCFRunLoopBeforeWaiting. A copy, so an observer that unregisters itself
+  // (or shuts the loop down) is not destroyed while it runs.
+  if (auto turnObserver = self->turnObserver_) {
+    double turnMs = NowMs() - self->turnStartMs_;
+    RunGuarded([&] { turnObserver(turnMs); });
+  }
+  if (self->activityObserver_ != nullptr) {
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    self->waitStartMs_ = NowMs();
+  }
+}
+
 }  // namespace tns
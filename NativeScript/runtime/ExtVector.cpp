@@ -1,39 +1,109 @@
 #include "ExtVector.h"
 
+#include <memory>
+
 #include "Caches.h"
 #include "FFICall.h"
 #include "Helpers.h"
 #include "Interop.h"
 #include "ObjectManager.h"
+#include "robin_hood.h"
 
 using namespace v8;
 
 namespace tns {
 
-Local<Value> ExtVector::NewInstance(Isolate* isolate, void* data,
-                                    ffi_type* ffiType,
-                                    const TypeEncoding* innerTypeEncoding,
-                                    const TypeEncoding* typeEncoding) {
+namespace {
+
+// Per-isolate kinds (Caches::StateFor), keyed by element type and lane count.
+// SIMD-heavy code returns vectors by the thousand, all of a handful of kinds.
+struct ExtVectorState {
+  robin_hood::unordered_map<uint32_t, std::unique_ptr<ExtVectorKind>> kinds;
+};
+
+uint32_t KindKey(BinaryTypeEncodingType elementType, size_t lanes) {
+  return (static_cast<uint32_t>(elementType) << 16) |
+         static_cast<uint32_t>(lanes);
+}
+
+const ExtVectorKind* KindFromData(Local<Value> data) {
+  return static_cast<const ExtVectorKind*>(data.As<External>()->Value());
+}
+
+}  // namespace
+
+ExtVectorKind::~ExtVectorKind() {
+  FFICall::DisposeFFIType(this->ffiType, this->typeEncoding);
+}
+
+const ExtVectorKind* ExtVector::GetKind(Isolate* isolate,
+                                        const TypeEncoding* typeEncoding) {
+  ExtVectorState* state = Caches::StateFor<ExtVectorState>(isolate);
+  if (state == nullptr) {
+    return nullptr;
+  }
+
+  const TypeEncoding* innerTypeEncoding =
+      typeEncoding->details.extVector.getInnerType();
+  size_t lanes = typeEncoding->details.extVector.size;
+  std::unique_ptr<ExtVectorKind>& kind =
+      state->kinds[KindKey(innerTypeEncoding->type, lanes)];
+  if (kind != nullptr) {
+    return kind.get();
+  }
+
+  // TODO: Validate that the inner type is supported (float, double)
+  kind = std::make_unique<ExtVectorKind>();
+  kind->elementType = innerTypeEncoding->type;
+  kind->lanes = lanes;
+  kind->ffiType = FFICall::GetArgumentType(typeEncoding);
+  kind->size = kind->ffiType->size;
+  kind->elementSize =
+      lanes > 0 ? kind->ffiType->elements[0]->size : kind->size;
+  kind->typeEncoding = typeEncoding;
+  kind->innerTypeEncoding = innerTypeEncoding;
+  kind->instanceTemplate.Reset(isolate,
+                               CreateInstanceTemplate(isolate, kind.get()));
+  return kind.get();
+}
+
+Local<ObjectTemplate> ExtVector::CreateInstanceTemplate(
+    Isolate* isolate, const ExtVectorKind* kind) {
+  // The kind outlives every instance: both go with the isolate's Caches.
+  Local<External> data =
+      External::New(isolate, const_cast<ExtVectorKind*>(kind));
+
   Local<FunctionTemplate> ctorFuncTemplate = FunctionTemplate::New(isolate);
-  ctorFuncTemplate->InstanceTemplate()->SetInternalFieldCount(1);
-  ctorFuncTemplate->InstanceTemplate()->SetHandler(
-      IndexedPropertyHandlerConfiguration(IndexedPropertyGetCallback,
-                                          IndexedPropertySetCallback));
   ctorFuncTemplate->SetClassName(tns::ToV8String(isolate, "ExtVector"));
-  ExtVector::RegisterToStringMethod(isolate,
-                                    ctorFuncTemplate->PrototypeTemplate());
 
+  Local<ObjectTemplate> prototypeTemplate =
+      ctorFuncTemplate->PrototypeTemplate();
+  ExtVector::RegisterToStringMethod(isolate, prototypeTemplate);
+  prototypeTemplate->Set(
+      tns::ToV8String(isolate, "asTypedArray"),
+      FunctionTemplate::New(isolate, ExtVector::AsTypedArrayCallback, data));
+
+  Local<ObjectTemplate> instanceTemplate =
+      ctorFuncTemplate->InstanceTemplate();
+  instanceTemplate->SetInternalFieldCount(1);
+  instanceTemplate->SetHandler(IndexedPropertyHandlerConfiguration(
+      IndexedPropertyGetCallback, IndexedPropertySetCallback, nullptr, nullptr,
+      nullptr, data));
+  return instanceTemplate;
+}
+
+Local<Value> ExtVector::NewInstance(Isolate* isolate, void* data,
+                                    const ExtVectorKind* kind) {
   Local<Context> context = isolate->GetCurrentContext();
-  Local<Value> result;
-  bool success =
-      ctorFuncTemplate->InstanceTemplate()->NewInstance(context).ToLocal(
-          &result);
+  Local<Object> result;
+  bool success = kind->instanceTemplate.Get(isolate)
+                     ->NewInstance(context)
+                     .ToLocal(&result);
   tns::Assert(success, isolate);
 
-  // TODO: Validate that the inner type is supported (float, double)
-  ExtVectorWrapper* wrapper =
-      new ExtVectorWrapper(data, ffiType, innerTypeEncoding, typeEncoding);
-  tns::SetValue(isolate, result.As<Object>(), wrapper);
+  ExtVectorWrapper* wrapper = new ExtVectorWrapper(
+      data, kind->ffiType, kind->innerTypeEncoding, kind->typeEncoding);
+  tns::SetValue(isolate, result, wrapper);
 
   return result;
 }
@@ -46,13 +116,10 @@ v8::Intercepted ExtVector::IndexedPropertyGetCallback(
   tns::Assert(wrapper != nullptr && wrapper->Type() == WrapperType::ExtVector,
               isolate);
   ExtVectorWrapper* extVectorWrapper = static_cast<ExtVectorWrapper*>(wrapper);
-  const TypeEncoding* innerTypeEncoding = extVectorWrapper->InnerTypeEncoding();
-  ffi_type* innerFFIType = FFICall::GetArgumentType(innerTypeEncoding);
-  size_t offset = index * innerFFIType->size;
-  FFICall::DisposeFFIType(innerFFIType, innerTypeEncoding);
+  const ExtVectorKind* kind = KindFromData(info.Data());
 
-  ffi_type* ffiType = extVectorWrapper->FFIType();
-  if (offset >= ffiType->size) {
+  size_t offset = index * kind->elementSize;
+  if (offset >= kind->size) {
     // Trying to access an element outside of the vector size
     info.GetReturnValue().SetUndefined();
     return v8::Intercepted::kYes;
@@ -61,7 +128,7 @@ v8::Intercepted ExtVector::IndexedPropertyGetCallback(
   void* data = extVectorWrapper->Data();
   BaseCall call((uint8_t*)data, offset);
   Local<Value> result =
-      Interop::GetPrimitiveReturnType(context, innerTypeEncoding->type, &call);
+      Interop::GetPrimitiveReturnType(context, kind->elementType, &call);
   info.GetReturnValue().Set(result);
   return v8::Intercepted::kYes;
 }
@@ -76,20 +143,17 @@ v8::Intercepted ExtVector::IndexedPropertySetCallback(
   tns::Assert(wrapper != nullptr && wrapper->Type() == WrapperType::ExtVector,
               isolate);
   ExtVectorWrapper* extVectorWrapper = static_cast<ExtVectorWrapper*>(wrapper);
-  const TypeEncoding* innerTypeEncoding = extVectorWrapper->InnerTypeEncoding();
-  ffi_type* innerFFIType = FFICall::GetArgumentType(innerTypeEncoding);
-  size_t offset = index * innerFFIType->size;
-  FFICall::DisposeFFIType(innerFFIType, innerTypeEncoding);
+  const ExtVectorKind* kind = KindFromData(info.Data());
 
-  ffi_type* ffiType = extVectorWrapper->FFIType();
-  if (offset >= ffiType->size) {
+  size_t offset = index * kind->elementSize;
+  if (offset >= kind->size) {
     // Trying to access an element outside of the vector size
     return v8::Intercepted::kNo;
   }
 
   void* data = extVectorWrapper->Data();
   void* dest = (uint8_t*)data + offset;
-  Interop::WriteValue(context, innerTypeEncoding, dest, value);
+  Interop::WriteValue(context, kind->innerTypeEncoding, dest, value);
   // Not intercepted: the native write is done, but V8 must still perform
   // the ordinary store, which is what the old void-returning callback did
   // by falling through without setting a return value.
@@ -121,7 +185,71 @@ void ExtVector::RegisterToStringMethod(
         info.GetReturnValue().Set(result);
       });
 
-  prototypeTemplate->Set(tns::ToV8String(isolate, "toString"), funcTemplate);
+  prototypeTemplate->Set(tns::Keys::ToString(isolate), funcTemplate);
+}
+
+// A typed array over the vector's own storage, one element per declared lane:
+// reading or writing all of a vector costs one call instead of one
+// interceptor round trip per lane, and writes through it are seen natively.
+void ExtVector::AsTypedArrayCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  BaseDataWrapper* baseWrapper =
+      tns::GetValueOrReport(isolate, info.This(), "ExtVector.asTypedArray");
+  if (baseWrapper == nullptr) {
+    return;
+  }
+  if (baseWrapper->Type() != WrapperType::ExtVector) {
+    isolate->ThrowException(Exception::TypeError(tns::ToV8String(
+        isolate, "asTypedArray called on a non-vector receiver")));
+    return;
+  }
+  ExtVectorWrapper* wrapper = static_cast<ExtVectorWrapper*>(baseWrapper);
+  const ExtVectorKind* kind = KindFromData(info.Data());
+
+  Local<ArrayBuffer> buffer =
+      ArrayBuffer::New(isolate, wrapper->GetBackingStore(isolate));
+  size_t lanes = kind->lanes;
+  Local<Value> result;
+  switch (kind->elementType) {
+    case BinaryTypeEncodingType::FloatEncoding:
+      result = Float32Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::DoubleEncoding:
+      result = Float64Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::CharEncoding:
+      result = Int8Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::UCharEncoding:
+    case BinaryTypeEncodingType::BoolEncoding:
+      result = Uint8Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::ShortEncoding:
+      result = Int16Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::UShortEncoding:
+    case BinaryTypeEncodingType::UnicharEncoding:
+      result = Uint16Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::IntEncoding:
+      result = Int32Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::UIntEncoding:
+      result = Uint32Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::LongEncoding:
+    case BinaryTypeEncodingType::LongLongEncoding:
+      result = BigInt64Array::New(buffer, 0, lanes);
+      break;
+    case BinaryTypeEncodingType::ULongEncoding:
+    case BinaryTypeEncodingType::ULongLongEncoding:
+      result = BigUint64Array::New(buffer, 0, lanes);
+      break;
+    default:
+      result = Uint8Array::New(buffer, 0, kind->size);
+      break;
+  }
+  info.GetReturnValue().Set(result);
 }
 
 }  // namespace tns
@@ -7,14 +7,37 @@
 
 namespace tns {
 
+// What every vector of one element type and lane count shares, built once per
+// isolate on first use: its layout, its ffi type and the template its
+// instances come from.
+struct ExtVectorKind {
+  BinaryTypeEncodingType elementType;
+  size_t elementSize;
+  // As declared; the storage is padded to `size`, e.g. 16 bytes for a float3.
+  size_t lanes;
+  size_t size;
+  // Owned by the kind; wrappers borrow it.
+  ffi_type* ffiType;
+  const TypeEncoding* typeEncoding;
+  const TypeEncoding* innerTypeEncoding;
+  v8::Global<v8::ObjectTemplate> instanceTemplate;
+
+  ~ExtVectorKind();
+};
+
 class ExtVector {
  public:
+  // Null once the isolate has begun tearing down.
+  static const ExtVectorKind* GetKind(v8::Isolate* isolate,
+                                      const TypeEncoding* typeEncoding);
+
+  // Takes ownership of `data`, a malloc'ed block of kind->size bytes.
   static v8::Local<v8::Value> NewInstance(v8::Isolate* isolate, void* data,
-                                          ffi_type* ffiType,
-                                          const TypeEncoding* innerTypeEncoding,
-                                          const TypeEncoding* typeEncoding);
+                                          const ExtVectorKind* kind);
 
  private:
+  static v8::Local<v8::ObjectTemplate> CreateInstanceTemplate(
+      v8::Isolate* isolate, const ExtVectorKind* kind);
   static void RegisterToStringMethod(
       v8::Isolate* isolate, v8::Local<v8::ObjectTemplate> prototypeTemplate);
   static v8::Intercepted IndexedPropertyGetCallback(
@@ -22,6 +45,8 @@ class ExtVector {
   static v8::Intercepted IndexedPropertySetCallback(
       uint32_t index, v8::Local<v8::Value> value,
       const v8::PropertyCallbackInfo<v8::Boolean>& info);
+  static void AsTypedArrayCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
 };
 
 }  // namespace tns
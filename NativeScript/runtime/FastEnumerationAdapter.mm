@@ -48,7 +48,7 @@ NSUInteger FastEnumerationAdapter(Isolate* isolate, id self, NSFastEnumerationSt
     Local<Object> iteratorObj = poIteratorObj->Get(isolate);
     Local<Context> context = isolate->GetCurrentContext();
     Local<Value> next;
-    bool success = iteratorObj->Get(context, tns::ToV8String(isolate, "next")).ToLocal(&next);
+    bool success = iteratorObj->Get(context, tns::Keys::Next(isolate)).ToLocal(&next);
     tns::Assert(success && !next.IsEmpty() && next->IsFunction(), isolate);
 
     state->itemsPtr = buffer;
@@ -71,7 +71,7 @@ NSUInteger FastEnumerationAdapter(Isolate* isolate, id self, NSFastEnumerationSt
 
       Local<Value> done;
       bool success =
-          nextResult.As<Object>()->Get(context, tns::ToV8String(isolate, "done")).ToLocal(&done);
+          nextResult.As<Object>()->Get(context, tns::Keys::Done(isolate)).ToLocal(&done);
       tns::Assert(success && tns::IsBool(done), isolate);
 
       if (tns::ToBool(done)) {
@@ -83,7 +83,7 @@ NSUInteger FastEnumerationAdapter(Isolate* isolate, id self, NSFastEnumerationSt
 
       Local<Value> value;
       success =
-          nextResult.As<Object>()->Get(context, tns::ToV8String(isolate, "value")).ToLocal(&value);
+          nextResult.As<Object>()->Get(context, tns::Keys::Value(isolate)).ToLocal(&value);
       tns::Assert(success && !value.IsEmpty(), isolate);
 
       id result = Interop::ToObject(context, value);
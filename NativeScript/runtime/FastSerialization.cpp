@@ -0,0 +1,569 @@
+#include "FastSerialization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "SerializationBufferPool.h"
+
+using namespace v8;
+
+namespace tns {
+namespace serialization {
+
+namespace {
+
+enum class Tag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kInt32,
+  kDouble,
+  kOneByteString,  // uint32 length, Latin-1 bytes
+  kTwoByteString,  // uint32 length, padding to 2, UTF-16 code units
+  kObject,         // uint32 count, then count (string key, value) pairs
+  kArray,          // uint32 length, then length values
+  kTypedArray,     // TypedArrayKind, uint64 byte length, bytes
+};
+
+// Constructor, element size.
+#define NS_FAST_TYPED_ARRAYS(V) \
+  V(Uint8Array, 1)              \
+  V(Uint8ClampedArray, 1)       \
+  V(Int8Array, 1)               \
+  V(Uint16Array, 2)             \
+  V(Int16Array, 2)              \
+  V(Uint32Array, 4)             \
+  V(Int32Array, 4)              \
+  V(Float32Array, 4)            \
+  V(Float64Array, 8)            \
+  V(BigInt64Array, 8)           \
+  V(BigUint64Array, 8)
+
+enum class TypedArrayKind : uint8_t {
+#define NS_KIND(name, size) k##name,
+  NS_FAST_TYPED_ARRAYS(NS_KIND)
+#undef NS_KIND
+};
+
+class Writer {
+ public:
+  ~Writer() { SerializationBufferPool::Release(data_, capacity_); }
+
+  bool WriteTag(Tag tag) { return WriteBytes(&tag, sizeof(tag)); }
+
+  template <typename T>
+  bool WriteRaw(T value) {
+    return WriteBytes(&value, sizeof(value));
+  }
+
+  bool WriteBytes(const void* bytes, size_t length) {
+    if (!Reserve(length)) {
+      return false;
+    }
+    if (length > 0) {
+      std::memcpy(data_ + size_, bytes, length);
+      size_ += length;
+    }
+    return true;
+  }
+
+  bool AlignTo2() { return size_ % 2 == 0 || WriteRaw<uint8_t>(0); }
+
+  // Room for `length` more bytes, for writers that fill it in themselves.
+  uint8_t* Claim(size_t length) {
+    if (!Reserve(length)) {
+      return nullptr;
+    }
+    uint8_t* result = data_ + size_;
+    size_ += length;
+    return result;
+  }
+
+  void Release(uint8_t** data, size_t* size, size_t* capacity) {
+    *data = data_;
+    *size = size_;
+    *capacity = capacity_;
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+ private:
+  bool Reserve(size_t length) {
+    if (capacity_ - size_ >= length) {
+      return true;
+    }
+    size_t wanted = std::max(size_ + length, capacity_ * 2);
+    uint8_t* grown =
+        data_ == nullptr
+            ? SerializationBufferPool::Acquire(wanted, &capacity_)
+            : SerializationBufferPool::Grow(data_, wanted, &capacity_);
+    if (grown == nullptr) {
+      return false;
+    }
+    data_ = grown;
+    return true;
+  }
+
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+};
+
+bool WriteString(Isolate* isolate, Local<String> string, Writer& writer) {
+  String::ValueView view(isolate, string);
+  uint32_t length = static_cast<uint32_t>(view.length());
+  if (view.is_one_byte()) {
+    return writer.WriteTag(Tag::kOneByteString) &&
+           writer.WriteRaw(length) && writer.WriteBytes(view.data8(), length);
+  }
+  return writer.WriteTag(Tag::kTwoByteString) && writer.WriteRaw(length) &&
+         writer.AlignTo2() &&
+         writer.WriteBytes(view.data16(), length * sizeof(uint16_t));
+}
+
+// False for anything that is not a primitive this format encodes.
+bool WritePrimitive(Isolate* isolate, Local<Value> value, Writer& writer) {
+  if (value->IsUndefined()) {
+    return writer.WriteTag(Tag::kUndefined);
+  }
+  if (value->IsNull()) {
+    return writer.WriteTag(Tag::kNull);
+  }
+  if (value->IsTrue()) {
+    return writer.WriteTag(Tag::kTrue);
+  }
+  if (value->IsFalse()) {
+    return writer.WriteTag(Tag::kFalse);
+  }
+  // -0 is not an Int32, so it takes the double branch and keeps its sign.
+  if (value->IsInt32()) {
+    return writer.WriteTag(Tag::kInt32) &&
+           writer.WriteRaw(value.As<Int32>()->Value());
+  }
+  if (value->IsNumber()) {
+    return writer.WriteTag(Tag::kDouble) &&
+           writer.WriteRaw(value.As<Number>()->Value());
+  }
+  if (value->IsString()) {
+    return WriteString(isolate, value.As<String>(), writer);
+  }
+  return false;
+}
+
+// Objects the serializer gives a dedicated encoding keep it even when their
+// prototype has been swapped for Object.prototype.
+bool IsOrdinaryObject(Local<Object> object) {
+  return !object->IsProxy() && !object->IsFunction() &&
+         object->InternalFieldCount() == 0 && !object->IsArrayBuffer() &&
+         !object->IsArrayBufferView() && !object->IsSharedArrayBuffer() &&
+         !object->IsDate() && !object->IsRegExp() && !object->IsMap() &&
+         !object->IsSet() && !object->IsNativeError() &&
+         !object->IsBooleanObject() && !object->IsNumberObject() &&
+         !object->IsStringObject() && !object->IsBigIntObject() &&
+         !object->IsSymbolObject() && !object->IsPromise() &&
+         !object->IsWeakMap() && !object->IsWeakSet() &&
+         !object->IsWasmModuleObject();
+}
+
+Maybe<bool> WritePlainObject(Isolate* isolate, Local<Context> context,
+                             Local<Object> object, Writer& writer) {
+  // The same keys, in the same order, the serializer would visit.
+  Local<v8::Array> keys;
+  if (!object
+           ->GetPropertyNames(context, KeyCollectionMode::kOwnOnly,
+                              static_cast<PropertyFilter>(ONLY_ENUMERABLE |
+                                                          SKIP_SYMBOLS),
+                              IndexFilter::kIncludeIndices,
+                              KeyConversionMode::kConvertToString)
+           .ToLocal(&keys)) {
+    return Nothing<bool>();
+  }
+
+  uint32_t count = keys->Length();
+  if (!writer.WriteTag(Tag::kObject) || !writer.WriteRaw(count)) {
+    return Just(false);
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> key;
+    Local<Value> value;
+    if (!keys->Get(context, i).ToLocal(&key) ||
+        !object->Get(context, key).ToLocal(&value)) {
+      return Nothing<bool>();
+    }
+    if (!WriteString(isolate, key.As<String>(), writer) ||
+        !WritePrimitive(isolate, value, writer)) {
+      return Just(false);
+    }
+  }
+  return Just(true);
+}
+
+Maybe<bool> WriteDenseArray(Isolate* isolate, Local<Context> context,
+                            Local<v8::Array> array, Writer& writer) {
+  // Named properties on an array (a RegExp match's `index`, say) travel with
+  // it through the serializer; only a bare list of elements is handled here.
+  Local<v8::Array> named;
+  if (!array
+           ->GetPropertyNames(context, KeyCollectionMode::kOwnOnly,
+                              static_cast<PropertyFilter>(ONLY_ENUMERABLE |
+                                                          SKIP_SYMBOLS),
+                              IndexFilter::kSkipIndices)
+           .ToLocal(&named)) {
+    return Nothing<bool>();
+  }
+  if (named->Length() > 0) {
+    return Just(false);
+  }
+
+  uint32_t length = array->Length();
+  if (!writer.WriteTag(Tag::kArray) || !writer.WriteRaw(length)) {
+    return Just(false);
+  }
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> value;
+    if (!array->Get(context, i).ToLocal(&value)) {
+      return Nothing<bool>();
+    }
+    if (value->IsUndefined()) {
+      // A hole reads as undefined too, but must stay a hole.
+      Maybe<bool> present = array->HasRealIndexedProperty(context, i);
+      if (present.IsNothing()) {
+        return Nothing<bool>();
+      }
+      if (!present.FromJust()) {
+        return Just(false);
+      }
+    }
+    if (!WritePrimitive(isolate, value, writer)) {
+      return Just(false);
+    }
+  }
+  return Just(true);
+}
+
+// False for a kind this format does not know (Float16Array, say).
+bool GetTypedArrayKind(Local<TypedArray> typedArray, TypedArrayKind* kind) {
+#define NS_KIND(name, size)             \
+  if (typedArray->Is##name()) {         \
+    *kind = TypedArrayKind::k##name;    \
+    return true;                        \
+  }
+  NS_FAST_TYPED_ARRAYS(NS_KIND)
+#undef NS_KIND
+  return false;
+}
+
+bool WriteTypedArray(Local<TypedArray> typedArray, Writer& writer) {
+  TypedArrayKind kind;
+  if (!GetTypedArrayKind(typedArray, &kind)) {
+    return false;
+  }
+
+  // An on-heap typed array has no separate buffer yet; asking for one would
+  // allocate it. By construction it spans all of its (fixed, unshared) memory.
+  size_t byteLength = typedArray->ByteLength();
+  if (typedArray->HasBuffer()) {
+    Local<ArrayBuffer> buffer = typedArray->Buffer();
+    if (buffer->WasDetached() || buffer->IsResizableByUserJavaScript() ||
+        typedArray->ByteOffset() != 0 || buffer->ByteLength() != byteLength) {
+      return false;
+    }
+  }
+
+  if (!writer.WriteTag(Tag::kTypedArray) || !writer.WriteRaw(kind) ||
+      !writer.WriteRaw(static_cast<uint64_t>(byteLength))) {
+    return false;
+  }
+  uint8_t* bytes = writer.Claim(byteLength);
+  return bytes != nullptr &&
+         typedArray->CopyContents(bytes, byteLength) == byteLength;
+}
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : position_(data), end_(data + size) {}
+
+  bool AtEnd() const { return position_ == end_; }
+
+  template <typename T>
+  bool ReadRaw(T* value) {
+    const uint8_t* bytes = ReadBytes(sizeof(T));
+    if (bytes == nullptr) {
+      return false;
+    }
+    std::memcpy(value, bytes, sizeof(T));
+    return true;
+  }
+
+  const uint8_t* ReadBytes(size_t length) {
+    if (static_cast<size_t>(end_ - position_) < length) {
+      return nullptr;
+    }
+    const uint8_t* result = position_;
+    position_ += length;
+    return result;
+  }
+
+  // The writer padded relative to the start of a malloc'ed (so aligned)
+  // buffer; the same skip here lands on an aligned code unit.
+  bool AlignTo2(const uint8_t* start) {
+    return (position_ - start) % 2 == 0 || ReadBytes(1) != nullptr;
+  }
+
+ private:
+  const uint8_t* position_;
+  const uint8_t* end_;
+};
+
+class FastDeserializer {
+ public:
+  FastDeserializer(Isolate* isolate, Local<Context> context,
+                   const PlainPrototypes& prototypes, const uint8_t* data,
+                   size_t size)
+      : isolate_(isolate),
+        context_(context),
+        prototypes_(prototypes),
+        start_(data),
+        reader_(data, size) {}
+
+  MaybeLocal<Value> Read() {
+    Local<Value> result;
+    Tag tag;
+    if (!reader_.ReadRaw(&tag)) {
+      return MaybeLocal<Value>();
+    }
+    switch (tag) {
+      case Tag::kObject:
+        if (!ReadObject().ToLocal(&result)) {
+          return MaybeLocal<Value>();
+        }
+        break;
+      case Tag::kArray:
+        if (!ReadArray().ToLocal(&result)) {
+          return MaybeLocal<Value>();
+        }
+        break;
+      case Tag::kTypedArray:
+        if (!ReadTypedArray().ToLocal(&result)) {
+          return MaybeLocal<Value>();
+        }
+        break;
+      default:
+        if (!ReadPrimitive(tag).ToLocal(&result)) {
+          return MaybeLocal<Value>();
+        }
+        break;
+    }
+    if (!reader_.AtEnd()) {
+      return MaybeLocal<Value>();
+    }
+    return result;
+  }
+
+ private:
+  MaybeLocal<Value> ReadPrimitive(Tag tag) {
+    switch (tag) {
+      case Tag::kUndefined:
+        return v8::Undefined(isolate_);
+      case Tag::kNull:
+        return v8::Null(isolate_);
+      case Tag::kTrue:
+        return v8::True(isolate_);
+      case Tag::kFalse:
+        return v8::False(isolate_);
+      case Tag::kInt32: {
+        int32_t value;
+        if (!reader_.ReadRaw(&value)) {
+          return MaybeLocal<Value>();
+        }
+        return Integer::New(isolate_, value);
+      }
+      case Tag::kDouble: {
+        double value;
+        if (!reader_.ReadRaw(&value)) {
+          return MaybeLocal<Value>();
+        }
+        return Number::New(isolate_, value);
+      }
+      case Tag::kOneByteString:
+      case Tag::kTwoByteString: {
+        Local<String> string;
+        if (!ReadString(tag, NewStringType::kNormal).ToLocal(&string)) {
+          return MaybeLocal<Value>();
+        }
+        return string;
+      }
+      default:
+        return MaybeLocal<Value>();
+    }
+  }
+
+  MaybeLocal<String> ReadString(Tag tag, NewStringType type) {
+    uint32_t length;
+    if (!reader_.ReadRaw(&length)) {
+      return MaybeLocal<String>();
+    }
+    if (tag == Tag::kOneByteString) {
+      const uint8_t* bytes = reader_.ReadBytes(length);
+      if (bytes == nullptr) {
+        return MaybeLocal<String>();
+      }
+      return String::NewFromOneByte(isolate_, bytes, type,
+                                    static_cast<int>(length));
+    }
+    if (tag != Tag::kTwoByteString || !reader_.AlignTo2(start_)) {
+      return MaybeLocal<String>();
+    }
+    const uint8_t* bytes =
+        reader_.ReadBytes(static_cast<size_t>(length) * sizeof(uint16_t));
+    if (bytes == nullptr) {
+      return MaybeLocal<String>();
+    }
+    return String::NewFromTwoByte(isolate_,
+                                  reinterpret_cast<const uint16_t*>(bytes),
+                                  type, static_cast<int>(length));
+  }
+
+  MaybeLocal<Value> ReadObject() {
+    uint32_t count;
+    if (!reader_.ReadRaw(&count)) {
+      return MaybeLocal<Value>();
+    }
+    std::vector<Local<Name>> names;
+    std::vector<Local<Value>> values;
+    names.reserve(count);
+    values.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Tag keyTag;
+      Tag valueTag;
+      Local<String> key;
+      Local<Value> value;
+      // Keys are internalized, as a literal's would be, so that lookups on
+      // the result hit the string table's fast path.
+      if (!reader_.ReadRaw(&keyTag) ||
+          !ReadString(keyTag, NewStringType::kInternalized).ToLocal(&key) ||
+          !reader_.ReadRaw(&valueTag) ||
+          !ReadPrimitive(valueTag).ToLocal(&value)) {
+        return MaybeLocal<Value>();
+      }
+      names.push_back(key);
+      values.push_back(value);
+    }
+
+    if (!prototypes_.object.IsEmpty()) {
+      return Object::New(isolate_, prototypes_.object, names.data(),
+                         values.data(), count);
+    }
+    // Isolate teardown: no cached prototype, build it key by key.
+    Local<Object> object = Object::New(isolate_);
+    for (uint32_t i = 0; i < count; i++) {
+      if (object->CreateDataProperty(context_, names[i], values[i])
+              .IsNothing()) {
+        return MaybeLocal<Value>();
+      }
+    }
+    return object;
+  }
+
+  MaybeLocal<Value> ReadArray() {
+    uint32_t length;
+    if (!reader_.ReadRaw(&length)) {
+      return MaybeLocal<Value>();
+    }
+    std::vector<Local<Value>> elements;
+    elements.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Tag tag;
+      Local<Value> value;
+      if (!reader_.ReadRaw(&tag) || !ReadPrimitive(tag).ToLocal(&value)) {
+        return MaybeLocal<Value>();
+      }
+      elements.push_back(value);
+    }
+    return v8::Array::New(isolate_, elements.data(), elements.size());
+  }
+
+  MaybeLocal<Value> ReadTypedArray() {
+    TypedArrayKind kind;
+    uint64_t byteLength;
+    if (!reader_.ReadRaw(&kind) || !reader_.ReadRaw(&byteLength)) {
+      return MaybeLocal<Value>();
+    }
+    const uint8_t* bytes = reader_.ReadBytes(byteLength);
+    if (bytes == nullptr) {
+      return MaybeLocal<Value>();
+    }
+
+    Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate_, byteLength);
+    if (byteLength > 0) {
+      std::memcpy(buffer->Data(), bytes, byteLength);
+    }
+    switch (kind) {
+#define NS_KIND(name, size)   \
+  case TypedArrayKind::k##name: \
+    return name::New(buffer, 0, byteLength / size);
+      NS_FAST_TYPED_ARRAYS(NS_KIND)
+#undef NS_KIND
+    }
+    return MaybeLocal<Value>();
+  }
+
+  Isolate* isolate_;
+  Local<Context> context_;
+  const PlainPrototypes& prototypes_;
+  const uint8_t* start_;
+  Reader reader_;
+};
+
+}  // namespace
+
+Maybe<bool> TryFastSerialize(Isolate* isolate, Local<Context> context,
+                             const PlainPrototypes& prototypes,
+                             Local<Value> input, uint8_t** buffer,
+                             size_t* size, size_t* capacity) {
+  Writer writer;
+  bool written;
+  if (input->IsTypedArray()) {
+    written = WriteTypedArray(input.As<TypedArray>(), writer);
+  } else if (input->IsObject()) {
+    if (prototypes.object.IsEmpty()) {
+      return Just(false);
+    }
+    Local<Object> object = input.As<Object>();
+    Local<Value> prototype = object->GetPrototype();
+    Maybe<bool> result = Just(false);
+    if (object->IsArray()) {
+      if (prototype == prototypes.array) {
+        result = WriteDenseArray(isolate, context, object.As<v8::Array>(),
+                                 writer);
+      }
+    } else if (prototype == prototypes.object &&
+               IsOrdinaryObject(object)) {
+      result = WritePlainObject(isolate, context, object, writer);
+    }
+    if (result.IsNothing()) {
+      return Nothing<bool>();
+    }
+    written = result.FromJust();
+  } else {
+    written = WritePrimitive(isolate, input, writer);
+  }
+
+  if (!written) {
+    return Just(false);
+  }
+  writer.Release(buffer, size, capacity);
+  return Just(true);
+}
+
+MaybeLocal<Value> FastDeserialize(Isolate* isolate, Local<Context> context,
+                                  const PlainPrototypes& prototypes,
+                                  const uint8_t* data, size_t size) {
+  FastDeserializer deserializer(isolate, context, prototypes, data, size);
+  return deserializer.Read();
+}
+
+}  // namespace serialization
+}  // namespace tns
@@ -0,0 +1,52 @@
+#ifndef FastSerialization_h
+#define FastSerialization_h
+
+#include "Common.h"
+
+namespace tns {
+namespace serialization {
+
+// A compact encoding for the values most messages actually carry, written
+// without going through ValueSerializer:
+//  - primitives other than symbols and BigInts, including strings;
+//  - plain objects (whose prototype is Object.prototype) and dense arrays
+//    (Array.prototype, no holes, no named properties) whose values are all
+//    such primitives;
+//  - a typed array that views the whole of an ordinary, fixed-length
+//    ArrayBuffer.
+// Anything else — nesting, identity (the same object twice), Dates, Maps,
+// shared or resizable memory, native wrappers — is V8's serializer's job.
+//
+// The format is private to one process: host byte order, no version header.
+
+// The prototypes a value must have to count as plain: the isolate's
+// Object.prototype and Array.prototype, which callers keep per isolate. Both
+// empty during isolate teardown, when objects are refused and read back key by
+// key.
+struct PlainPrototypes {
+  v8::Local<v8::Value> object;
+  v8::Local<v8::Value> array;
+};
+
+// Writes `input` into a buffer taken from SerializationBufferPool. Just(true)
+// with `buffer`, `size` and `capacity` filled in; Just(false) when `input` is
+// not a covered shape, and nothing is kept; Nothing with the exception pending
+// when a getter threw. A getter that ran before the shape was refused runs
+// again in the fallback serializer.
+v8::Maybe<bool> TryFastSerialize(v8::Isolate* isolate,
+                                 v8::Local<v8::Context> context,
+                                 const PlainPrototypes& prototypes,
+                                 v8::Local<v8::Value> input, uint8_t** buffer,
+                                 size_t* size, size_t* capacity);
+
+// Reads back a buffer written by TryFastSerialize. Empty, with nothing thrown,
+// when the buffer is malformed; the caller reports it.
+v8::MaybeLocal<v8::Value> FastDeserialize(v8::Isolate* isolate,
+                                          v8::Local<v8::Context> context,
+                                          const PlainPrototypes& prototypes,
+                                          const uint8_t* data, size_t size);
+
+}  // namespace serialization
+}  // namespace tns
+
+#endif /* FastSerialization_h */
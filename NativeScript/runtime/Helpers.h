@@ -12,6 +12,7 @@
 #include "ArcMacro.h"
 #include "Common.h"
 #include "DataWrapper.h"
+#include "InternedKeys.h"
 
 #ifdef __OBJC__
 #include <Foundation/Foundation.h>
@@ -50,6 +51,20 @@ inline v8::Local<v8::String> ToV8String(v8::Isolate* isolate, const char* value,
 inline v8::Local<v8::String> ToV8String(v8::Isolate* isolate, const char* value) {
   return v8::String::NewFromUtf8(isolate, value).ToLocalChecked();
 }
+// Strings of at least this many code units are handed to V8 as external
+// strings rather than copied into its heap.
+constexpr CFIndex kExternalStringThreshold = 16 * 1024;
+
+// Hands `str`'s characters to V8 without copying them into the JS heap. An
+// immutable string is retained and its own buffer is used; anything else is
+// snapshotted once into a malloc'ed buffer V8 takes over. Empty if V8 refuses
+// the string (e.g. it exceeds String::kMaxLength).
+v8::MaybeLocal<v8::String> NewExternalString(v8::Isolate* isolate, CFStringRef str,
+                                             CFIndex length);
+
+// True when every byte is below 0x80, i.e. UTF-8 and Latin-1 agree on it.
+bool IsAscii(const char* data, size_t length);
+
 #ifdef __OBJC__
 // Both sides store text as either 8-bit or UTF-16, never UTF-8, so the buffer is
 // handed to V8 in whichever width CFString already holds. Going through
@@ -67,6 +82,14 @@ inline v8::Local<v8::String> ToV8String(v8::Isolate* isolate, const NSString* va
     return v8::String::Empty(isolate);
   }
 
+  // Multi-megabyte JSON payloads and file contents would otherwise be copied
+  // into the V8 heap while the NSString still holds the same characters.
+  v8::Local<v8::String> external;
+  if (length >= kExternalStringThreshold &&
+      NewExternalString(isolate, str, length).ToLocal(&external)) {
+    return external;
+  }
+
   // An ASCII pointer is handed back only when every code unit is < 0x80, so the
   // code unit count doubles as the byte count.
   if (const char* ascii = CFStringGetCStringPtr(str, kCFStringEncodingASCII)) {
@@ -242,6 +265,9 @@ inline bool ToBool(const v8::Local<v8::Value>& value) {
   return result;
 }
 bool Exists(const char* fullPath);
+// A module's source text exactly as it is on disk, read through mmap. Large
+// ASCII files stay mapped and back the string directly. Throws
+// NativeScriptException when the file cannot be read.
 v8::Local<v8::String> ReadModule(v8::Isolate* isolate, const std::string& filePath);
 const char* ReadText(const std::string& filePath, long& length, bool& isNew);
 std::string ReadText(const std::string& file);
@@ -252,6 +278,11 @@ void SetPrivateValue(const v8::Local<v8::Object>& obj, const v8::Local<v8::Strin
                      const v8::Local<v8::Value>& value);
 v8::Local<v8::Value> GetPrivateValue(const v8::Local<v8::Object>& obj,
                                      const v8::Local<v8::String>& propName);
+// The same, for a key already resolved (e.g. from tns::Keys).
+void SetPrivateValue(const v8::Local<v8::Object>& obj, const v8::Local<v8::Private>& privateKey,
+                     const v8::Local<v8::Value>& value);
+v8::Local<v8::Value> GetPrivateValue(const v8::Local<v8::Object>& obj,
+                                     const v8::Local<v8::Private>& privateKey);
 
 void SetValue(v8::Isolate* isolate, const v8::Local<v8::Object>& obj, BaseDataWrapper* value);
 BaseDataWrapper* GetValue(v8::Isolate* isolate, const v8::Local<v8::Value>& val);
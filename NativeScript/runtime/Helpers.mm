@@ -7,7 +7,9 @@
 #include <objc/runtime.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <atomic>
 #include <fstream>
 #include <mutex>
@@ -15,6 +17,7 @@
 #include "Caches.h"
 #include "ErrorEvents.h"
 #include "NativeScriptException.h"
+#include "OneByteStringResource.h"
 #include "Runtime.h"
 #include "RuntimeConfig.h"
 
@@ -65,40 +68,140 @@ bool tns::Exists(const char* fullPath) {
 }
 
 Local<v8::String> tns::ReadModule(Isolate* isolate, const std::string& filePath) {
-  struct stat finfo;
-
   int file = open(filePath.c_str(), O_RDONLY);
   if (file < 0) {
     throw NativeScriptException(isolate, "Cannot read module " + filePath);
   }
 
-  fstat(file, &finfo);
-  long length = finfo.st_size;
+  struct stat finfo;
+  if (fstat(file, &finfo) != 0) {
+    close(file);
+    throw NativeScriptException(isolate, "Cannot read module " + filePath);
+  }
+  size_t length = static_cast<size_t>(finfo.st_size);
+  if (length == 0) {
+    close(file);
+    return v8::String::Empty(isolate);
+  }
 
-  char* newBuffer = new char[length + 128];
-  strcpy(newBuffer,
-         "(function(module, exports, require, __filename, __dirname) { ");  // 61 Characters
-  read(file, &newBuffer[61], length);
+  // Mapped rather than read: the pages come straight from the file cache, and
+  // nothing is copied on the way to V8.
+  void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
   close(file);
-  length += 61;
-
-  // Add the closing "\n})"
-  newBuffer[length] = 10;
-  ++length;
-  newBuffer[length] = '}';
-  ++length;
-  newBuffer[length] = ')';
-  ++length;
-  newBuffer[length] = 0;
-
-  Local<v8::String> str =
-      v8::String::NewFromUtf8(isolate, newBuffer, NewStringType::kNormal, (int)length)
-          .ToLocalChecked();
-  delete[] newBuffer;
+  if (mapped == MAP_FAILED) {
+    throw NativeScriptException(isolate, "Cannot read module " + filePath);
+  }
+  const char* data = static_cast<const char*>(mapped);
+
+  Local<v8::String> str;
+  bool ascii = tns::IsAscii(data, length);
+  // Most bundles are plain ASCII: V8 can then compile straight from the
+  // mapping. Not in debug builds, where livesync rewrites files under the app.
+  if (ascii && length >= kExternalStringThreshold && !RuntimeConfig.IsDebug) {
+    // The rest of the last page reads as zeros, so there is a NUL after the source unless it
+    // ends exactly on a page boundary.
+    bool nulTerminated = length % getpagesize() != 0;
+    OneByteStringResource* resource = new OneByteStringResource(
+        data, length, UnmapStringBuffer, reinterpret_cast<void*>(length), nulTerminated);
+    if (v8::String::NewExternalOneByte(isolate, resource).ToLocal(&str)) {
+      return str;
+    }
+    delete resource;
+    throw NativeScriptException(isolate, "Cannot read module " + filePath);
+  }
 
+  // ASCII is its own Latin-1, which skips the UTF-8 decoder.
+  bool created = ascii ? v8::String::NewFromOneByte(isolate, reinterpret_cast<const uint8_t*>(data),
+                                                    NewStringType::kNormal, (int)length)
+                             .ToLocal(&str)
+                       : v8::String::NewFromUtf8(isolate, data, NewStringType::kNormal, (int)length)
+                             .ToLocal(&str);
+  munmap(mapped, length);
+  if (!created) {
+    throw NativeScriptException(isolate, "Cannot read module " + filePath);
+  }
   return str;
 }
 
+bool tns::IsAscii(const char* data, size_t length) {
+  // Eight bytes per step; sources are megabytes long.
+  size_t i = 0;
+  uint64_t bits = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    bits |= word;
+  }
+  for (; i < length; i++) {
+    bits |= static_cast<uint8_t>(data[i]);
+  }
+  return (bits & 0x8080808080808080ull) == 0;
+}
+
+v8::MaybeLocal<v8::String> tns::NewExternalString(Isolate* isolate, CFStringRef str,
+                                                  CFIndex length) {
+  // Copying an immutable CFString only retains it. A mutable one is copied, so
+  // later edits cannot change a string V8 believes is immutable.
+  CFStringRef owner = CFStringCreateCopy(kCFAllocatorDefault, str);
+  if (owner == nullptr) {
+    return MaybeLocal<v8::String>();
+  }
+
+  // The copy may have been re-encoded; what counts is the owner's buffer.
+  length = CFStringGetLength(owner);
+  Local<v8::String> result;
+  if (const char* ascii = CFStringGetCStringPtr(owner, kCFStringEncodingASCII)) {
+    // CFStringGetCStringPtr only returns NUL-terminated buffers.
+    OneByteStringResource* resource =
+        new OneByteStringResource(ascii, length, ReleaseStringOwner, (void*)owner, true);
+    if (v8::String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+      return result;
+    }
+    delete resource;
+    return MaybeLocal<v8::String>();
+  }
+
+  if (const UniChar* utf16 = CFStringGetCharactersPtr(owner)) {
+    TwoByteStringResource* resource =
+        new TwoByteStringResource(reinterpret_cast<const uint16_t*>(utf16), length,
+                                  ReleaseStringOwner, (void*)owner);
+    if (v8::String::NewExternalTwoByte(isolate, resource).ToLocal(&result)) {
+      return result;
+    }
+    delete resource;
+    return MaybeLocal<v8::String>();
+  }
+
+  // No direct buffer (bridged or inline storage): one copy into memory V8
+  // adopts, instead of a scratch buffer plus a copy into the heap.
+  CFRange range = CFRangeMake(0, length);
+  CFIndex usedLength = 0;
+  char* narrow = static_cast<char*>(malloc((size_t)length + 1));
+  if (CFStringGetBytes(owner, range, kCFStringEncodingASCII, 0, false,
+                       reinterpret_cast<UInt8*>(narrow), length, &usedLength) == length) {
+    CFRelease(owner);
+    narrow[length] = '\0';
+    OneByteStringResource* resource = new OneByteStringResource(narrow, length, true);
+    if (v8::String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+      return result;
+    }
+    delete resource;
+    return MaybeLocal<v8::String>();
+  }
+  free(narrow);
+
+  uint16_t* wide = static_cast<uint16_t*>(malloc((size_t)length * sizeof(uint16_t)));
+  CFStringGetCharacters(owner, range, reinterpret_cast<UniChar*>(wide));
+  CFRelease(owner);
+  TwoByteStringResource* resource =
+      new TwoByteStringResource(wide, length, FreeStringBuffer, nullptr);
+  if (v8::String::NewExternalTwoByte(isolate, resource).ToLocal(&result)) {
+    return result;
+  }
+  delete resource;
+  return MaybeLocal<v8::String>();
+}
+
 const char* tns::ReadText(const std::string& filePath, long& length, bool& isNew) {
   FILE* file = fopen(filePath.c_str(), "rb");
   if (file == nullptr) {
@@ -185,23 +288,32 @@ bool tns::WriteBinary(const std::string& path, const void* data, long length) {
 
 void tns::SetPrivateValue(const Local<Object>& obj, const Local<v8::String>& propName,
                           const Local<Value>& value) {
+  Isolate* isolate = v8::Isolate::GetCurrent();
+  tns::SetPrivateValue(obj, Private::ForApi(isolate, propName), value);
+}
+
+Local<Value> tns::GetPrivateValue(const Local<Object>& obj, const Local<v8::String>& propName) {
+  Isolate* isolate = v8::Isolate::GetCurrent();
+  return tns::GetPrivateValue(obj, Private::ForApi(isolate, propName));
+}
+
+void tns::SetPrivateValue(const Local<Object>& obj, const Local<Private>& privateKey,
+                          const Local<Value>& value) {
   Local<Context> context;
   bool success = obj->GetCreationContext(v8::Isolate::GetCurrent()).ToLocal(&context);
   tns::Assert(success);
   Isolate* isolate = v8::Isolate::GetCurrent();
-  Local<Private> privateKey = Private::ForApi(isolate, propName);
 
   if (!obj->SetPrivate(context, privateKey, value).To(&success) || !success) {
     tns::Assert(false, isolate);
   }
 }
 
-Local<Value> tns::GetPrivateValue(const Local<Object>& obj, const Local<v8::String>& propName) {
+Local<Value> tns::GetPrivateValue(const Local<Object>& obj, const Local<Private>& privateKey) {
   Local<Context> context;
   bool success = obj->GetCreationContext(v8::Isolate::GetCurrent()).ToLocal(&context);
   tns::Assert(success);
   Isolate* isolate = v8::Isolate::GetCurrent();
-  Local<Private> privateKey = Private::ForApi(isolate, propName);
 
   Maybe<bool> hasPrivate = obj->HasPrivate(context, privateKey);
 
@@ -238,7 +350,7 @@ void tns::SetValue(Isolate* isolate, const Local<Object>& obj, BaseDataWrapper*
   if (obj->InternalFieldCount() > 0) {
     obj->SetInternalField(0, ext);
   } else {
-    tns::SetPrivateValue(obj, tns::ToV8String(isolate, "metadata"), ext);
+    tns::SetPrivateValue(obj, tns::Keys::MetadataPrivate(isolate), ext);
   }
 }
 
@@ -258,7 +370,7 @@ tns::BaseDataWrapper* tns::GetValue(Isolate* isolate, const Local<Value>& val) {
         field.As<External>()->Value(v8::kExternalPointerTypeTagDefault));
   }
 
-  Local<Value> metadataProp = tns::GetPrivateValue(obj, tns::ToV8String(isolate, "metadata"));
+  Local<Value> metadataProp = tns::GetPrivateValue(obj, tns::Keys::MetadataPrivate(isolate));
   if (metadataProp.IsEmpty() || metadataProp->IsNullOrUndefined() || !metadataProp->IsExternal()) {
     return nullptr;
   }
@@ -469,8 +581,7 @@ tns::BaseDataWrapper* tns::GetValueOrReport(Isolate* isolate, const Local<Value>
   if (val->IsObject()) {
     // One report per husk object: a released buffer touched in a tight loop
     // must not flood the event queue.
-    Local<Private> reported =
-        Private::ForApi(isolate, tns::ToV8String(isolate, "ns:releasedAccessReported"));
+    Local<Private> reported = tns::Keys::ReleasedAccessReportedPrivate(isolate);
     Local<Object> obj = val.As<Object>();
     if (obj->HasPrivate(context, reported).FromMaybe(false)) {
       return nullptr;
@@ -497,8 +608,8 @@ void tns::DeleteValue(Isolate* isolate, const Local<Value>& val) {
     return;
   }
 
-  Local<v8::String> metadataKey = tns::ToV8String(isolate, "metadata");
-  Local<Value> metadataProp = tns::GetPrivateValue(obj, metadataKey);
+  Local<Private> privateKey = tns::Keys::MetadataPrivate(isolate);
+  Local<Value> metadataProp = tns::GetPrivateValue(obj, privateKey);
   if (metadataProp.IsEmpty() || metadataProp->IsNullOrUndefined() || !metadataProp->IsExternal()) {
     return;
   }
@@ -506,7 +617,6 @@ void tns::DeleteValue(Isolate* isolate, const Local<Value>& val) {
   Local<Context> context;
   bool success = obj->GetCreationContext(v8::Isolate::GetCurrent()).ToLocal(&context);
   tns::Assert(success, isolate);
-  Local<Private> privateKey = Private::ForApi(isolate, metadataKey);
 
   success = obj->DeletePrivate(context, privateKey).FromMaybe(false);
   tns::Assert(success, isolate);
@@ -534,7 +644,7 @@ bool tns::IsArrayOrArrayLike(Isolate* isolate, const Local<Value>& value) {
   Local<Context> context;
   bool success = obj->GetCreationContext(v8::Isolate::GetCurrent()).ToLocal(&context);
   tns::Assert(success, isolate);
-  return obj->Has(context, ToV8String(isolate, "length")).FromMaybe(false);
+  return obj->Has(context, tns::Keys::Length(isolate)).FromMaybe(false);
 }
 
 void* tns::TryGetBufferFromArrayBuffer(const v8::Local<v8::Value>& value, bool& isArrayBuffer) {
@@ -775,7 +885,7 @@ std::string tns::RemapStackTraceIfAvailable(Isolate* isolate, const std::string&
   Local<Object> global = context->Global();
   Local<Value> remapFnVal;
   bool hasRemap =
-      global->Get(context, tns::ToV8String(isolate, "__ns_remapStack")).ToLocal(&remapFnVal);
+      global->Get(context, tns::Keys::NsRemapStack(isolate)).ToLocal(&remapFnVal);
   if (hasRemap && remapFnVal->IsFunction()) {
     Local<v8::Function> remapFn = remapFnVal.As<v8::Function>();
     Local<Value> args[] = {tns::ToV8String(isolate, stackTrace)};
@@ -797,7 +907,7 @@ std::string tns::GetSmartStackTrace(Isolate* isolate, v8::TryCatch* tryCatch,
     if (exception->IsObject()) {
       Local<Object> excObj = exception.As<Object>();
       Local<Value> stackVal;
-      if (excObj->Get(context, tns::ToV8String(isolate, "stack")).ToLocal(&stackVal) &&
+      if (excObj->Get(context, tns::Keys::Stack(isolate)).ToLocal(&stackVal) &&
           stackVal->IsString()) {
         stack = tns::ToString(isolate, stackVal.As<v8::String>());
       }
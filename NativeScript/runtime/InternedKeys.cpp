@@ -0,0 +1,79 @@
+#include "InternedKeys.h"
+
+#include "Caches.h"
+#include "Constants.h"
+
+using namespace v8;
+
+namespace tns {
+
+namespace {
+
+const char* const kStringValues[] = {
+#define NS_INTERNED_VALUE(name, value) value,
+    NS_INTERNED_STRINGS(NS_INTERNED_VALUE)
+#undef NS_INTERNED_VALUE
+};
+
+const char* const kPrivateNames[] = {
+#define NS_INTERNED_VALUE(name, value) value,
+    NS_INTERNED_PRIVATES(NS_INTERNED_VALUE)
+#undef NS_INTERNED_VALUE
+};
+
+Local<String> NewInternalized(Isolate* isolate, const char* value) {
+  return String::NewFromUtf8(isolate, value, NewStringType::kInternalized)
+      .ToLocalChecked();
+}
+
+Local<Private> NewPrivate(Isolate* isolate, InternedPrivate key) {
+  // ForApi, like the ad hoc lookups these replace: the same key is shared
+  // with any code still calling Private::ForApi with the plain name.
+  return Private::ForApi(
+      isolate,
+      NewInternalized(isolate, kPrivateNames[static_cast<size_t>(key)]));
+}
+
+// Without going through Caches::Get, which hands out a shared_ptr copy.
+InternedKeyTable* TableFor(Isolate* isolate) {
+  void* raw = isolate->GetData(Constants::CACHES_ISOLATE_SLOT);
+  if (raw == nullptr) {
+    return nullptr;
+  }
+  return &reinterpret_cast<std::shared_ptr<Caches>*>(raw)->get()->InternedKeys;
+}
+
+}  // namespace
+
+Local<String> InternedKeyTable::Get(Isolate* isolate, InternedString key) {
+  Eternal<String>& slot = this->strings_[static_cast<size_t>(key)];
+  if (slot.IsEmpty()) {
+    slot.Set(isolate,
+             NewInternalized(isolate, kStringValues[static_cast<size_t>(key)]));
+  }
+  return slot.Get(isolate);
+}
+
+Local<Private> InternedKeyTable::Get(Isolate* isolate, InternedPrivate key) {
+  Eternal<Private>& slot = this->privates_[static_cast<size_t>(key)];
+  if (slot.IsEmpty()) {
+    slot.Set(isolate, NewPrivate(isolate, key));
+  }
+  return slot.Get(isolate);
+}
+
+Local<String> Keys::Get(Isolate* isolate, InternedString key) {
+  if (InternedKeyTable* table = TableFor(isolate)) {
+    return table->Get(isolate, key);
+  }
+  return NewInternalized(isolate, kStringValues[static_cast<size_t>(key)]);
+}
+
+Local<Private> Keys::Get(Isolate* isolate, InternedPrivate key) {
+  if (InternedKeyTable* table = TableFor(isolate)) {
+    return table->Get(isolate, key);
+  }
+  return NewPrivate(isolate, key);
+}
+
+}  // namespace tns
@@ -0,0 +1,89 @@
+#ifndef InternedKeys_h
+#define InternedKeys_h
+
+#include <cstdint>
+
+#include "Common.h"
+
+namespace tns {
+
+// Property names the runtime itself reads and writes on hot paths (wrapping,
+// prototype lookups, error decoration). Each is internalized once per isolate
+// and kept in a v8::Eternal, instead of being created and re-internalized on
+// every tns::ToV8String(isolate, "literal") call.
+#define NS_INTERNED_STRINGS(V)               \
+  V(Prototype, "prototype")                  \
+  V(Constructor, "constructor")              \
+  V(Length, "length")                        \
+  V(Name, "name")                            \
+  V(Message, "message")                      \
+  V(Stack, "stack")                          \
+  V(ToString, "toString")                    \
+  V(Value, "value")                          \
+  V(Done, "done")                            \
+  V(Next, "next")                            \
+  V(NativeException, "nativeException")      \
+  V(NsRemapStack, "__ns_remapStack")         \
+  V(FullMessage, "fullMessage")              \
+  V(StackTrace, "stackTrace")
+
+// Keys of v8::Private values the runtime attaches to objects.
+#define NS_INTERNED_PRIVATES(V)                              \
+  V(Metadata, "metadata")                                    \
+  V(WorkerId, "workerId")                                    \
+  V(ReleasedAccessReported, "ns:releasedAccessReported")
+
+enum class InternedString : uint8_t {
+#define NS_INTERNED_ENUM(name, value) name,
+  NS_INTERNED_STRINGS(NS_INTERNED_ENUM)
+#undef NS_INTERNED_ENUM
+      Count
+};
+
+enum class InternedPrivate : uint8_t {
+#define NS_INTERNED_ENUM(name, value) name,
+  NS_INTERNED_PRIVATES(NS_INTERNED_ENUM)
+#undef NS_INTERNED_ENUM
+      Count
+};
+
+// Lives in Caches; entries are created on first use.
+class InternedKeyTable {
+ public:
+  v8::Local<v8::String> Get(v8::Isolate* isolate, InternedString key);
+  v8::Local<v8::Private> Get(v8::Isolate* isolate, InternedPrivate key);
+
+ private:
+  v8::Eternal<v8::String>
+      strings_[static_cast<size_t>(InternedString::Count)];
+  v8::Eternal<v8::Private>
+      privates_[static_cast<size_t>(InternedPrivate::Count)];
+};
+
+// Call sites use the generated accessors, e.g. Keys::Prototype(isolate) or
+// Keys::MetadataPrivate(isolate). Without a Caches (an isolate being torn
+// down) they fall back to creating the key.
+class Keys {
+ public:
+  static v8::Local<v8::String> Get(v8::Isolate* isolate, InternedString key);
+  static v8::Local<v8::Private> Get(v8::Isolate* isolate,
+                                    InternedPrivate key);
+
+#define NS_INTERNED_ACCESSOR(name, value)                        \
+  static v8::Local<v8::String> name(v8::Isolate* isolate) {      \
+    return Get(isolate, InternedString::name);                   \
+  }
+  NS_INTERNED_STRINGS(NS_INTERNED_ACCESSOR)
+#undef NS_INTERNED_ACCESSOR
+
+#define NS_INTERNED_ACCESSOR(name, value)                            \
+  static v8::Local<v8::Private> name##Private(v8::Isolate* isolate) { \
+    return Get(isolate, InternedPrivate::name);                      \
+  }
+  NS_INTERNED_PRIVATES(NS_INTERNED_ACCESSOR)
+#undef NS_INTERNED_ACCESSOR
+};
+
+}  // namespace tns
+
+#endif /* InternedKeys_h */
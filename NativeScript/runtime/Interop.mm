@@ -1,5 +1,6 @@
 #include "Interop.h"
 #include <Foundation/Foundation.h>
+#include <dlfcn.h>
 #include <sstream>
 #include "ArgConverter.h"
 #include "ArrayAdapter.h"
@@ -8,6 +9,7 @@
 #include "DictionaryAdapter.h"
 #include "ExtVector.h"
 #include "Helpers.h"
+#include "InteropStats.h"
 #include "NSDataAdapter.h"
 #include "NativeScriptException.h"
 #include "ObjectManager.h"
@@ -18,6 +20,7 @@
 #include "RuntimeConfig.h"
 #include "SymbolIterator.h"
 #include "SymbolLoader.h"
+#include "Tracing.h"
 #include "UnmanagedType.h"
 #include "robin_hood.h"
 
@@ -250,10 +253,12 @@ void Interop::WriteValue(Local<Context> context, const TypeEncoding* typeEncodin
         isRefTypeEqual(typeEncoding, "NSNumber")) {
       bool value = tns::ToBool(arg);
       NSNumber* num = [NSNumber numberWithBool:value];
+      NS_INTEROP_STATS_COUNT(NumberBoxing);
       Interop::SetValue(dest, num);
     } else if (typeEncoding->type == BinaryTypeEncodingType::IdEncoding) {
       bool value = tns::ToBool(arg);
       NSObject* o = @(value);
+      NS_INTEROP_STATS_COUNT(NumberBoxing);
       Interop::SetValue(dest, o);
     } else {
       bool value = tns::ToBool(arg);
@@ -265,17 +270,13 @@ void Interop::WriteValue(Local<Context> context, const TypeEncoding* typeEncodin
     Interop::SetValue(dest, sel_registerName(str.c_str()));
   } else if (typeEncoding->type == BinaryTypeEncodingType::CStringEncoding) {
     if (arg->IsString()) {
-      const char* value = nullptr;
       Local<v8::String> strArg = arg.As<v8::String>();
-      if (strArg->IsExternalOneByte()) {
-        const v8::String::ExternalOneByteStringResource* resource =
-            strArg->GetExternalOneByteStringResource();
-        value = resource->data();
-      } else {
+      const char* value = OneByteStringResource::CString(strArg);
+      if (value == nullptr) {
         v8::String::Utf8Value utf8Value(isolate, arg);
         value = strdup(*utf8Value);
         auto length = strArg->Length() + 1;
-        OneByteStringResource* resource = new OneByteStringResource(value, length);
+        OneByteStringResource* resource = new OneByteStringResource(value, length, true);
         bool success = v8::String::NewExternalOneByte(isolate, resource).ToLocal(&arg);
         tns::Assert(success, isolate);
       }
@@ -340,6 +341,7 @@ void Interop::WriteValue(Local<Context> context, const TypeEncoding* typeEncodin
         typeEncoding->type == BinaryTypeEncodingType::IdEncoding) {
       // NSNumber
       NSNumber* num = [NSNumber numberWithDouble:value];
+      NS_INTEROP_STATS_COUNT(NumberBoxing);
       Interop::SetValue(dest, num);
     } else if (typeEncoding->type == BinaryTypeEncodingType::UShortEncoding) {
       Interop::SetNumericValue<unsigned short>(dest, value);
@@ -699,6 +701,7 @@ id Interop::ToObject(Local<Context> context, v8::Local<v8::Value> arg) {
     return result;
   } else if (tns::IsNumber(arg)) {
     double value = tns::ToNumber(isolate, arg);
+    NS_INTEROP_STATS_COUNT(NumberBoxing);
     return @(value);
   } else if (arg->IsDate()) {
     Local<Date> date = arg.As<Date>();
@@ -707,6 +710,7 @@ id Interop::ToObject(Local<Context> context, v8::Local<v8::Value> arg) {
     return nsDate;
   } else if (tns::IsBool(arg)) {
     bool value = tns::ToBool(arg);
+    NS_INTEROP_STATS_COUNT(NumberBoxing);
     return @(value);
   } else if (arg->IsArray()) {
     Local<Object> obj = arg.As<Object>();
@@ -758,6 +762,7 @@ Local<Value> Interop::StructToValue(Local<Context> context, void* result, Struct
     memcpy(dest, result, ffiType->size);
 
     wrapper = new StructWrapper(structInfo, dest, nullptr);
+    NS_INTEROP_STATS_COUNT(StructAllocation);
   } else {
     Local<Value> parent = parentStruct->Get(isolate);
     BaseDataWrapper* parentWrapper = tns::GetValue(isolate, parent);
@@ -766,6 +771,7 @@ Local<Value> Interop::StructToValue(Local<Context> context, void* result, Struct
       parentStructWrapper->IncrementChildren();
     }
     wrapper = new StructWrapper(structInfo, result, parentStruct);
+    NS_INTEROP_STATS_COUNT(StructAllocation);
   }
 
   std::shared_ptr<Caches> cache = Caches::Get(isolate);
@@ -930,13 +936,14 @@ Local<Value> Interop::GetResult(Local<Context> context, const TypeEncoding* type
   }
 
   if (typeEncoding->type == BinaryTypeEncodingType::ExtVectorEncoding) {
-    ffi_type* ffiType = FFICall::GetArgumentType(typeEncoding, isStructMember);
-    const TypeEncoding* innerTypeEncoding = typeEncoding->details.extVector.getInnerType();
+    const ExtVectorKind* kind = ExtVector::GetKind(isolate, typeEncoding);
+    if (kind == nullptr) {
+      return Undefined(isolate);
+    }
     void* buffer = call->ResultBuffer();
-    void* data = malloc(ffiType->size);
-    memcpy(data, buffer, ffiType->size);
-    Local<Value> value =
-        ExtVector::NewInstance(isolate, data, ffiType, innerTypeEncoding, typeEncoding);
+    void* data = malloc(kind->size);
+    memcpy(data, buffer, kind->size);
+    Local<Value> value = ExtVector::NewInstance(isolate, data, kind);
     ObjectManager::Register(context, value);
     return value;
   }
@@ -1585,6 +1592,22 @@ SEL Interop::GetSwizzledMethodSelector(SEL selector) {
 }
 
 Local<Value> Interop::CallFunctionInternal(MethodCall& methodCall) {
+  // ObjC calls all go through objc_msgSend, so they are told apart by selector.
+  NS_INTEROP_STATS_SCOPE(stats, methodCall.isPrimitiveFunction_,
+                         methodCall.isPrimitiveFunction_ ? methodCall.functionPointer_
+                                                         : (void*)methodCall.selector_);
+  // Naming the call costs a dladdr for C functions, so only while ns.interop is recorded.
+  const char* traceName = nullptr;
+  if (Tracing::IsEnabled(TraceCategory::Interop)) {
+    Dl_info info;
+    traceName = !methodCall.isPrimitiveFunction_ ? sel_getName(methodCall.selector_)
+                : dladdr(methodCall.functionPointer_, &info) != 0 ? info.dli_sname
+                                                                  : nullptr;
+  }
+  TraceScope trace(TraceCategory::Interop,
+                   methodCall.isPrimitiveFunction_ ? "cFunction" : "objcMethod", "symbol",
+                   traceName);
+
   int initialParameterIndex = methodCall.isPrimitiveFunction_ ? 0 : 2;
 
   int argsCount = initialParameterIndex + (int)methodCall.args_.Length();
@@ -1656,8 +1679,10 @@ Local<Value> Interop::CallFunctionInternal(MethodCall& methodCall) {
   }
 
   @try {
+    NS_INTEROP_STATS_BEGIN_NATIVE(stats);
     ffi_call(parametrizedCall->Cif, FFI_FN(methodCall.functionPointer_), call.ResultBuffer(),
              call.ArgsArray());
+    NS_INTEROP_STATS_END_NATIVE(stats);
   } @catch (NSException* e) {
     // Preserve the original NSException: build a JS Error carrying its name and
     // reason, and attach the wrapped native object as `nativeException` (mirrors
@@ -1679,19 +1704,19 @@ Local<Value> Interop::CallFunctionInternal(MethodCall& methodCall) {
 
     Local<Object> jsErrObj = jsErrVal.As<Object>();
     if (nsName != nil) {
-      jsErrObj->Set(context, tns::ToV8String(isolate, "name"), tns::ToV8String(isolate, nsName))
+      jsErrObj->Set(context, tns::Keys::Name(isolate), tns::ToV8String(isolate, nsName))
           .FromMaybe(false);
     }
     if (nsReason != nil) {
       jsErrObj
-          ->Set(context, tns::ToV8String(isolate, "message"), tns::ToV8String(isolate, nsReason))
+          ->Set(context, tns::Keys::Message(isolate), tns::ToV8String(isolate, nsReason))
           .FromMaybe(false);
     }
 
     ObjCDataWrapper* wrapper = new ObjCDataWrapper((id)e);
     Local<Value> nativeWrapper =
         ArgConverter::CreateJsWrapper(context, wrapper, Local<Object>(), true);
-    jsErrObj->Set(context, tns::ToV8String(isolate, "nativeException"), nativeWrapper)
+    jsErrObj->Set(context, tns::Keys::NativeException(isolate), nativeWrapper)
         .FromMaybe(false);
 
     throw NativeScriptException(isolate, jsErrObj.As<Value>(), message);
@@ -1735,11 +1760,11 @@ Local<Value> Interop::CallFunctionInternal(MethodCall& methodCall) {
       ObjCDataWrapper* wrapper = new ObjCDataWrapper(error);
       Local<Value> nativeWrapper =
           ArgConverter::CreateJsWrapper(context, wrapper, Local<Object>(), true);
-      jsErrObj->Set(context, tns::ToV8String(isolate, "nativeException"), nativeWrapper)
+      jsErrObj->Set(context, tns::Keys::NativeException(isolate), nativeWrapper)
           .FromMaybe(false);
 
       // Ensure the Error has a proper 'name' property.
-      jsErrObj->Set(context, tns::ToV8String(isolate, "name"), tns::ToV8String(isolate, "NSError"))
+      jsErrObj->Set(context, tns::Keys::Name(isolate), tns::ToV8String(isolate, "NSError"))
           .FromMaybe(false);
 
       // Throw the JS Error with full stack information — V8 will populate the stack for the created
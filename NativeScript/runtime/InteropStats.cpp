@@ -0,0 +1,307 @@
+#include "InteropStats.h"
+
+#ifdef NATIVESCRIPT_INTEROP_STATS
+
+#include <dlfcn.h>
+#include <objc/runtime.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Helpers.h"
+#include "UnfairLock.h"
+
+using namespace v8;
+
+namespace tns {
+
+std::atomic<bool> InteropStats::enabled_{false};
+std::atomic<uint64_t>
+    InteropStats::counters_[static_cast<int>(Counter::Count)] = {};
+
+namespace {
+
+// Log-linear buckets: four linear sub-buckets per power of two, so any sample
+// lands in a bucket at most 25% wider than itself. 128 buckets reach ~8.6 s;
+// longer calls share the last one.
+constexpr int kSubBucketBits = 2;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+constexpr int kBuckets = 128;
+
+int BucketIndex(uint64_t nanos) {
+  if (nanos < kSubBuckets) {
+    return static_cast<int>(nanos);
+  }
+  int msb = 63 - __builtin_clzll(nanos);
+  int sub = static_cast<int>(nanos >> (msb - kSubBucketBits)) &
+            (kSubBuckets - 1);
+  int index = (msb - kSubBucketBits + 1) * kSubBuckets + sub;
+  return std::min(index, kBuckets - 1);
+}
+
+uint64_t BucketLowerBound(int index) {
+  if (index < kSubBuckets) {
+    return static_cast<uint64_t>(index);
+  }
+  int msb = index / kSubBuckets + kSubBucketBits - 1;
+  uint64_t sub = static_cast<uint64_t>(index % kSubBuckets);
+  return (kSubBuckets + sub) << (msb - kSubBucketBits);
+}
+
+struct Histogram {
+  uint32_t buckets[kBuckets] = {};
+  uint64_t totalNanos = 0;
+
+  void Add(uint64_t nanos) {
+    this->buckets[BucketIndex(nanos)]++;
+    this->totalNanos += nanos;
+  }
+
+  void Merge(const Histogram& other) {
+    for (int i = 0; i < kBuckets; i++) {
+      this->buckets[i] += other.buckets[i];
+    }
+    this->totalNanos += other.totalNanos;
+  }
+};
+
+struct Entry {
+  uint64_t count = 0;
+  Histogram marshal;
+  Histogram native;
+
+  void Merge(const Entry& other) {
+    this->count += other.count;
+    this->marshal.Merge(other.marshal);
+    this->native.Merge(other.native);
+  }
+};
+
+struct Key {
+  InteropStats::Kind kind;
+  const void* address;
+
+  bool operator==(const Key& other) const {
+    return this->kind == other.kind && this->address == other.address;
+  }
+};
+
+struct KeyHash {
+  size_t operator()(const Key& key) const {
+    return std::hash<const void*>()(key.address) ^
+           static_cast<size_t>(key.kind);
+  }
+};
+
+using EntryMap = std::unordered_map<Key, Entry, KeyHash>;
+
+// One per JS thread. The owning thread is the only writer; its lock is only
+// ever contended by a reader merging the tables.
+struct Table {
+  UnfairMutex mutex;
+  EntryMap entries;
+};
+
+void MergeInto(EntryMap& target, const EntryMap& source) {
+  for (const auto& pair : source) {
+    target[pair.first].Merge(pair.second);
+  }
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<Table*> tables;
+  // What exited threads recorded.
+  EntryMap retired;
+};
+
+Registry& GetRegistry() {
+  // Leaked on purpose: threads may still retire their tables during exit.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+struct ThreadTable {
+  Table* table = nullptr;
+
+  ~ThreadTable() {
+    if (this->table == nullptr) {
+      return;
+    }
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.tables.erase(std::remove(registry.tables.begin(),
+                                      registry.tables.end(), this->table),
+                          registry.tables.end());
+    MergeInto(registry.retired, this->table->entries);
+    delete this->table;
+  }
+};
+
+thread_local ThreadTable threadTable;
+
+Table* GetThreadTable() {
+  if (threadTable.table == nullptr) {
+    Table* table = new Table();
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.tables.push_back(table);
+    threadTable.table = table;
+  }
+  return threadTable.table;
+}
+
+uint64_t TicksToNanos(uint64_t ticks) {
+  static mach_timebase_info_data_t timebase = [] {
+    mach_timebase_info_data_t info;
+    mach_timebase_info(&info);
+    return info;
+  }();
+  return ticks * timebase.numer / timebase.denom;
+}
+
+std::string ResolveName(const Key& key) {
+  if (key.kind == InteropStats::Kind::ObjCMethod) {
+    return sel_getName(static_cast<SEL>(const_cast<void*>(key.address)));
+  }
+  Dl_info info;
+  if (dladdr(key.address, &info) != 0 && info.dli_sname != nullptr) {
+    return info.dli_sname;
+  }
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%p", key.address);
+  return buffer;
+}
+
+bool Set(Local<Context> context, Local<Object> target, const char* key,
+         Local<Value> value) {
+  return target
+      ->Set(context, tns::ToV8String(context->GetIsolate(), key), value)
+      .FromMaybe(false);
+}
+
+bool SetNumber(Local<Context> context, Local<Object> target, const char* key,
+               double value) {
+  return Set(context, target, key, Number::New(context->GetIsolate(), value));
+}
+
+// Non-empty buckets only, as [lowerBoundNanos, count] pairs in ascending
+// order.
+Local<v8::Array> HistogramToArray(Local<Context> context,
+                                  const Histogram& histogram) {
+  Isolate* isolate = context->GetIsolate();
+  Local<v8::Array> result = v8::Array::New(isolate);
+  uint32_t index = 0;
+  for (int i = 0; i < kBuckets; i++) {
+    if (histogram.buckets[i] == 0) {
+      continue;
+    }
+    Local<Value> pair[] = {
+        Number::New(isolate, static_cast<double>(BucketLowerBound(i))),
+        Number::New(isolate, histogram.buckets[i])};
+    if (!result->Set(context, index++, v8::Array::New(isolate, pair, 2))
+             .FromMaybe(false)) {
+      return Local<v8::Array>();
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+void InteropStats::Record(Kind kind, const void* key, uint64_t marshalTicks,
+                          uint64_t nativeTicks) {
+  Table* table = GetThreadTable();
+  std::lock_guard<UnfairMutex> lock(table->mutex);
+  Entry& entry = table->entries[Key{kind, key}];
+  entry.count++;
+  entry.marshal.Add(TicksToNanos(marshalTicks));
+  entry.native.Add(TicksToNanos(nativeTicks));
+}
+
+void InteropStats::Reset() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (Table* table : registry.tables) {
+    std::lock_guard<UnfairMutex> tableLock(table->mutex);
+    table->entries.clear();
+  }
+  registry.retired.clear();
+  for (std::atomic<uint64_t>& counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
+
+MaybeLocal<Object> InteropStats::ToObject(Local<Context> context) {
+  Isolate* isolate = context->GetIsolate();
+
+  EntryMap merged;
+  {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    merged = registry.retired;
+    for (Table* table : registry.tables) {
+      std::lock_guard<UnfairMutex> tableLock(table->mutex);
+      MergeInto(merged, table->entries);
+    }
+  }
+
+  std::vector<const EntryMap::value_type*> sorted;
+  sorted.reserve(merged.size());
+  for (const auto& pair : merged) {
+    sorted.push_back(&pair);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) {
+    return a->second.marshal.totalNanos + a->second.native.totalNanos >
+           b->second.marshal.totalNanos + b->second.native.totalNanos;
+  });
+
+  Local<v8::Array> calls = v8::Array::New(isolate);
+  uint32_t index = 0;
+  for (const EntryMap::value_type* pair : sorted) {
+    const Entry& entry = pair->second;
+    Local<Object> call = Object::New(isolate);
+    Local<v8::Array> marshalHistogram =
+        HistogramToArray(context, entry.marshal);
+    Local<v8::Array> nativeHistogram = HistogramToArray(context, entry.native);
+    bool success =
+        !marshalHistogram.IsEmpty() && !nativeHistogram.IsEmpty() &&
+        Set(context, call, "kind",
+            tns::ToV8String(isolate, pair->first.kind == Kind::ObjCMethod
+                                         ? "objc"
+                                         : "c")) &&
+        Set(context, call, "name",
+            tns::ToV8String(isolate, ResolveName(pair->first))) &&
+        SetNumber(context, call, "count", entry.count) &&
+        SetNumber(context, call, "marshalNanos", entry.marshal.totalNanos) &&
+        SetNumber(context, call, "nativeNanos", entry.native.totalNanos) &&
+        Set(context, call, "marshalHistogram", marshalHistogram) &&
+        Set(context, call, "nativeHistogram", nativeHistogram) &&
+        calls->Set(context, index++, call).FromMaybe(false);
+    if (!success) {
+      return MaybeLocal<Object>();
+    }
+  }
+
+  Local<Object> result = Object::New(isolate);
+  bool success =
+      Set(context, result, "enabled", v8::Boolean::New(isolate, IsEnabled())) &&
+      SetNumber(context, result, "structAllocations",
+                counters_[static_cast<int>(Counter::StructAllocation)].load(
+                    std::memory_order_relaxed)) &&
+      SetNumber(context, result, "numberBoxings",
+                counters_[static_cast<int>(Counter::NumberBoxing)].load(
+                    std::memory_order_relaxed)) &&
+      Set(context, result, "calls", calls);
+  if (!success) {
+    return MaybeLocal<Object>();
+  }
+  return result;
+}
+
+}  // namespace tns
+
+#endif /* NATIVESCRIPT_INTEROP_STATS */
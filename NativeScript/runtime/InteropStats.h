@@ -0,0 +1,143 @@
+#ifndef InteropStats_h
+#define InteropStats_h
+
+/**
+ Call-site counters for the ObjC/C interop layer, compiled in only with
+ NATIVESCRIPT_INTEROP_STATS.
+
+ Every native call made from JS — ObjC methods through
+ MetadataBuilder::MethodCallback and ArgConverter::Invoke, C functions through
+ MetadataBuilder::CFunctionCallback — converges on
+ Interop::CallFunctionInternal, which opens an InteropCallScope. The scope
+ splits the call into marshaling (arguments in, result out) and the native
+ call itself (ffi_call), and records both into log-linear histograms keyed by
+ selector or function pointer. StructWrapper allocations and NSNumber boxing
+ are counted alongside.
+
+ Recording is off until enabled from JS (ns:perf enableInteropStats), so a
+ build with the flag set pays one relaxed atomic load per call while idle.
+ Tables are per thread and only merged when read, so JS threads never contend
+ with each other. Without the flag every hook below compiles to nothing.
+ */
+
+#ifdef NATIVESCRIPT_INTEROP_STATS
+
+#include <mach/mach_time.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "Common.h"
+
+namespace tns {
+
+class InteropStats {
+ public:
+  enum class Kind : uint8_t { ObjCMethod, CFunction };
+  enum class Counter : uint8_t { StructAllocation, NumberBoxing, Count };
+
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static void Record(Kind kind, const void* key, uint64_t marshalTicks,
+                     uint64_t nativeTicks);
+
+  static void Increment(Counter counter) {
+    if (IsEnabled()) {
+      counters_[static_cast<int>(counter)].fetch_add(
+          1, std::memory_order_relaxed);
+    }
+  }
+
+  static void SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  // Drops everything recorded so far, on every thread.
+  static void Reset();
+
+  // Merges the per-thread tables into the object ns:perf getInteropStats
+  // returns; calls are sorted by total time, heaviest first.
+  static v8::MaybeLocal<v8::Object> ToObject(v8::Local<v8::Context> context);
+
+ private:
+  static std::atomic<bool> enabled_;
+  static std::atomic<uint64_t> counters_[static_cast<int>(Counter::Count)];
+};
+
+// Times one native call. Marks are mach_absolute_time() ticks; the scope
+// records from its destructor so calls that throw are still counted.
+class InteropCallScope {
+ public:
+  InteropCallScope(InteropStats::Kind kind, const void* key)
+      : kind_(kind), key_(InteropStats::IsEnabled() ? key : nullptr) {
+    if (this->key_ != nullptr) {
+      this->start_ = mach_absolute_time();
+    }
+  }
+
+  ~InteropCallScope() {
+    if (this->key_ == nullptr) {
+      return;
+    }
+    uint64_t end = mach_absolute_time();
+    if (this->nativeStart_ == 0) {
+      // Failed while marshaling the arguments.
+      InteropStats::Record(this->kind_, this->key_, end - this->start_, 0);
+      return;
+    }
+    if (this->nativeEnd_ == 0) {
+      // The native call raised.
+      this->nativeEnd_ = end;
+    }
+    uint64_t native = this->nativeEnd_ - this->nativeStart_;
+    InteropStats::Record(this->kind_, this->key_,
+                         (end - this->start_) - native, native);
+  }
+
+  InteropCallScope(const InteropCallScope&) = delete;
+  InteropCallScope& operator=(const InteropCallScope&) = delete;
+
+  void BeginNativeCall() {
+    if (this->key_ != nullptr) {
+      this->nativeStart_ = mach_absolute_time();
+    }
+  }
+
+  void EndNativeCall() {
+    if (this->key_ != nullptr) {
+      this->nativeEnd_ = mach_absolute_time();
+    }
+  }
+
+ private:
+  InteropStats::Kind kind_;
+  const void* key_;
+  uint64_t start_ = 0;
+  uint64_t nativeStart_ = 0;
+  uint64_t nativeEnd_ = 0;
+};
+
+}  // namespace tns
+
+#define NS_INTEROP_STATS_SCOPE(name, isCFunction, key)                  \
+  tns::InteropCallScope name((isCFunction)                              \
+                                 ? tns::InteropStats::Kind::CFunction   \
+                                 : tns::InteropStats::Kind::ObjCMethod, \
+                             key)
+#define NS_INTEROP_STATS_BEGIN_NATIVE(name) name.BeginNativeCall()
+#define NS_INTEROP_STATS_END_NATIVE(name) name.EndNativeCall()
+#define NS_INTEROP_STATS_COUNT(counter) \
+  tns::InteropStats::Increment(tns::InteropStats::Counter::counter)
+
+#else
+
+#define NS_INTEROP_STATS_SCOPE(name, isCFunction, key)
+#define NS_INTEROP_STATS_BEGIN_NATIVE(name)
+#define NS_INTEROP_STATS_END_NATIVE(name)
+#define NS_INTEROP_STATS_COUNT(counter)
+
+#endif /* NATIVESCRIPT_INTEROP_STATS */
+
+#endif /* InteropStats_h */
@@ -357,7 +357,7 @@ static Local<Value> GetWrappedNSException(Local<Context> context, Local<Value> v
   if (value->IsObject()) {
     Local<Value> nativeExc;
     if (value.As<Object>()
-            ->Get(context, tns::ToV8String(isolate, "nativeException"))
+            ->Get(context, tns::Keys::NativeException(isolate))
             .ToLocal(&nativeExc) &&
         isWrappedNSException(nativeExc)) {
       return nativeExc;
@@ -396,7 +396,7 @@ void Interop::RegisterEscapeExceptionFunction(Local<Context> context, Local<Obje
         bool xIsObject = x->IsObject();
         if (xIsObject) {
           Local<Value> msgVal;
-          if (x.As<Object>()->Get(context, tns::ToV8String(isolate, "message")).ToLocal(&msgVal) &&
+          if (x.As<Object>()->Get(context, tns::Keys::Message(isolate)).ToLocal(&msgVal) &&
               !msgVal->IsNullOrUndefined()) {
             message = tns::ToString(isolate, msgVal);
           } else {
@@ -415,10 +415,10 @@ void Interop::RegisterEscapeExceptionFunction(Local<Context> context, Local<Obje
         std::string stack;
         if (xIsObject) {
           Local<Value> stackVal;
-          if (x.As<Object>()->Get(context, tns::ToV8String(isolate, "stack")).ToLocal(&stackVal) &&
+          if (x.As<Object>()->Get(context, tns::Keys::Stack(isolate)).ToLocal(&stackVal) &&
               stackVal->IsString()) {
             stack = tns::ToString(isolate, stackVal);
-            errObj->Set(context, tns::ToV8String(isolate, "stack"), stackVal).FromMaybe(false);
+            errObj->Set(context, tns::Keys::Stack(isolate), stackVal).FromMaybe(false);
           }
         }
 
@@ -437,34 +437,34 @@ void Interop::RegisterEscapeExceptionFunction(Local<Context> context, Local<Obje
             .FromMaybe(false);
         Local<Value> nativeExc = GetWrappedNSException(context, x);
         if (!nativeExc.IsEmpty()) {
-          payload->Set(context, tns::ToV8String(isolate, "nativeException"), nativeExc)
+          payload->Set(context, tns::Keys::NativeException(isolate), nativeExc)
               .FromMaybe(false);
           // Also carry the JS origin/propagation stack of the error that wrapped
           // the native exception, when present.
           if (!stack.empty()) {
             payload
-                ->Set(context, tns::ToV8String(isolate, "stack"), tns::ToV8String(isolate, stack))
+                ->Set(context, tns::Keys::Stack(isolate), tns::ToV8String(isolate, stack))
                 .FromMaybe(false);
           }
         } else {
           std::string name = "Error";
           if (xIsObject) {
             Local<Value> nameVal;
-            if (x.As<Object>()->Get(context, tns::ToV8String(isolate, "name")).ToLocal(&nameVal) &&
+            if (x.As<Object>()->Get(context, tns::Keys::Name(isolate)).ToLocal(&nameVal) &&
                 nameVal->IsString()) {
               name = tns::ToString(isolate, nameVal);
             }
           }
-          payload->Set(context, tns::ToV8String(isolate, "name"), tns::ToV8String(isolate, name))
+          payload->Set(context, tns::Keys::Name(isolate), tns::ToV8String(isolate, name))
               .FromMaybe(false);
           payload
-              ->Set(context, tns::ToV8String(isolate, "message"), tns::ToV8String(isolate, message))
+              ->Set(context, tns::Keys::Message(isolate), tns::ToV8String(isolate, message))
               .FromMaybe(false);
           // When x is a non-Error (no .stack, e.g. a plain string) fall back to
           // the escape-site stack so a stack always travels with the escape.
           const std::string& synthStack = stack.empty() ? escapeStack : stack;
           payload
-              ->Set(context, tns::ToV8String(isolate, "stack"),
+              ->Set(context, tns::Keys::Stack(isolate),
                     tns::ToV8String(isolate, synthStack))
               .FromMaybe(false);
         }
@@ -1,7 +1,12 @@
 #ifndef KnownUnknownClassPair_h
 #define KnownUnknownClassPair_h
 
+#if __has_include(<objc/objc.h>)
 #include <objc/objc.h>
+#else
+// Host builds of MetadataFormat.h pass classes around without dereferencing them
+typedef struct objc_class* Class;
+#endif
 
 namespace tns {
 
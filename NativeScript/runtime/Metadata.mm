@@ -334,12 +334,4 @@ vector<const MethodMeta*> BaseClassMeta::initializersWithProtocols(
   return container;
 }
 
-static MetaFile* metaFileInstance(nullptr);
-
-MetaFile* MetaFile::instance() { return metaFileInstance; }
-
-MetaFile* MetaFile::setInstance(void* metadataPtr) {
-  metaFileInstance = reinterpret_cast<MetaFile*>(metadataPtr);
-  return metaFileInstance;
-}
 }  // namespace tns
@@ -6,6 +6,8 @@
 #include "Helpers.h"
 #include "InlineFunctions.h"
 #include "Interop.h"
+#include "InteropStats.h"
+#include "MetadataProfile.h"
 #include "NativeScriptException.h"
 #include "ObjectManager.h"
 #include "Runtime.h"
@@ -57,6 +59,14 @@ v8::Intercepted MetadataBuilder::GlobalPropertyGetter(Local<v8::Name> property,
   }
 
   const Meta* meta = ArgConverter::GetMeta(propName);
+  if (meta == nullptr && MetaFile::instance()->isPruned(propName.c_str())) {
+    std::string message = propName +
+                          " is not defined: it was left out of the metadata by the usage "
+                          "manifest the app was built with. Add it to the manifest or build "
+                          "without one.";
+    isolate->ThrowException(v8::Exception::ReferenceError(tns::ToV8String(isolate, message)));
+    return v8::Intercepted::kYes;
+  }
   if (meta == nullptr || !meta->isAvailable()) {
     return v8::Intercepted::kNo;
   }
@@ -227,6 +237,7 @@ void MetadataBuilder::StructConstructorCallback(const FunctionCallbackInfo<Value
     }
 
     StructWrapper* wrapper = new StructWrapper(structInfo, dest, nullptr);
+    NS_INTEROP_STATS_COUNT(StructAllocation);
     Local<Context> context = isolate->GetCurrentContext();
     Local<Value> result = ArgConverter::ConvertArgument(context, wrapper);
 
@@ -320,6 +331,7 @@ std::pair<ffi_type*, void*> MetadataBuilder::GetStructData(Local<Context> contex
 Local<FunctionTemplate> MetadataBuilder::GetOrCreateConstructorFunctionTemplate(
     Local<Context> context, const BaseClassMeta* meta, KnownUnknownClassPair pair,
     const std::vector<std::string>& additionalProtocols) {
+  MetadataProfile::Record(meta);
   robin_hood::unordered_map<std::string, uint8_t> instanceMembers;
   robin_hood::unordered_map<std::string, uint8_t> staticMembers;
   return MetadataBuilder::GetOrCreateConstructorFunctionTemplateInternal(
@@ -396,7 +408,7 @@ Local<FunctionTemplate> MetadataBuilder::GetOrCreateConstructorFunctionTemplateI
                                                instanceMembers);
 
   ctorFuncTemplate->PrototypeTemplate()->Set(
-      tns::ToV8String(isolate, "toString"),
+      tns::Keys::ToString(isolate),
       FunctionTemplate::New(isolate, MetadataBuilder::ToStringFunctionCallback));
 
   if (meta->type() == MetaType::Interface) {
@@ -455,7 +467,7 @@ Local<FunctionTemplate> MetadataBuilder::GetOrCreateConstructorFunctionTemplateI
                                            staticMembers);
 
   Local<Value> prototypeValue;
-  success = ctorFunc->Get(context, tns::ToV8String(isolate, "prototype")).ToLocal(&prototypeValue);
+  success = ctorFunc->Get(context, tns::Keys::Prototype(isolate)).ToLocal(&prototypeValue);
   tns::Assert(success, isolate);
   Local<Object> prototype = prototypeValue.As<Object>();
 
@@ -962,7 +974,7 @@ void MetadataBuilder::DefineFunctionLengthProperty(Local<Context> context,
   const PropertyAttribute readOnlyFlags = static_cast<PropertyAttribute>(
       PropertyAttribute::DontEnum | PropertyAttribute::DontDelete | PropertyAttribute::ReadOnly);
   int paramsCount = std::max(0, encodings->count - 1);
-  bool success = func->DefineOwnProperty(context, tns::ToV8String(isolate, "length"),
+  bool success = func->DefineOwnProperty(context, tns::Keys::Length(isolate),
                                          Number::New(isolate, paramsCount), readOnlyFlags)
                      .FromMaybe(false);
   tns::Assert(success, isolate);
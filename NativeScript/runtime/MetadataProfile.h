@@ -0,0 +1,59 @@
+#ifndef MetadataProfile_h
+#define MetadataProfile_h
+
+/**
+ Counts how often the runtime reads each global metadata entry, so that the
+ metadata generator can place the hot entries at the front of the metadata
+ heap (its -access-profile option).
+
+ Recording is off unless "recordMetadataProfile" is set in the app's
+ package.json: true writes Documents/metadata-profile.txt, a string is the
+ path to write. Entries are counted in ArgConverter::GetMeta, cached lookups
+ included, and in MetadataBuilder each time a class's constructor template is
+ requested. The file is rewritten when the app moves to the background, when
+ it terminates and at exit, one "jsName count" line per entry, most read
+ first. While recording, the time from launch to the first frame and the page
+ faults up to it are logged once, to compare layouts on a device.
+
+ While idle a read costs one relaxed atomic load.
+ */
+
+#include <atomic>
+#include <string>
+
+#include "Metadata.h"
+
+namespace tns {
+
+class MetadataProfile {
+ public:
+  // Reads the app's setting. Runs once from Runtime::Initialize, before any
+  // metadata is read.
+  static void Init();
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  static void Record(const Meta* meta) {
+    if (IsEnabled() && meta != nullptr) {
+      RecordEnabled(meta);
+    }
+  }
+
+  // Rewrites the profile with the counts so far.
+  static void Write();
+
+  // The file a recording setting such as "recordMetadataUsage" names: empty
+  // when it is unset or false, Documents/<defaultFileName> when it is true
+  // and the setting itself when it is a string.
+  static std::string RecordingPath(const std::string& key,
+                                   const std::string& defaultFileName);
+
+ private:
+  static void RecordEnabled(const Meta* meta);
+
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace tns
+
+#endif /* MetadataProfile_h */
@@ -0,0 +1,142 @@
+#include "MetadataProfile.h"
+#include <Foundation/Foundation.h>
+#include <UIKit/UIKit.h>
+#include <sys/resource.h>
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include "Helpers.h"
+#include "Runtime.h"
+#include "UnfairLock.h"
+#include "robin_hood.h"
+
+namespace tns {
+
+std::atomic<bool> MetadataProfile::enabled_{false};
+
+namespace {
+
+struct ProfileEntry {
+  uint64_t count;
+  // Position of the first read, which orders entries read equally often the way startup
+  // reads them
+  size_t first;
+};
+
+UnfairMutex profileMutex;
+robin_hood::unordered_map<const Meta*, ProfileEntry> profileEntries;
+std::string profilePath;
+
+double MillisSinceLaunch() {
+  struct kinfo_proc info;
+  size_t size = sizeof(info);
+  int mib[] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+  if (sysctl(mib, 4, &info, &size, nullptr, 0) != 0) {
+    return -1;
+  }
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  const struct timeval& start = info.kp_proc.p_starttime;
+  return (now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0;
+}
+
+// Core Animation commits a run loop turn's changes just before the main run loop sleeps, so
+// the first time it is about to sleep the first frame has been committed.
+void LogFirstFrame() {
+  CFRunLoopObserverRef observer = CFRunLoopObserverCreateWithHandler(
+      kCFAllocatorDefault, kCFRunLoopBeforeWaiting, /*repeats*/ false,
+      /*order*/ std::numeric_limits<CFIndex>::max(), ^(CFRunLoopObserverRef, CFRunLoopActivity) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        Log(@"Metadata profile: first frame %.1f ms after launch, %ld page faults (%ld read from "
+            @"disk)",
+            MillisSinceLaunch(), usage.ru_minflt + usage.ru_majflt, usage.ru_majflt);
+      });
+  CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopCommonModes);
+  CFRelease(observer);
+}
+
+}  // namespace
+
+std::string MetadataProfile::RecordingPath(const std::string& key,
+                                           const std::string& defaultFileName) {
+  id value = Runtime::GetAppConfigValue(key);
+  if ([value isKindOfClass:[NSString class]]) {
+    return [value fileSystemRepresentation];
+  }
+  if (value == nil || ![value boolValue]) {
+    return std::string();
+  }
+  NSString* documents = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask,
+                                                             YES) firstObject];
+  return [[documents stringByAppendingPathComponent:tns::ToNSString(defaultFileName)]
+      fileSystemRepresentation];
+}
+
+void MetadataProfile::Init() {
+  profilePath = RecordingPath("recordMetadataProfile", "metadata-profile.txt");
+  if (profilePath.empty()) {
+    return;
+  }
+  Log(@"Recording the metadata profile to %s", profilePath.c_str());
+  enabled_.store(true, std::memory_order_relaxed);
+
+  // Apps are usually killed in the background rather than exited, so the profile is written
+  // whenever that may happen.
+  NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+  for (NSNotificationName name in
+       @[ UIApplicationDidEnterBackgroundNotification, UIApplicationWillTerminateNotification ]) {
+    [center addObserverForName:name
+                        object:nil
+                         queue:nil
+                    usingBlock:^(NSNotification* notification) {
+                      MetadataProfile::Write();
+                    }];
+  }
+  atexit([]() { MetadataProfile::Write(); });
+  LogFirstFrame();
+}
+
+void MetadataProfile::RecordEnabled(const Meta* meta) {
+  std::lock_guard<UnfairMutex> lock(profileMutex);
+  auto it = profileEntries.find(meta);
+  if (it == profileEntries.end()) {
+    profileEntries.emplace(meta, ProfileEntry{1, profileEntries.size()});
+  } else {
+    it->second.count++;
+  }
+}
+
+void MetadataProfile::Write() {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  std::vector<std::pair<const Meta*, ProfileEntry>> entries;
+  {
+    std::lock_guard<UnfairMutex> lock(profileMutex);
+    entries.assign(profileEntries.begin(), profileEntries.end());
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.second.count != b.second.count ? a.second.count > b.second.count
+                                            : a.second.first < b.second.first;
+  });
+
+  FILE* file = fopen(profilePath.c_str(), "w");
+  if (file == nullptr) {
+    Log(@"Unable to write the metadata profile to %s", profilePath.c_str());
+    return;
+  }
+  for (const auto& entry : entries) {
+    fprintf(file, "%s %llu\n", entry.first->jsName(),
+            static_cast<unsigned long long>(entry.second.count));
+  }
+  fclose(file);
+}
+
+}  // namespace tns
@@ -115,15 +115,18 @@ class ModuleInternal {
                                  const std::string& baseDir, bool& isData,
                                  const ModuleEvaluationOptions& options);
   // Compile (and cache) a classic script; returns the compiled Script handle.
+  // Only the app bundle, which runs as is, is loaded this way.
   static v8::Local<v8::Script> LoadClassicScript(v8::Isolate* isolate,
                                                  const std::string& path);
+  // Compile (and cache) a CommonJS module as the body of a function taking
+  // (module, exports, require, __filename, __dirname); returns that function.
+  static v8::Local<v8::Function> LoadCommonJsFunction(v8::Isolate* isolate,
+                                                      const std::string& path);
 
   // Compile/link/evaluate an ES module; returns its namespace object.
   static v8::Local<v8::Value> LoadESModule(
       v8::Isolate* isolate, const std::string& path,
       const ModuleEvaluationOptions& options);
-  static v8::Local<v8::String> WrapModuleContent(v8::Isolate* isolate,
-                                                 const std::string& path);
   v8::Local<v8::Object> LoadModule(v8::Isolate* isolate,
                                    const std::string& modulePath,
                                    const std::string& cacheKey,
@@ -138,7 +141,8 @@ class ModuleInternal {
   // the wrong kind outright. One file compiled both ways — require('./x.js')
   // and import './x.js' — would otherwise share a blob and each load would
   // reject and overwrite the other's, so the two kinds get their own suffix
-  // and the cache actually hits.
+  // and the cache actually hits. CommonJS function blobs share the classic
+  // kind: no file is ever compiled as both the bundle script and a module.
   enum class ScriptCacheKind { kClassicScript, kEsModule };
   static v8::ScriptCompiler::CachedData* LoadScriptCache(
       const std::string& path, ScriptCacheKind kind);
@@ -16,6 +16,7 @@
 #include "NsBuiltinModules.h"
 #include "Runtime.h"
 #include "RuntimeConfig.h"
+#include "Tracing.h"
 #include "napi/NapiModules.h"
 
 using namespace v8;
@@ -207,6 +208,7 @@ ModuleInternal::ModuleInternal(Local<Context> context) {
 }
 
 void ModuleInternal::RunModule(Isolate* isolate, std::string path) {
+  TraceScope trace(TraceCategory::Module, "runMain", "path", path.c_str());
   // The app entry arrives as "./"; resolve it before deciding how to run it so
   // an ES module entry takes the module path instead of being require()d. A
   // required entry would evaluate under the strict policy, which refuses a
@@ -642,6 +644,7 @@ void ModuleInternal::RequireCallback(const FunctionCallbackInfo<Value>& info) {
 Local<Object> ModuleInternal::LoadImpl(Isolate* isolate, const std::string& moduleName,
                                        const std::string& baseDir, bool& isData,
                                        const ModuleEvaluationOptions& options) {
+  TraceScope trace(TraceCategory::Module, "require", "specifier", moduleName.c_str());
   // The specifier goes into the key verbatim. Stripping its extension made
   // './config.js' and './config.json' the same key, so whichever loaded first
   // answered for both. Specifier spellings that differ but resolve to one file
@@ -762,6 +765,7 @@ static Local<Value> RequireExportsForNamespace(Isolate* isolate, Local<Context>
 Local<Object> ModuleInternal::LoadModule(Isolate* isolate, const std::string& modulePath,
                                          const std::string& cacheKey,
                                          const ModuleEvaluationOptions& options) {
+  TraceScope trace(TraceCategory::Module, "loadModule", "path", modulePath.c_str());
   Local<Object> moduleObj = Object::New(isolate);
   Local<Object> exportsObj = Object::New(isolate);
   Local<Context> context = isolate->GetCurrentContext();
@@ -892,6 +896,7 @@ Local<Object> ModuleInternal::LoadModule(Isolate* isolate, const std::string& mo
 }
 
 Local<Object> ModuleInternal::LoadData(Isolate* isolate, const std::string& modulePath) {
+  TraceScope trace(TraceCategory::Module, "loadJSON", "path", modulePath.c_str());
   Local<Object> json;
 
   std::string jsonData = tns::ReadText(modulePath);
@@ -929,6 +934,12 @@ Local<Value> ModuleInternal::LoadScript(Isolate* isolate, const std::string& pat
     return ModuleInternal::LoadESModule(isolate, canonicalPath, options);
   }
 
+  // Everything but the app bundle is a CommonJS module: hand back its factory.
+  std::string bundlePath = RuntimeConfig.ApplicationPath + "/bundle.js";
+  if (canonicalPath != bundlePath) {
+    return ModuleInternal::LoadCommonJsFunction(isolate, canonicalPath);
+  }
+
   Local<Script> script = ModuleInternal::LoadClassicScript(isolate, canonicalPath);
 
   if (script.IsEmpty()) {
@@ -973,8 +984,8 @@ Local<Script> ModuleInternal::LoadClassicScript(Isolate* isolate, const std::str
   std::string base = ReplaceAll(canonicalPath, RuntimeConfig.BaseDir, "");
   std::string url = "file://" + base;
 
-  // wrap & cache lookup
-  Local<v8::String> sourceText = ModuleInternal::WrapModuleContent(isolate, canonicalPath);
+  // read & cache lookup
+  Local<v8::String> sourceText = tns::ReadModule(isolate, canonicalPath);
   auto* cacheData = ModuleInternal::LoadScriptCache(canonicalPath, ScriptCacheKind::kClassicScript);
 
   // note: is_module=false here
@@ -1010,13 +1021,71 @@ Local<Script> ModuleInternal::LoadClassicScript(Isolate* isolate, const std::str
     throw NativeScriptException(isolate, tc, "Cannot compile script " + canonicalPath);
   }
 
-  if (cacheData == nullptr) {
+  if (cacheData == nullptr || source.GetCachedData()->rejected) {
     ModuleInternal::SaveScriptCache(script, canonicalPath);
   }
 
   return script;
 }
 
+Local<v8::Function> ModuleInternal::LoadCommonJsFunction(Isolate* isolate,
+                                                         const std::string& path) {
+  std::string canonicalPath = NormalizePath(path);
+
+  struct stat st;
+  if (stat(canonicalPath.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+    throw NativeScriptException("Cannot find module " + canonicalPath);
+  }
+
+  auto context = isolate->GetCurrentContext();
+  std::string base = ReplaceAll(canonicalPath, RuntimeConfig.BaseDir, "");
+  std::string url = "file://" + base;
+
+  // The source is compiled as a function body, so it is never copied into a
+  // "(function(...) {" ... "})" wrapper, and line 1 keeps its own columns.
+  Local<v8::String> sourceText = tns::ReadModule(isolate, canonicalPath);
+  auto* cacheData = ModuleInternal::LoadScriptCache(canonicalPath, ScriptCacheKind::kClassicScript);
+
+  Local<v8::String> urlString;
+  if (!v8::String::NewFromUtf8(isolate, url.c_str(), NewStringType::kNormal).ToLocal(&urlString)) {
+    throw NativeScriptException(isolate, "Failed to create URL string for script " + canonicalPath);
+  }
+
+  ScriptOrigin origin(urlString, 0, 0, false, -1, Local<Value>(), false, false, false);
+  ScriptCompiler::Source source(sourceText, origin, cacheData);
+  Local<v8::String> parameters[] = {
+      tns::ToV8String(isolate, "module"), tns::ToV8String(isolate, "exports"),
+      tns::ToV8String(isolate, "require"), tns::ToV8String(isolate, "__filename"),
+      tns::ToV8String(isolate, "__dirname")};
+
+  auto opts = cacheData ? ScriptCompiler::kConsumeCodeCache : ScriptCompiler::kNoCompileOptions;
+
+  TryCatch tc(isolate);
+  Local<v8::Function> moduleFunc;
+  if (!ScriptCompiler::CompileFunction(context, &source, sizeof(parameters) / sizeof(parameters[0]),
+                                       parameters, 0, nullptr, opts)
+           .ToLocal(&moduleFunc) ||
+      tc.HasCaught()) {
+    if (RuntimeConfig.IsDebug) {
+      Log(@"***** JavaScript exception occurred *****");
+      Log(@"Error compiling module: %s", canonicalPath.c_str());
+      if (tc.HasCaught()) {
+        tns::LogError(isolate, tc);
+      }
+    }
+    throw NativeScriptException(isolate, tc, "Cannot compile script " + canonicalPath);
+  }
+
+  // A blob written for the wrapped script an older runtime compiled (or by
+  // another V8) is rejected; replace it so the next launch hits again.
+  if (!RuntimeConfig.IsDebug && (cacheData == nullptr || source.GetCachedData()->rejected)) {
+    ModuleInternal::SaveScriptCache(ScriptCompiler::CreateCodeCacheForFunction(moduleFunc),
+                                    canonicalPath, ScriptCacheKind::kClassicScript);
+  }
+
+  return moduleFunc;
+}
+
 MaybeLocal<Module> ModuleInternal::CompileFileEsModule(Isolate* isolate, const std::string& path) {
   std::string canonicalPath = NormalizePath(path);
 
@@ -1028,7 +1097,7 @@ MaybeLocal<Module> ModuleInternal::CompileFileEsModule(Isolate* isolate, const s
   std::string base = ReplaceAll(canonicalPath, RuntimeConfig.BaseDir, "");
   std::string url = "file://" + base;
 
-  Local<v8::String> sourceText = ModuleInternal::WrapModuleContent(isolate, canonicalPath);
+  Local<v8::String> sourceText = tns::ReadModule(isolate, canonicalPath);
   auto* cacheData = ModuleInternal::LoadScriptCache(canonicalPath, ScriptCacheKind::kEsModule);
 
   Local<v8::String> urlString;
@@ -1188,13 +1257,13 @@ static void LogEsmPhase(const std::string& canonicalPath, const char* phase, con
       Local<Object> errorObj = reason.As<Object>();
 
       Local<Value> messageVal;
-      if (errorObj->Get(context, tns::ToV8String(isolate, "message")).ToLocal(&messageVal) &&
+      if (errorObj->Get(context, tns::Keys::Message(isolate)).ToLocal(&messageVal) &&
           messageVal->IsString()) {
         errorMessage = tns::ToString(isolate, messageVal);
       }
 
       Local<Value> stackVal;
-      if (errorObj->Get(context, tns::ToV8String(isolate, "stack")).ToLocal(&stackVal) &&
+      if (errorObj->Get(context, tns::Keys::Stack(isolate)).ToLocal(&stackVal) &&
           stackVal->IsString()) {
         stackTrace = ReplaceAll(tns::ToString(isolate, stackVal), RuntimeConfig.BaseDir, "");
       }
@@ -1437,6 +1506,7 @@ MaybeLocal<Promise> EvaluateModuleGraph(Isolate* isolate, Local<Context> context
 
 Local<Value> ModuleInternal::LoadESModule(Isolate* isolate, const std::string& path,
                                           const ModuleEvaluationOptions& options) {
+  TraceScope trace(TraceCategory::Module, "loadESModule", "path", path.c_str());
   bool isHttpModule = IsHttpModulePath(path);
   std::string canonicalPath = CanonicalizeModulePath(path);
   std::string requestPath = isHttpModule ? NormalizeHttpModuleUrl(path) : canonicalPath;
@@ -1666,42 +1736,6 @@ void ModuleInternal::RunScript(Isolate* isolate, std::string script) {
   this->RunScriptString(isolate, context, script);
 }
 
-v8::Local<v8::String> ModuleInternal::WrapModuleContent(v8::Isolate* isolate,
-                                                        const std::string& path) {
-  // For classical scripts we wrap the source into the CommonJS factory function
-  // but for ES modules (".mjs") we must leave the source intact so that the
-  // V8 parser can recognise the "export"/"import" syntax. Wrapping an ES module
-  // in a function expression would turn those top-level keywords into syntax
-  // errors (e.g. `export *` → "Unexpected token '*'").
-
-  // Check if this is an .mjs file but NOT a .mjs.map file
-  if (IsESModule(path)) {
-    // Read raw text without wrapping. A worker entry needs no preamble: module
-    // scope nests inside global scope, so `self`, `postMessage`, `close`,
-    // `importScripts` and `console` already resolve to the worker globals.
-    // Declaring them instead shifted every stack line number by the length of
-    // the preamble and made an entry with its own `const self` a SyntaxError.
-    return tns::ToV8String(isolate, tns::ReadText(path));
-  }
-
-  // Check if this is the main application bundle (webpack-style IIFE)
-  // Main bundles typically end with "bundle.js" and are in the app root
-  std::string appPath = RuntimeConfig.ApplicationPath;
-  std::string bundlePath = appPath + "/bundle.js";
-
-  if (path == bundlePath) {
-    // Main application bundle should not be wrapped in CommonJS factory
-    // as it's typically a webpack-style IIFE that executes immediately
-    std::string sourceText = tns::ReadText(path);
-    return tns::ToV8String(isolate, sourceText);
-  }
-
-  // Worker .js files should use CommonJS wrapping like regular .js files
-  // This ensures proper runtime context and global object setup
-
-  return tns::ReadModule(isolate, path);
-}
-
 std::string ModuleInternal::ResolvePath(Isolate* isolate, const std::string& baseDir,
                                         const std::string& moduleName) {
   NSString* baseDirStr = [NSString stringWithUTF8String:baseDir.c_str()];
@@ -382,14 +382,11 @@ void IndexModuleForIsolate(v8::Isolate* isolate, const std::string& canonicalKey
 
 // Turn a value JS handed us into a real v8::Promise.
 //
-// A promise that reaches us from JS is usually NOT a v8::Promise: PromiseProxy
-// replaces the global Promise with a Proxy whose construct trap returns
-// `new Proxy(promise, ...)` so callbacks can be marshaled back to the creating
-// runloop. Such a value satisfies `instanceof Promise` in JS but fails
-// v8::Value::IsPromise(), so testing for a v8::Promise silently rejects
-// perfectly good input. Adopt any thenable instead — Resolver::New builds on the
-// intrinsic %Promise%, which the global override does not affect, and resolving
-// it with a thenable adopts that thenable's state.
+// A promise-like value from JS need not be a v8::Promise: a userland or
+// polyfilled promise satisfies `then` but fails v8::Value::IsPromise(), so
+// testing for a v8::Promise would reject perfectly good input. Adopt any
+// thenable instead — Resolver::New builds on the intrinsic %Promise%, and
+// resolving it with a thenable adopts that thenable's state.
 //
 // Values produced by V8 itself (Module::Evaluate) are genuine promises and take
 // the fast path.
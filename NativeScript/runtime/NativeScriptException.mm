@@ -100,7 +100,7 @@ NativeScriptException::NativeScriptException(Isolate* isolate, const std::string
   Local<Value> error = Exception::Error(tns::ToV8String(isolate, message));
   auto context = Caches::Get(isolate)->GetContext();
   error.As<Object>()
-      ->Set(context, ToV8String(isolate, "name"), ToV8String(isolate, this->name_))
+      ->Set(context, Keys::Name(isolate), ToV8String(isolate, this->name_))
       .FromMaybe(false);
   this->javascriptException_ = new Persistent<Value>(isolate, error);
   this->message_ = GetErrorMessage(isolate, error, message);
@@ -187,7 +187,7 @@ void NativeScriptException::ReportToJsHandlersAndLog(Isolate* isolate, Local<Val
   if (error->IsObject()) {
     Local<Context> context = isolate->GetCurrentContext();
     bool stackTraceSet = error.As<Object>()
-                             ->Set(context, tns::ToV8String(isolate, "stackTrace"),
+                             ->Set(context, tns::Keys::StackTrace(isolate),
                                    tns::ToV8String(isolate, stackForEvent))
                              .FromMaybe(false);
     if (!stackTraceSet) {
@@ -332,7 +332,7 @@ void NativeScriptException::ReportFatalTail(Isolate* isolate, Local<Value> error
   std::string fullMessage;
   if (error->IsObject()) {
     auto errObject = error.As<Object>();
-    auto fullMessageString = tns::ToV8String(isolate, "fullMessage");
+    auto fullMessageString = tns::Keys::FullMessage(isolate);
     if (errObject->HasOwnProperty(context, fullMessageString).ToChecked()) {
       // check if we have a "fullMessage" on the error, and log that instead - since it includes
       // more info about the exception.
@@ -354,7 +354,7 @@ void NativeScriptException::ReportFatalTail(Isolate* isolate, Local<Value> error
     if (error->IsObject()) {
       // Try to set stackTrace property, but don't crash if it fails
       bool stackTraceSet = error.As<Object>()
-                               ->Set(context, tns::ToV8String(isolate, "stackTrace"),
+                               ->Set(context, tns::Keys::StackTrace(isolate),
                                      tns::ToV8String(isolate, stackTrace))
                                .FromMaybe(false);
       if (!stackTraceSet) {
@@ -691,7 +691,7 @@ void NativeScriptException::ReThrowToV8(Isolate* isolate) {
       if (errObj->IsObject()) {
         if (!this->fullMessage_.empty()) {
           bool success = errObj.As<Object>()
-                             ->Set(context, tns::ToV8String(isolate, "fullMessage"),
+                             ->Set(context, tns::Keys::FullMessage(isolate),
                                    tns::ToV8String(isolate, this->fullMessage_))
                              .FromMaybe(false);
           if (!success) {
@@ -699,7 +699,7 @@ void NativeScriptException::ReThrowToV8(Isolate* isolate) {
           }
         } else if (!this->message_.empty()) {
           bool success = errObj.As<Object>()
-                             ->Set(context, tns::ToV8String(isolate, "fullMessage"),
+                             ->Set(context, tns::Keys::FullMessage(isolate),
                                    tns::ToV8String(isolate, this->message_))
                              .FromMaybe(false);
           if (!success) {
@@ -737,7 +737,7 @@ std::string NativeScriptException::GetErrorMessage(Isolate* isolate, Local<Value
 
   std::string errMessage;
   bool hasFullErrorMessage = false;
-  auto v8FullMessage = tns::ToV8String(isolate, "fullMessage");
+  auto v8FullMessage = tns::Keys::FullMessage(isolate);
   if (error->IsObject() && error.As<Object>()->Has(context, v8FullMessage).ToChecked()) {
     hasFullErrorMessage = true;
     Local<Value> errMsgVal;
@@ -0,0 +1,66 @@
+#ifndef NativeTransfer_h
+#define NativeTransfer_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common.h"
+
+namespace tns {
+namespace serialization {
+
+// A native object sent to another isolate by handle rather than by copy: a
+// retained ObjC object, an interop pointer, or a struct's bytes together with
+// the name of its metadata. Worker postMessage captures one for every native
+// wrapper named in its transfer list; the receiving isolate rebuilds the
+// wrapper its own interop layer would have produced for the same object.
+//
+// Only objects that are safe to use from two threads at once may cross:
+//  - ObjC objects of an immutable Foundation value class (NSData, NSString and
+//    NSAttributedString when not mutable; NSNumber, NSDate, NSURL, NSUUID,
+//    NSValue), UIImage, or a class the app lists under
+//    `"workers": { "threadSafeClasses": [...] }` in package.json.
+//  - interop.Pointer, whose address is shared as is; keeping the memory alive
+//    and synchronizing access is the app's responsibility.
+//  - Structs with metadata, which are copied (they are plain bytes).
+// Anything else is a DataCloneError.
+//
+// Handles are created on the sending thread and destroyed on whichever thread
+// drops the message, so they hold nothing bound to either isolate.
+class NativeHandle {
+ public:
+  // Null with a DataCloneError pending when `object` may not cross threads.
+  static std::unique_ptr<NativeHandle> Capture(v8::Isolate* isolate,
+                                               v8::Local<v8::Object> object);
+
+  // Whether `value` is a native wrapper, i.e. something Capture should judge
+  // rather than a plain JS value.
+  static bool IsNativeWrapper(v8::Isolate* isolate, v8::Local<v8::Value> value);
+
+  ~NativeHandle();
+
+  NativeHandle(const NativeHandle&) = delete;
+  NativeHandle& operator=(const NativeHandle&) = delete;
+
+  // Wraps the native object for `context`'s isolate. An ObjC object already
+  // wrapped there comes back as that same wrapper.
+  v8::MaybeLocal<v8::Object> Rebuild(v8::Local<v8::Context> context) const;
+
+ private:
+  enum class Kind { kObject, kPointer, kStruct };
+
+  NativeHandle(Kind kind, void* data) : kind_(kind), data_(data) {}
+
+  Kind kind_;
+  // kObject: the retained id. kPointer: the address.
+  void* data_;
+  // kStruct only.
+  std::string structName_;
+  std::vector<uint8_t> structBytes_;
+};
+
+}  // namespace serialization
+}  // namespace tns
+
+#endif /* NativeTransfer_h */
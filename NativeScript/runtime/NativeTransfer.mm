@@ -0,0 +1,190 @@
+#include "NativeTransfer.h"
+#include <Foundation/Foundation.h>
+#include <cstring>
+#include "ArgConverter.h"
+#include "Caches.h"
+#include "FFICall.h"
+#include "Helpers.h"
+#include "Interop.h"
+#include "Pointer.h"
+#include "Runtime.h"
+#include "StructuredSerialization.h"
+
+using namespace v8;
+
+namespace tns {
+namespace serialization {
+
+namespace {
+
+// Classes whose instances never change after creation. The first three have
+// mutable subclasses, which -copy tells apart: an immutable instance answers
+// itself, a mutable one a snapshot.
+bool IsImmutableValue(id object) {
+  if ([object isKindOfClass:[NSData class]] || [object isKindOfClass:[NSString class]] ||
+      [object isKindOfClass:[NSAttributedString class]]) {
+    id copy = [object copy];
+    bool immutable = copy == object;
+    [copy release];
+    return immutable;
+  }
+
+  return [object isKindOfClass:[NSNumber class]] || [object isKindOfClass:[NSDate class]] ||
+         [object isKindOfClass:[NSURL class]] || [object isKindOfClass:[NSUUID class]] ||
+         [object isKindOfClass:[NSValue class]];
+}
+
+// UIImage is documented as safe to use from any thread. Looked up by name so
+// this file does not pull in UIKit.
+Class UIImageClass() {
+  static Class klass = NSClassFromString(@"UIImage");
+  return klass;
+}
+
+// package.json: { "workers": { "threadSafeClasses": ["MyImmutableModel", ...] } }.
+// Read once; subclasses of a listed class are accepted too.
+const std::vector<Class>& AppThreadSafeClasses() {
+  static const std::vector<Class> classes = []() {
+    std::vector<Class> result;
+    id workers = Runtime::GetAppConfigValue("workers");
+    if (![workers isKindOfClass:[NSDictionary class]]) {
+      return result;
+    }
+    id names = ((NSDictionary*)workers)[@"threadSafeClasses"];
+    if (![names isKindOfClass:[NSArray class]]) {
+      return result;
+    }
+    for (id name in (NSArray*)names) {
+      if ([name isKindOfClass:[NSString class]]) {
+        if (Class klass = NSClassFromString((NSString*)name)) {
+          result.push_back(klass);
+        }
+      }
+    }
+    return result;
+  }();
+  return classes;
+}
+
+bool IsThreadSafe(id object) {
+  if (IsImmutableValue(object)) {
+    return true;
+  }
+  Class uiImage = UIImageClass();
+  if (uiImage != nil && [object isKindOfClass:uiImage]) {
+    return true;
+  }
+  for (Class klass : AppThreadSafeClasses()) {
+    if ([object isKindOfClass:klass]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool NativeHandle::IsNativeWrapper(Isolate* isolate, Local<Value> value) {
+  return value->IsObject() && tns::GetValue(isolate, value) != nullptr;
+}
+
+std::unique_ptr<NativeHandle> NativeHandle::Capture(Isolate* isolate, Local<Object> object) {
+  BaseDataWrapper* wrapper = tns::GetValue(isolate, object);
+  if (wrapper == nullptr) {
+    ThrowDataCloneError(isolate, "A value in the transfer list is not transferable");
+    return nullptr;
+  }
+
+  switch (wrapper->Type()) {
+    case WrapperType::ObjCObject: {
+      id data = static_cast<ObjCDataWrapper*>(wrapper)->Data();
+      if (data == nil) {
+        break;
+      }
+      if (!IsThreadSafe(data)) {
+        ThrowDataCloneError(isolate, "#<" + std::string(object_getClassName(data)) +
+                                         "> is not thread-safe and cannot be sent to a worker. "
+                                         "List its class under workers.threadSafeClasses in "
+                                         "package.json if it is.");
+        return nullptr;
+      }
+      return std::unique_ptr<NativeHandle>(new NativeHandle(Kind::kObject, [data retain]));
+    }
+    case WrapperType::Pointer: {
+      void* data = static_cast<PointerWrapper*>(wrapper)->Data();
+      return std::unique_ptr<NativeHandle>(new NativeHandle(Kind::kPointer, data));
+    }
+    case WrapperType::Struct: {
+      StructWrapper* structWrapper = static_cast<StructWrapper*>(wrapper);
+      StructInfo structInfo = structWrapper->StructInfo();
+      std::string name = structInfo.Name();
+      const Meta* meta = name.empty() ? nullptr : ArgConverter::GetMeta(name);
+      if (meta == nullptr || meta->type() != MetaType::Struct) {
+        // Without metadata the receiver has no way to lay the bytes out again.
+        ThrowDataCloneError(isolate, "An anonymous struct cannot be sent to a worker");
+        return nullptr;
+      }
+      const uint8_t* bytes = static_cast<const uint8_t*>(structWrapper->Data());
+      std::unique_ptr<NativeHandle> handle(new NativeHandle(Kind::kStruct, nullptr));
+      handle->structName_ = std::move(name);
+      handle->structBytes_.assign(bytes, bytes + structInfo.FFIType()->size);
+      return handle;
+    }
+    default:
+      break;
+  }
+
+  std::string name = tns::ToString(isolate, object->GetConstructorName());
+  ThrowDataCloneError(isolate, "#<" + name + "> cannot be sent to a worker");
+  return nullptr;
+}
+
+NativeHandle::~NativeHandle() {
+  if (this->kind_ == Kind::kObject) {
+    [(id)this->data_ release];
+  }
+}
+
+MaybeLocal<Object> NativeHandle::Rebuild(Local<Context> context) const {
+  Isolate* isolate = context->GetIsolate();
+  Local<Value> result;
+  switch (this->kind_) {
+    case Kind::kObject: {
+      // The same path an interop call returning this object takes, so an object
+      // the worker already knows keeps its wrapper (and its JS identity).
+      id data = (id)this->data_;
+      auto cache = Caches::Get(isolate);
+      auto poInstance = ArgConverter::FindCachedInstance(isolate, cache, data);
+      if (poInstance != nullptr) {
+        result = poInstance->Get(isolate);
+        break;
+      }
+      ObjCDataWrapper* wrapper = new ObjCDataWrapper(data);
+      result = ArgConverter::ConvertArgument(context, wrapper);
+      tns::DeleteWrapperIfUnused(isolate, result, wrapper);
+      break;
+    }
+    case Kind::kPointer:
+      result = Pointer::NewInstance(context, this->data_);
+      break;
+    case Kind::kStruct: {
+      const Meta* meta = ArgConverter::GetMeta(this->structName_);
+      if (meta == nullptr || meta->type() != MetaType::Struct) {
+        return MaybeLocal<Object>();
+      }
+      StructInfo structInfo = FFICall::GetStructInfo(static_cast<const StructMeta*>(meta));
+      // StructToValue copies the bytes into memory the new wrapper owns.
+      result = Interop::StructToValue(context, const_cast<uint8_t*>(this->structBytes_.data()),
+                                      structInfo, nullptr);
+      break;
+    }
+  }
+
+  if (result.IsEmpty() || !result->IsObject()) {
+    return MaybeLocal<Object>();
+  }
+  return result.As<Object>();
+}
+
+}  // namespace serialization
+}  // namespace tns
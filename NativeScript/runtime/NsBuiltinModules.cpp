@@ -7,6 +7,7 @@
 #include "Console.h"
 #include "Helpers.h"
 #include "ModuleInternalCallbacks.h"
+#include "Profiling.h"
 #include "Runtime.h"
 
 using namespace v8;
@@ -29,6 +30,7 @@ struct Registration {
 // never carries compatibility code.
 constexpr Registration kRegistry[] = {
     {"ns:module", BuiltinId::kNsModule},
+    {"ns:perf", BuiltinId::kNsPerf},
     {"ns:runtime", BuiltinId::kNsRuntime},
     {"ns:util", BuiltinId::kNsUtil},
     {"node:module", BuiltinId::kNodeModule},
@@ -159,6 +161,14 @@ MaybeLocal<Object> BuildBinding(Local<Context> context, BuiltinId builtin) {
       }
       break;
     }
+    case BuiltinId::kNsPerf: {
+      // Profilers, heap snapshots and heap statistics (Profiling.cpp); all
+      // argument validation happens natively.
+      if (!Profiling::BuildBinding(context, binding)) {
+        return MaybeLocal<Object>();
+      }
+      break;
+    }
     case BuiltinId::kNsRuntime: {
       Local<v8::Function> setConfig, getConfig;
       if (!v8::Function::New(context, SetConfigCallback).ToLocal(&setConfig) ||
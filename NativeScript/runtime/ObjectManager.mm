@@ -7,6 +7,7 @@
 #include "DataWrapper.h"
 #include "FFICall.h"
 #include "Helpers.h"
+#include "Tracing.h"
 
 using namespace v8;
 using namespace std;
@@ -134,6 +135,7 @@ void ObjectManager::DisposeAllRegistered(Isolate* isolate) {
 }
 
 void ObjectManager::FinalizerCallback(const WeakCallbackInfo<ObjectWeakCallbackState>& data) {
+  TraceScope trace(TraceCategory::GC, "finalizer");
   ObjectWeakCallbackState* state = data.GetParameter();
   Isolate* isolate = data.GetIsolate();
   Local<Value> value = state->target_->Get(isolate);
@@ -268,7 +270,12 @@ bool ObjectManager::DisposeValue(Isolate* isolate, Local<Value> value, bool isFi
     }
     case WrapperType::ExtVector: {
       ExtVectorWrapper* extVectorWrapper = static_cast<ExtVectorWrapper*>(wrapper);
-      FFICall::DisposeFFIType(extVectorWrapper->FFIType(), extVectorWrapper->TypeEncoding());
+      // The ffi type belongs to the isolate's ExtVectorKind. Once typed-array views have been
+      // handed out the data is theirs to free.
+      if (extVectorWrapper->HasBackingStore()) {
+        extVectorWrapper->ReleaseBackingStore();
+        break;
+      }
       void* data = extVectorWrapper->Data();
       if (data) {
         std::free(data);
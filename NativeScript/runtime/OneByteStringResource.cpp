@@ -1,15 +1,76 @@
 #include "OneByteStringResource.h"
+#include <CoreFoundation/CoreFoundation.h>
+#include <sys/mman.h>
+#include <cstdlib>
+#include <cstring>
 
 using namespace v8;
 
 namespace tns {
 
-OneByteStringResource::OneByteStringResource(const char* data, size_t length):
-    data_(data), length_(length) {
+namespace {
+
+// V8 hands back external resources as its own base class, which V8 builds without RTTI, and
+// Node-API modules create external one-byte strings of their own. The class is final, so its
+// resources are the ones whose vtable pointer, first in the object under the Itanium C++ ABI, is
+// this class's.
+const void* VtableOf(const void* object) {
+    const void* vtable;
+    memcpy(&vtable, object, sizeof(vtable));
+    return vtable;
+}
+
+void KeepStringBuffer(const void* data, void* context) {
+}
+
+const void* OwnVtable() {
+    static const void* vtable = [] {
+        OneByteStringResource probe(nullptr, 0, KeepStringBuffer, nullptr);
+        return VtableOf(&probe);
+    }();
+    return vtable;
+}
+
+}
+
+void FreeStringBuffer(const void* data, void* context) {
+    std::free(const_cast<void*>(data));
+}
+
+void DeleteStringBuffer(const void* data, void* context) {
+    delete[] static_cast<const char*>(data);
+}
+
+void ReleaseStringOwner(const void* data, void* context) {
+    CFRelease(static_cast<CFTypeRef>(context));
+}
+
+void UnmapStringBuffer(const void* data, void* context) {
+    munmap(const_cast<void*>(data), reinterpret_cast<size_t>(context));
+}
+
+OneByteStringResource::OneByteStringResource(const char* data, size_t length, bool nulTerminated):
+    OneByteStringResource(data, length, FreeStringBuffer, nullptr, nulTerminated) {
+}
+
+OneByteStringResource::OneByteStringResource(const char* data, size_t length, StringResourceRelease release, void* context, bool nulTerminated):
+    data_(data), length_(length), release_(release), context_(context), nulTerminated_(nulTerminated) {
 }
 
 OneByteStringResource::~OneByteStringResource() {
-    delete this->data_;
+    this->release_(this->data_, this->context_);
+}
+
+const char* OneByteStringResource::CString(Local<v8::String> str) {
+    if (!str->IsExternalOneByte()) {
+        return nullptr;
+    }
+    const v8::String::ExternalOneByteStringResource* resource = str->GetExternalOneByteStringResource();
+    if (VtableOf(resource) != OwnVtable()) {
+        return nullptr;
+    }
+    const OneByteStringResource* own = static_cast<const OneByteStringResource*>(resource);
+    return own->nulTerminated_ ? own->data_ : nullptr;
 }
 
 const char* OneByteStringResource::data() const {
@@ -20,4 +81,20 @@ size_t OneByteStringResource::length() const {
     return this->length_;
 }
 
+TwoByteStringResource::TwoByteStringResource(const uint16_t* data, size_t length, StringResourceRelease release, void* context):
+    data_(data), length_(length), release_(release), context_(context) {
+}
+
+TwoByteStringResource::~TwoByteStringResource() {
+    this->release_(this->data_, this->context_);
+}
+
+const uint16_t* TwoByteStringResource::data() const {
+    return this->data_;
+}
+
+size_t TwoByteStringResource::length() const {
+    return this->length_;
+}
+
 }
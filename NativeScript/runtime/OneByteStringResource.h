@@ -5,15 +5,51 @@
 
 namespace tns {
 
-class OneByteStringResource : public v8::String::ExternalOneByteStringResource {
+// Called once V8 no longer needs an external string's characters. `context` is
+// whatever was handed to the resource alongside them, e.g. a retained CFString.
+typedef void (*StringResourceRelease)(const void* data, void* context);
+
+// Releases a malloc'ed buffer (the default), a new[]'ed one, a CFTypeRef
+// passed as the context, or an mmap'ed file whose length is the context.
+void FreeStringBuffer(const void* data, void* context);
+void DeleteStringBuffer(const void* data, void* context);
+void ReleaseStringOwner(const void* data, void* context);
+void UnmapStringBuffer(const void* data, void* context);
+
+class OneByteStringResource final : public v8::String::ExternalOneByteStringResource {
 public:
-    OneByteStringResource(const char* data, size_t length);
+    // Takes ownership of a malloc'ed buffer. `nulTerminated` says a NUL follows the characters,
+    // so that data() can be handed to native code as a C string.
+    OneByteStringResource(const char* data, size_t length, bool nulTerminated = false);
+    OneByteStringResource(const char* data, size_t length, StringResourceRelease release, void* context, bool nulTerminated = false);
     ~OneByteStringResource() override;
     const char* data() const override;
     size_t length() const override;
+
+    // The characters of `str` as a C string when it is external and its resource is one of these
+    // with a NUL after its characters, otherwise null. Other external strings, such as mapped files whose size is a
+    // multiple of the page size, have no NUL to stop at.
+    static const char* CString(v8::Local<v8::String> str);
 private:
     const char* data_;
     size_t length_;
+    StringResourceRelease release_;
+    void* context_;
+    bool nulTerminated_;
+};
+
+// The UTF-16 counterpart, for strings whose characters are not all Latin-1.
+class TwoByteStringResource : public v8::String::ExternalStringResource {
+public:
+    TwoByteStringResource(const uint16_t* data, size_t length, StringResourceRelease release, void* context);
+    ~TwoByteStringResource() override;
+    const uint16_t* data() const override;
+    size_t length() const override;
+private:
+    const uint16_t* data_;
+    size_t length_;
+    StringResourceRelease release_;
+    void* context_;
 };
 
 }
@@ -1,6 +1,12 @@
 #include "Performance.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "BuiltinLoader.h"
+#include "Caches.h"
+#include "EventLoop.h"
 #include "Helpers.h"
 #include "Runtime.h"
 
@@ -8,6 +14,175 @@ using namespace v8;
 
 namespace tns {
 
+namespace {
+
+// Long Tasks API: a turn at least this long is reported.
+constexpr double kLongTaskThresholdMs = 50.0;
+// A loop that never sleeps (a worker spinning on Atomics.wait) has no turn
+// end to flush at; entries past this bound are dropped, not accumulated.
+constexpr size_t kMaxPendingEntries = 1024;
+
+// Entry type codes shared with deliverNativeEntries in performance.js.
+enum class NativeEntryType { kLongTask = 0, kGc = 1 };
+
+// One longtask or gc record; `kind` and `flags` are the v8::GCType and
+// v8::GCCallbackFlags of a gc entry and 0 for a long task.
+struct NativeEntry {
+  NativeEntryType type;
+  double startTime;
+  double duration;
+  int kind;
+  int flags;
+};
+
+// Written by the GC epilogue on whichever thread holds the isolate and read by
+// the end-of-turn hook on the home thread before it takes the Locker, hence
+// its own mutex and shared ownership with that hook.
+struct NativeEntryQueue {
+  std::mutex mutex;
+  std::vector<NativeEntry> pending;
+  std::atomic<bool> observeGc{false};
+  std::atomic<bool> observeLongTasks{false};
+
+  void Push(const NativeEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.size() < kMaxPendingEntries) {
+      pending.push_back(entry);
+    }
+  }
+};
+
+// Per-isolate (Caches::StateFor).
+struct PerformanceState {
+  std::shared_ptr<NativeEntryQueue> queue =
+      std::make_shared<NativeEntryQueue>();
+  // deliverNativeEntries, the performance builtin's export
+  Global<v8::Function> deliver;
+  // performance-timeline start of the collection in progress
+  double gcStartTime = 0;
+  bool gcCallbacksAdded = false;
+};
+
+void GCPrologue(Isolate* isolate, GCType type, GCCallbackFlags flags) {
+  PerformanceState* state = Caches::StateFor<PerformanceState>(isolate);
+  if (state != nullptr) {
+    state->gcStartTime = Performance::NowMillis(isolate);
+  }
+}
+
+void GCEpilogue(Isolate* isolate, GCType type, GCCallbackFlags flags) {
+  PerformanceState* state = Caches::StateFor<PerformanceState>(isolate);
+  if (state == nullptr || !state->queue->observeGc) {
+    return;
+  }
+  double end = Performance::NowMillis(isolate);
+  state->queue->Push({NativeEntryType::kGc, state->gcStartTime,
+                      end - state->gcStartTime, static_cast<int>(type),
+                      static_cast<int>(flags)});
+}
+
+// The runtime loop's turn observer: queues a longtask entry for a long turn,
+// then hands everything queued during the turn to JS in one call. Nothing
+// pending means no Locker is taken.
+void TurnEnded(Isolate* isolate, const std::shared_ptr<NativeEntryQueue>& queue,
+               double turnMs) {
+  if (queue->observeLongTasks && turnMs >= kLongTaskThresholdMs) {
+    double end = Performance::NowMillis(isolate);
+    queue->Push({NativeEntryType::kLongTask, end - turnMs, turnMs, 0, 0});
+  }
+
+  std::vector<NativeEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->pending.empty()) {
+      return;
+    }
+    entries.swap(queue->pending);
+  }
+  if (!Runtime::IsAlive(isolate)) {
+    return;
+  }
+
+  v8::Locker locker(isolate);
+  Isolate::Scope isolate_scope(isolate);
+  HandleScope handle_scope(isolate);
+  auto cache = Caches::Get(isolate);
+  PerformanceState* state = Caches::StateFor<PerformanceState>(isolate);
+  if (state == nullptr || state->deliver.IsEmpty() || !cache->HasContext()) {
+    return;
+  }
+  Local<Context> context = cache->GetContext();
+  Context::Scope context_scope(context);
+
+  // Flattened five numbers per entry: type, startTime, duration, kind, flags.
+  std::vector<Local<Value>> values;
+  values.reserve(entries.size() * 5);
+  for (const NativeEntry& entry : entries) {
+    values.push_back(Number::New(isolate, static_cast<int>(entry.type)));
+    values.push_back(Number::New(isolate, entry.startTime));
+    values.push_back(Number::New(isolate, entry.duration));
+    values.push_back(Number::New(isolate, entry.kind));
+    values.push_back(Number::New(isolate, entry.flags));
+  }
+  Local<Value> args[] = {
+      v8::Array::New(isolate, values.data(), values.size())};
+
+  TryCatch tc(isolate);
+  Local<Value> result;
+  if (!state->deliver.Get(isolate)
+           ->Call(context, v8::Undefined(isolate), 1, args)
+           .ToLocal(&result) &&
+      tc.HasCaught()) {
+    tns::LogError(isolate, tc);
+  }
+}
+
+// binding.observeNativeEntries(gc, longTask): which of the natively produced
+// entry types some PerformanceObserver currently wants. The GC callbacks stay
+// off until a gc observer first exists.
+void ObserveNativeEntriesCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  PerformanceState* state = Caches::StateFor<PerformanceState>(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  bool gc = info.Length() > 0 && info[0]->BooleanValue(isolate);
+  bool longTask = info.Length() > 1 && info[1]->BooleanValue(isolate);
+  state->queue->observeGc = gc;
+  state->queue->observeLongTasks = longTask;
+  if (gc && !state->gcCallbacksAdded) {
+    state->gcCallbacksAdded = true;
+    isolate->AddGCPrologueCallback(GCPrologue);
+    isolate->AddGCEpilogueCallback(GCEpilogue);
+  }
+}
+
+// binding.sampleLoopTiming(out): writes the runtime loop's [idle, active]
+// milliseconds into the Float64Array `out`.
+void SampleLoopTimingCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  if (info.Length() < 1 || !info[0]->IsFloat64Array()) {
+    return;
+  }
+  Local<Float64Array> out = info[0].As<Float64Array>();
+  if (out->Length() < 2) {
+    return;
+  }
+
+  double idle = 0;
+  double active = 0;
+  Runtime* runtime = Runtime::GetRuntime(isolate);
+  if (runtime != nullptr && runtime->GetEventLoop() != nullptr) {
+    runtime->GetEventLoop()->LoopTiming(&idle, &active);
+  }
+  double* data = reinterpret_cast<double*>(
+      static_cast<uint8_t*>(out->Buffer()->GetBackingStore()->Data()) + out->ByteOffset());
+  data[0] = idle;
+  data[1] = active;
+}
+
+}  // namespace
+
 void Performance::Init(v8::Local<v8::Context> context) {
   Isolate* isolate = v8::Isolate::GetCurrent();
 
@@ -21,6 +196,14 @@ void Performance::Init(v8::Local<v8::Context> context) {
                      .ToLocal(&now);
   tns::Assert(success, isolate);
 
+  Local<v8::Function> observeNativeEntries;
+  Local<v8::Function> sampleLoopTiming;
+  success = v8::Function::New(context, ObserveNativeEntriesCallback)
+                .ToLocal(&observeNativeEntries) &&
+            v8::Function::New(context, SampleLoopTimingCallback)
+                .ToLocal(&sampleLoopTiming);
+  tns::Assert(success, isolate);
+
   Local<Object> binding = Object::New(isolate);
   success = binding->Set(context, tns::ToV8String(isolate, "now"), now)
                 .FromMaybe(false);
@@ -29,13 +212,33 @@ void Performance::Init(v8::Local<v8::Context> context) {
   success = binding
                 ->Set(context, tns::ToV8String(isolate, "timeOrigin"),
                       v8::Number::New(isolate, TimeOriginMillis(isolate)))
+                .FromMaybe(false) &&
+            binding
+                ->Set(context, tns::ToV8String(isolate, "observeNativeEntries"),
+                      observeNativeEntries)
+                .FromMaybe(false) &&
+            binding
+                ->Set(context, tns::ToV8String(isolate, "sampleLoopTiming"),
+                      sampleLoopTiming)
                 .FromMaybe(false);
   tns::Assert(success, isolate);
 
   Local<Value> result;
   success = BuiltinLoader::RunBuiltin(context, BuiltinId::kPerformance, binding)
                 .ToLocal(&result);
-  tns::Assert(success, isolate);
+  tns::Assert(success && result->IsFunction(), isolate);
+
+  PerformanceState* state = Caches::StateFor<PerformanceState>(isolate);
+  tns::Assert(state != nullptr, isolate);
+  state->deliver.Reset(isolate, result.As<v8::Function>());
+
+  Runtime* runtime = Runtime::GetRuntime(isolate);
+  if (runtime != nullptr && runtime->GetEventLoop() != nullptr) {
+    std::shared_ptr<NativeEntryQueue> queue = state->queue;
+    runtime->GetEventLoop()->SetTurnObserver([isolate, queue](double turnMs) {
+      TurnEnded(isolate, queue, turnMs);
+    });
+  }
 }
 
 double Performance::NowMillis(Isolate* isolate) {
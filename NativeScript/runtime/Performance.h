@@ -8,7 +8,9 @@ namespace tns {
 class Performance {
  public:
   // Installs the WHATWG Performance API by evaluating internal/performance.js
-  // with a bag of natives {now, timeOrigin}. Must run after Events::Init
+  // with a bag of natives {now, timeOrigin, sampleLoopTiming,
+  // observeNativeEntries}, and registers the runtime loop's turn observer that
+  // delivers longtask and gc entries to it. Must run after Events::Init
   // (Performance extends EventTarget) and after ErrorEvents::Init (observer
   // failures are reported through it). Evaluated once per isolate during
   // Runtime::Init, for main and worker isolates alike; each isolate carries its
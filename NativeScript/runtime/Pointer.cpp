@@ -57,7 +57,7 @@ Local<v8::Function> Pointer::GetPointerCtorFunc(Local<Context> context) {
   tns::SetValue(isolate, ctorFunc, new PointerTypeWrapper());
 
   Local<Value> prototypeValue;
-  bool success = ctorFunc->Get(context, tns::ToV8String(isolate, "prototype"))
+  bool success = ctorFunc->Get(context, tns::Keys::Prototype(isolate))
                      .ToLocal(&prototypeValue);
   tns::Assert(success && prototypeValue->IsObject(), isolate);
   Local<Object> prototype = prototypeValue.As<Object>();
@@ -257,7 +257,7 @@ void Pointer::RegisterToStringMethod(Local<Context> context,
   tns::Assert(funcTemplate->GetFunction(context).ToLocal(&func), isolate);
 
   bool success =
-      prototype->Set(context, tns::ToV8String(isolate, "toString"), func)
+      prototype->Set(context, tns::Keys::ToString(isolate), func)
           .FromMaybe(false);
   tns::Assert(success, isolate);
 }
@@ -0,0 +1,731 @@
+#include "Profiling.h"
+
+#include <mach/mach.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "Caches.h"
+#include "Helpers.h"
+#include "InteropStats.h"
+#include "inspector/ns-v8-tracing-agent-impl.h"
+
+using namespace v8;
+
+namespace tns {
+
+namespace {
+
+// Per-isolate profiler state (Caches::StateFor). The CpuProfiler is created on
+// the first startCpuProfile and disposed with the isolate's Caches, under the
+// teardown Locker while the isolate is still alive.
+struct ProfilingState {
+  Isolate* isolate = nullptr;
+  CpuProfiler* cpuProfiler = nullptr;
+  bool heapSampling = false;
+
+  ~ProfilingState() {
+    if (this->heapSampling && this->isolate != nullptr) {
+      this->isolate->GetHeapProfiler()->StopSamplingHeapProfiler();
+    }
+    if (this->cpuProfiler != nullptr) {
+      this->cpuProfiler->Dispose();
+    }
+  }
+};
+
+ProfilingState* GetState(Isolate* isolate) {
+  ProfilingState* state = Caches::StateFor<ProfilingState>(isolate);
+  if (state != nullptr) {
+    state->isolate = isolate;
+  }
+  return state;
+}
+
+void ThrowTypeError(Isolate* isolate, const std::string& message) {
+  isolate->ThrowException(
+      Exception::TypeError(tns::ToV8String(isolate, message)));
+}
+
+void ThrowError(Isolate* isolate, const std::string& message) {
+  isolate->ThrowException(Exception::Error(tns::ToV8String(isolate, message)));
+}
+
+void ThrowWriteError(Isolate* isolate, const std::string& path, int error) {
+  ThrowError(isolate, "ns:perf: could not write '" + path +
+                          "': " + strerror(error));
+}
+
+// Profiles are addressed by title, and V8 reads an empty title as "the last
+// profile started" on stop — which would let one caller stop another's
+// profile — so titles must be non-empty.
+bool GetTitleArgument(const FunctionCallbackInfo<Value>& info,
+                      const char* usage) {
+  if (info.Length() < 1 || !info[0]->IsString() ||
+      info[0].As<String>()->Length() == 0) {
+    ThrowTypeError(info.GetIsolate(), usage);
+    return false;
+  }
+  return true;
+}
+
+// Output files are named by absolute path only: there is no working directory
+// on a device to resolve a relative one against.
+bool GetPathArgument(const FunctionCallbackInfo<Value>& info, int index,
+                     const char* function, std::string& path) {
+  Isolate* isolate = info.GetIsolate();
+  if (info.Length() > index && info[index]->IsString()) {
+    path = tns::ToString(isolate, info[index]);
+    if (!path.empty() && path[0] == '/') {
+      return true;
+    }
+  }
+  ThrowTypeError(isolate,
+                 std::string(function) + " expects an absolute file path");
+  return false;
+}
+
+// Reads an optional positive integer option. Leaves `value` untouched when the
+// options bag or the key is absent.
+bool GetPositiveIntegerOption(Local<Context> context, Local<Value> options,
+                              const char* function, const char* key,
+                              int64_t& value) {
+  Isolate* isolate = context->GetIsolate();
+  if (options.IsEmpty() || options->IsUndefined()) {
+    return true;
+  }
+  if (!options->IsObject()) {
+    ThrowTypeError(isolate,
+                   std::string(function) + ": options must be an object");
+    return false;
+  }
+  Local<Value> raw;
+  if (!options.As<Object>()
+           ->Get(context, tns::ToV8String(isolate, key))
+           .ToLocal(&raw)) {
+    return false;
+  }
+  if (raw->IsUndefined()) {
+    return true;
+  }
+  double number = raw->IsNumber() ? raw.As<Number>()->Value() : 0;
+  if (!(number >= 1 && number <= INT32_MAX) ||
+      number != static_cast<double>(static_cast<int64_t>(number))) {
+    ThrowTypeError(isolate, std::string(function) + ": '" + key +
+                                "' must be a positive integer");
+    return false;
+  }
+  value = static_cast<int64_t>(number);
+  return true;
+}
+
+// Reads options.categories: absent, or an array of non-empty strings.
+bool GetCategoriesOption(Local<Context> context, Local<Value> options,
+                         std::vector<std::string>& categories) {
+  Isolate* isolate = context->GetIsolate();
+  if (options.IsEmpty() || options->IsUndefined()) {
+    return true;
+  }
+  if (!options->IsObject()) {
+    ThrowTypeError(isolate, "startTrace: options must be an object");
+    return false;
+  }
+  Local<Value> raw;
+  if (!options.As<Object>()
+           ->Get(context, tns::ToV8String(isolate, "categories"))
+           .ToLocal(&raw)) {
+    return false;
+  }
+  if (raw->IsUndefined()) {
+    return true;
+  }
+  if (raw->IsArray()) {
+    Local<v8::Array> array = raw.As<v8::Array>();
+    for (uint32_t i = 0; i < array->Length(); i++) {
+      Local<Value> item;
+      if (!array->Get(context, i).ToLocal(&item)) {
+        return false;
+      }
+      if (!item->IsString() || item.As<String>()->Length() == 0) {
+        categories.clear();
+        break;
+      }
+      categories.push_back(tns::ToString(isolate, item));
+    }
+    if (categories.size() == array->Length()) {
+      return true;
+    }
+  }
+  ThrowTypeError(isolate,
+                 "startTrace: 'categories' must be an array of non-empty "
+                 "strings");
+  return false;
+}
+
+// Traces started from JS are process-wide, like the controller they record
+// through, so one agent serves every isolate.
+inspector::TracingAgentImpl* GetTraceAgent() {
+  static inspector::TracingAgentImpl* agent =
+      new inspector::TracingAgentImpl();
+  return agent;
+}
+
+void AppendJsonString(std::string& out, const std::string& value) {
+  out.push_back('"');
+  for (unsigned char c : value) {
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if (c < 0x20) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          out.append(escaped);
+        } else {
+          out.push_back(static_cast<char>(c));
+        }
+    }
+  }
+  out.push_back('"');
+}
+
+std::string ToStringOrEmpty(Isolate* isolate, Local<String> value) {
+  return value.IsEmpty() ? std::string() : tns::ToString(isolate, value);
+}
+
+// Writes one node of a sampling heap profile in DevTools'
+// HeapProfiler.SamplingHeapProfileNode shape. Each node is flushed before its
+// children are visited, so the file grows without the whole tree ever being
+// held as one string.
+bool WriteAllocationNode(Isolate* isolate, FileOutputStream& stream,
+                         const AllocationProfile::Node* node) {
+  size_t selfSize = 0;
+  for (const AllocationProfile::Allocation& allocation : node->allocations) {
+    selfSize += allocation.size * allocation.count;
+  }
+
+  std::string out = "{\"callFrame\":{\"functionName\":";
+  AppendJsonString(out, ToStringOrEmpty(isolate, node->name));
+  out.append(",\"scriptId\":\"");
+  out.append(std::to_string(node->script_id));
+  out.append("\",\"url\":");
+  AppendJsonString(out, ToStringOrEmpty(isolate, node->script_name));
+  // AllocationProfile positions are 1-based; DevTools call frames are 0-based.
+  out.append(",\"lineNumber\":");
+  out.append(std::to_string(node->line_number - 1));
+  out.append(",\"columnNumber\":");
+  out.append(std::to_string(node->column_number - 1));
+  out.append("},\"selfSize\":");
+  out.append(std::to_string(selfSize));
+  out.append(",\"id\":");
+  out.append(std::to_string(node->node_id));
+  out.append(",\"children\":[");
+  if (!stream.Write(out)) {
+    return false;
+  }
+
+  bool first = true;
+  for (const AllocationProfile::Node* child : node->children) {
+    if ((!first && !stream.Write(",", 1)) ||
+        !WriteAllocationNode(isolate, stream, child)) {
+      return false;
+    }
+    first = false;
+  }
+  return stream.Write("]}", 2);
+}
+
+bool WriteAllocationProfile(Isolate* isolate, FileOutputStream& stream,
+                            AllocationProfile* profile) {
+  HandleScope handleScope(isolate);
+  if (!stream.Write("{\"head\":", 8) ||
+      !WriteAllocationNode(isolate, stream, profile->GetRootNode()) ||
+      !stream.Write(",\"samples\":[", 12)) {
+    return false;
+  }
+  bool first = true;
+  for (const AllocationProfile::Sample& sample : profile->GetSamples()) {
+    std::string out = first ? "{\"size\":" : ",{\"size\":";
+    out.append(std::to_string(sample.size * sample.count));
+    out.append(",\"nodeId\":");
+    out.append(std::to_string(sample.node_id));
+    out.append(",\"ordinal\":");
+    out.append(std::to_string(sample.sample_id));
+    out.push_back('}');
+    if (!stream.Write(out)) {
+      return false;
+    }
+    first = false;
+  }
+  return stream.Write("]}", 2);
+}
+
+bool SetNumber(Local<Context> context, Local<Object> target, const char* key,
+               double value) {
+  Isolate* isolate = context->GetIsolate();
+  return target
+      ->Set(context, tns::ToV8String(isolate, key),
+            Number::New(isolate, value))
+      .FromMaybe(false);
+}
+
+}  // namespace
+
+FileOutputStream::FileOutputStream(const std::string& path) : path_(path) {
+  this->file_ = fopen(path.c_str(), "wb");
+  if (this->file_ == nullptr) {
+    this->error_ = errno;
+  }
+}
+
+FileOutputStream::~FileOutputStream() { this->Close(); }
+
+bool FileOutputStream::Close() {
+  if (this->file_ == nullptr) {
+    return this->error_ == 0;
+  }
+  if (fclose(this->file_) != 0 && this->error_ == 0) {
+    this->error_ = errno;
+  }
+  this->file_ = nullptr;
+  if (this->error_ != 0) {
+    remove(this->path_.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool FileOutputStream::Write(const char* data, size_t size) {
+  if (this->file_ == nullptr || this->error_ != 0) {
+    return false;
+  }
+  if (fwrite(data, 1, size, this->file_) != size) {
+    this->error_ = errno != 0 ? errno : EIO;
+    return false;
+  }
+  return true;
+}
+
+OutputStream::WriteResult FileOutputStream::WriteAsciiChunk(char* data,
+                                                            int size) {
+  return this->Write(data, static_cast<size_t>(size)) ? kContinue : kAbort;
+}
+
+bool Profiling::BuildBinding(Local<Context> context, Local<Object> binding) {
+  tns::SetMethod(context, binding, "startCpuProfile", StartCpuProfileCallback);
+  tns::SetMethod(context, binding, "stopCpuProfile", StopCpuProfileCallback);
+  tns::SetMethod(context, binding, "writeHeapSnapshot",
+                 WriteHeapSnapshotCallback);
+  tns::SetMethod(context, binding, "startHeapSampling",
+                 StartHeapSamplingCallback);
+  tns::SetMethod(context, binding, "stopHeapSampling",
+                 StopHeapSamplingCallback);
+  tns::SetMethodNoSideEffect(context, binding, "getHeapStatistics",
+                             GetHeapStatisticsCallback);
+  tns::SetMethodNoSideEffect(context, binding, "getHeapSpaceStatistics",
+                             GetHeapSpaceStatisticsCallback);
+  tns::SetMethodNoSideEffect(context, binding, "getProcessMemory",
+                             GetProcessMemoryCallback);
+  tns::SetMethod(context, binding, "startTrace", StartTraceCallback);
+  tns::SetMethod(context, binding, "stopTrace", StopTraceCallback);
+#ifdef NATIVESCRIPT_INTEROP_STATS
+  // Only builds with interop stats compiled in expose these; ns-perf.js
+  // re-exports them when present.
+  tns::SetMethod(context, binding, "enableInteropStats",
+                 EnableInteropStatsCallback);
+  tns::SetMethod(context, binding, "disableInteropStats",
+                 DisableInteropStatsCallback);
+  tns::SetMethodNoSideEffect(context, binding, "getInteropStats",
+                             GetInteropStatsCallback);
+  tns::SetMethod(context, binding, "resetInteropStats",
+                 ResetInteropStatsCallback);
+  tns::SetMethod(context, binding, "writeInteropStats",
+                 WriteInteropStatsCallback);
+#endif
+  return true;
+}
+
+void Profiling::StartCpuProfileCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  if (!GetTitleArgument(info,
+                        "startCpuProfile expects (title: string, options?)")) {
+    return;
+  }
+  int64_t samplingInterval = 0;
+  if (!GetPositiveIntegerOption(
+          context, info.Length() > 1 ? info[1] : Local<Value>(),
+          "startCpuProfile", "samplingIntervalMicros", samplingInterval)) {
+    return;
+  }
+
+  ProfilingState* state = GetState(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  if (state->cpuProfiler == nullptr) {
+    state->cpuProfiler = CpuProfiler::New(isolate);
+  }
+
+  // V8 records the individual samples and time deltas DevTools needs to draw
+  // a timeline only when max_samples is nonzero; with 0 it keeps just the
+  // call tree. kNoSampleLimit is the nonzero value that never drops samples.
+  CpuProfilingOptions options(kLeafNodeLineNumbers,
+                              CpuProfilingOptions::kNoSampleLimit,
+                              static_cast<int>(samplingInterval));
+  CpuProfilingResult result =
+      state->cpuProfiler->Start(info[0].As<String>(), std::move(options));
+  switch (result.status) {
+    case CpuProfilingStatus::kStarted:
+      return;
+    case CpuProfilingStatus::kAlreadyStarted:
+      ThrowError(isolate, "ns:perf: a CPU profile titled '" +
+                              tns::ToString(isolate, info[0]) +
+                              "' is already running");
+      return;
+    case CpuProfilingStatus::kErrorTooManyProfilers:
+      ThrowError(isolate, "ns:perf: too many CPU profiles are running");
+      return;
+  }
+}
+
+void Profiling::StopCpuProfileCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  if (!GetTitleArgument(info,
+                        "stopCpuProfile expects (title: string, path: "
+                        "string)")) {
+    return;
+  }
+  std::string path;
+  if (!GetPathArgument(info, 1, "stopCpuProfile", path)) {
+    return;
+  }
+
+  ProfilingState* state = GetState(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  CpuProfile* profile = nullptr;
+  if (state->cpuProfiler != nullptr) {
+    profile = state->cpuProfiler->StopProfiling(info[0].As<String>());
+  }
+  if (profile == nullptr) {
+    ThrowError(isolate, "ns:perf: no CPU profile titled '" +
+                            tns::ToString(isolate, info[0]) + "' is running");
+    return;
+  }
+
+  FileOutputStream stream(path);
+  if (stream.IsOpen()) {
+    profile->Serialize(&stream, CpuProfile::kJSON);
+  }
+  profile->Delete();
+  if (!stream.Close()) {
+    ThrowWriteError(isolate, path, stream.Error());
+    return;
+  }
+  info.GetReturnValue().Set(info[1]);
+}
+
+void Profiling::WriteHeapSnapshotCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  std::string path;
+  if (!GetPathArgument(info, 0, "writeHeapSnapshot", path)) {
+    return;
+  }
+
+  // Opened before the snapshot is taken: a bad path should fail fast rather
+  // than after a full heap walk.
+  FileOutputStream stream(path);
+  if (!stream.IsOpen()) {
+    ThrowWriteError(isolate, path, stream.Error());
+    return;
+  }
+
+  const HeapSnapshot* snapshot =
+      isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  if (snapshot == nullptr) {
+    stream.Close();
+    remove(path.c_str());
+    ThrowError(isolate, "ns:perf: the heap snapshot could not be taken");
+    return;
+  }
+  snapshot->Serialize(&stream, HeapSnapshot::kJSON);
+  const_cast<HeapSnapshot*>(snapshot)->Delete();
+  if (!stream.Close()) {
+    ThrowWriteError(isolate, path, stream.Error());
+    return;
+  }
+  info.GetReturnValue().Set(info[0]);
+}
+
+void Profiling::StartHeapSamplingCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  Local<Value> options = info.Length() > 0 ? info[0] : Local<Value>();
+  // V8's own defaults: one sample per 512 KiB allocated on average, stacks 16
+  // frames deep.
+  int64_t samplingInterval = 512 * 1024;
+  int64_t stackDepth = 16;
+  if (!GetPositiveIntegerOption(context, options, "startHeapSampling",
+                                "samplingInterval", samplingInterval) ||
+      !GetPositiveIntegerOption(context, options, "startHeapSampling",
+                                "stackDepth", stackDepth)) {
+    return;
+  }
+
+  ProfilingState* state = GetState(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  if (state->heapSampling) {
+    ThrowError(isolate, "ns:perf: heap sampling is already running");
+    return;
+  }
+  if (!isolate->GetHeapProfiler()->StartSamplingHeapProfiler(
+          static_cast<uint64_t>(samplingInterval),
+          static_cast<int>(stackDepth))) {
+    ThrowError(isolate, "ns:perf: heap sampling could not be started");
+    return;
+  }
+  state->heapSampling = true;
+}
+
+void Profiling::StopHeapSamplingCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  std::string path;
+  if (!GetPathArgument(info, 0, "stopHeapSampling", path)) {
+    return;
+  }
+
+  ProfilingState* state = GetState(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  if (!state->heapSampling) {
+    ThrowError(isolate, "ns:perf: heap sampling is not running");
+    return;
+  }
+
+  HeapProfiler* heapProfiler = isolate->GetHeapProfiler();
+  std::unique_ptr<AllocationProfile> profile(
+      heapProfiler->GetAllocationProfile());
+  heapProfiler->StopSamplingHeapProfiler();
+  state->heapSampling = false;
+  if (profile == nullptr) {
+    ThrowError(isolate,
+               "ns:perf: the sampling heap profile could not be collected");
+    return;
+  }
+
+  FileOutputStream stream(path);
+  if (stream.IsOpen()) {
+    WriteAllocationProfile(isolate, stream, profile.get());
+  }
+  if (!stream.Close()) {
+    ThrowWriteError(isolate, path, stream.Error());
+    return;
+  }
+  info.GetReturnValue().Set(info[0]);
+}
+
+// Key names follow Node's v8.getHeapStatistics() so existing telemetry code
+// reads them unchanged.
+void Profiling::GetHeapStatisticsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+
+  Local<Object> result = Object::New(isolate);
+  bool success =
+      SetNumber(context, result, "total_heap_size", stats.total_heap_size()) &&
+      SetNumber(context, result, "total_heap_size_executable",
+                stats.total_heap_size_executable()) &&
+      SetNumber(context, result, "total_physical_size",
+                stats.total_physical_size()) &&
+      SetNumber(context, result, "total_available_size",
+                stats.total_available_size()) &&
+      SetNumber(context, result, "used_heap_size", stats.used_heap_size()) &&
+      SetNumber(context, result, "heap_size_limit", stats.heap_size_limit()) &&
+      SetNumber(context, result, "malloced_memory", stats.malloced_memory()) &&
+      SetNumber(context, result, "peak_malloced_memory",
+                stats.peak_malloced_memory()) &&
+      SetNumber(context, result, "does_zap_garbage",
+                stats.does_zap_garbage()) &&
+      SetNumber(context, result, "number_of_native_contexts",
+                stats.number_of_native_contexts()) &&
+      SetNumber(context, result, "number_of_detached_contexts",
+                stats.number_of_detached_contexts()) &&
+      SetNumber(context, result, "total_global_handles_size",
+                stats.total_global_handles_size()) &&
+      SetNumber(context, result, "used_global_handles_size",
+                stats.used_global_handles_size()) &&
+      SetNumber(context, result, "external_memory", stats.external_memory());
+  if (success) {
+    info.GetReturnValue().Set(result);
+  }
+}
+
+void Profiling::GetHeapSpaceStatisticsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  size_t count = isolate->NumberOfHeapSpaces();
+  Local<v8::Array> result = v8::Array::New(isolate);
+  uint32_t index = 0;
+  for (size_t i = 0; i < count; i++) {
+    HeapSpaceStatistics stats;
+    if (!isolate->GetHeapSpaceStatistics(&stats, i)) {
+      continue;
+    }
+    Local<Object> space = Object::New(isolate);
+    bool success =
+        space
+            ->Set(context, tns::ToV8String(isolate, "space_name"),
+                  tns::ToV8String(isolate, stats.space_name()))
+            .FromMaybe(false) &&
+        SetNumber(context, space, "space_size", stats.space_size()) &&
+        SetNumber(context, space, "space_used_size",
+                  stats.space_used_size()) &&
+        SetNumber(context, space, "space_available_size",
+                  stats.space_available_size()) &&
+        SetNumber(context, space, "physical_space_size",
+                  stats.physical_space_size()) &&
+        result->Set(context, index++, space).FromMaybe(false);
+    if (!success) {
+      return;
+    }
+  }
+  info.GetReturnValue().Set(result);
+}
+
+// What the OS charges the process, which is what jetsam acts on:
+// phys_footprint rather than resident size, since compressed and swapped
+// pages still count against the app.
+void Profiling::GetProcessMemoryCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  task_vm_info_data_t vmInfo;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  kern_return_t status =
+      task_info(mach_task_self(), TASK_VM_INFO,
+                reinterpret_cast<task_info_t>(&vmInfo), &count);
+  if (status != KERN_SUCCESS) {
+    ThrowError(isolate, std::string("ns:perf: task_info failed: ") +
+                            mach_error_string(status));
+    return;
+  }
+
+  Local<Object> result = Object::New(isolate);
+  bool success =
+      SetNumber(context, result, "residentSize", vmInfo.resident_size) &&
+      SetNumber(context, result, "footprint", vmInfo.phys_footprint) &&
+      SetNumber(context, result, "peakFootprint",
+                vmInfo.ledger_phys_footprint_peak);
+  if (success) {
+    info.GetReturnValue().Set(result);
+  }
+}
+
+void Profiling::StartTraceCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  std::string path;
+  std::vector<std::string> categories;
+  if (!GetPathArgument(info, 0, "startTrace", path) ||
+      !GetCategoriesOption(context,
+                           info.Length() > 1 ? info[1] : Local<Value>(),
+                           categories)) {
+    return;
+  }
+  std::string error;
+  if (!GetTraceAgent()->startToFile(path, categories, error)) {
+    ThrowError(isolate, "ns:perf: " + error);
+  }
+}
+
+void Profiling::StopTraceCallback(const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  std::string path;
+  std::string error;
+  if (!GetTraceAgent()->endToFile(path, error)) {
+    ThrowError(isolate, "ns:perf: " + error);
+    return;
+  }
+  info.GetReturnValue().Set(tns::ToV8String(isolate, path));
+}
+
+#ifdef NATIVESCRIPT_INTEROP_STATS
+void Profiling::EnableInteropStatsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  InteropStats::SetEnabled(true);
+}
+
+void Profiling::DisableInteropStatsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  InteropStats::SetEnabled(false);
+}
+
+void Profiling::GetInteropStatsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Local<Object> result;
+  if (InteropStats::ToObject(info.GetIsolate()->GetCurrentContext())
+          .ToLocal(&result)) {
+    info.GetReturnValue().Set(result);
+  }
+}
+
+void Profiling::ResetInteropStatsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  InteropStats::Reset();
+}
+
+// Same shape as getInteropStats(). The merged stats are small (one entry per
+// distinct call site), so they are serialized in one piece.
+void Profiling::WriteInteropStatsCallback(
+    const FunctionCallbackInfo<Value>& info) {
+  Isolate* isolate = info.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  std::string path;
+  if (!GetPathArgument(info, 0, "writeInteropStats", path)) {
+    return;
+  }
+  Local<Object> stats;
+  Local<String> json;
+  if (!InteropStats::ToObject(context).ToLocal(&stats) ||
+      !JSON::Stringify(context, stats).ToLocal(&json)) {
+    return;
+  }
+
+  FileOutputStream stream(path);
+  stream.Write(tns::ToString(isolate, json));
+  if (!stream.Close()) {
+    ThrowWriteError(isolate, path, stream.Error());
+    return;
+  }
+  info.GetReturnValue().Set(info[0]);
+}
+#endif
+
+}  // namespace tns
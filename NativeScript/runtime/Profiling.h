@@ -0,0 +1,102 @@
+#ifndef Profiling_h
+#define Profiling_h
+
+#include <cstdio>
+#include <string>
+
+#include "Common.h"
+#include "v8-profiler.h"
+
+namespace tns {
+
+// A v8::OutputStream that writes every chunk straight to a file, so a
+// serialized profile or heap snapshot never has to exist in memory as a
+// whole: V8 hands over one chunk at a time and the chunk is gone once written.
+// A failed write aborts the serialization and the partial file is removed.
+class FileOutputStream : public v8::OutputStream {
+ public:
+  explicit FileOutputStream(const std::string& path);
+  ~FileOutputStream() override;
+
+  FileOutputStream(const FileOutputStream&) = delete;
+  FileOutputStream& operator=(const FileOutputStream&) = delete;
+
+  // False when the file could not be opened; Error() then holds the errno.
+  bool IsOpen() const { return file_ != nullptr; }
+
+  // Flushes and closes the file. Returns false — with the partial file removed
+  // and Error() set — when any write failed along the way.
+  bool Close();
+
+  int Error() const { return error_; }
+
+  void EndOfStream() override {}
+  int GetChunkSize() override { return kChunkSize; }
+  WriteResult WriteAsciiChunk(char* data, int size) override;
+
+  // Appends raw bytes outside of a V8 serialization (hand-written JSON).
+  bool Write(const char* data, size_t size);
+  bool Write(const std::string& data) {
+    return Write(data.data(), data.size());
+  }
+
+ private:
+  static constexpr int kChunkSize = 64 * 1024;
+
+  std::string path_;
+  FILE* file_ = nullptr;
+  int error_ = 0;
+};
+
+// The `ns:perf` builtin module: on-demand CPU profiles, heap snapshots,
+// sampling heap profiles, traces and heap statistics, written to disk in the
+// formats Chrome DevTools loads (.cpuprofile, .heapsnapshot, .heapprofile,
+// trace JSON), so a production build can be profiled without attaching the
+// inspector. See docs/ns-builtin-modules.md for the contract. Profilers are
+// per isolate: each worker profiles only its own heap and its own JS thread.
+// Traces are process-wide.
+class Profiling {
+ public:
+  // Populates the ns:perf binding bag with its natives. Returns false with an
+  // exception pending on failure.
+  static bool BuildBinding(v8::Local<v8::Context> context,
+                           v8::Local<v8::Object> binding);
+
+ private:
+  static void StartCpuProfileCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void StopCpuProfileCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void WriteHeapSnapshotCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void StartHeapSamplingCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void StopHeapSamplingCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetHeapStatisticsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetHeapSpaceStatisticsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetProcessMemoryCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void StartTraceCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void StopTraceCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+#ifdef NATIVESCRIPT_INTEROP_STATS
+  static void EnableInteropStatsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void DisableInteropStatsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetInteropStatsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void ResetInteropStatsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void WriteInteropStatsCallback(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+#endif
+};
+
+}  // namespace tns
+
+#endif /* Profiling_h */
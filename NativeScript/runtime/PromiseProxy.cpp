@@ -1,8 +1,9 @@
 #include "PromiseProxy.h"
 
-#include <CoreFoundation/CoreFoundation.h>
+#include <pthread.h>
 
-#include "BuiltinLoader.h"
+#include "Caches.h"
+#include "EventLoop.h"
 #include "Helpers.h"
 #include "Runtime.h"
 
@@ -10,37 +11,111 @@ using namespace v8;
 
 namespace tns {
 
-// Reports whether the calling thread runs the isolate's runtime loop. That loop
-// is where timers fire and is always being pumped, so a promise resolution is
-// marshaled back to its creating thread only when that thread is the runtime
-// loop; a promise created elsewhere settles on whichever thread resolves it.
-static void IsRuntimeRunloopCallback(const FunctionCallbackInfo<Value>& args) {
-  Runtime* runtime = Runtime::GetRuntime(args.GetIsolate());
-  bool isRuntimeLoop =
-      runtime != nullptr && CFRunLoopGetCurrent() == runtime->RuntimeLoop();
-  args.GetReturnValue().Set(isRuntimeLoop);
+namespace {
+
+// Per-isolate (Caches::StateFor). The runtime loop's thread is recorded once,
+// at init, so telling a foreign thread apart is a pthread_equal per call.
+struct PromiseAffinityState {
+  pthread_t originThread;
+  // Marks promises created by script entered from a foreign thread. Any
+  // promise without it was created on the runtime loop.
+  Global<Private> foreignOrigin;
+  // Set while script entered from a foreign thread holds the isolate.
+  bool deferring = false;
+  // Set when that script resolved or rejected a promise created on the loop.
+  bool resolvedLoopPromise = false;
+  // Set while the reactions of a foreign call run on its own thread.
+  bool draining = false;
+};
+
+// Installed only while script entered from a foreign thread runs, so promises
+// on the runtime loop pay nothing for it.
+void ForeignThreadPromiseHook(PromiseHookType type, Local<Promise> promise,
+                              Local<Value> parent) {
+  if (type != PromiseHookType::kInit && type != PromiseHookType::kResolve) {
+    return;
+  }
+  Isolate* isolate = promise->GetIsolate();
+  PromiseAffinityState* state =
+      Caches::StateFor<PromiseAffinityState>(isolate);
+  if (state == nullptr) {
+    return;
+  }
+  Local<Context> context = isolate->GetCurrentContext();
+  Local<Private> foreignOrigin = state->foreignOrigin.Get(isolate);
+  if (type == PromiseHookType::kInit) {
+    promise->SetPrivate(context, foreignOrigin, v8::True(isolate)).FromMaybe(false);
+  } else if (!promise->HasPrivate(context, foreignOrigin).FromMaybe(true)) {
+    state->resolvedLoopPromise = true;
+  }
+}
+
+// Fires on every entry into script. Entering from a thread other than the
+// runtime loop's switches the microtask queue to explicit, so the depth-0
+// checkpoint V8 would otherwise run on that thread waits for CallCompleted to
+// decide where it runs, and watches which promises that script settles.
+void BeforeCallEntered(Isolate* isolate) {
+  PromiseAffinityState* state =
+      Caches::StateFor<PromiseAffinityState>(isolate);
+  if (state == nullptr || state->deferring ||
+      pthread_equal(pthread_self(), state->originThread)) {
+    return;
+  }
+  state->deferring = true;
+  state->resolvedLoopPromise = false;
+  isolate->SetMicrotasksPolicy(MicrotasksPolicy::kExplicit);
+  isolate->SetPromiseHook(ForeignThreadPromiseHook);
+}
+
+// Fires when the outermost foreign call returns. Promises created on a
+// foreign thread settle there, as promise-proxy.js had them: that thread's run
+// loop may be dormant, and the loop may itself be blocked waiting on it. Only
+// when the call resolved or rejected a promise created on the runtime loop is
+// the checkpoint posted to the loop, which is always being pumped. The queue
+// is shared, so reactions queued by the same call go along with it.
+void CallCompleted(Isolate* isolate) {
+  PromiseAffinityState* state =
+      Caches::StateFor<PromiseAffinityState>(isolate);
+  if (state == nullptr || !state->deferring || state->draining) {
+    return;
+  }
+
+  Runtime* runtime = Runtime::GetRuntime(isolate);
+  bool marshal = state->resolvedLoopPromise && runtime != nullptr &&
+                 runtime->GetEventLoop() != nullptr;
+  if (!marshal) {
+    // Script that the reactions call into is part of this drain, not a new
+    // foreign call. A loop promise settled by one of them has its reactions
+    // run here too: the drain cannot be split.
+    state->draining = true;
+    isolate->PerformMicrotaskCheckpoint();
+    state->draining = false;
+  }
+
+  isolate->SetPromiseHook(nullptr);
+  isolate->SetMicrotasksPolicy(MicrotasksPolicy::kAuto);
+  state->deferring = false;
+  state->resolvedLoopPromise = false;
+  if (marshal) {
+    // Every internal-lane entry ends in a microtask checkpoint.
+    runtime->GetEventLoop()->PostInternal([]() {});
+  }
 }
 
+}  // namespace
+
 void PromiseProxy::Init(v8::Local<v8::Context> context) {
   Isolate* isolate = v8::Isolate::GetCurrent();
 
-  Local<v8::Function> isRuntimeRunloop;
-  bool success = v8::Function::New(context, IsRuntimeRunloopCallback)
-                     .ToLocal(&isRuntimeRunloop);
-  tns::Assert(success, isolate);
-
-  Local<Object> binding = Object::New(isolate);
-  success = binding
-                ->Set(context, tns::ToV8String(isolate, "isRuntimeRunloop"),
-                      isRuntimeRunloop)
-                .FromMaybe(false);
-  tns::Assert(success, isolate);
-
-  Local<Value> result;
-  success =
-      BuiltinLoader::RunBuiltin(context, BuiltinId::kPromiseProxy, binding)
-          .ToLocal(&result);
-  tns::Assert(success, isolate);
+  PromiseAffinityState* state =
+      Caches::StateFor<PromiseAffinityState>(isolate);
+  tns::Assert(state != nullptr, isolate);
+  state->originThread = pthread_self();
+  state->foreignOrigin.Reset(
+      isolate, Private::New(isolate, tns::ToV8String(isolate, "tns::foreignPromiseOrigin")));
+
+  isolate->AddBeforeCallEnteredCallback(BeforeCallEntered);
+  isolate->AddCallCompletedCallback(CallCompleted);
 }
 
 }  // namespace tns
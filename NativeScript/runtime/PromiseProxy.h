@@ -5,6 +5,12 @@
 
 namespace tns {
 
+// Keeps the reactions of promises created on the runtime loop on that loop.
+// When script entered from another thread (a native callback on a background
+// queue, say) resolves or rejects such a promise, the microtask checkpoint is
+// posted to the runtime loop instead of running where it is, as if the promise
+// were resolved from the loop. Promises created on other threads settle on the
+// thread that resolves them. Promise itself stays the untouched intrinsic.
 class PromiseProxy {
 public:
     static void Init(v8::Local<v8::Context> context);
@@ -57,7 +57,7 @@ Local<v8::Function> Reference::GetInteropReferenceCtorFunc(
       IndexedPropertyHandlerConfiguration(IndexedPropertyGetCallback,
                                           IndexedPropertySetCallback));
   Local<ObjectTemplate> proto = ctorFuncTemplate->PrototypeTemplate();
-  proto->SetAccessorProperty(tns::ToV8String(isolate, "value"),
+  proto->SetAccessorProperty(tns::Keys::Value(isolate),
                              FunctionTemplate::New(isolate, GetValueCallback),
                              FunctionTemplate::New(isolate, SetValueCallback));
 
@@ -68,7 +68,7 @@ Local<v8::Function> Reference::GetInteropReferenceCtorFunc(
 
   tns::SetValue(isolate, ctorFunc, new ReferenceTypeWrapper());
   Local<Value> prototypeValue;
-  bool success = ctorFunc->Get(context, tns::ToV8String(isolate, "prototype"))
+  bool success = ctorFunc->Get(context, tns::Keys::Prototype(isolate))
                      .ToLocal(&prototypeValue);
   tns::Assert(success && prototypeValue->IsObject(), isolate);
   Local<Object> prototype = prototypeValue.As<Object>();
@@ -391,7 +391,7 @@ void Reference::RegisterToStringMethod(Local<Context> context,
   tns::Assert(funcTemplate->GetFunction(context).ToLocal(&func), isolate);
 
   bool success =
-      prototype->Set(context, tns::ToV8String(isolate, "toString"), func)
+      prototype->Set(context, tns::Keys::ToString(isolate), func)
           .FromMaybe(false);
   tns::Assert(success, isolate);
 }
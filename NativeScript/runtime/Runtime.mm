@@ -12,6 +12,7 @@
 #include "InlineFunctions.h"
 #include "Interop.h"
 #include "IsolateTracked.h"
+#include "MetadataProfile.h"
 #include "NativeScriptException.h"
 #include "NativeScriptPlatform.h"
 #include "ObjectManager.h"
@@ -212,6 +213,7 @@ void Runtime::Initialize() {
   // Before anything worth tracing runs, so NS_DEBUG covers boot itself.
   tns::InitializeLogCategoriesFromEnvironment();
   MetaFile::setInstance(RuntimeConfig.MetadataPtr);
+  MetadataProfile::Init();
 }
 
 Runtime::Runtime() {
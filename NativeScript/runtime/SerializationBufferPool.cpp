@@ -0,0 +1,78 @@
+#include "SerializationBufferPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace tns {
+namespace serialization {
+
+namespace {
+
+// Small enough that a typical message never regrows, and that a full pool
+// (kMaxPooledBuffers of the largest kept size) stays around a megabyte.
+constexpr size_t kMinimumBufferSize = 1024;
+constexpr size_t kMaxPooledBufferSize = 128 * 1024;
+constexpr size_t kMaxPooledBuffers = 8;
+
+struct PooledBuffer {
+  uint8_t* data;
+  size_t capacity;
+};
+
+std::mutex bufferPoolMutex;
+std::vector<PooledBuffer> bufferPool;
+
+}  // namespace
+
+uint8_t* SerializationBufferPool::Acquire(size_t minimumSize,
+                                          size_t* capacity) {
+  {
+    std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    // Most recently released first: the likeliest to still be in cache.
+    for (auto it = bufferPool.rbegin(); it != bufferPool.rend(); ++it) {
+      if (it->capacity >= minimumSize) {
+        PooledBuffer buffer = *it;
+        bufferPool.erase(std::next(it).base());
+        *capacity = buffer.capacity;
+        return buffer.data;
+      }
+    }
+  }
+
+  size_t size = std::max(minimumSize, kMinimumBufferSize);
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(size));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  *capacity = size;
+  return data;
+}
+
+uint8_t* SerializationBufferPool::Grow(uint8_t* buffer, size_t newSize,
+                                       size_t* capacity) {
+  uint8_t* data = static_cast<uint8_t*>(std::realloc(buffer, newSize));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  *capacity = newSize;
+  return data;
+}
+
+void SerializationBufferPool::Release(uint8_t* buffer, size_t capacity) {
+  if (buffer == nullptr) {
+    return;
+  }
+  if (capacity <= kMaxPooledBufferSize) {
+    std::lock_guard<std::mutex> lock(bufferPoolMutex);
+    if (bufferPool.size() < kMaxPooledBuffers) {
+      bufferPool.push_back({buffer, capacity});
+      return;
+    }
+  }
+  std::free(buffer);
+}
+
+}  // namespace serialization
+}  // namespace tns
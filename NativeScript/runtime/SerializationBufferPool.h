@@ -0,0 +1,26 @@
+#ifndef SerializationBufferPool_h
+#define SerializationBufferPool_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tns {
+namespace serialization {
+
+// Serialization output buffers are recycled through a small process-wide pool
+// rather than malloc'ed per message. Messages are written on one thread and
+// read on another, so the pool is shared and locked; only modest blocks are
+// kept, so one huge message does not pin its buffer forever.
+class SerializationBufferPool {
+ public:
+  // A block of at least `minimumSize` bytes; its real size goes to `capacity`.
+  static uint8_t* Acquire(size_t minimumSize, size_t* capacity);
+  // realloc() for a block from Acquire. Null (with `buffer` intact) on failure.
+  static uint8_t* Grow(uint8_t* buffer, size_t newSize, size_t* capacity);
+  static void Release(uint8_t* buffer, size_t capacity);
+};
+
+}  // namespace serialization
+}  // namespace tns
+
+#endif /* SerializationBufferPool_h */
@@ -1,5 +1,7 @@
 #include "StructuredSerialization.h"
 
+#include "Caches.h"
+#include "FastSerialization.h"
 #include "Helpers.h"
 #include "NativeScriptException.h"
 
@@ -15,24 +17,104 @@ void ThrowDataCloneError(Isolate* isolate, const std::string& message) {
 
 namespace {
 
+// Per-isolate (Caches::StateFor): the prototypes the fast path checks values
+// against, captured the first time either direction runs.
+struct SerializationState {
+  Global<Value> objectPrototype;
+  Global<Value> arrayPrototype;
+};
+
+PlainPrototypes GetPlainPrototypes(Isolate* isolate) {
+  PlainPrototypes prototypes;
+  SerializationState* state = Caches::StateFor<SerializationState>(isolate);
+  if (state == nullptr) {
+    return prototypes;
+  }
+  if (state->objectPrototype.IsEmpty()) {
+    state->objectPrototype.Reset(isolate, Object::New(isolate)->GetPrototype());
+    state->arrayPrototype.Reset(isolate,
+                                v8::Array::New(isolate)->GetPrototype());
+  }
+  prototypes.object = state->objectPrototype.Get(isolate);
+  prototypes.array = state->arrayPrototype.Get(isolate);
+  return prototypes;
+}
+
+// Native wrappers from the transfer list, in list order, each paired with the
+// handle captured for it.
+using NativeTransfers =
+    std::vector<std::pair<Local<Object>, std::unique_ptr<NativeHandle>>>;
+
 class SerializerDelegate : public ValueSerializer::Delegate {
  public:
   SerializerDelegate(Isolate* isolate, HostObjectPolicy hostObjectPolicy,
-                     std::vector<std::shared_ptr<BackingStore>>* sharedBuffers)
+                     std::vector<std::shared_ptr<BackingStore>>* sharedBuffers,
+                     const NativeTransfers* nativeTransfers)
       : isolate_(isolate),
         hostObjectPolicy_(hostObjectPolicy),
-        sharedBuffers_(sharedBuffers) {}
+        sharedBuffers_(sharedBuffers),
+        nativeTransfers_(nativeTransfers) {}
+
+  void SetSerializer(ValueSerializer* serializer) { serializer_ = serializer; }
+
+  // The capacity of the block the serializer currently writes into, which
+  // Release() does not report but the pool needs back.
+  size_t BufferCapacity() const { return capacity_; }
+
+  void* ReallocateBufferMemory(void* oldBuffer, size_t size,
+                               size_t* actualSize) override {
+    uint8_t* buffer =
+        oldBuffer == nullptr
+            ? SerializationBufferPool::Acquire(size, actualSize)
+            : SerializationBufferPool::Grow(static_cast<uint8_t*>(oldBuffer),
+                                            size, actualSize);
+    if (buffer != nullptr) {
+      capacity_ = *actualSize;
+    }
+    return buffer;
+  }
+
+  void FreeBufferMemory(void* buffer) override {
+    SerializationBufferPool::Release(static_cast<uint8_t*>(buffer), capacity_);
+  }
 
   void ThrowDataCloneError(Local<v8::String> message) override {
     serialization::ThrowDataCloneError(isolate_,
                                        tns::ToString(isolate_, message));
   }
 
+  // V8 on its own only treats objects with internal fields as host objects;
+  // wrappers that keep theirs in a private (structs, for one) would otherwise
+  // be written as plain objects even when named in the transfer list.
+  bool HasCustomHostObject(Isolate* isolate) override {
+    return !nativeTransfers_->empty();
+  }
+
+  Maybe<bool> IsHostObject(Isolate* isolate, Local<Object> object) override {
+    if (object->InternalFieldCount() > 0) {
+      return Just(true);
+    }
+    for (const auto& entry : *nativeTransfers_) {
+      if (entry.first == object) {
+        return Just(true);
+      }
+    }
+    return Just(false);
+  }
+
   Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object) override {
     if (hostObjectPolicy_ == HostObjectPolicy::kDegrade) {
-      // V8 has already written the kHostObject tag; writing no payload is what
-      // the zero-byte ReadHostObject below expects, and the value surfaces as
-      // an empty object.
+      // V8 has already written the kHostObject tag. The payload is 1 + the
+      // index of the object's native handle, or 0 for a wrapper that was not
+      // in the transfer list: that one surfaces as an empty object.
+      uint32_t id = 0;
+      for (size_t i = 0; i < nativeTransfers_->size(); i++) {
+        if ((*nativeTransfers_)[i].first == object) {
+          id = static_cast<uint32_t>(i + 1);
+          break;
+        }
+      }
+      serializer_->WriteUint32(id);
       return Just(true);
     }
     std::string name = tns::ToString(isolate, object->GetConstructorName());
@@ -70,18 +152,34 @@ class SerializerDelegate : public ValueSerializer::Delegate {
   Isolate* isolate_;
   HostObjectPolicy hostObjectPolicy_;
   std::vector<std::shared_ptr<BackingStore>>* sharedBuffers_;
+  const NativeTransfers* nativeTransfers_;
+  ValueSerializer* serializer_ = nullptr;
+  size_t capacity_ = 0;
 };
 
 class DeserializerDelegate : public ValueDeserializer::Delegate {
  public:
-  explicit DeserializerDelegate(
-      const std::vector<Local<SharedArrayBuffer>>* sharedBuffers)
-      : sharedBuffers_(sharedBuffers) {}
+  DeserializerDelegate(
+      const std::vector<Local<SharedArrayBuffer>>* sharedBuffers,
+      const std::vector<std::unique_ptr<NativeHandle>>* nativeHandles)
+      : sharedBuffers_(sharedBuffers), nativeHandles_(nativeHandles) {}
 
-  // Counterpart of the kDegrade branch: consumes no bytes, so the stream stays
-  // balanced. Unreachable for a value written under kReject.
+  void SetDeserializer(ValueDeserializer* deserializer) {
+    deserializer_ = deserializer;
+  }
+
+  // Counterpart of the kDegrade branch. Unreachable for a value written under
+  // kReject.
   MaybeLocal<Object> ReadHostObject(Isolate* isolate) override {
-    return Object::New(isolate);
+    uint32_t id;
+    if (!deserializer_->ReadUint32(&id) || id > nativeHandles_->size()) {
+      ThrowDataCloneError(isolate, "Unable to deserialize cloned data.");
+      return MaybeLocal<Object>();
+    }
+    if (id == 0) {
+      return Object::New(isolate);
+    }
+    return (*nativeHandles_)[id - 1]->Rebuild(isolate->GetCurrentContext());
   }
 
   MaybeLocal<SharedArrayBuffer> GetSharedArrayBufferFromId(
@@ -94,15 +192,21 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
 
  private:
   const std::vector<Local<SharedArrayBuffer>>* sharedBuffers_;
+  const std::vector<std::unique_ptr<NativeHandle>>* nativeHandles_;
+  ValueDeserializer* deserializer_ = nullptr;
 };
 
 // Validates the transfer list and collects it in registration order. The
 // detached and detachable checks are load-bearing rather than defensive:
 // ArrayBuffer::Detach() aborts the process on a non-detachable buffer instead
-// of reporting failure.
+// of reporting failure. Native wrappers are accepted only under kDegrade
+// (worker messaging), and are captured here so an object that may not cross
+// threads is refused before anything is detached.
 bool CollectTransferList(Isolate* isolate, Local<Context> context,
                          Local<Value> transferList,
-                         std::vector<Local<ArrayBuffer>>& transfers) {
+                         HostObjectPolicy hostObjectPolicy,
+                         std::vector<Local<ArrayBuffer>>& transfers,
+                         NativeTransfers& nativeTransfers) {
   if (transferList.IsEmpty() || transferList->IsUndefined() ||
       transferList->IsNull()) {
     return true;
@@ -121,6 +225,24 @@ bool CollectTransferList(Isolate* isolate, Local<Context> context,
     if (!list->Get(context, i).ToLocal(&item)) {
       return false;
     }
+    if (hostObjectPolicy == HostObjectPolicy::kDegrade &&
+        NativeHandle::IsNativeWrapper(isolate, item)) {
+      Local<Object> object = item.As<Object>();
+      for (const auto& existing : nativeTransfers) {
+        if (existing.first == object) {
+          ThrowDataCloneError(
+              isolate, "The transfer list contains the same object twice");
+          return false;
+        }
+      }
+      std::unique_ptr<NativeHandle> handle =
+          NativeHandle::Capture(isolate, object);
+      if (handle == nullptr) {
+        return false;
+      }
+      nativeTransfers.emplace_back(object, std::move(handle));
+      continue;
+    }
     if (!item->IsArrayBuffer()) {
       ThrowDataCloneError(isolate,
                           "A value in the transfer list is not transferable");
@@ -158,12 +280,37 @@ Maybe<bool> SerializedValue::Serialize(Isolate* isolate, Local<Context> context,
   tns::Assert(buffer_ == nullptr, isolate);
 
   std::vector<Local<ArrayBuffer>> transfers;
-  if (!CollectTransferList(isolate, context, transferList, transfers)) {
+  NativeTransfers nativeTransfers;
+  if (!CollectTransferList(isolate, context, transferList, hostObjectPolicy,
+                           transfers, nativeTransfers)) {
     return Nothing<bool>();
   }
 
-  SerializerDelegate delegate(isolate, hostObjectPolicy, &sharedBuffers_);
+  // Nothing to move or share: flat data can skip V8's serializer. Anything the
+  // fast path does not cover falls through unchanged.
+  if (transfers.empty() && nativeTransfers.empty()) {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    Maybe<bool> fast =
+        TryFastSerialize(isolate, context, GetPlainPrototypes(isolate), input,
+                         &data, &size, &capacity);
+    if (fast.IsNothing()) {
+      return Nothing<bool>();
+    }
+    if (fast.FromJust()) {
+      buffer_ = std::unique_ptr<uint8_t, PoolDeleter>(data,
+                                                      PoolDeleter{capacity});
+      bufferSize_ = size;
+      format_ = Format::kFast;
+      return Just(true);
+    }
+  }
+
+  SerializerDelegate delegate(isolate, hostObjectPolicy, &sharedBuffers_,
+                              &nativeTransfers);
   ValueSerializer serializer(isolate, &delegate);
+  delegate.SetSerializer(&serializer);
   for (size_t i = 0; i < transfers.size(); i++) {
     serializer.TransferArrayBuffer(static_cast<uint32_t>(i), transfers[i]);
   }
@@ -174,7 +321,8 @@ Maybe<bool> SerializedValue::Serialize(Isolate* isolate, Local<Context> context,
   // Release() hands ownership over whether or not the write succeeded, so the
   // buffer is claimed either way rather than leaking with the serializer.
   std::pair<uint8_t*, size_t> data = serializer.Release();
-  std::unique_ptr<uint8_t, FreeDeleter> owned(data.first);
+  std::unique_ptr<uint8_t, PoolDeleter> owned(
+      data.first, PoolDeleter{delegate.BufferCapacity()});
   if (!written) {
     return Nothing<bool>();
   }
@@ -196,6 +344,9 @@ Maybe<bool> SerializedValue::Serialize(Isolate* isolate, Local<Context> context,
     }
     transferredBuffers_.push_back(std::move(backingStore));
   }
+  for (auto& entry : nativeTransfers) {
+    nativeHandles_.push_back(std::move(entry.second));
+  }
 
   buffer_ = std::move(owned);
   bufferSize_ = data.second;
@@ -207,14 +358,28 @@ MaybeLocal<Value> SerializedValue::Deserialize(Isolate* isolate,
   Context::Scope contextScope(context);
   EscapableHandleScope handleScope(isolate);
 
+  if (format_ == Format::kFast) {
+    Local<Value> result;
+    if (!FastDeserialize(isolate, context, GetPlainPrototypes(isolate),
+                         buffer_.get(), bufferSize_)
+             .ToLocal(&result)) {
+      if (!isolate->IsExecutionTerminating()) {
+        ThrowDataCloneError(isolate, "Unable to deserialize cloned data.");
+      }
+      return MaybeLocal<Value>();
+    }
+    return handleScope.Escape(result);
+  }
+
   std::vector<Local<SharedArrayBuffer>> sharedBuffers;
   for (const std::shared_ptr<BackingStore>& backingStore : sharedBuffers_) {
     sharedBuffers.push_back(SharedArrayBuffer::New(isolate, backingStore));
   }
 
-  DeserializerDelegate delegate(&sharedBuffers);
+  DeserializerDelegate delegate(&sharedBuffers, &nativeHandles_);
   ValueDeserializer deserializer(isolate, buffer_.get(), bufferSize_,
                                  &delegate);
+  delegate.SetDeserializer(&deserializer);
 
   for (size_t i = 0; i < transferredBuffers_.size(); i++) {
     deserializer.TransferArrayBuffer(
@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "Common.h"
+#include "NativeTransfer.h"
+#include "SerializationBufferPool.h"
 
 namespace tns {
 namespace serialization {
@@ -22,7 +24,8 @@ enum class HostObjectPolicy {
   // Worker postMessage: the value arrives as an empty object. This is what the
   // runtime has always shipped and what the cross-runtime worker suite asserts;
   // moving it to kReject is a breaking change both runtimes have to make
-  // together.
+  // together. Wrappers named in the transfer list are the opt-in exception:
+  // they cross by handle (see NativeHandle).
   kDegrade,
 };
 
@@ -44,9 +47,11 @@ class SerializedValue {
   SerializedValue& operator=(const SerializedValue&) = delete;
 
   // Serializes `input`, moving out of this isolate every ArrayBuffer named by
-  // `transferList` (an Array, or undefined/null for none). Returns Nothing with
-  // an exception pending: a TypeError when the transfer list is not an Array, a
-  // DataCloneError for anything wrong with its entries or with the value.
+  // `transferList` (an Array, or undefined/null for none). Under kDegrade the
+  // list may also name native wrappers, which are sent by handle. Returns
+  // Nothing with an exception pending: a TypeError when the transfer list is
+  // not an Array, a DataCloneError for anything wrong with its entries or with
+  // the value.
   v8::Maybe<bool> Serialize(v8::Isolate* isolate,
                             v8::Local<v8::Context> context,
                             v8::Local<v8::Value> input,
@@ -59,19 +64,30 @@ class SerializedValue {
                                         v8::Local<v8::Context> context);
 
  private:
-  struct FreeDeleter {
-    void operator()(void* pointer) const { std::free(pointer); }
+  struct PoolDeleter {
+    size_t capacity = 0;
+    void operator()(uint8_t* buffer) const {
+      SerializationBufferPool::Release(buffer, capacity);
+    }
   };
 
-  // The serializer grows this with realloc() through its delegate's default
-  // allocator, so it is free()d rather than deleted.
-  std::unique_ptr<uint8_t, FreeDeleter> buffer_;
+  // How buffer_ is encoded: V8's wire format, or the compact one
+  // FastSerialization.h writes for flat, primitive-only values.
+  enum class Format : uint8_t { kV8, kFast };
+
+  // Taken from SerializationBufferPool, by the serializer's delegate or by the
+  // fast path, and handed back to it when the value goes away.
+  std::unique_ptr<uint8_t, PoolDeleter> buffer_;
   size_t bufferSize_ = 0;
+  Format format_ = Format::kV8;
   // Backing stores moved out of the sending isolate. Each is re-wrapped in a
   // fresh ArrayBuffer under the same transfer id on the receiving side.
   std::vector<std::shared_ptr<v8::BackingStore>> transferredBuffers_;
   // Backing stores shared with — not moved from — the sending isolate.
   std::vector<std::shared_ptr<v8::BackingStore>> sharedBuffers_;
+  // Native objects named in the transfer list, indexed by the id written in
+  // place of each host object.
+  std::vector<std::unique_ptr<NativeHandle>> nativeHandles_;
 };
 
 }  // namespace serialization
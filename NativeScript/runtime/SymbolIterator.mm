@@ -44,7 +44,7 @@ Local<Object> SymbolIterator::CreateIteratorObject(Local<Context> context, Local
   Local<v8::Function> next;
   success = v8::Function::New(context, NextCallback).ToLocal(&next);
   tns::Assert(success, isolate);
-  success = result->Set(context, tns::ToV8String(isolate, "next"), next).FromMaybe(false);
+  success = result->Set(context, tns::Keys::Next(isolate), next).FromMaybe(false);
   tns::Assert(success, isolate);
 
   return result;
@@ -74,10 +74,10 @@ void SymbolIterator::NextCallback(const v8::FunctionCallbackInfo<v8::Value>& arg
 
   if (index >= [target count]) {
     bool success =
-        obj->Set(context, tns::ToV8String(isolate, "done"), v8::Boolean::New(isolate, true))
+        obj->Set(context, tns::Keys::Done(isolate), v8::Boolean::New(isolate, true))
             .FromMaybe(false);
     tns::Assert(success, isolate);
-    success = obj->Set(context, tns::ToV8String(isolate, "value"), v8::Undefined(isolate))
+    success = obj->Set(context, tns::Keys::Value(isolate), v8::Undefined(isolate))
                   .FromMaybe(false);
     tns::Assert(success, isolate);
   } else {
@@ -94,10 +94,10 @@ void SymbolIterator::NextCallback(const v8::FunctionCallbackInfo<v8::Value>& arg
     }
 
     bool success =
-        obj->Set(context, tns::ToV8String(isolate, "done"), v8::Boolean::New(isolate, false))
+        obj->Set(context, tns::Keys::Done(isolate), v8::Boolean::New(isolate, false))
             .FromMaybe(false);
     tns::Assert(success, isolate);
-    success = obj->Set(context, tns::ToV8String(isolate, "value"), val).FromMaybe(false);
+    success = obj->Set(context, tns::Keys::Value(isolate), val).FromMaybe(false);
     tns::Assert(success, isolate);
 
     index++;
@@ -0,0 +1,138 @@
+#include "Tracing.h"
+
+#include "NativeScriptPlatform.h"
+
+using namespace v8;
+
+namespace tns {
+
+namespace {
+
+// From V8's trace_event_common.h, which is not part of the public headers.
+constexpr char kPhaseComplete = 'X';
+constexpr char kPhaseInstant = 'I';
+constexpr uint8_t kValueTypeInt = 3;
+constexpr uint8_t kValueTypeCopyString = 7;
+constexpr uint8_t kValueTypeNone = 0;
+
+const char* const kCategoryNames[] = {
+    "ns.module", "ns.interop", "ns.gc", "ns.eventloop", "ns.worker",
+};
+static_assert(sizeof(kCategoryNames) / sizeof(kCategoryNames[0]) ==
+                  static_cast<size_t>(TraceCategory::Count),
+              "every TraceCategory needs a name");
+
+// Stands in for a category's flag until the platform exists.
+const uint8_t kDisabled = 0;
+
+TracingController* GetController() {
+  NativeScriptPlatform* platform = NativeScriptPlatform::Instance();
+  return platform != nullptr ? platform->GetTracingController() : nullptr;
+}
+
+uint64_t ToArgValue(const char* value) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+}
+
+}  // namespace
+
+std::atomic<const uint8_t*>
+    Tracing::flags_[static_cast<int>(TraceCategory::Count)] = {};
+
+const char* Tracing::CategoryName(TraceCategory category) {
+  return kCategoryNames[static_cast<int>(category)];
+}
+
+// The controller hands out one flag byte per category for the life of the
+// process and flips it as traces start and stop, so it is looked up once.
+const uint8_t* Tracing::ResolveCategoryFlag(TraceCategory category) {
+  TracingController* controller = GetController();
+  if (controller == nullptr) {
+    return &kDisabled;
+  }
+  const uint8_t* flag =
+      controller->GetCategoryGroupEnabled(CategoryName(category));
+  flags_[static_cast<int>(category)].store(flag, std::memory_order_release);
+  return flag;
+}
+
+uint64_t Tracing::AddEvent(char phase, const uint8_t* flag, const char* name,
+                           const char* argName, uint8_t argType,
+                           uint64_t argValue) {
+  TracingController* controller = GetController();
+  if (controller == nullptr) {
+    return 0;
+  }
+  const char* argNames[] = {argName};
+  const uint8_t argTypes[] = {argType};
+  const uint64_t argValues[] = {argValue};
+  return controller->AddTraceEvent(
+      phase, flag, name, nullptr, 0, 0, argName != nullptr ? 1 : 0, argNames,
+      argTypes, argValues, nullptr, 0);
+}
+
+void Tracing::UpdateDuration(const uint8_t* flag, const char* name,
+                             uint64_t handle) {
+  if (TracingController* controller = GetController()) {
+    controller->UpdateTraceEventDuration(flag, name, handle);
+  }
+}
+
+void Tracing::Instant(TraceCategory category, const char* name) {
+  const uint8_t* flag = CategoryFlag(category);
+  if (*flag != 0) {
+    AddEvent(kPhaseInstant, flag, name, nullptr, kValueTypeNone, 0);
+  }
+}
+
+void Tracing::Instant(TraceCategory category, const char* name,
+                      const char* argName, int64_t argValue) {
+  const uint8_t* flag = CategoryFlag(category);
+  if (*flag != 0) {
+    AddEvent(kPhaseInstant, flag, name, argName, kValueTypeInt,
+             static_cast<uint64_t>(argValue));
+  }
+}
+
+TraceScope::TraceScope(TraceCategory category, const char* name)
+    : name_(name) {
+  const uint8_t* flag = Tracing::CategoryFlag(category);
+  if (*flag != 0) {
+    this->flag_ = flag;
+    this->handle_ = Tracing::AddEvent(kPhaseComplete, flag, name, nullptr,
+                                      kValueTypeNone, 0);
+  }
+}
+
+TraceScope::TraceScope(TraceCategory category, const char* name,
+                       const char* argName, const char* argValue)
+    : name_(name) {
+  const uint8_t* flag = Tracing::CategoryFlag(category);
+  if (*flag != 0) {
+    this->flag_ = flag;
+    // A null value records the event without the argument.
+    this->handle_ = Tracing::AddEvent(
+        kPhaseComplete, flag, name, argValue != nullptr ? argName : nullptr,
+        kValueTypeCopyString, ToArgValue(argValue));
+  }
+}
+
+TraceScope::TraceScope(TraceCategory category, const char* name,
+                       const char* argName, int64_t argValue)
+    : name_(name) {
+  const uint8_t* flag = Tracing::CategoryFlag(category);
+  if (*flag != 0) {
+    this->flag_ = flag;
+    this->handle_ = Tracing::AddEvent(kPhaseComplete, flag, name, argName,
+                                      kValueTypeInt,
+                                      static_cast<uint64_t>(argValue));
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (this->flag_ != nullptr) {
+    Tracing::UpdateDuration(this->flag_, this->name_, this->handle_);
+  }
+}
+
+}  // namespace tns
@@ -0,0 +1,87 @@
+#ifndef Tracing_h
+#define Tracing_h
+
+#include <atomic>
+#include <cstdint>
+
+#include "Common.h"
+
+namespace tns {
+
+// Runtime-defined trace categories. They are recorded through the platform's
+// TracingController next to V8's own events, so a trace started from DevTools
+// (Tracing.start) or from ns:perf startTrace shows both on one timeline.
+enum class TraceCategory : uint8_t {
+  Module,     // ns.module: require, module loading and evaluation
+  Interop,    // ns.interop: every ObjC/C call made from JS
+  GC,         // ns.gc: native wrapper finalizers
+  EventLoop,  // ns.eventloop: EventLoop lane dispatches
+  Worker,     // ns.worker: worker startup, message delivery, termination
+  Count
+};
+
+class Tracing {
+ public:
+  // The category's name as it appears in the trace, e.g. "ns.module".
+  static const char* CategoryName(TraceCategory category);
+
+  // One byte load once the category has been resolved; this is the whole cost
+  // of an instrumentation point while its category is not being recorded.
+  static bool IsEnabled(TraceCategory category) {
+    return *CategoryFlag(category) != 0;
+  }
+
+  // Records a zero-duration event.
+  static void Instant(TraceCategory category, const char* name);
+  static void Instant(TraceCategory category, const char* name,
+                      const char* argName, int64_t argValue);
+
+ private:
+  friend class TraceScope;
+
+  static const uint8_t* CategoryFlag(TraceCategory category) {
+    const uint8_t* flag = flags_[static_cast<int>(category)].load(
+        std::memory_order_acquire);
+    return flag != nullptr ? flag : ResolveCategoryFlag(category);
+  }
+
+  static const uint8_t* ResolveCategoryFlag(TraceCategory category);
+
+  // argName == nullptr records no argument. String arguments are copied.
+  static uint64_t AddEvent(char phase, const uint8_t* flag, const char* name,
+                           const char* argName, uint8_t argType,
+                           uint64_t argValue);
+  static void UpdateDuration(const uint8_t* flag, const char* name,
+                             uint64_t handle);
+
+  static std::atomic<const uint8_t*>
+      flags_[static_cast<int>(TraceCategory::Count)];
+};
+
+// Records a complete ("X") event spanning the scope's lifetime. Event and
+// argument names must be string literals; string argument values are copied
+// and may be temporaries. Nothing is evaluated beyond the category check when
+// the category is off, but argument expressions at the call site still are —
+// guard costly ones with Tracing::IsEnabled.
+class TraceScope {
+ public:
+  TraceScope(TraceCategory category, const char* name);
+  TraceScope(TraceCategory category, const char* name, const char* argName,
+             const char* argValue);
+  TraceScope(TraceCategory category, const char* name, const char* argName,
+             int64_t argValue);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  // Null while the category is off.
+  const uint8_t* flag_ = nullptr;
+  const char* name_;
+  uint64_t handle_ = 0;
+};
+
+}  // namespace tns
+
+#endif /* Tracing_h */
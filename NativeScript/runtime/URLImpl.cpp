@@ -64,7 +64,7 @@ v8::Local<v8::FunctionTemplate> URLImpl::GetCtor(v8::Isolate* isolate) {
   tmpl->SetNativeDataProperty(ToV8String(isolate, "username"), GetUserName,
                               SetUserName);
 
-  tmpl->Set(ToV8String(isolate, "toString"),
+  tmpl->Set(Keys::ToString(isolate),
             v8::FunctionTemplate::New(isolate, &ToString));
 
   ctorTmpl->Set(ToV8String(isolate, "canParse"),
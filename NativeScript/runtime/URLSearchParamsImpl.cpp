@@ -80,7 +80,7 @@ v8::Local<v8::FunctionTemplate> URLSearchParamsImpl::GetCtor(
   tmpl->Set(ToV8String(isolate, "sort"),
             v8::FunctionTemplate::New(isolate, Sort));
 
-  tmpl->Set(ToV8String(isolate, "toString"),
+  tmpl->Set(Keys::ToString(isolate),
             v8::FunctionTemplate::New(isolate, &ToString));
 
   tmpl->Set(ToV8String(isolate, "values"),
@@ -168,8 +168,8 @@ void IteratorNext(const v8::FunctionCallbackInfo<v8::Value>& args) {
   auto kind = kindValue->Int32Value(context).FromMaybe(ITER_ENTRIES);
 
   auto result = v8::Object::New(isolate);
-  auto valueKey = ToV8String(isolate, "value");
-  auto doneKey = ToV8String(isolate, "done");
+  auto valueKey = Keys::Value(isolate);
+  auto doneKey = Keys::Done(isolate);
 
   URLSearchParamsImpl* ptr =
       sourceValue->IsObject()
@@ -239,7 +239,7 @@ void ReturnLiveIterator(const v8::FunctionCallbackInfo<v8::Value>& args,
   auto iterator = v8::Object::New(isolate);
   // Recorded in the hidden state so next() can brand-check its receiver.
   state->Set(context, ToV8String(isolate, kStateIterator), iterator).Check();
-  iterator->Set(context, ToV8String(isolate, "next"), nextFn).Check();
+  iterator->Set(context, Keys::Next(isolate), nextFn).Check();
   iterator->Set(context, v8::Symbol::GetIterator(isolate), selfFn).Check();
   iterator
       ->DefineOwnProperty(context, v8::Symbol::GetToStringTag(isolate),
@@ -288,7 +288,7 @@ bool OpenIterator(v8::Local<v8::Context> context, v8::Local<v8::Value> receiver,
   }
   outIterator = iteratorValue.As<v8::Object>();
   v8::Local<v8::Value> nextValue;
-  if (!outIterator->Get(context, ToV8String(isolate, "next"))
+  if (!outIterator->Get(context, Keys::Next(isolate))
            .ToLocal(&nextValue)) {
     return false;
   }
@@ -318,14 +318,14 @@ bool StepIterator(v8::Local<v8::Context> context,
   }
   auto result = resultValue.As<v8::Object>();
   v8::Local<v8::Value> doneValue;
-  if (!result->Get(context, ToV8String(isolate, "done")).ToLocal(&doneValue)) {
+  if (!result->Get(context, Keys::Done(isolate)).ToLocal(&doneValue)) {
     return false;
   }
   outDone = doneValue->BooleanValue(isolate);
   if (outDone) {
     return true;
   }
-  return result->Get(context, ToV8String(isolate, "value")).ToLocal(&outValue);
+  return result->Get(context, Keys::Value(isolate)).ToLocal(&outValue);
 }
 
 // ES IteratorClose for an abrupt (error) completion: call the iterator's
@@ -1,7 +1,11 @@
 #ifndef UnfairLock_h
 #define UnfairLock_h
 
+#ifdef __APPLE__
 #include <os/lock.h>
+#else
+#include <mutex>
+#endif
 
 /**
  BasicLockable wrapper over os_unfair_lock — the fastest blocking lock on
@@ -29,8 +33,15 @@
    Under bursty contention it degenerates to spinlock behavior (~30x slower,
    ~30x more CPU at 8 threads), it is the worst option under QoS inversion,
    and it changes nothing when the holder sleeps.
+
+ Off Darwin, where only the host benchmarks build runtime code, it is a
+ std::mutex.
  */
 
+#ifndef __APPLE__
+using UnfairMutex = std::mutex;
+#else
+
 #ifdef NATIVESCRIPT_UNFAIR_LOCK_ADAPTIVE_SPIN
 extern "C" void os_unfair_lock_lock_with_options(os_unfair_lock_t lock,
                                                  uint32_t options);
@@ -57,4 +68,6 @@ struct UnfairMutex {
   inline void unlock() noexcept { os_unfair_lock_unlock(&lock_); }
 };
 
+#endif /* __APPLE__ */
+
 #endif /* UnfairLock_h */
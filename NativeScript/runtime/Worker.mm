@@ -74,7 +74,7 @@ void Worker::ConstructorCallback(const FunctionCallbackInfo<Value>& info) {
     } else if (info[0]->IsObject()) {
       Local<Object> urlObj = info[0].As<Object>();
       Local<Value> toStringMethod;
-      if (urlObj->Get(context, tns::ToV8String(isolate, "toString")).ToLocal(&toStringMethod)) {
+      if (urlObj->Get(context, tns::Keys::ToString(isolate)).ToLocal(&toStringMethod)) {
         if (toStringMethod->IsFunction()) {
           Local<v8::Function> toString = toStringMethod.As<v8::Function>();
           Local<Value> result;
@@ -510,7 +510,7 @@ void Worker::SetWorkerId(Isolate* isolate, int workerId) {
   Local<Context> context = Caches::Get(isolate)->GetContext();
   Context::Scope contextScope(context);
   Local<Object> global = context->Global();
-  global->SetPrivate(context, Private::ForApi(isolate, tns::ToV8String(isolate, "workerId")),
+  global->SetPrivate(context, tns::Keys::WorkerIdPrivate(isolate),
                      Number::New(isolate, workerId));
 }
 
@@ -519,7 +519,7 @@ int Worker::GetWorkerId(Isolate* isolate, Local<Object> global) {
 
   Local<Context> context = isolate->GetCurrentContext();
   bool success =
-      global->GetPrivate(context, Private::ForApi(isolate, tns::ToV8String(isolate, "workerId")))
+      global->GetPrivate(context, tns::Keys::WorkerIdPrivate(isolate))
           .ToLocal(&value);
   tns::Assert(success && value->IsNumber(), isolate);
 
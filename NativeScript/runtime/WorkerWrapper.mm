@@ -5,6 +5,7 @@
 #include "Helpers.h"
 #include "Runtime.h"
 #include "RuntimeConfig.h"
+#include "Tracing.h"
 #include "inspector/JsV8InspectorClient.h"
 #include "inspector/WorkerInspectorClient.h"
 
@@ -101,6 +102,7 @@ void WorkerWrapper::DrainPendingTasks() {
   if (this->workerIsolate_ == nullptr) {
     return;
   }
+  TraceScope trace(TraceCategory::Worker, "deliverMessages", "workerId", this->workerId_);
   v8::Locker locker(this->workerIsolate_);
   Isolate::Scope isolate_scope(this->workerIsolate_);
   HandleScope handle_scope(this->workerIsolate_);
@@ -151,7 +153,11 @@ void WorkerWrapper::BackgroundLooper(std::function<Isolate*()> func) {
         },
         this);
 
-    this->workerIsolate_ = func();
+    {
+      // Isolate creation and the entry script's evaluation.
+      TraceScope trace(TraceCategory::Worker, "startWorker", "workerId", this->workerId_);
+      this->workerIsolate_ = func();
+    }
 
     this->DrainPendingTasks();
 
@@ -192,6 +198,7 @@ void WorkerWrapper::Terminate() {
   // set terminating to true atomically
   bool wasTerminating = this->isTerminating_.exchange(true);
   if (!wasTerminating) {
+    Tracing::Instant(TraceCategory::Worker, "terminate", "workerId", this->workerId_);
     if (this->workerIsolate_ != nullptr) {
       // Flagged before the request so a pump that is between iterations sees
       // it on its next check, rather than only once V8 has some JS to
@@ -344,7 +351,7 @@ void WorkerWrapper::ReportEntryEvaluationRejection(Local<Context> context, Local
     if (reason->IsObject()) {
       Local<Object> reasonObj = reason.As<Object>();
       Local<Value> stackVal;
-      if (reasonObj->Get(context, tns::ToV8String(isolate, "stack")).ToLocal(&stackVal) &&
+      if (reasonObj->Get(context, tns::Keys::Stack(isolate)).ToLocal(&stackVal) &&
           !stackVal->IsUndefined()) {
         stackTrace = tns::ToString(isolate, stackVal);
       }
@@ -495,14 +502,14 @@ Local<Object> WorkerWrapper::ConstructErrorObject(Local<Context> context, std::s
   tns::Assert(success, isolate);
 
   tns::Assert(
-      obj->Set(context, tns::ToV8String(isolate, "message"), tns::ToV8String(isolate, message))
+      obj->Set(context, tns::Keys::Message(isolate), tns::ToV8String(isolate, message))
           .FromMaybe(false),
       isolate);
   tns::Assert(
       obj->Set(context, tns::ToV8String(isolate, "filename"), tns::ToV8String(isolate, source))
           .FromMaybe(false),
       isolate);
-  tns::Assert(obj->Set(context, tns::ToV8String(isolate, "stackTrace"),
+  tns::Assert(obj->Set(context, tns::Keys::StackTrace(isolate),
                        tns::ToV8String(isolate, stackTrace))
                   .FromMaybe(false),
               isolate);
@@ -0,0 +1,46 @@
+"use strict";
+
+// The `ns:perf` builtin module: on-demand CPU profiles, heap snapshots,
+// sampling heap profiles, traces and heap statistics, written to disk in the
+// formats Chrome DevTools loads. See docs/ns-builtin-modules.md for the contract.
+// Arguments are validated on the native side (Profiling.cpp), so this file
+// stays a thin, frozen surface.
+//
+// Membership varies by build:
+//   - the `*InteropStats` functions exist only in builds compiled with
+//     NATIVESCRIPT_INTEROP_STATS.
+// Missing members are simply absent — never present-but-throwing — so
+// feature checks work.
+
+const {
+  startCpuProfile,
+  stopCpuProfile,
+  writeHeapSnapshot,
+  startHeapSampling,
+  stopHeapSampling,
+  getHeapStatistics,
+  getHeapSpaceStatistics,
+  getProcessMemory,
+  startTrace,
+  stopTrace,
+} = binding;
+const { ObjectFreeze } = primordials;
+
+exports.startCpuProfile = startCpuProfile;
+exports.stopCpuProfile = stopCpuProfile;
+exports.writeHeapSnapshot = writeHeapSnapshot;
+exports.startHeapSampling = startHeapSampling;
+exports.stopHeapSampling = stopHeapSampling;
+exports.getHeapStatistics = getHeapStatistics;
+exports.getHeapSpaceStatistics = getHeapSpaceStatistics;
+exports.getProcessMemory = getProcessMemory;
+exports.startTrace = startTrace;
+exports.stopTrace = stopTrace;
+if (binding.getInteropStats !== undefined) {
+  exports.enableInteropStats = binding.enableInteropStats;
+  exports.disableInteropStats = binding.disableInteropStats;
+  exports.getInteropStats = binding.getInteropStats;
+  exports.resetInteropStats = binding.resetInteropStats;
+  exports.writeInteropStats = binding.writeInteropStats;
+}
+ObjectFreeze(exports);
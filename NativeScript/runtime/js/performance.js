@@ -1,11 +1,19 @@
 "use strict";
 // High Resolution Time + User Timing Level 3 + Performance Timeline: the
 // `performance` global and its interface objects. The native side contributes
-// exactly two things through the binding bag — `now()` (double ms since this
-// isolate's time origin, monotonic) and `timeOrigin` (wall-clock ms since the
-// Unix epoch, sampled when the isolate's time origin was taken) — everything
-// else is portable JS, intended to run unchanged on the Android runtime
-// against an equivalent bag.
+// `now()` (double ms since this isolate's time origin, monotonic) and
+// `timeOrigin` (wall-clock ms since the Unix epoch, sampled when the isolate's
+// time origin was taken) through the binding bag, plus, optionally, the
+// runtime hooks behind eventLoopUtilization() and the `gc`/`longtask` entry
+// types:
+// - `sampleLoopTiming(out)` writes the event loop's [idle, active] ms into a
+//   Float64Array;
+// - `observeNativeEntries(gc, longTask)` tells the native side which of those
+//   entry types are observed; it then calls this module's export,
+//   deliverNativeEntries, at the end of each event-loop turn.
+// Everything else is portable JS, intended to run unchanged on the Android
+// runtime against an equivalent bag; without the hooks the two entry types
+// are simply unsupported and utilization reads as zero.
 //
 // Deliberate deviations from the specs:
 // - Observer callbacks are delivered from a microtask rather than a queued
@@ -14,7 +22,7 @@
 // - Failures the specs express as DOMException (SyntaxError,
 //   InvalidModificationError) are Error instances with `name` patched —
 //   DOMException does not exist in this runtime.
-const { now, timeOrigin } = binding;
+const { now, timeOrigin, sampleLoopTiming, observeNativeEntries } = binding;
 const {
   ArrayPrototypeIndexOf,
   ArrayPrototypePush,
@@ -28,6 +36,7 @@ const {
   ObjectDefineProperty,
   ObjectFreeze,
   ObjectGetOwnPropertyDescriptor,
+  ObjectPrototypeHasOwnProperty,
   String,
   SymbolIterator,
   SymbolToStringTag,
@@ -179,6 +188,50 @@ class PerformanceMeasure extends PerformanceEntry {
   }
 }
 
+// Long Tasks API: an event-loop turn of 50ms or more. Only the "self" name and
+// no attribution: there are no frames or containers to blame, so telling JS
+// work from GC or native callbacks means correlating with `gc` entries and
+// marks by time.
+class PerformanceLongTaskTiming extends PerformanceEntry {
+  constructor(token, startTime, duration) {
+    if (token !== kInternal) {
+      throw illegalConstructor();
+    }
+    super(token, "self", "longtask", startTime, duration);
+  }
+  get attribution() {
+    return NO_ATTRIBUTION;
+  }
+  toJSON() {
+    const json = super.toJSON();
+    json.attribution = NO_ATTRIBUTION;
+    return json;
+  }
+}
+const NO_ATTRIBUTION = ObjectFreeze([]);
+
+// Node's `gc` entry: name "gc", `detail` { kind, flags } carrying the
+// v8::GCType and v8::GCCallbackFlags bits (equal to Node's
+// NODE_PERFORMANCE_GC_* constants). Not a global, as in Node.
+class GCPerformanceEntry extends PerformanceEntry {
+  #detail;
+  constructor(token, startTime, duration, kind, flags) {
+    if (token !== kInternal) {
+      throw illegalConstructor();
+    }
+    super(token, "gc", "gc", startTime, duration);
+    this.#detail = ObjectFreeze({ kind: kind, flags: flags });
+  }
+  get detail() {
+    return this.#detail;
+  }
+  toJSON() {
+    const json = super.toJSON();
+    json.detail = this.#detail;
+    return json;
+  }
+}
+
 // ---- Performance timeline (per-isolate; this module runs once per isolate).
 
 const entries = []; // marks + measures, insertion order
@@ -251,7 +304,14 @@ function convertMarkToTimestamp(value) {
 
 // ---- Performance observers.
 
-const SUPPORTED_ENTRY_TYPES = ObjectFreeze(["mark", "measure"]);
+const hasNativeEntries = typeof observeNativeEntries === "function";
+// Alphabetical, per spec.
+const SUPPORTED_ENTRY_TYPES = ObjectFreeze(
+  hasNativeEntries ? ["gc", "longtask", "mark", "measure"] : ["mark", "measure"]
+);
+// Natively produced types go to observers only: they are never added to the
+// timeline, so getEntries() and `buffered: true` do not see them.
+const NATIVE_ENTRY_TYPES = ObjectFreeze(["gc", "longtask"]);
 
 // Registration order is the spec's delivery order. Each element is an
 // observer's internal record ({ observer, callback, types, queue, mode }),
@@ -304,6 +364,37 @@ function notifyObservers(entry) {
   }
 }
 
+// Keeps the native side producing exactly the native types some registered
+// observer wants; the GC callbacks cost nothing until the first gc observer.
+function syncNativeObservation() {
+  if (!hasNativeEntries) {
+    return;
+  }
+  let gc = false;
+  let longTask = false;
+  for (let i = 0; i < observers.length; i++) {
+    const types = observers[i].types;
+    gc = gc || ArrayPrototypeIndexOf(types, "gc") !== -1;
+    longTask = longTask || ArrayPrototypeIndexOf(types, "longtask") !== -1;
+  }
+  observeNativeEntries(gc, longTask);
+}
+
+// The module's export, called by the native side at the end of an event-loop
+// turn with that turn's records, five numbers each: type (0 longtask, 1 gc),
+// startTime, duration, GC kind, GC flags.
+function deliverNativeEntries(records) {
+  for (let i = 0; i + 4 < records.length; i += 5) {
+    const entry =
+      records[i] === 0
+        ? new PerformanceLongTaskTiming(kInternal, records[i + 1], records[i + 2])
+        : new GCPerformanceEntry(
+            kInternal, records[i + 1], records[i + 2], records[i + 3], records[i + 4]
+          );
+    notifyObservers(entry);
+  }
+}
+
 class PerformanceObserverEntryList {
   #entries;
   constructor(token, list) {
@@ -410,7 +501,7 @@ class PerformanceObserver {
       if (ArrayPrototypeIndexOf(record.types, t) === -1) {
         ArrayPrototypePush(record.types, t); // the type form accumulates
       }
-      if (options.buffered) {
+      if (options.buffered && ArrayPrototypeIndexOf(NATIVE_ENTRY_TYPES, t) === -1) {
         for (let i = 0; i < entries.length; i++) {
           if (entries[i].entryType === t) {
             ArrayPrototypePush(record.queue, entries[i]);
@@ -424,6 +515,7 @@ class PerformanceObserver {
     if (ArrayPrototypeIndexOf(observers, record) === -1) {
       ArrayPrototypePush(observers, record);
     }
+    syncNativeObservation();
   }
   disconnect() {
     const record = this.#record;
@@ -432,6 +524,7 @@ class PerformanceObserver {
       ArrayPrototypeSplice(observers, idx, 1);
     }
     record.queue = []; // pending records are dropped; takeRecords() first to keep them
+    syncNativeObservation();
   }
   takeRecords() {
     const record = this.#record;
@@ -462,6 +555,29 @@ class Performance extends EventTarget {
   get timeOrigin() {
     return timeOrigin;
   }
+  // Node's performance.eventLoopUtilization([utilization1[, utilization2]]):
+  // idle and active ms of this isolate's event loop since it started, or the
+  // delta from utilization1, or between the two arguments.
+  eventLoopUtilization(utilization1, utilization2) {
+    if (utilization2 !== undefined && utilization2 !== null) {
+      return utilization(
+        checkUtilization(utilization1).idle - checkUtilization(utilization2).idle,
+        utilization1.active - utilization2.active
+      );
+    }
+    let idle = 0;
+    let active = 0;
+    if (typeof sampleLoopTiming === "function") {
+      sampleLoopTiming(loopTiming);
+      idle = loopTiming[0];
+      active = loopTiming[1];
+    }
+    if (utilization1 !== undefined && utilization1 !== null) {
+      checkUtilization(utilization1);
+      return utilization(idle - utilization1.idle, active - utilization1.active);
+    }
+    return utilization(idle, active);
+  }
   now() {
     return now();
   }
@@ -566,6 +682,27 @@ class Performance extends EventTarget {
   }
 }
 
+const loopTiming = new Float64Array(2);
+
+function utilization(idle, active) {
+  const total = idle + active;
+  return { idle: idle, active: active, utilization: total > 0 ? active / total : 0 };
+}
+
+function checkUtilization(value) {
+  if (
+    value === null ||
+    typeof value !== "object" ||
+    !ObjectPrototypeHasOwnProperty(value, "idle") ||
+    !ObjectPrototypeHasOwnProperty(value, "active")
+  ) {
+    throw new TypeError(
+      "eventLoopUtilization: expected an object returned by eventLoopUtilization()"
+    );
+  }
+  return value;
+}
+
 // WebIDL shape: interface members are enumerable prototype properties and the
 // class string is a configurable, non-writable Symbol.toStringTag; class
 // syntax alone yields non-enumerable members.
@@ -588,6 +725,8 @@ finishInterface(PerformanceEntry, "PerformanceEntry", [
 ]);
 finishInterface(PerformanceMark, "PerformanceMark", ["detail", "toJSON"]);
 finishInterface(PerformanceMeasure, "PerformanceMeasure", ["detail", "toJSON"]);
+finishInterface(PerformanceLongTaskTiming, "PerformanceLongTaskTiming", ["attribution", "toJSON"]);
+finishInterface(GCPerformanceEntry, "PerformanceEntry", ["detail", "toJSON"]);
 finishInterface(PerformanceObserverEntryList, "PerformanceObserverEntryList", [
   "getEntries", "getEntriesByType", "getEntriesByName",
 ]);
@@ -595,7 +734,7 @@ finishInterface(PerformanceObserver, "PerformanceObserver", [
   "observe", "disconnect", "takeRecords",
 ]);
 finishInterface(Performance, "Performance", [
-  "timeOrigin", "now", "toJSON", "mark", "measure",
+  "timeOrigin", "now", "toJSON", "mark", "measure", "eventLoopUtilization",
   "clearMarks", "clearMeasures",
   "getEntries", "getEntriesByType", "getEntriesByName",
 ]);
@@ -604,6 +743,9 @@ g.Performance = Performance;
 g.PerformanceEntry = PerformanceEntry;
 g.PerformanceMark = PerformanceMark;
 g.PerformanceMeasure = PerformanceMeasure;
+g.PerformanceLongTaskTiming = PerformanceLongTaskTiming;
 g.PerformanceObserver = PerformanceObserver;
 g.PerformanceObserverEntryList = PerformanceObserverEntryList;
 g.performance = new Performance(kInternal);
+
+module.exports = deliverNativeEntries;
@@ -8,6 +8,7 @@
 #include "JSIV8ValueConverter.h"
 
 #include "V8PointerValue.h"
+#include "V8PropNameTable.h"
 
 namespace jsi = facebook::jsi;
 
@@ -151,8 +152,7 @@ v8::Local<v8::Function> JSIV8ValueConverter::ToV8Function(
 jsi::PropNameID JSIV8ValueConverter::ToJSIPropNameID(
     const V8Runtime& runtime, const v8::Local<v8::Name>& property) {
   v8::HandleScope scopedHandle(runtime.isolate_);
-  return runtime.make<jsi::PropNameID>(
-      new V8PointerValue(runtime.isolate_, property));
+  return runtime.make<jsi::PropNameID>(runtime.propNames_->Get(property));
 }
 
 // static
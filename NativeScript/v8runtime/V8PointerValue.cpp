@@ -7,8 +7,82 @@
 
 #include "V8PointerValue.h"
 
+#include <mutex>
+
+#include "runtime/UnfairLock.h"
+
 namespace rnv8 {
 
+#ifndef NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL
+namespace {
+
+// Slabs are never returned to the system: the pool stays at the peak number
+// of live values, which jsi code reaches again and again (every property
+// access through a HostObject mints values).
+class PointerValuePool {
+ public:
+  void* Allocate() {
+    std::lock_guard<UnfairMutex> lock(mutex_);
+    if (free_ == nullptr) {
+      Grow();
+    }
+    Node* node = free_;
+    free_ = node->next;
+    return node;
+  }
+
+  void Free(void* pointer) {
+    Node* node = static_cast<Node*>(pointer);
+    std::lock_guard<UnfairMutex> lock(mutex_);
+    node->next = free_;
+    free_ = node;
+  }
+
+ private:
+  union Node {
+    Node* next;
+    alignas(V8PointerValue) unsigned char storage[sizeof(V8PointerValue)];
+  };
+
+  static constexpr size_t kSlabSize = 256;
+
+  void Grow() {
+    Node* slab = static_cast<Node*>(::operator new(sizeof(Node) * kSlabSize));
+    for (size_t i = 0; i < kSlabSize; i++) {
+      slab[i].next = free_;
+      free_ = &slab[i];
+    }
+  }
+
+  // Values are created under the isolate lock but released from whichever
+  // thread drops the last jsi owner.
+  UnfairMutex mutex_;
+  Node* free_ = nullptr;
+};
+
+PointerValuePool& GetPool() {
+  // Leaked on purpose: values may still be released during exit.
+  static PointerValuePool* pool = new PointerValuePool();
+  return *pool;
+}
+
+}  // namespace
+
+// static
+void* V8PointerValue::operator new(size_t size) {
+  assert(size == sizeof(V8PointerValue));
+  return GetPool().Allocate();
+}
+
+// static
+void V8PointerValue::operator delete(void* pointer) {
+  if (pointer != nullptr) {
+    GetPool().Free(pointer);
+  }
+}
+
+#endif  // NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL
+
 V8PointerValue::V8PointerValue(v8::Isolate* isolate,
                                const v8::Local<v8::Value>& value)
     : isolate_(isolate), value_(isolate, value) {}
@@ -59,7 +133,12 @@ V8PointerValue* V8PointerValue::createFromUtf8(v8::Isolate* isolate,
   return new V8PointerValue(isolate, v8String);
 }
 
-void V8PointerValue::invalidate() {
+void V8PointerValue::invalidate() { Release(); }
+
+void V8PointerValue::Release() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
   {
     v8::Locker locker(isolate_);
     v8::Isolate::Scope scopedIsolate(isolate_);
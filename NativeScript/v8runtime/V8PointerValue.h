@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "V8Runtime.h"
 #include "jsi/jsi.h"
 #include "v8.h"
@@ -26,6 +28,23 @@ class V8PointerValue final : public V8Runtime::PointerValue {
 
   void Reset(v8::Isolate* isolate, v8::Local<v8::Value> value);
 
+  // Values that never change identity (strings, symbols, property names) are
+  // shared rather than cloned: every jsi owner holds one reference, and the
+  // Global is only dropped when the last of them lets go. Object values are
+  // never shared, since setNativeState swaps the object they hold.
+  V8PointerValue* Retain() {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return this;
+  }
+  void Release();
+
+#ifndef NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL
+  // Records come from a free list carved out of slabs, so a jsi value costs a
+  // list pop rather than a malloc.
+  static void* operator new(size_t size);
+  static void operator delete(void* pointer);
+#endif
+
  public:
   static V8PointerValue* createFromOneByte(v8::Isolate* isolate,
                                            const char* str, size_t length);
@@ -41,6 +60,7 @@ class V8PointerValue final : public V8Runtime::PointerValue {
   friend class V8Runtime;
   v8::Isolate* isolate_;
   v8::Global<v8::Value> value_;
+  std::atomic<uint32_t> refs_{1};
 };
 
 }  // namespace rnv8
\ No newline at end of file
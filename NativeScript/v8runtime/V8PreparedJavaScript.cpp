@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Kudo Chien.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "V8PreparedJavaScript.h"
+
+#include <cstring>
+#include <vector>
+
+namespace jsi = facebook::jsi;
+
+namespace rnv8 {
+
+namespace {
+
+// Header prepended to V8's cache data:
+//   uint32 magic, uint32 CachedDataVersionTag, uint64 source hash.
+// Caches never leave the device that produced them, so host byte order.
+constexpr uint32_t kCodeCacheMagic = 0x4e534343;  // "NSCC"
+constexpr size_t kCodeCacheHeaderSize = 16;
+
+class VectorBuffer : public jsi::Buffer {
+ public:
+  explicit VectorBuffer(std::vector<uint8_t> data) : data_(std::move(data)) {}
+  size_t size() const override { return data_.size(); }
+  const uint8_t* data() const override { return data_.data(); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+}  // namespace
+
+V8PreparedJavaScript::V8PreparedJavaScript(
+    v8::Isolate* isolate, std::shared_ptr<const jsi::Buffer> source,
+    std::string sourceURL, uint64_t sourceHash)
+    : isolate_(isolate),
+      source_(std::move(source)),
+      sourceURL_(std::move(sourceURL)),
+      sourceHash_(sourceHash) {}
+
+V8PreparedJavaScript::~V8PreparedJavaScript() {
+  if (!script_.IsEmpty()) {
+    v8::Locker locker(isolate_);
+    v8::Isolate::Scope scopedIsolate(isolate_);
+    script_.Reset();
+  }
+}
+
+// static
+uint64_t V8PreparedJavaScript::HashSource(const jsi::Buffer& source) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  const uint8_t* data = source.data();
+  for (size_t i = 0, size = source.size(); i < size; i++) {
+    hash = (hash ^ data[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// static
+std::shared_ptr<const jsi::Buffer> V8PreparedJavaScript::EncodeCodeCache(
+    uint64_t sourceHash, const v8::ScriptCompiler::CachedData& data) {
+  std::vector<uint8_t> buffer(kCodeCacheHeaderSize + data.length);
+  uint32_t magic = kCodeCacheMagic;
+  uint32_t tag = v8::ScriptCompiler::CachedDataVersionTag();
+  std::memcpy(buffer.data(), &magic, sizeof(magic));
+  std::memcpy(buffer.data() + 4, &tag, sizeof(tag));
+  std::memcpy(buffer.data() + 8, &sourceHash, sizeof(sourceHash));
+  std::memcpy(buffer.data() + kCodeCacheHeaderSize, data.data, data.length);
+  return std::make_shared<VectorBuffer>(std::move(buffer));
+}
+
+V8PreparedJavaScript::CodeCacheStatus V8PreparedJavaScript::ValidateCodeCache(
+    const jsi::Buffer& codeCache, const uint8_t** data, int* length) const {
+  if (codeCache.size() <= kCodeCacheHeaderSize) {
+    return CodeCacheStatus::kInvalidHeader;
+  }
+  uint32_t magic;
+  uint32_t tag;
+  uint64_t sourceHash;
+  std::memcpy(&magic, codeCache.data(), sizeof(magic));
+  std::memcpy(&tag, codeCache.data() + 4, sizeof(tag));
+  std::memcpy(&sourceHash, codeCache.data() + 8, sizeof(sourceHash));
+  if (magic != kCodeCacheMagic) {
+    return CodeCacheStatus::kInvalidHeader;
+  }
+  // V8 checks the tag itself, but only matches the source by length: a
+  // same-sized edit of the bundle would otherwise run stale code.
+  if (tag != v8::ScriptCompiler::CachedDataVersionTag()) {
+    return CodeCacheStatus::kFlagsMismatch;
+  }
+  if (sourceHash != sourceHash_) {
+    return CodeCacheStatus::kSourceMismatch;
+  }
+  *data = codeCache.data() + kCodeCacheHeaderSize;
+  *length = static_cast<int>(codeCache.size() - kCodeCacheHeaderSize);
+  return CodeCacheStatus::kAccepted;
+}
+
+}  // namespace rnv8
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Kudo Chien.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "jsi/jsi.h"
+#include "v8.h"
+
+namespace rnv8 {
+
+// A bundle compiled once by V8Runtime::prepareJavaScript. Evaluating it binds
+// the already-compiled script to the runtime's context, so only the first
+// evaluation pays for parsing.
+//
+// Compilation can start from a code cache produced by an earlier
+// V8Runtime::createCodeCache (typically persisted by the host across
+// launches). A cache is only handed to V8 when its header matches the source
+// hash and V8's version/flags tag; codeCacheStatus() reports whether it was
+// used.
+class V8PreparedJavaScript : public facebook::jsi::PreparedJavaScript {
+ public:
+  enum class CodeCacheStatus {
+    kNone,            // no code cache was supplied
+    kAccepted,        // V8 deserialized the cache instead of parsing
+    kInvalidHeader,   // not a cache written by createCodeCache
+    kSourceMismatch,  // produced for a different source
+    kFlagsMismatch,   // produced by another V8 version or flag set
+    kRejected,        // V8 rejected it (checksum, snapshot, ...)
+  };
+
+  V8PreparedJavaScript(v8::Isolate* isolate,
+                       std::shared_ptr<const facebook::jsi::Buffer> source,
+                       std::string sourceURL, uint64_t sourceHash);
+  ~V8PreparedJavaScript() override;
+
+  const std::string& sourceURL() const { return sourceURL_; }
+  uint64_t sourceHash() const { return sourceHash_; }
+  CodeCacheStatus codeCacheStatus() const { return codeCacheStatus_; }
+  bool codeCacheRejected() const {
+    return codeCacheStatus_ != CodeCacheStatus::kNone &&
+           codeCacheStatus_ != CodeCacheStatus::kAccepted;
+  }
+
+  // FNV-1a over the source bytes; what a code cache is keyed by.
+  static uint64_t HashSource(const facebook::jsi::Buffer& source);
+
+  // Wraps V8's cache data in the header checked by ValidateCodeCache.
+  static std::shared_ptr<const facebook::jsi::Buffer> EncodeCodeCache(
+      uint64_t sourceHash, const v8::ScriptCompiler::CachedData& data);
+
+  // Checks the header of `codeCache` against this source and the running V8.
+  // On success `data` points at V8's part of the buffer, which must outlive
+  // the compilation it is used for.
+  CodeCacheStatus ValidateCodeCache(const facebook::jsi::Buffer& codeCache,
+                                    const uint8_t** data,
+                                    int* length) const;
+
+ private:
+  friend class V8Runtime;
+
+  v8::Isolate* isolate_;
+  std::shared_ptr<const facebook::jsi::Buffer> source_;
+  std::string sourceURL_;
+  uint64_t sourceHash_;
+  CodeCacheStatus codeCacheStatus_ = CodeCacheStatus::kNone;
+  // Compiled for isolate_ only; another runtime recompiles from source_.
+  v8::Global<v8::UnboundScript> script_;
+};
+
+}  // namespace rnv8
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Kudo Chien.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "V8PropNameTable.h"
+
+#include "V8PointerValue.h"
+
+namespace rnv8 {
+
+V8PropNameTable::V8PropNameTable(v8::Isolate* isolate) : isolate_(isolate) {}
+
+V8PropNameTable::~V8PropNameTable() {
+  for (auto& entry : entries_) {
+    entry.second->Release();
+  }
+}
+
+V8PointerValue* V8PropNameTable::Get(v8::Local<v8::Name> name) {
+#ifdef NATIVESCRIPT_V8_NO_PROP_NAME_TABLE
+  return new V8PointerValue(isolate_, name);
+#else
+  if (!name->IsString()) {
+    return new V8PointerValue(isolate_, name);
+  }
+
+  v8::HandleScope scopedHandle(isolate_);
+  v8::Local<v8::String> string = name.As<v8::String>();
+  int hash = name->GetIdentityHash();
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    v8::Local<v8::Value> value = it->second->Get(isolate_);
+    // Property keys are internalized, so identity almost always decides.
+    if (value == name || value.As<v8::String>()->StringEquals(string)) {
+      return it->second->Retain();
+    }
+  }
+
+  V8PointerValue* value = new V8PointerValue(isolate_, name);
+  if (entries_.size() < kMaxEntries) {
+    entries_.emplace(hash, value->Retain());
+  }
+  return value;
+#endif
+}
+
+}  // namespace rnv8
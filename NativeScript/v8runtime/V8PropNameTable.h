@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Kudo Chien.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include "v8.h"
+
+namespace rnv8 {
+
+class V8PointerValue;
+
+// Per-runtime table of property-name values. HostObject interceptors and
+// createPropNameIDFrom* hand out a shared reference to the name's value
+// instead of minting a V8PointerValue (and a Global) per call, so a property
+// read through a HostObject costs a hash lookup. Only strings are interned;
+// symbols are usually one-offs. Used under the isolate lock only.
+//
+// NATIVESCRIPT_V8_NO_PROP_NAME_TABLE mints a value per call again, and
+// NATIVESCRIPT_V8_NO_POINTER_VALUE_POOL takes V8PointerValue records from
+// malloc again, for measuring what each saves (see prop-name-benchmark).
+class V8PropNameTable {
+ public:
+  explicit V8PropNameTable(v8::Isolate* isolate);
+  // Must run under the isolate lock.
+  ~V8PropNameTable();
+
+  V8PropNameTable(const V8PropNameTable&) = delete;
+  V8PropNameTable& operator=(const V8PropNameTable&) = delete;
+
+  // A value the caller owns one reference to (see V8PointerValue::Retain).
+  V8PointerValue* Get(v8::Local<v8::Name> name);
+
+ private:
+  // Entries keep their strings alive for the life of the runtime; past this
+  // many (say, computed keys), names are no longer interned.
+  static constexpr size_t kMaxEntries = 4096;
+
+  v8::Isolate* isolate_;
+  // Keyed by the string hash, which V8 stores in the string itself.
+  std::unordered_multimap<int, V8PointerValue*> entries_;
+};
+
+}  // namespace rnv8
@@ -7,8 +7,6 @@
 
 #include "V8Runtime.h"
 
-#include "runtime/Helpers.h"
-#include "runtime/Runtime.h"
 #include "v8.h"
 
 // #include <glog/logging.h>
@@ -20,6 +18,8 @@
 #include "JSIV8ValueConverter.h"
 // #include "V8Inspector.h"
 #include "V8PointerValue.h"
+#include "V8PreparedJavaScript.h"
+#include "V8PropNameTable.h"
 #include "jsi/jsilib.h"
 
 namespace jsi = facebook::jsi;
@@ -36,9 +36,7 @@ const char kHostFunctionProxyProp[] = "__hostFunctionProxy";
 std::unique_ptr<v8::Platform> V8Runtime::s_platform = nullptr;
 std::mutex s_platform_mutex;  // protects s_platform
 
-V8Runtime::V8Runtime() {
-  isolate_ = tns::Runtime::GetCurrentRuntime()->GetIsolate();
-
+V8Runtime::V8Runtime(v8::Isolate* isolate) : isolate_(isolate) {
   // V8Runtime::V8Runtime(
   //     std::unique_ptr<V8RuntimeConfig> config,
   //     std::shared_ptr<facebook::react::MessageQueueThread> jsQueue)
@@ -71,6 +69,7 @@ V8Runtime::V8Runtime() {
   v8::HandleScope scopedHandle(isolate_);
   context_.Reset(isolate_, isolate_->GetCurrentContext());
   v8::Context::Scope scopedContext(context_.Get(isolate_));
+  propNames_ = std::make_unique<V8PropNameTable>(isolate_);
   arrayBufferAllocator_.reset(
       v8::ArrayBuffer::Allocator::NewDefaultAllocator());
   // jsQueue_ = jsQueue;
@@ -170,6 +169,7 @@ V8Runtime::~V8Runtime() {
       inspectorClient_.reset();
     }
 
+    propNames_.reset();
     context_.Reset();
   }
   if (!isSharedRuntime_) {
@@ -179,6 +179,28 @@ V8Runtime::~V8Runtime() {
   // v8::V8::DisposePlatform();
 }
 
+V8Runtime::OperationScope::OperationScope(const V8Runtime& runtime) {
+  v8::Isolate* isolate = runtime.isolate_;
+  // Both checks are thread-local reads, where even a nested Locker goes
+  // through V8's thread manager.
+  if (v8::Isolate::TryGetCurrent() != isolate ||
+      !v8::Locker::IsLocked(isolate)) {
+    locker_.emplace(isolate);
+    isolateScope_.emplace(isolate);
+  }
+  handleScope_.emplace(isolate);
+  v8::Local<v8::Context> context = runtime.context_.Get(isolate);
+  if (!isolate->InContext() || isolate->GetCurrentContext() != context) {
+    contextScope_.emplace(context);
+  }
+}
+
+V8Runtime::BatchScope::BatchScope(V8Runtime& runtime)
+    : locker_(runtime.isolate_),
+      isolateScope_(runtime.isolate_),
+      handleScope_(runtime.isolate_),
+      contextScope_(runtime.context_.Get(runtime.isolate_)) {}
+
 void V8Runtime::OnMainLoopIdle() {
   // v8::Locker locker(isolate_);
   // v8::Isolate::Scope scopedIsolate(isolate_);
@@ -421,22 +443,133 @@ v8::Platform* V8Runtime::GetPlatform() { return s_platform.get(); }
 jsi::Value V8Runtime::evaluateJavaScript(
     const std::shared_ptr<const jsi::Buffer>& buffer,
     const std::string& sourceURL) {
-  return {};
+  OperationScope scope(*this);
+
+  return RunScript(CompileScript(buffer, sourceURL, nullptr, nullptr));
 }
 
 std::shared_ptr<const jsi::PreparedJavaScript> V8Runtime::prepareJavaScript(
     const std::shared_ptr<const jsi::Buffer>& buffer, std::string sourceURL) {
-  return nullptr;
+  return prepareJavaScriptWithCodeCache(buffer, std::move(sourceURL), nullptr);
+}
+
+std::shared_ptr<const V8PreparedJavaScript>
+V8Runtime::prepareJavaScriptWithCodeCache(
+    const std::shared_ptr<const jsi::Buffer>& buffer, std::string sourceURL,
+    const std::shared_ptr<const jsi::Buffer>& codeCache) {
+  auto prepared = std::make_shared<V8PreparedJavaScript>(
+      isolate_, buffer, std::move(sourceURL),
+      V8PreparedJavaScript::HashSource(*buffer));
+
+  OperationScope scope(*this);
+
+  v8::ScriptCompiler::CachedData* cachedData = nullptr;
+  if (codeCache) {
+    const uint8_t* data = nullptr;
+    int length = 0;
+    prepared->codeCacheStatus_ =
+        prepared->ValidateCodeCache(*codeCache, &data, &length);
+    if (prepared->codeCacheStatus_ ==
+        V8PreparedJavaScript::CodeCacheStatus::kAccepted) {
+      // Not owned: codeCache outlives the compilation below.
+      cachedData = new v8::ScriptCompiler::CachedData(
+          data, length, v8::ScriptCompiler::CachedData::BufferNotOwned);
+    }
+  }
+
+  bool cacheRejected = false;
+  v8::Local<v8::UnboundScript> script =
+      CompileScript(buffer, prepared->sourceURL(), cachedData, &cacheRejected);
+  if (cacheRejected) {
+    prepared->codeCacheStatus_ =
+        V8PreparedJavaScript::CodeCacheStatus::kRejected;
+  }
+  prepared->script_.Reset(isolate_, script);
+  return prepared;
 }
 
 jsi::Value V8Runtime::evaluatePreparedJavaScript(
     const std::shared_ptr<const jsi::PreparedJavaScript>& js) {
-  // The second arg is a `std::string` sourceURL; newer Clang (Xcode 26.x)
-  // enforces `-Wnonnull` on its non-null `const char*` constructor, so we
-  // can no longer pass `nullptr`. Empty string is the documented "unknown
-  // source URL" value and matches the existing `prepareJavaScript` no-op
-  // (which already returns nullptr above).
-  return evaluateJavaScript(nullptr, "");
+  auto prepared = std::dynamic_pointer_cast<const V8PreparedJavaScript>(js);
+  if (!prepared) {
+    throw jsi::JSINativeException(
+        "evaluatePreparedJavaScript: not prepared by a V8Runtime");
+  }
+
+  OperationScope scope(*this);
+
+  // The compiled script belongs to the isolate that prepared it; any other
+  // runtime has to parse the source again.
+  if (prepared->isolate_ != isolate_) {
+    return RunScript(CompileScript(prepared->source_, prepared->sourceURL(),
+                                   nullptr, nullptr));
+  }
+  return RunScript(prepared->script_.Get(isolate_));
+}
+
+std::shared_ptr<const jsi::Buffer> V8Runtime::createCodeCache(
+    const std::shared_ptr<const jsi::PreparedJavaScript>& js) {
+  auto prepared = std::dynamic_pointer_cast<const V8PreparedJavaScript>(js);
+  if (!prepared || prepared->isolate_ != isolate_) {
+    return nullptr;
+  }
+
+  OperationScope scope(*this);
+
+  std::unique_ptr<v8::ScriptCompiler::CachedData> data(
+      v8::ScriptCompiler::CreateCodeCache(prepared->script_.Get(isolate_)));
+  if (!data) {
+    return nullptr;
+  }
+  return V8PreparedJavaScript::EncodeCodeCache(prepared->sourceHash(), *data);
+}
+
+v8::Local<v8::UnboundScript> V8Runtime::CompileScript(
+    const std::shared_ptr<const jsi::Buffer>& buffer,
+    const std::string& sourceURL, v8::ScriptCompiler::CachedData* cachedData,
+    bool* cacheRejected) {
+  v8::EscapableHandleScope scopedHandle(isolate_);
+  v8::TryCatch tryCatch(isolate_);
+
+  // Source adopts cachedData, so it is released on every path below.
+  v8::Local<v8::String> sourceString;
+  v8::Local<v8::String> sourceURLString;
+  if (!JSIV8ValueConverter::ToV8String(*this, buffer).ToLocal(&sourceString) ||
+      !v8::String::NewFromUtf8(isolate_, sourceURL.c_str(),
+                               v8::NewStringType::kNormal,
+                               static_cast<int>(sourceURL.length()))
+           .ToLocal(&sourceURLString)) {
+    delete cachedData;
+    throw jsi::JSINativeException("Cannot create a V8 string for " +
+                                  sourceURL);
+  }
+  v8::ScriptOrigin origin(sourceURLString);
+  v8::ScriptCompiler::Source source(sourceString, origin, cachedData);
+
+  v8::Local<v8::UnboundScript> script;
+  if (!v8::ScriptCompiler::CompileUnboundScript(
+           isolate_, &source,
+           cachedData != nullptr ? v8::ScriptCompiler::kConsumeCodeCache
+                                 : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script)) {
+    ReportException(isolate_, &tryCatch);
+  }
+  if (cacheRejected != nullptr) {
+    *cacheRejected = cachedData != nullptr && source.GetCachedData()->rejected;
+  }
+  return scopedHandle.Escape(script);
+}
+
+jsi::Value V8Runtime::RunScript(v8::Local<v8::UnboundScript> script) {
+  v8::HandleScope scopedHandle(isolate_);
+  v8::TryCatch tryCatch(isolate_);
+  v8::Local<v8::Context> context = context_.Get(isolate_);
+
+  v8::Local<v8::Value> result;
+  if (!script->BindToCurrentContext()->Run(context).ToLocal(&result)) {
+    ReportException(isolate_, &tryCatch);
+  }
+  return JSIV8ValueConverter::ToJSIValue(isolate_, result);
 }
 
 void V8Runtime::queueMicrotask(const jsi::Function& callback) {
@@ -444,10 +577,7 @@ void V8Runtime::queueMicrotask(const jsi::Function& callback) {
 }
 
 bool V8Runtime::drainMicrotasks(int maxMicrotasksHint) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   while (v8::platform::PumpMessageLoop(
       s_platform.get(), isolate_,
@@ -459,10 +589,7 @@ bool V8Runtime::drainMicrotasks(int maxMicrotasksHint) {
 }
 
 jsi::Object V8Runtime::global() {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   return make<jsi::Object>(
       new V8PointerValue(isolate_, context_.Get(isolate_)->Global()));
@@ -482,14 +609,9 @@ jsi::Runtime::PointerValue* V8Runtime::cloneSymbol(
   if (!pv) {
     return nullptr;
   }
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
-
-  const V8PointerValue* v8PointerValue = static_cast<const V8PointerValue*>(pv);
-  assert(v8PointerValue->Get(isolate_)->IsSymbol());
-  return new V8PointerValue(isolate_, v8PointerValue->Get(isolate_));
+  // Symbols and strings never change, so their clones share the value.
+  return const_cast<V8PointerValue*>(static_cast<const V8PointerValue*>(pv))
+      ->Retain();
 }
 
 jsi::Runtime::PointerValue* V8Runtime::cloneBigInt(
@@ -498,10 +620,7 @@ jsi::Runtime::PointerValue* V8Runtime::cloneBigInt(
     return nullptr;
   }
 
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue = static_cast<const V8PointerValue*>(pv);
   assert(v8PointerValue->Get(isolate_)->IsBigInt());
@@ -513,15 +632,8 @@ jsi::Runtime::PointerValue* V8Runtime::cloneString(
   if (!pv) {
     return nullptr;
   }
-
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
-
-  const V8PointerValue* v8PointerValue = static_cast<const V8PointerValue*>(pv);
-  assert(v8PointerValue->Get(isolate_)->IsString());
-  return new V8PointerValue(isolate_, v8PointerValue->Get(isolate_));
+  return const_cast<V8PointerValue*>(static_cast<const V8PointerValue*>(pv))
+      ->Retain();
 }
 
 jsi::Runtime::PointerValue* V8Runtime::cloneObject(
@@ -530,10 +642,7 @@ jsi::Runtime::PointerValue* V8Runtime::cloneObject(
     return nullptr;
   }
 
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue = static_cast<const V8PointerValue*>(pv);
   assert(v8PointerValue->Get(isolate_)->IsObject());
@@ -542,73 +651,66 @@ jsi::Runtime::PointerValue* V8Runtime::cloneObject(
 
 jsi::Runtime::PointerValue* V8Runtime::clonePropNameID(
     const Runtime::PointerValue* pv) {
-  return cloneString(pv);
+  // A PropNameID may hold a symbol as well as a string.
+  return cloneSymbol(pv);
 }
 
 jsi::PropNameID V8Runtime::createPropNameIDFromAscii(const char* str,
                                                      size_t length) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
-  V8PointerValue* value =
-      V8PointerValue::createFromOneByte(isolate_, str, length);
-  if (!value) {
+  OperationScope scope(*this);
+  // Internalizing is a lookup in V8's string table when the name exists,
+  // which it does for any property the bundle mentions.
+  v8::Local<v8::String> name;
+  if (!v8::String::NewFromOneByte(isolate_,
+                                  reinterpret_cast<const uint8_t*>(str),
+                                  v8::NewStringType::kInternalized,
+                                  static_cast<int>(length))
+           .ToLocal(&name)) {
     throw jsi::JSError(*this, "createFromOneByte() - string creation failed.");
   }
 
-  return make<jsi::PropNameID>(value);
+  return make<jsi::PropNameID>(propNames_->Get(name));
 }
 
 jsi::PropNameID V8Runtime::createPropNameIDFromUtf8(const uint8_t* utf8,
                                                     size_t length) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
-  V8PointerValue* value =
-      V8PointerValue::createFromUtf8(isolate_, utf8, length);
-  if (!value) {
+  OperationScope scope(*this);
+  v8::Local<v8::String> name;
+  if (!v8::String::NewFromUtf8(isolate_, reinterpret_cast<const char*>(utf8),
+                               v8::NewStringType::kInternalized,
+                               static_cast<int>(length))
+           .ToLocal(&name)) {
     throw jsi::JSError(*this, "createFromUtf8() - string creation failed.");
   }
 
-  return make<jsi::PropNameID>(value);
+  return make<jsi::PropNameID>(propNames_->Get(name));
 }
 
 jsi::PropNameID V8Runtime::createPropNameIDFromString(const jsi::String& str) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(str));
   assert(v8PointerValue->Get(isolate_)->IsString());
 
-  v8::String::Utf8Value utf8(isolate_, v8PointerValue->Get(isolate_));
-  return createPropNameIDFromUtf8(reinterpret_cast<const uint8_t*>(*utf8),
-                                  utf8.length());
+  return make<jsi::PropNameID>(
+      propNames_->Get(v8PointerValue->Get(isolate_).As<v8::String>()));
 }
 
 jsi::PropNameID V8Runtime::createPropNameIDFromSymbol(
     const facebook::jsi::Symbol& sym) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   assert(static_cast<const V8PointerValue*>(getPointerValue(sym))
              ->Get(isolate_)
              ->IsSymbol());
 
-  return make<jsi::PropNameID>(const_cast<PointerValue*>(getPointerValue(sym)));
+  // Shared with `sym`: each owner releases its own reference.
+  return make<jsi::PropNameID>(cloneSymbol(getPointerValue(sym)));
 }
 
 std::string V8Runtime::utf8(const jsi::PropNameID& sym) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(sym));
@@ -617,10 +719,7 @@ std::string V8Runtime::utf8(const jsi::PropNameID& sym) {
 }
 
 bool V8Runtime::compare(const jsi::PropNameID& a, const jsi::PropNameID& b) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValueA =
       static_cast<const V8PointerValue*>(getPointerValue(a));
@@ -639,30 +738,21 @@ std::string V8Runtime::symbolToString(const jsi::Symbol& symbol) {
 }
 
 jsi::BigInt V8Runtime::createBigIntFromInt64(int64_t value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::BigInt> v8BigInt = v8::BigInt::New(isolate_, value);
   return make<jsi::BigInt>(new V8PointerValue(isolate_, v8BigInt));
 }
 
 jsi::BigInt V8Runtime::createBigIntFromUint64(uint64_t value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::BigInt> v8BigInt = v8::BigInt::NewFromUnsigned(isolate_, value);
   return make<jsi::BigInt>(new V8PointerValue(isolate_, v8BigInt));
 }
 
 bool V8Runtime::bigintIsInt64(const jsi::BigInt& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(value));
@@ -675,10 +765,7 @@ bool V8Runtime::bigintIsInt64(const jsi::BigInt& value) {
 }
 
 bool V8Runtime::bigintIsUint64(const jsi::BigInt& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(value));
@@ -691,10 +778,7 @@ bool V8Runtime::bigintIsUint64(const jsi::BigInt& value) {
 }
 
 uint64_t V8Runtime::truncate(const jsi::BigInt& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(value));
@@ -705,10 +789,7 @@ uint64_t V8Runtime::truncate(const jsi::BigInt& value) {
 }
 
 jsi::String V8Runtime::bigintToString(const jsi::BigInt& value, int radix) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(value));
@@ -745,10 +826,7 @@ jsi::String V8Runtime::bigintToString(const jsi::BigInt& value, int radix) {
 }
 
 jsi::String V8Runtime::createStringFromAscii(const char* str, size_t length) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   V8PointerValue* value =
       V8PointerValue::createFromOneByte(isolate_, str, length);
@@ -760,10 +838,7 @@ jsi::String V8Runtime::createStringFromAscii(const char* str, size_t length) {
 }
 
 jsi::String V8Runtime::createStringFromUtf8(const uint8_t* str, size_t length) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   V8PointerValue* value = V8PointerValue::createFromUtf8(isolate_, str, length);
   if (!value) {
@@ -774,10 +849,7 @@ jsi::String V8Runtime::createStringFromUtf8(const uint8_t* str, size_t length) {
 }
 
 std::string V8Runtime::utf8(const jsi::String& str) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(str));
@@ -788,10 +860,7 @@ std::string V8Runtime::utf8(const jsi::String& str) {
 }
 
 jsi::Object V8Runtime::createObject() {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> object = v8::Object::New(isolate_);
   return make<jsi::Object>(new V8PointerValue(isolate_, object));
@@ -799,10 +868,7 @@ jsi::Object V8Runtime::createObject() {
 
 jsi::Object V8Runtime::createObject(
     std::shared_ptr<jsi::HostObject> hostObject) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   HostObjectProxy* hostObjectProxy =
       new HostObjectProxy(*this, isolate_, hostObject);
@@ -837,10 +903,7 @@ std::shared_ptr<jsi::HostObject> V8Runtime::getHostObject(
 
   // We are guarenteed at this point to have isHostObject(obj) == true
   // so the internal data should be HostObjectMetadata
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -857,10 +920,7 @@ jsi::HostFunctionType& V8Runtime::getHostFunction(
   assert(isHostFunction(function));
 
   // We know that isHostFunction(function) is true here, so its safe to proceed
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(function));
@@ -883,10 +943,7 @@ jsi::HostFunctionType& V8Runtime::getHostFunction(
 }
 
 bool V8Runtime::hasNativeState(const jsi::Object& object) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -902,10 +959,7 @@ std::shared_ptr<jsi::NativeState> V8Runtime::getNativeState(
 
   // We are guarenteed at this point to have hasNativeState(obj) == true
   // so the internal data should be a NativeState
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -921,10 +975,7 @@ void V8Runtime::setNativeState(const jsi::Object& object,
     throw jsi::JSINativeException("native state unsupported on HostObject");
   }
 
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8ObjectOriginal =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -984,10 +1035,7 @@ void V8Runtime::setNativeState(const jsi::Object& object,
 
 jsi::Value V8Runtime::getProperty(const jsi::Object& object,
                                   const jsi::PropNameID& name) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8Object =
@@ -1008,10 +1056,7 @@ jsi::Value V8Runtime::getProperty(const jsi::Object& object,
 
 jsi::Value V8Runtime::getProperty(const jsi::Object& object,
                                   const jsi::String& name) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8Object =
@@ -1031,10 +1076,7 @@ jsi::Value V8Runtime::getProperty(const jsi::Object& object,
 
 bool V8Runtime::hasProperty(const jsi::Object& object,
                             const jsi::PropNameID& name) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8Object =
@@ -1055,10 +1097,7 @@ bool V8Runtime::hasProperty(const jsi::Object& object,
 
 bool V8Runtime::hasProperty(const jsi::Object& object,
                             const jsi::String& name) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8Object =
@@ -1080,10 +1119,7 @@ bool V8Runtime::hasProperty(const jsi::Object& object,
 void V8Runtime::setPropertyValue(const jsi::Object& object,
                                  const jsi::PropNameID& name,
                                  const jsi::Value& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1100,10 +1136,7 @@ void V8Runtime::setPropertyValue(const jsi::Object& object,
 void V8Runtime::setPropertyValue(const jsi::Object& object,
                                  const jsi::String& name,
                                  const jsi::Value& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1118,10 +1151,7 @@ void V8Runtime::setPropertyValue(const jsi::Object& object,
 }
 
 bool V8Runtime::isArray(const jsi::Object& object) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1129,10 +1159,7 @@ bool V8Runtime::isArray(const jsi::Object& object) const {
 }
 
 bool V8Runtime::isArrayBuffer(const jsi::Object& object) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1140,10 +1167,7 @@ bool V8Runtime::isArrayBuffer(const jsi::Object& object) const {
 }
 
 bool V8Runtime::isFunction(const jsi::Object& object) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1151,10 +1175,7 @@ bool V8Runtime::isFunction(const jsi::Object& object) const {
 }
 
 bool V8Runtime::isHostObject(const jsi::Object& object) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1162,10 +1183,7 @@ bool V8Runtime::isHostObject(const jsi::Object& object) const {
 }
 
 bool V8Runtime::isHostFunction(const jsi::Function& function) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Function> v8Function =
       JSIV8ValueConverter::ToV8Function(*this, function);
@@ -1178,10 +1196,7 @@ bool V8Runtime::isHostFunction(const jsi::Function& function) const {
 }
 
 jsi::Array V8Runtime::getPropertyNames(const jsi::Object& object) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, object);
@@ -1201,10 +1216,7 @@ jsi::Array V8Runtime::getPropertyNames(const jsi::Object& object) {
 }
 
 jsi::WeakObject V8Runtime::createWeakObject(const jsi::Object& weakObject) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(weakObject));
@@ -1218,10 +1230,7 @@ jsi::WeakObject V8Runtime::createWeakObject(const jsi::Object& weakObject) {
 }
 
 jsi::Value V8Runtime::lockWeakObject(const jsi::WeakObject& weakObject) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   const V8PointerValue* v8PointerValue =
       static_cast<const V8PointerValue*>(getPointerValue(weakObject));
@@ -1231,10 +1240,7 @@ jsi::Value V8Runtime::lockWeakObject(const jsi::WeakObject& weakObject) {
 }
 
 jsi::Array V8Runtime::createArray(size_t length) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Array> v8Array =
       v8::Array::New(isolate_, static_cast<int>(length));
@@ -1248,20 +1254,14 @@ jsi::ArrayBuffer V8Runtime::createArrayBuffer(
 }
 
 size_t V8Runtime::size(const jsi::Array& array) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Array> v8Array = JSIV8ValueConverter::ToV8Array(*this, array);
   return v8Array->Length();
 }
 
 size_t V8Runtime::size(const jsi::ArrayBuffer& arrayBuffer) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, arrayBuffer);
@@ -1271,10 +1271,7 @@ size_t V8Runtime::size(const jsi::ArrayBuffer& arrayBuffer) {
 }
 
 uint8_t* V8Runtime::data(const jsi::ArrayBuffer& arrayBuffer) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Object> v8Object =
       JSIV8ValueConverter::ToV8Object(*this, arrayBuffer);
@@ -1284,10 +1281,7 @@ uint8_t* V8Runtime::data(const jsi::ArrayBuffer& arrayBuffer) {
 }
 
 jsi::Value V8Runtime::getValueAtIndex(const jsi::Array& array, size_t i) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Array> v8Array = JSIV8ValueConverter::ToV8Array(*this, array);
   v8::MaybeLocal<v8::Value> result =
@@ -1300,10 +1294,7 @@ jsi::Value V8Runtime::getValueAtIndex(const jsi::Array& array, size_t i) {
 
 void V8Runtime::setValueAtIndexImpl(const jsi::Array& array, size_t i,
                                     const jsi::Value& value) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::Local<v8::Array> v8Array = JSIV8ValueConverter::ToV8Array(*this, array);
   v8::Maybe<bool> result =
@@ -1317,10 +1308,7 @@ void V8Runtime::setValueAtIndexImpl(const jsi::Array& array, size_t i,
 jsi::Function V8Runtime::createFunctionFromHostFunction(
     const jsi::PropNameID& name, unsigned int paramCount,
     jsi::HostFunctionType func) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   HostFunctionProxy* hostFunctionProxy =
       new HostFunctionProxy(*this, isolate_, std::move(func));
@@ -1359,10 +1347,7 @@ jsi::Function V8Runtime::createFunctionFromHostFunction(
 jsi::Value V8Runtime::call(const jsi::Function& function,
                            const jsi::Value& jsThis, const jsi::Value* args,
                            size_t count) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Function> v8Function =
@@ -1399,10 +1384,7 @@ jsi::Value V8Runtime::call(const jsi::Function& function,
 
 jsi::Value V8Runtime::callAsConstructor(const jsi::Function& function,
                                         const jsi::Value* args, size_t count) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Function> v8Function =
@@ -1430,10 +1412,7 @@ jsi::Value V8Runtime::callAsConstructor(const jsi::Function& function,
 }
 
 bool V8Runtime::strictEquals(const jsi::Symbol& a, const jsi::Symbol& b) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Symbol> v8SymbolA = JSIV8ValueConverter::ToV8Symbol(*this, a);
@@ -1447,10 +1426,7 @@ bool V8Runtime::strictEquals(const jsi::Symbol& a, const jsi::Symbol& b) const {
 }
 
 bool V8Runtime::strictEquals(const jsi::BigInt& a, const jsi::BigInt& b) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Value> v8ValueA =
@@ -1466,10 +1442,7 @@ bool V8Runtime::strictEquals(const jsi::BigInt& a, const jsi::BigInt& b) const {
 }
 
 bool V8Runtime::strictEquals(const jsi::String& a, const jsi::String& b) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::String> v8StringA = JSIV8ValueConverter::ToV8String(*this, a);
@@ -1483,10 +1456,7 @@ bool V8Runtime::strictEquals(const jsi::String& a, const jsi::String& b) const {
 }
 
 bool V8Runtime::strictEquals(const jsi::Object& a, const jsi::Object& b) const {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8ObjectA = JSIV8ValueConverter::ToV8Object(*this, a);
@@ -1500,10 +1470,7 @@ bool V8Runtime::strictEquals(const jsi::Object& a, const jsi::Object& b) const {
 }
 
 bool V8Runtime::instanceOf(const jsi::Object& o, const jsi::Function& f) {
-  v8::Locker locker(isolate_);
-  v8::Isolate::Scope scopedIsolate(isolate_);
-  v8::HandleScope scopedHandle(isolate_);
-  v8::Context::Scope scopedContext(context_.Get(isolate_));
+  OperationScope scope(*this);
 
   v8::TryCatch tryCatch(isolate_);
   v8::Local<v8::Object> v8Object = JSIV8ValueConverter::ToV8Object(*this, o);
@@ -8,6 +8,9 @@
 #pragma once
 
 // #include <cxxreact/MessageQueueThread.h>
+#include <optional>
+
+#include "V8PreparedJavaScript.h"
 #include "V8RuntimeConfig.h"
 #include "jsi/jsi.h"
 #include "libplatform/libplatform.h"
@@ -17,11 +20,14 @@ namespace rnv8 {
 
 class V8Runtime;
 class V8PointerValue;
+class V8PropNameTable;
 class InspectorClient;
 
 class V8Runtime : public facebook::jsi::Runtime {
  public:
-  V8Runtime();
+  // Wraps `isolate`, taking the context it is currently in as the runtime's
+  // global context. The runtime disposes the isolate when it is destroyed.
+  explicit V8Runtime(v8::Isolate* isolate);
   //   V8Runtime(
   //       std::unique_ptr<V8RuntimeConfig> config,
   //       std::shared_ptr<facebook::react::MessageQueueThread> jsQueue);
@@ -33,6 +39,40 @@ class V8Runtime : public facebook::jsi::Runtime {
   // Calling this function when the platform main runloop is idle
   void OnMainLoopIdle();
 
+  // Enters the runtime once for a run of JSI calls made from native code
+  // that is not already inside a host function: the calls made while it is
+  // open skip their own locking and isolate/context entry. Stack-allocate it
+  // on the thread making the calls.
+  class BatchScope {
+   public:
+    explicit BatchScope(V8Runtime& runtime);
+
+    BatchScope(const BatchScope&) = delete;
+    BatchScope& operator=(const BatchScope&) = delete;
+
+   private:
+    v8::Locker locker_;
+    v8::Isolate::Scope isolateScope_;
+    v8::HandleScope handleScope_;
+    v8::Context::Scope contextScope_;
+  };
+
+  // As prepareJavaScript, but compiles from a code cache returned by an
+  // earlier createCodeCache for the same source when it is still valid. An
+  // unusable cache is ignored; V8PreparedJavaScript::codeCacheStatus() says
+  // which happened.
+  std::shared_ptr<const V8PreparedJavaScript> prepareJavaScriptWithCodeCache(
+      const std::shared_ptr<const facebook::jsi::Buffer>& buffer,
+      std::string sourceURL,
+      const std::shared_ptr<const facebook::jsi::Buffer>& codeCache);
+
+  // Serializes what V8 has compiled for `js` so far, for the host to persist
+  // and pass to prepareJavaScriptWithCodeCache next time. Taken after the
+  // bundle has run, the cache also covers the functions startup compiled
+  // lazily. Null when `js` was not prepared by this runtime.
+  std::shared_ptr<const facebook::jsi::Buffer> createCodeCache(
+      const std::shared_ptr<const facebook::jsi::PreparedJavaScript>& js);
+
  private:
   v8::Local<v8::Context> CreateGlobalContext(v8::Isolate* isolate);
   facebook::jsi::Value ExecuteScript(v8::Isolate* isolate,
@@ -40,6 +80,14 @@ class V8Runtime : public facebook::jsi::Runtime {
                                      const std::string& sourceURL);
   void ReportException(v8::Isolate* isolate, v8::TryCatch* tryCatch) const;
 
+  // Compile and run in the runtime's context; both throw jsi::JSError on
+  // failure. CompileScript takes ownership of `cachedData`.
+  v8::Local<v8::UnboundScript> CompileScript(
+      const std::shared_ptr<const facebook::jsi::Buffer>& buffer,
+      const std::string& sourceURL,
+      v8::ScriptCompiler::CachedData* cachedData, bool* cacheRejected);
+  facebook::jsi::Value RunScript(v8::Local<v8::UnboundScript> script);
+
   std::unique_ptr<v8::ScriptCompiler::CachedData> LoadCodeCacheIfNeeded(
       const std::string& sourceURL);
   bool SaveCodeCacheIfNeeded(const v8::Local<v8::Script>& script,
@@ -49,6 +97,25 @@ class V8Runtime : public facebook::jsi::Runtime {
       const v8::ScriptOrigin& origin,
       v8::ScriptCompiler::CachedData* cachedData);
 
+  // What every JSI operation opens first. When the calling thread already
+  // holds the isolate in the runtime's context (a host function calling back
+  // into JSI, or an open BatchScope), only a HandleScope is opened; the
+  // Locker and isolate/context entry are skipped.
+  class OperationScope {
+   public:
+    explicit OperationScope(const V8Runtime& runtime);
+
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+   private:
+    // Destroyed in reverse order: context, handles, isolate, lock.
+    std::optional<v8::Locker> locker_;
+    std::optional<v8::Isolate::Scope> isolateScope_;
+    std::optional<v8::HandleScope> handleScope_;
+    std::optional<v8::Context::Scope> contextScope_;
+  };
+
   enum InternalFieldType {
     kInvalid = 0,
     kHostObject = 1,
@@ -221,6 +288,7 @@ class V8Runtime : public facebook::jsi::Runtime {
   std::unique_ptr<v8::StartupData> snapshotBlob_;
   v8::Isolate* isolate_;
   v8::Global<v8::Context> context_;
+  std::unique_ptr<V8PropNameTable> propNames_;
   std::shared_ptr<InspectorClient> inspectorClient_;
   bool isSharedRuntime_ = false;
   //   std::shared_ptr<facebook::react::MessageQueueThread> jsQueue_;
@@ -8,11 +8,13 @@
 #include "V8RuntimeFactory.h"
 
 #include "V8Runtime.h"
+#include "runtime/Runtime.h"
 
 namespace rnv8 {
 
 std::unique_ptr<facebook::jsi::Runtime> createV8Runtime() {
-  return std::make_unique<V8Runtime>();
+  return std::make_unique<V8Runtime>(
+      tns::Runtime::GetCurrentRuntime()->GetIsolate());
 }
 
 // std::unique_ptr<facebook::jsi::Runtime> createSharedV8Runtime(
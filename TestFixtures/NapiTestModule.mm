@@ -6,8 +6,11 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "NapiTestSupport.h"
+#include "napi/NapiAsyncWorkPool.h"
+#include "napi/NapiThreadSafeFunction.h"
 
 typedef struct {
   double value;
@@ -347,6 +350,132 @@ static napi_value StartCancelledWork(napi_env env, napi_callback_info info) {
   return NapiStatusValue(env, napi_cancel_async_work(env, context->work));
 }
 
+static void SetNumberProperty(napi_env env, napi_value object, const char* name, double value) {
+  napi_value number = NULL;
+  napi_create_double(env, value, &number);
+  napi_set_named_property(env, object, name, number);
+}
+
+// A batch of CPU-bound works queued at once, to see them spread over the pool
+// and their completions share runloop entries.
+struct NapiWorkBatch {
+  napi_ref doneRef = NULL;
+  int remaining = 0;
+  int spinMs = 0;
+  std::atomic<int> running{0};
+  std::atomic<int> peakRunning{0};
+  tns::NapiAsyncWorkPoolStats before;
+};
+
+struct NapiWorkBatchItem {
+  NapiWorkBatch* batch;
+  napi_async_work work;
+};
+
+static void ExecuteBatchWork(napi_env env, void* data) {
+  (void)env;
+  NapiWorkBatch* batch = ((NapiWorkBatchItem*)data)->batch;
+  int running = batch->running.fetch_add(1) + 1;
+  int peak = batch->peakRunning.load();
+  while (running > peak && !batch->peakRunning.compare_exchange_weak(peak, running)) {
+  }
+
+  auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(batch->spinMs);
+  while (std::chrono::steady_clock::now() < until) {
+  }
+  batch->running.fetch_sub(1);
+}
+
+static void CompleteBatchWork(napi_env env, napi_status status, void* data) {
+  (void)status;
+  NapiWorkBatchItem* item = (NapiWorkBatchItem*)data;
+  NapiWorkBatch* batch = item->batch;
+  napi_delete_async_work(env, item->work);
+  delete item;
+
+  if (--batch->remaining > 0) {
+    return;
+  }
+
+  tns::NapiAsyncWorkPoolStats after;
+  tns::NapiGetAsyncWorkPoolStats(&after);
+
+  napi_value done = NULL;
+  napi_get_reference_value(env, batch->doneRef, &done);
+  if (done != NULL) {
+    napi_value result = NULL;
+    napi_create_object(env, &result);
+    SetNumberProperty(env, result, "peakRunning", batch->peakRunning.load());
+    SetNumberProperty(env, result, "maxThreads", (double)after.maxThreads);
+    SetNumberProperty(env, result, "completed",
+                      (double)(after.completed - batch->before.completed));
+    SetNumberProperty(env, result, "completionBatches",
+                      (double)(after.completionBatches - batch->before.completionBatches));
+    SetNumberProperty(env, result, "queueMs",
+                      (after.totalQueueNs - batch->before.totalQueueNs) / 1e6);
+
+    napi_value recv = NULL;
+    napi_get_undefined(env, &recv);
+    napi_call_function(env, recv, done, 1, &result, NULL);
+  }
+  napi_delete_reference(env, batch->doneRef);
+  delete batch;
+}
+
+// startAsyncWorkBatch(count, spinMs, onDone)
+static napi_value StartAsyncWorkBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  int32_t count = 0;
+  int32_t spinMs = 0;
+  NAPI_CALL(env, napi_get_value_int32(env, args[0], &count));
+  NAPI_CALL(env, napi_get_value_int32(env, args[1], &spinMs));
+
+  napi_value name = NULL;
+  NAPI_CALL(env, napi_create_string_utf8(env, "napi-test-work-batch", NAPI_AUTO_LENGTH, &name));
+
+  NapiWorkBatch* batch = new NapiWorkBatch();
+  batch->remaining = count;
+  batch->spinMs = spinMs;
+  tns::NapiGetAsyncWorkPoolStats(&batch->before);
+  if (napi_create_reference(env, args[2], 1, &batch->doneRef) != napi_ok) {
+    delete batch;
+    NapiThrowLastError(env);
+    return NULL;
+  }
+
+  // Every work is created before any is queued, so a failure leaves nothing
+  // running against the batch.
+  std::vector<NapiWorkBatchItem*> items;
+  for (int i = 0; i < count; i++) {
+    NapiWorkBatchItem* item = new NapiWorkBatchItem{batch, NULL};
+    items.push_back(item);
+    if (napi_create_async_work(env, NULL, name, ExecuteBatchWork, CompleteBatchWork, item,
+                               &item->work) != napi_ok) {
+      for (NapiWorkBatchItem* created : items) {
+        if (created->work != NULL) {
+          napi_delete_async_work(env, created->work);
+        }
+        delete created;
+      }
+      napi_delete_reference(env, batch->doneRef);
+      delete batch;
+      NapiThrowLastError(env);
+      return NULL;
+    }
+  }
+
+  for (NapiWorkBatchItem* item : items) {
+    NAPI_CALL(env, napi_queue_async_work(env, item->work));
+  }
+
+  napi_value result = NULL;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
 //=== Threadsafe functions =================================================
 
 // Shared between the producer thread and the finalizer, which runs on the JS
@@ -504,6 +633,144 @@ static napi_value ProbeTsfnAbort(napi_env env, napi_callback_info info) {
   return result;
 }
 
+//=== Threadsafe function stress ===========================================
+
+// Several producers pushing as fast as they can; the spec checks that nothing
+// is lost or reordered per producer, through the ring or the locked queue, and
+// compares their throughput. Values carry the producer's index in the
+// millions, its sequence number below.
+struct NapiTsfnStressContext {
+  napi_threadsafe_function tsfn = NULL;
+  napi_ref doneRef = NULL;
+  int producers = 0;
+  int perProducer = 0;
+  bool blocking = true;
+  std::chrono::steady_clock::time_point start;
+  std::atomic<int> owners{1};
+  std::atomic<int> queueFullRetries{0};
+  std::atomic<int> lastCallStatus{napi_ok};
+};
+
+static void ReleaseTsfnStressContext(NapiTsfnStressContext* context) {
+  if (context->owners.fetch_sub(1) == 1) {
+    delete context;
+  }
+}
+
+static void TsfnStressFinalize(napi_env env, void* data, void* hint) {
+  (void)hint;
+  NapiTsfnStressContext* context = (NapiTsfnStressContext*)data;
+  double elapsedMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - context->start)
+                         .count();
+
+  napi_value done = NULL;
+  napi_get_reference_value(env, context->doneRef, &done);
+  if (done != NULL) {
+    napi_value result = NULL;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "status",
+                            NapiStatusValue(env, (napi_status)context->lastCallStatus.load()));
+    SetNumberProperty(env, result, "elapsedMs", elapsedMs);
+    SetNumberProperty(env, result, "queueFullRetries", context->queueFullRetries.load());
+
+    tns::NapiThreadSafeFunctionStats stats;
+    if (tns::NapiGetThreadSafeFunctionStats(context->tsfn, &stats)) {
+      SetNumberProperty(env, result, "calls", (double)stats.calls);
+      SetNumberProperty(env, result, "delivered", (double)stats.delivered);
+      SetNumberProperty(env, result, "dispatches", (double)stats.dispatches);
+      SetNumberProperty(env, result, "peakQueueDepth", (double)stats.peakQueueDepth);
+      SetNumberProperty(env, result, "queueFull", (double)stats.queueFull);
+      SetNumberProperty(env, result, "maxWaitMs", stats.maxWaitNs / 1e6);
+      SetNumberProperty(env, result, "blockedMs", stats.blockedNs / 1e6);
+    }
+
+    napi_value recv = NULL;
+    napi_get_undefined(env, &recv);
+    napi_call_function(env, recv, done, 1, &result, NULL);
+  }
+  napi_delete_reference(env, context->doneRef);
+
+  ReleaseTsfnStressContext(context);
+}
+
+static void TsfnStressProducer(NapiTsfnStressContext* context, int index) {
+  napi_threadsafe_function tsfn = context->tsfn;
+
+  for (int i = 0; i < context->perProducer; i++) {
+    void* value = (void*)(intptr_t)(index * 1000000 + i);
+    napi_status status = napi_call_threadsafe_function(
+        tsfn, value, context->blocking ? napi_tsfn_blocking : napi_tsfn_nonblocking);
+    while (status == napi_queue_full) {
+      context->queueFullRetries.fetch_add(1);
+      std::this_thread::yield();
+      status = napi_call_threadsafe_function(tsfn, value, napi_tsfn_nonblocking);
+    }
+    if (status != napi_ok) {
+      context->lastCallStatus.store(status);
+      break;
+    }
+  }
+
+  napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+  ReleaseTsfnStressContext(context);
+}
+
+// startTsfnStress(producers, perProducer, maxQueueSize, blocking, onValue, onDone,
+//                 lockedQueue)
+static napi_value StartTsfnStress(napi_env env, napi_callback_info info) {
+  size_t argc = 7;
+  napi_value args[7];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  int32_t producers = 0;
+  int32_t perProducer = 0;
+  int32_t maxQueueSize = 0;
+  bool blocking = true;
+  bool lockedQueue = false;
+  NAPI_CALL(env, napi_get_value_int32(env, args[0], &producers));
+  NAPI_CALL(env, napi_get_value_int32(env, args[1], &perProducer));
+  NAPI_CALL(env, napi_get_value_int32(env, args[2], &maxQueueSize));
+  NAPI_CALL(env, napi_get_value_bool(env, args[3], &blocking));
+  if (argc > 6) {
+    NAPI_CALL(env, napi_get_value_bool(env, args[6], &lockedQueue));
+  }
+
+  NapiTsfnStressContext* context = new NapiTsfnStressContext();
+  context->producers = producers;
+  context->perProducer = perProducer;
+  context->blocking = blocking;
+
+  napi_value name = NULL;
+  if (napi_create_string_utf8(env, "napi-test-tsfn-stress", NAPI_AUTO_LENGTH, &name) != napi_ok ||
+      napi_create_reference(env, args[5], 1, &context->doneRef) != napi_ok ||
+      napi_create_threadsafe_function(env, args[4], NULL, name, (size_t)maxQueueSize,
+                                      (size_t)producers, context, TsfnStressFinalize, NULL,
+                                      TsfnCallJs, &context->tsfn) != napi_ok) {
+    if (context->doneRef != NULL) {
+      napi_delete_reference(env, context->doneRef);
+    }
+    delete context;
+    NapiThrowLastError(env);
+    return NULL;
+  }
+
+  if (lockedQueue) {
+    tns::NapiUseLockedThreadSafeFunctionQueue(context->tsfn);
+  }
+
+  // One reference per producer thread; the finalizer holds the original.
+  context->owners.fetch_add(producers);
+  context->start = std::chrono::steady_clock::now();
+  for (int i = 0; i < producers; i++) {
+    std::thread(TsfnStressProducer, context, i).detach();
+  }
+
+  napi_value result = NULL;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
 //=== Callback scopes ======================================================
 
 static napi_value InvokeViaMakeCallback(napi_env env, napi_callback_info info) {
@@ -591,9 +858,11 @@ static napi_value InitNapiTestModule(napi_env env, napi_value exports) {
       NAPI_METHOD("releaseRef", ReleaseRef),
       NAPI_METHOD("startAsyncWork", StartAsyncWork),
       NAPI_METHOD("startCancelledWork", StartCancelledWork),
+      NAPI_METHOD("startAsyncWorkBatch", StartAsyncWorkBatch),
       NAPI_METHOD("startTsfn", StartTsfn),
       NAPI_METHOD("pushTsfn", PushTsfn),
       NAPI_METHOD("probeTsfnAbort", ProbeTsfnAbort),
+      NAPI_METHOD("startTsfnStress", StartTsfnStress),
       NAPI_METHOD("invokeViaMakeCallback", InvokeViaMakeCallback),
       NAPI_METHOD("exerciseCleanupHooks", ExerciseCleanupHooks),
       NAPI_GETTER("wrapCount", GetWrapCount),
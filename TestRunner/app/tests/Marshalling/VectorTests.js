@@ -100,4 +100,41 @@ describe(module.id, function () {
         expect(v.z.toFixed(4)).toBe((3.4567).toFixed(4));
         expect(v.w.toFixed(4)).toBe((4.5678).toFixed(4));
     });
+
+    it("vectors of one kind share a prototype", function() {
+        expect(Object.getPrototypeOf(getFloat4())).toBe(Object.getPrototypeOf(incrementFloat4(getFloat4())));
+        expect(Object.getPrototypeOf(getFloat4())).not.toBe(Object.getPrototypeOf(getFloat3()));
+        expect(Object.getPrototypeOf(getFloat4())).not.toBe(Object.getPrototypeOf(getDouble4()));
+    });
+
+    it("asTypedArray views the vector's storage", function() {
+        var f = getFloat3();
+        var view = f.asTypedArray();
+        expect(view instanceof Float32Array).toBe(true);
+        expect(view.length).toBe(3);
+        expect(view[2].toFixed(4)).toBe(3.4567.toFixed(4));
+
+        view[0] = 10;
+        expect(f[0]).toBe(10);
+        var fi = incrementFloat3(f);
+        expect(fi[0]).toBe(11);
+
+        var d = getDouble2().asTypedArray();
+        expect(d instanceof Float64Array).toBe(true);
+        expect(d.length).toBe(2);
+    });
+
+    it("asTypedArray outlives its vector", function() {
+        var view = getFloat4().asTypedArray();
+        gc();
+        expect(view[3].toFixed(4)).toBe(4.5678.toFixed(4));
+    });
+
+    it("shares one template per element type and lane count", function() {
+        var first = getFloat4();
+        var second = incrementFloat4(getFloat4());
+        expect(Object.getPrototypeOf(first)).toBe(Object.getPrototypeOf(second));
+        expect(first.asTypedArray).toBe(second.asTypedArray);
+        expect(Object.getPrototypeOf(getDouble2())).not.toBe(Object.getPrototypeOf(first));
+    });
 });
@@ -29,6 +29,47 @@ describe(module.id, function () {
         expect(module).toBeDefined();
      });
 
+     it("compiles a module as a function of the CommonJS parameters", function () {
+        var dir = NSTemporaryDirectory() + "cjs-params-" + Date.now();
+        NSFileManager.defaultManager.createDirectoryAtPathWithIntermediateDirectoriesAttributesError(dir, true, null, null);
+        var source = "module.exports = { count: arguments.length, file: __filename, dir: __dirname, " +
+            "same: exports === module.exports, line: new Error().stack.split('\\n')[1] };";
+        NSString.stringWithString(source).writeToFileAtomicallyEncodingError(dir + "/params.js", true, NSUTF8StringEncoding, null);
+
+        var result = require(dir + "/params.js");
+        expect(result.count).toBe(5);
+        expect(result.file).toBe(dir + "/params.js");
+        expect(result.dir).toBe(dir);
+        expect(result.same).toBe(true);
+        // No wrapper in front of the source: the throw site is where the file says.
+        expect(result.line).toContain(":1:" + (source.indexOf("new Error") + 1));
+
+        NSFileManager.defaultManager.removeItemAtPathError(dir, null);
+     });
+
+     it("loads 1,000 modules once each", function () {
+        var dir = NSTemporaryDirectory() + "cjs-startup-" + Date.now();
+        NSFileManager.defaultManager.createDirectoryAtPathWithIntermediateDirectoriesAttributesError(dir, true, null, null);
+        var count = 1000;
+        global.__cjsStartupEvaluations = 0;
+        for (var i = 0; i < count; i++) {
+            var source = "global.__cjsStartupEvaluations++;\nvar values = [];\n" +
+                "for (var j = 0; j < 32; j++) { values.push(j * " + i + "); }\n" +
+                "module.exports = values.length;\n";
+            NSString.stringWithString(source).writeToFileAtomicallyEncodingError(dir + "/m" + i + ".js", true, NSUTF8StringEncoding, null);
+        }
+        var entry = "var total = 0;\nfor (var i = 0; i < " + count + "; i++) { total += require('./m' + i + '.js'); }\n" +
+            "module.exports = total;\n";
+        NSString.stringWithString(entry).writeToFileAtomicallyEncodingError(dir + "/index.js", true, NSUTF8StringEncoding, null);
+
+        expect(require(dir + "/index.js")).toBe(count * 32);
+        expect(require(dir + "/m7.js")).toBe(32);
+        expect(global.__cjsStartupEvaluations).toBe(count);
+        delete global.__cjsStartupEvaluations;
+
+        NSFileManager.defaultManager.removeItemAtPathError(dir, null);
+     });
+
     //  it("'use strict'; statement is respected", function(){
     //     let requireFunc = () => require("./strict-violation-use-strict");
     //     expect(requireFunc).toThrowError("Cannot delete unqualified property 'x' in strict mode.");
@@ -18,9 +18,11 @@ describe("Node-API addon", function () {
         expect(typeof napi.releaseRef).toBe("function");
         expect(typeof napi.startAsyncWork).toBe("function");
         expect(typeof napi.startCancelledWork).toBe("function");
+        expect(typeof napi.startAsyncWorkBatch).toBe("function");
         expect(typeof napi.startTsfn).toBe("function");
         expect(typeof napi.pushTsfn).toBe("function");
         expect(typeof napi.probeTsfnAbort).toBe("function");
+        expect(typeof napi.startTsfnStress).toBe("function");
         expect(typeof napi.invokeViaMakeCallback).toBe("function");
         expect(typeof napi.exerciseCleanupHooks).toBe("function");
     });
@@ -188,6 +190,24 @@ describe("Node-API addon", function () {
                 done();
             });
         });
+
+        it("spreads a batch over the pool without exceeding its bound", function (done) {
+            napi.startAsyncWorkBatch(16, 20, function (result) {
+                // How many run at once depends on the device's cores; the
+                // spread is logged so runs can be compared.
+                console.log(
+                    "napi async work batch: " + result.peakRunning + " of " + result.maxThreads +
+                        " threads busy, " + result.completed + " completions in " +
+                        result.completionBatches + " runloop entries"
+                );
+                expect(result.maxThreads).not.toBeLessThan(4);
+                expect(result.peakRunning).not.toBeLessThan(1);
+                expect(result.peakRunning).not.toBeGreaterThan(result.maxThreads);
+                expect(result.completed).toBe(16);
+                expect(result.completionBatches).not.toBeGreaterThan(16);
+                done();
+            });
+        });
     });
 
     describe("napi_threadsafe_function", function () {
@@ -251,6 +271,100 @@ describe("Node-API addon", function () {
             );
         });
 
+        describe("under several producers", function () {
+            var PRODUCERS = 4;
+            var PER_PRODUCER = 5000;
+
+            function runStress(maxQueueSize, blocking, check, lockedQueue) {
+                var next = [];
+                var outOfOrder = 0;
+                var received = 0;
+                for (var i = 0; i < PRODUCERS; i++) {
+                    next.push(0);
+                }
+
+                napi.startTsfnStress(
+                    PRODUCERS,
+                    PER_PRODUCER,
+                    maxQueueSize,
+                    blocking,
+                    function (value) {
+                        var producer = Math.floor(value / 1000000);
+                        if (value % 1000000 !== next[producer]) {
+                            outOfOrder++;
+                        }
+                        next[producer] = (value % 1000000) + 1;
+                        received++;
+                    },
+                    function (result) {
+                        result.callsPerSecond = received / (result.elapsedMs / 1000);
+                        expect(result.status).toBe("ok");
+                        expect(outOfOrder).toBe(0);
+                        expect(received).toBe(PRODUCERS * PER_PRODUCER);
+                        expect(result.calls).toBe(PRODUCERS * PER_PRODUCER);
+                        expect(result.delivered).toBe(PRODUCERS * PER_PRODUCER);
+                        expect(result.dispatches).toBeLessThan(result.delivered);
+                        check(result);
+                    },
+                    !!lockedQueue
+                );
+            }
+
+            it("delivers every call in per-producer order without a bound", function (done) {
+                runStress(0, true, function (result) {
+                    expect(result.queueFull).toBe(0);
+                    expect(result.queueFullRetries).toBe(0);
+                    done();
+                });
+            });
+
+            it("blocks producers at the bound and never exceeds it", function (done) {
+                runStress(16, true, function (result) {
+                    expect(result.peakQueueDepth).toBeLessThan(17);
+                    expect(result.queueFull).toBe(0);
+                    done();
+                });
+            });
+
+            it("answers non-blocking calls at the bound with queue_full", function (done) {
+                runStress(16, false, function (result) {
+                    expect(result.peakQueueDepth).toBeLessThan(17);
+                    expect(result.queueFull).toBe(result.queueFullRetries);
+                    expect(result.blockedMs).toBe(0);
+                    done();
+                });
+            });
+
+            // The same load through the ring and through the mutex-guarded
+            // deque it replaced, one after the other in this run. Both must
+            // keep every call and its order; the ring must not be the slower
+            // by more than device noise explains.
+            [[0, true], [16, true]].forEach(function (mode) {
+                var maxQueueSize = mode[0];
+                var blocking = mode[1];
+                it("keeps pace with the locked queue (queue " + maxQueueSize + ")", function (done) {
+                    runStress(maxQueueSize, blocking, function (ring) {
+                        runStress(maxQueueSize, blocking, function (locked) {
+                            console.log(
+                                "napi tsfn stress (queue " + maxQueueSize + "): ring " +
+                                    Math.round(ring.callsPerSecond) + " calls/s, " +
+                                    ring.dispatches + " dispatches, blocked " +
+                                    ring.blockedMs.toFixed(2) + " ms; locked " +
+                                    Math.round(locked.callsPerSecond) + " calls/s, " +
+                                    locked.dispatches + " dispatches, blocked " +
+                                    locked.blockedMs.toFixed(2) + " ms"
+                            );
+                            if (maxQueueSize > 0) {
+                                expect(locked.peakQueueDepth).toBeLessThan(maxQueueSize + 1);
+                            }
+                            expect(ring.callsPerSecond).toBeGreaterThan(locked.callsPerSecond * 0.8);
+                            done();
+                        }, true);
+                    });
+                });
+            });
+        });
+
         it("reports closing after an abort and drops the queued call", function (done) {
             var delivered = [];
             var probe = napi.probeTsfnAbort(function (value) {
@@ -48,3 +48,79 @@ describe("Performance measure argument coercion", function () {
     expect(thrown && thrown.name).toBe("SyntaxError");
   });
 });
+
+describe("Performance runtime entries", function () {
+  it("Should list gc and longtask as supported entry types", function () {
+    expect(PerformanceObserver.supportedEntryTypes).toEqual(["gc", "longtask", "mark", "measure"]);
+  });
+
+  it("Should account event loop time as idle and active", function (done) {
+    const start = performance.eventLoopUtilization();
+    expect(start.idle).toBeGreaterThanOrEqual(0);
+    expect(start.active).toBeGreaterThan(0);
+    expect(start.utilization).toBeGreaterThan(0);
+    expect(start.utilization).toBeLessThanOrEqual(1);
+
+    // Mostly asleep: a 100ms timer with nothing else to do.
+    setTimeout(function () {
+      const delta = performance.eventLoopUtilization(start);
+      expect(delta.idle).toBeGreaterThan(50);
+      expect(delta.idle + delta.active).toBeGreaterThan(90);
+      expect(delta.utilization).toBeLessThan(0.5);
+
+      const between = performance.eventLoopUtilization(delta, { idle: 0, active: 0 });
+      expect(between.idle).toBe(delta.idle);
+      expect(between.active).toBe(delta.active);
+      expect(() => performance.eventLoopUtilization({})).toThrowError(TypeError);
+      done();
+    }, 100);
+  });
+
+  it("Should report a blocked event loop turn as a longtask", function (done) {
+    let blockedAt = 0;
+    const observer = new PerformanceObserver(function (list) {
+      const tasks = list.getEntriesByType("longtask");
+      if (tasks.length === 0) {
+        return;
+      }
+      observer.disconnect();
+      const task = tasks[tasks.length - 1];
+      expect(task instanceof PerformanceLongTaskTiming).toBe(true);
+      expect(task.name).toBe("self");
+      expect(task.duration).toBeGreaterThanOrEqual(80);
+      expect(task.startTime).toBeLessThanOrEqual(blockedAt);
+      expect(task.attribution).toEqual([]);
+      expect(performance.getEntriesByType("longtask")).toEqual([]);
+      done();
+    });
+    observer.observe({ type: "longtask" });
+
+    setTimeout(function () {
+      blockedAt = performance.now();
+      while (performance.now() - blockedAt < 80) {}
+    }, 0);
+  });
+
+  it("Should report collections as gc entries with kind and flags", function (done) {
+    const observer = new PerformanceObserver(function (list) {
+      // Scavenges may be reported too; wait for the full collection.
+      const full = list.getEntries().filter((e) => (e.detail.kind & 4) !== 0);
+      if (full.length === 0) {
+        return;
+      }
+      observer.disconnect();
+      const entry = full[0];
+      expect(entry.name).toBe("gc");
+      expect(entry.entryType).toBe("gc");
+      expect(entry.duration).toBeGreaterThanOrEqual(0);
+      expect(entry.startTime).toBeLessThanOrEqual(performance.now());
+      expect(typeof entry.detail.flags).toBe("number");
+      done();
+    });
+    observer.observe({ entryTypes: ["gc"] });
+
+    setTimeout(function () {
+      gc();
+    }, 0);
+  });
+});
@@ -152,6 +152,70 @@ describe("Promise scheduling", function () {
     });
 });
 
+describe("Promise thread affinity", function () {
+    it("leaves Promise the intrinsic constructor", function () {
+        expect(new Promise(() => {}).constructor).toBe(Promise);
+        expect((async () => {})().constructor).toBe(Promise);
+    });
+
+    it("resumes an await on the runtime loop after a background resolve", done => {
+        const expectedHash = NSThread.currentThread.hash;
+        (async () => {
+            const value = await new Promise(resolve => {
+                const queue = NSOperationQueue.alloc().init();
+                queue.addOperationWithBlock(() => resolve(42));
+            });
+            expect(value).toBe(42);
+            expect(NSThread.currentThread.hash).toBe(expectedHash);
+        })().then(done, error => {
+            expect(true).toBe(false, "The async function rejected: " + error);
+            done();
+        });
+    });
+
+    it("settles a promise created on a background thread on that thread", done => {
+        const mainHash = NSThread.currentThread.hash;
+        let backgroundHash = 0;
+        let settledHash = 0;
+        const queue = dispatch_get_global_queue(qos_class_t.QOS_CLASS_DEFAULT, 0);
+        dispatch_async(queue, () => {
+            backgroundHash = NSThread.currentThread.hash;
+            (async () => {
+                await Promise.resolve();
+                settledHash = NSThread.currentThread.hash;
+            })();
+        });
+
+        const check = () => {
+            if (settledHash === 0) {
+                setTimeout(check, 10);
+                return;
+            }
+            expect(settledHash).toBe(backgroundHash);
+            expect(settledHash).not.toBe(mainHash);
+            done();
+        };
+        check();
+    });
+
+    it("is the intrinsic Promise, not a wrapper", async () => {
+        // Async functions always return the intrinsic's instances, whatever
+        // the global Promise is.
+        const intrinsic = (async () => {})();
+        expect(intrinsic.constructor).toBe(Promise);
+        expect(Object.getPrototypeOf(intrinsic)).toBe(Promise.prototype);
+
+        let executorResolve;
+        const promise = new Promise(resolve => {
+            executorResolve = resolve;
+        });
+        expect(Object.getPrototypeOf(promise)).toBe(Promise.prototype);
+        expect(executorResolve.length).toBe(1);
+        executorResolve(42);
+        expect(await promise).toBe(42);
+    });
+});
+
 describe("unhandled rejections", function () {
     // Unhandled rejections are tracked per-isolate and reported once per runloop
     // turn (kCFRunLoopBeforeWaiting) through the same uncaught-error machinery
@@ -69,3 +69,72 @@ describe("structuredClone canary", () => {
     expect(typeof structuredClone).toBe("function");
   });
 });
+
+// Flat, primitive-only values and whole typed arrays take a compact encoding
+// instead of V8's serializer; these pin down that the two agree.
+describe("structuredClone fast path", () => {
+  it("round-trips primitives exactly", () => {
+    expect(Object.is(structuredClone(-0), -0)).toBe(true);
+    expect(Number.isNaN(structuredClone(NaN))).toBe(true);
+    expect(structuredClone(2 ** 40)).toBe(2 ** 40);
+    expect(structuredClone("café")).toBe("café");
+    expect(structuredClone("\u{1F600} wide")).toBe("\u{1F600} wide");
+    expect(structuredClone(null)).toBe(null);
+    expect(structuredClone(undefined)).toBe(undefined);
+  });
+
+  it("round-trips plain objects and arrays", () => {
+    const object = { a: 1, b: -0, c: "λ", d: true, e: null, f: undefined, 7: "index" };
+    const clone = structuredClone(object);
+    expect(clone).not.toBe(object);
+    expect(Object.keys(clone)).toEqual(Object.keys(object));
+    expect(Object.is(clone.b, -0)).toBe(true);
+    expect(clone.c).toBe("λ");
+    expect("f" in clone).toBe(true);
+    expect(Object.getPrototypeOf(clone)).toBe(Object.prototype);
+
+    const array = [1, 2.5, "x", false, null, undefined];
+    expect(structuredClone(array)).toEqual(array);
+    expect(Array.isArray(structuredClone(array))).toBe(true);
+  });
+
+  it("keeps what only the full serializer handles", () => {
+    const holey = [1, , 3];
+    expect(1 in structuredClone(holey)).toBe(false);
+
+    const match = "abc".match(/b/);
+    expect(structuredClone(match).index).toBe(1);
+
+    const nested = { inner: { value: 1 }, list: [[1], [2]] };
+    expect(structuredClone(nested)).toEqual(nested);
+
+    const date = new Date(0);
+    expect(structuredClone({ date }).date instanceof Date).toBe(true);
+  });
+
+  it("round-trips whole typed arrays", () => {
+    const small = new Uint8Array([1, 2, 3]);
+    expect(Array.from(structuredClone(small))).toEqual([1, 2, 3]);
+
+    const floats = new Float64Array(1024).map((_, i) => i / 3);
+    const clone = structuredClone(floats);
+    expect(clone instanceof Float64Array).toBe(true);
+    expect(clone.buffer).not.toBe(floats.buffer);
+    expect(clone[1023]).toBe(floats[1023]);
+
+    // A view over part of a buffer keeps its offset through the fallback.
+    const view = new Int16Array(new ArrayBuffer(16), 4, 2);
+    const viewClone = structuredClone(view);
+    expect(viewClone.byteOffset).toBe(4);
+    expect(viewClone.buffer.byteLength).toBe(16);
+  });
+
+  it("propagates a throwing getter", () => {
+    const object = {
+      get boom() {
+        throw new Error("getter");
+      },
+    };
+    expect(() => structuredClone(object)).toThrowError("getter");
+  });
+});
@@ -0,0 +1,70 @@
+// Native wrappers named in a postMessage transfer list cross to the worker by
+// handle; see docs/structured-clone.md.
+describe("Worker native object transfer", function () {
+    function roundTrip(value, transfer, echo, callback) {
+        const worker = new Worker("./nativeTransferWorker.js");
+        worker.onmessage = function (msg) {
+            worker.terminate();
+            callback(msg.data);
+        };
+        worker.postMessage({ value: value, echo: echo }, transfer);
+    }
+
+    it("sends an immutable NSData by handle and gets the same wrapper back", function (done) {
+        const data = NSMutableData.dataWithLength(1024).copy();
+        roundTrip(data, [data], true, function (reply) {
+            expect(reply.description).toBe("NSData:1024");
+            expect(reply.value).toBe(data);
+            done();
+        });
+    });
+
+    it("still degrades a native object left out of the transfer list", function (done) {
+        const data = NSMutableData.dataWithLength(16).copy();
+        roundTrip(data, undefined, false, function (reply) {
+            expect(reply.description).toBe("other:{}");
+            done();
+        });
+    });
+
+    it("refuses a mutable object before posting", function () {
+        const data = NSMutableData.dataWithLength(16);
+        let error;
+        try {
+            new Worker("./nativeTransferWorker.js").postMessage({ value: data }, [data]);
+        } catch (e) {
+            error = e;
+        }
+        expect(error && error.name).toBe("DataCloneError");
+        expect(String(error && error.message)).toContain("not thread-safe");
+    });
+
+    it("shares an interop.Pointer's address", function (done) {
+        const pointer = interop.alloc(16);
+        roundTrip(pointer, [pointer], false, function (reply) {
+            expect(reply.description).toBe("Pointer:" + pointer.toNumber());
+            interop.free(pointer);
+            done();
+        });
+    });
+
+    it("copies a struct with metadata", function (done) {
+        const rect = CGRectMake(10, 20, 30, 40);
+        roundTrip(rect, [rect], true, function (reply) {
+            expect(reply.description).toBe("CGRect:10,40");
+            expect(reply.value instanceof CGRect).toBe(true);
+            expect(reply.value.size.width).toBe(30);
+            done();
+        });
+    });
+
+    it("shares a large NSData's bytes instead of copying them", function (done) {
+        const size = 8 * 1024 * 1024;
+        const data = NSMutableData.dataWithLength(size).copy();
+        roundTrip(data, [data], false, function (reply) {
+            expect(reply.description).toBe("NSData:" + size);
+            expect(reply.address).toBe(data.bytes.toNumber());
+            done();
+        });
+    });
+});
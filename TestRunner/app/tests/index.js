@@ -140,6 +140,7 @@ require("./RuntimeImplementedAPIs");
 
 require("./Timers");
 require("./EventLoopTests");
+require("./WorkerNativeTransferTests");
 
 require("./URL");
 require("./URLSearchParams");
@@ -181,6 +182,7 @@ require("./PerformanceTests");
 
 // The ns:/node: builtin modules
 require("./NsUtilTests");
+require("./NsPerfTests");
 
 // Node-API addon surface
 require("./NapiTests");
@@ -0,0 +1,16 @@
+onmessage = function (msg) {
+    const value = msg.data.value;
+    let description;
+    let address;
+    if (value instanceof NSData) {
+        description = "NSData:" + value.length;
+        address = value.bytes.toNumber();
+    } else if (value instanceof interop.Pointer) {
+        description = "Pointer:" + value.toNumber();
+    } else if (value instanceof CGRect) {
+        description = "CGRect:" + value.origin.x + "," + value.size.height;
+    } else {
+        description = "other:" + JSON.stringify(value);
+    }
+    postMessage({ description: description, address: address, value: value }, msg.data.echo ? [value] : undefined);
+};
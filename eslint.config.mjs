@@ -82,10 +82,6 @@ export default [
         CGSize: 'readonly',
         UIEdgeInsets: 'readonly',
         NSRange: 'readonly',
-        CFRunLoopGetCurrent: 'readonly',
-        CFRunLoopPerformBlock: 'readonly',
-        CFRunLoopWakeUp: 'readonly',
-        kCFRunLoopDefaultMode: 'readonly',
         // Installed onto the global by inline-functions.js itself and
         // referenced by bare name from its sibling decorators:
         ObjCClass: 'readonly',
@@ -0,0 +1,228 @@
+// Writes a synthetic corpus of declarations to a metadata heap the way BinarySerializer does, once
+// with the generator's BinaryWriter and once with the writer it replaced, which wrote numbers a byte
+// at a time and interned strings in a std::map. Prints the best time of each and exits with 1 when
+// the two heaps are not byte for byte the same.
+//
+// Usage: binary-writer-benchmark [declarations (1000000)] [methods per declaration (4)] [runs (3)]
+
+#include "Binary/binaryWriter.h"
+#include "Utils/PhaseTimer.h"
+#include "Utils/memoryStream.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+using binary::MetaArrayCount;
+using binary::MetaFileOffset;
+
+// The BinaryWriter the generator used before, kept as the baseline
+class LegacyWriter {
+public:
+    LegacyWriter(std::shared_ptr<utils::Stream> stream)
+        : _stream(stream)
+    {
+    }
+
+    MetaFileOffset currentPosition() const
+    {
+        return _stream->position();
+    }
+
+    MetaFileOffset push_string(const std::string& str, bool shouldIntern = true)
+    {
+        if (shouldIntern && _uniqueStrings.count(str)) {
+            return _uniqueStrings[str];
+        }
+        MetaFileOffset offset = _stream->position();
+        for (char c : str) {
+            _stream->push_byte((uint8_t)c);
+        }
+        _stream->push_byte('\0');
+        if (shouldIntern) {
+            _uniqueStrings.emplace(str, offset);
+        }
+        return offset;
+    }
+
+    MetaFileOffset push_pointer(MetaFileOffset offset)
+    {
+        return push_number(offset, sizeof(MetaFileOffset));
+    }
+
+    MetaFileOffset push_arrayCount(MetaArrayCount count)
+    {
+        return push_number(count, sizeof(MetaArrayCount));
+    }
+
+    MetaFileOffset push_binaryArray(std::vector<MetaFileOffset>& binaryArray)
+    {
+        if (binaryArray.empty() && _emptyArrayOffset != 0) {
+            return _emptyArrayOffset;
+        }
+        MetaFileOffset offset = _stream->position();
+        push_arrayCount((MetaArrayCount)binaryArray.size());
+        for (MetaFileOffset element : binaryArray) {
+            push_pointer(element);
+        }
+        if (binaryArray.empty()) {
+            _emptyArrayOffset = offset;
+        }
+        return offset;
+    }
+
+    MetaFileOffset push_int(int32_t value)
+    {
+        return push_number(value, 4);
+    }
+
+    MetaFileOffset push_short(int16_t value)
+    {
+        return push_number(value, 2);
+    }
+
+    MetaFileOffset push_byte(uint8_t value)
+    {
+        MetaFileOffset offset = _stream->position();
+        _stream->push_byte(value);
+        return offset;
+    }
+
+private:
+    MetaFileOffset push_number(long number, int bytesCount)
+    {
+        MetaFileOffset offset = _stream->position();
+        for (int i = 0; i < bytesCount; i++) {
+            int pad = 8 * i;
+            _stream->push_byte((uint8_t)((number & (255L << pad)) >> pad));
+        }
+        return offset;
+    }
+
+    std::shared_ptr<utils::Stream> _stream;
+    std::map<std::string, MetaFileOffset> _uniqueStrings;
+    MetaFileOffset _emptyArrayOffset = 0;
+};
+
+// Names shaped like an SDK's: unique class names, some with a separate native name, and selectors,
+// property names and type names from shared vocabularies, so most strings are interning hits.
+struct Corpus {
+    Corpus(unsigned declarations, unsigned methodsPerDeclaration)
+        : methodsPerDeclaration(methodsPerDeclaration)
+    {
+        for (unsigned i = 0; i < declarations; i++) {
+            jsNames.push_back("Class" + std::to_string(i));
+            nativeNames.push_back(i % 4 == 0 ? "_TtC6Module" + std::to_string(i) : jsNames.back());
+        }
+        for (unsigned i = 0; i < 5000; i++) {
+            selectors.push_back("method" + std::to_string(i) + "WithObject:options:");
+        }
+        for (unsigned i = 0; i < 500; i++) {
+            typeNames.push_back("Struct" + std::to_string(i));
+        }
+    }
+
+    unsigned methodsPerDeclaration;
+    std::vector<std::string> jsNames;
+    std::vector<std::string> nativeNames;
+    std::vector<std::string> selectors;
+    std::vector<std::string> typeNames;
+};
+
+// Mirrors the calls BinarySerializer makes for an interface with its methods and their encodings
+template <class Writer>
+size_t writeCorpus(Writer& writer, const Corpus& corpus)
+{
+    writer.push_byte(0); // mark heap, as MetaFile does
+    MetaFileOffset module = writer.push_string("Module");
+    std::vector<MetaFileOffset> none;
+    std::vector<MetaFileOffset> offsets;
+    for (size_t i = 0; i < corpus.jsNames.size(); i++) {
+        std::vector<MetaFileOffset> methods;
+        for (unsigned j = 0; j < corpus.methodsPerDeclaration; j++) {
+            const std::string& selector = corpus.selectors[(i * 7 + j * 13) % corpus.selectors.size()];
+            MetaFileOffset names = writer.push_string(selector);
+            MetaFileOffset typeName = writer.push_string(corpus.typeNames[(i + j) % corpus.typeNames.size()]);
+            MetaFileOffset encodings = writer.push_arrayCount(3);
+            writer.push_byte(9); // a struct declaration reference
+            writer.push_pointer(typeName);
+            writer.push_byte(4);
+            writer.push_byte(15);
+            MetaFileOffset method = writer.push_pointer(names);
+            writer.push_pointer(module);
+            writer.push_byte(j % 2);
+            writer.push_byte(0);
+            writer.push_pointer(encodings);
+            methods.push_back(method);
+        }
+        MetaFileOffset jsName = writer.push_string(corpus.jsNames[i]);
+        MetaFileOffset names = jsName;
+        if (corpus.nativeNames[i] != corpus.jsNames[i]) {
+            MetaFileOffset nativeName = writer.push_string(corpus.nativeNames[i]);
+            names = writer.currentPosition();
+            writer.push_pointer(jsName);
+            writer.push_pointer(nativeName);
+        }
+        MetaFileOffset instanceMethods = writer.push_binaryArray(methods);
+        MetaFileOffset staticMethods = writer.push_binaryArray(none);
+        MetaFileOffset baseName = i == 0 ? 0 : writer.push_string(corpus.jsNames[i - 1]);
+        offsets.push_back(writer.push_pointer(names));
+        writer.push_pointer(module);
+        writer.push_byte(1);
+        writer.push_byte(0);
+        writer.push_pointer(instanceMethods);
+        writer.push_pointer(staticMethods);
+        writer.push_short(0);
+        writer.push_int(baseName);
+    }
+    writer.push_binaryArray(offsets);
+    return offsets.size();
+}
+
+template <class Writer>
+double bestOf(unsigned runs, const Corpus& corpus, std::shared_ptr<utils::MemoryStream>& heap)
+{
+    double best = 0;
+    for (unsigned run = 0; run < runs; run++) {
+        heap = std::make_shared<utils::MemoryStream>();
+        Writer writer(heap);
+        utils::PhaseTimer timer;
+        timer.start("run");
+        writeCorpus(writer, corpus);
+        timer.stop();
+        best = run == 0 ? timer.times()[0].second : std::min(best, timer.times()[0].second);
+    }
+    return best;
+}
+}
+
+int main(int argc, const char** argv)
+{
+    unsigned declarations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    unsigned methodsPerDeclaration = argc > 2 ? std::atoi(argv[2]) : 4;
+    unsigned runs = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3;
+
+    Corpus corpus(declarations, methodsPerDeclaration);
+    std::shared_ptr<utils::MemoryStream> legacyHeap;
+    std::shared_ptr<utils::MemoryStream> heap;
+    double legacyTime = bestOf<LegacyWriter>(runs, corpus, legacyHeap);
+    double time = bestOf<binary::BinaryWriter>(runs, corpus, heap);
+
+    std::cout << "Corpus: " << declarations << " declarations with " << methodsPerDeclaration << " methods each, " << heap->size() << " bytes of heap" << std::endl;
+    std::cout << "Best of " << runs << ":" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  byte writer and std::map   " << std::setw(9) << legacyTime << "s" << std::endl;
+    std::cout << "  BinaryWriter               " << std::setw(9) << time << "s  (" << std::setprecision(1) << legacyTime / time << "x)" << std::endl;
+
+    if (legacyHeap->size() != heap->size() || !std::equal(heap->begin(), heap->end(), legacyHeap->begin())) {
+        std::cerr << "error: the heaps differ" << std::endl;
+        return 1;
+    }
+    std::cout << "Heaps are identical" << std::endl;
+    return 0;
+}
@@ -0,0 +1,240 @@
+// Runs RemoveDuplicateMembersFilter and ResolveGlobalNamesCollisionsFilter over a synthetic corpus
+// shaped like a large SDK and prints the best time of each over several runs, with a checksum of
+// what they produced so that runs before and after a change to a filter can be compared.
+//
+// Usage: filters-benchmark [modules (40)] [classes per module (400)] [runs (5)]
+
+#include "Meta/Filters/RemoveDuplicateMembersFilter.h"
+#include "Meta/Filters/ResolveGlobalNamesCollisionsFilter.h"
+#include "Meta/TypeFactory.h"
+#include "Utils/PhaseTimer.h"
+#include <algorithm>
+#include <clang/Basic/Module.h>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+
+namespace {
+// Owns the metas and modules of one corpus. Every corpus built with the same sizes is the same.
+class SyntheticSdk {
+public:
+    SyntheticSdk(unsigned moduleCount, unsigned classesPerModule)
+        : _random(42)
+        , _types({ Meta::TypeFactory::getInt().get(), Meta::TypeFactory::getDouble().get(), Meta::TypeFactory::getBool().get(), Meta::TypeFactory::getCString().get(), Meta::TypeFactory::getSelector().get() })
+    {
+        // Selectors and property names come from vocabularies shared by all classes, so subclasses
+        // and adopted protocols redeclare inherited members the way SDK headers do.
+        clang::Module* foundation = addModule("Foundation");
+        Meta::InterfaceMeta* root = addInterface(foundation, "NSObject", nullptr, 120, 20, 10);
+        _interfaces.push_back(root);
+        _protocols.push_back(addProtocol(foundation, "NSObject", 40));
+
+        for (unsigned i = 0; i < moduleCount; i++) {
+            std::string moduleName = "Framework" + std::to_string(i);
+            clang::Module* module = addModule(moduleName);
+            clang::Module* submodule = new clang::Module(moduleName + "Private", clang::SourceLocation(), module, false, false, 0);
+            for (unsigned j = 0; j < classesPerModule; j++) {
+                clang::Module* owner = j % 3 == 0 ? submodule : module;
+                std::string name = moduleName + "Class" + std::to_string(j);
+                if (j % 5 == 0) {
+                    _protocols.push_back(addProtocol(owner, j % 100 == 0 ? moduleName + "Class" + std::to_string(j + 1) : name, 5 + _random() % 20));
+                } else {
+                    // bases are mostly recent classes, which makes for deep hierarchies
+                    size_t recent = std::min<size_t>(_interfaces.size(), 50);
+                    Meta::InterfaceMeta* base = _interfaces[_interfaces.size() - 1 - _random() % recent];
+                    _interfaces.push_back(addInterface(owner, name, base, 10 + _random() % 30, 2 + _random() % 6, 2 + _random() % 8));
+                }
+            }
+
+            // Globals, some named like a class and many sharing a name with another global
+            for (unsigned j = 0; j < classesPerModule / 2; j++) {
+                std::string name = j % 10 == 0 ? moduleName + "Class" + std::to_string(j) : moduleName + "Global" + std::to_string(_random() % (classesPerModule / 4 + 1));
+                switch (j % 5) {
+                case 0:
+                    addGlobal<Meta::FunctionMeta>(module, name);
+                    break;
+                case 1:
+                    addGlobal<Meta::StructMeta>(submodule, name);
+                    break;
+                case 2:
+                    addGlobal<Meta::EnumMeta>(module, name);
+                    break;
+                case 3:
+                    addGlobal<Meta::EnumConstantMeta>(module, name);
+                    break;
+                default:
+                    addGlobal<Meta::VarMeta>(submodule, name);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::list<Meta::Meta*> metas;
+
+    size_t memberCount() const
+    {
+        size_t count = 0;
+        for (Meta::Meta* meta : metas) {
+            if (meta->is(Meta::MetaType::Interface) || meta->is(Meta::MetaType::Protocol)) {
+                Meta::BaseClassMeta& baseClass = meta->as<Meta::BaseClassMeta>();
+                count += baseClass.instanceMethods.size() + baseClass.staticMethods.size() + baseClass.instanceProperties.size() + baseClass.staticProperties.size();
+            }
+        }
+        return count;
+    }
+
+private:
+    template <class T>
+    T* make(clang::Module* module, const std::string& name)
+    {
+        T* meta = new T();
+        _metas.emplace_back(meta);
+        meta->name = name;
+        meta->jsName = name;
+        meta->module = module;
+        return meta;
+    }
+
+    template <class T>
+    void addGlobal(clang::Module* module, const std::string& name)
+    {
+        metas.push_back(make<T>(module, name));
+    }
+
+    clang::Module* addModule(const std::string& name)
+    {
+        _modules.emplace_back(new clang::Module(name, clang::SourceLocation(), nullptr, true, false, 0));
+        return _modules.back().get();
+    }
+
+    // Most redeclarations repeat the signature; every eighth differs and is kept
+    Meta::MethodMeta* method(clang::Module* module, const std::string& selector)
+    {
+        Meta::MethodMeta* method = make<Meta::MethodMeta>(module, selector);
+        size_t seed = std::hash<std::string>()(selector) + (_random() % 8 == 0 ? 1 : 0);
+        for (size_t i = 0; i < 1 + seed % 3; i++) {
+            method->signature.push_back(_types[(seed + i) % _types.size()]);
+        }
+        return method;
+    }
+
+    Meta::PropertyMeta* property(clang::Module* module, const std::string& name)
+    {
+        Meta::PropertyMeta* property = make<Meta::PropertyMeta>(module, name);
+        property->getter = method(module, name);
+        if (_random() % 2 == 0) {
+            property->setter = method(module, "set" + name + ":");
+        }
+        return property;
+    }
+
+    void addMembers(Meta::BaseClassMeta* meta, unsigned instanceMethods, unsigned staticMethods, unsigned properties)
+    {
+        for (unsigned i = 0; i < instanceMethods; i++) {
+            meta->instanceMethods.push_back(method(meta->module, "instanceSelector" + std::to_string(_random() % 4000) + ":"));
+        }
+        for (unsigned i = 0; i < staticMethods; i++) {
+            meta->staticMethods.push_back(method(meta->module, "classSelector" + std::to_string(_random() % 800)));
+        }
+        for (unsigned i = 0; i < properties; i++) {
+            meta->instanceProperties.push_back(property(meta->module, "property" + std::to_string(_random() % 2000)));
+        }
+        if (_random() % 4 == 0) {
+            meta->staticProperties.push_back(property(meta->module, "shared" + std::to_string(_random() % 100)));
+        }
+        for (unsigned i = _random() % 4; i > 0 && !_protocols.empty(); i--) {
+            meta->protocols.push_back(_protocols[_random() % _protocols.size()]);
+        }
+    }
+
+    Meta::InterfaceMeta* addInterface(clang::Module* module, const std::string& name, Meta::InterfaceMeta* base, unsigned instanceMethods, unsigned staticMethods, unsigned properties)
+    {
+        Meta::InterfaceMeta* meta = make<Meta::InterfaceMeta>(module, name);
+        meta->base = base;
+        addMembers(meta, instanceMethods, staticMethods, properties);
+        metas.push_back(meta);
+        return meta;
+    }
+
+    Meta::ProtocolMeta* addProtocol(clang::Module* module, const std::string& name, unsigned instanceMethods)
+    {
+        Meta::ProtocolMeta* meta = make<Meta::ProtocolMeta>(module, name);
+        addMembers(meta, instanceMethods, 1, 2);
+        metas.push_back(meta);
+        return meta;
+    }
+
+    std::mt19937 _random;
+    std::vector<Meta::Type*> _types;
+    std::vector<Meta::InterfaceMeta*> _interfaces;
+    std::vector<Meta::ProtocolMeta*> _protocols;
+    std::vector<std::unique_ptr<Meta::Meta> > _metas;
+    // submodules are owned by their parent
+    std::vector<std::unique_ptr<clang::Module> > _modules;
+};
+
+// FNV-1a over the module names and the jsNames, in output order
+uint64_t checksumOf(const Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules& metasByModules)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const std::string& value) {
+        for (char c : value) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        hash = (hash ^ 0xff) * 1099511628211ull;
+    };
+    for (const std::pair<clang::Module*, std::vector<Meta::Meta*> >& module : metasByModules) {
+        add(module.first->Name);
+        for (Meta::Meta* meta : module.second) {
+            add(meta->jsName);
+        }
+    }
+    return hash;
+}
+}
+
+int main(int argc, const char** argv)
+{
+    unsigned modules = argc > 1 ? std::atoi(argv[1]) : 40;
+    unsigned classesPerModule = argc > 2 ? std::atoi(argv[2]) : 400;
+    unsigned runs = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    std::map<std::string, double> best;
+    for (unsigned run = 0; run < runs; run++) {
+        SyntheticSdk sdk(modules, classesPerModule);
+        if (run == 0) {
+            std::cout << "Corpus: " << sdk.metas.size() << " declarations with " << sdk.memberCount() << " members in " << modules + 1 << " modules" << std::endl;
+        }
+
+        utils::PhaseTimer timer;
+        timer.start("RemoveDuplicateMembers");
+        Meta::RemoveDuplicateMembersFilter().filter(sdk.metas);
+        timer.start("ResolveGlobalNamesCollisions");
+        Meta::ResolveGlobalNamesCollisionsFilter filter;
+        filter.filter(sdk.metas);
+        std::unique_ptr<std::pair<Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules, Meta::ResolveGlobalNamesCollisionsFilter::InterfacesByName> > result = filter.getResult();
+        timer.stop();
+
+        std::cout << "Run " << run + 1 << ":" << std::endl;
+        timer.print(std::cout);
+        for (const std::pair<std::string, double>& time : timer.times()) {
+            auto it = best.find(time.first);
+            if (it == best.end() || time.second < it->second) {
+                best[time.first] = time.second;
+            }
+        }
+        if (run == 0) {
+            std::cout << "Checksum: " << sdk.memberCount() << " members kept, names " << std::hex << checksumOf(result->first) << std::dec << std::endl;
+        }
+    }
+
+    std::cout << "Best of " << runs << ":" << std::endl;
+    for (const std::pair<const std::string, double>& time : best) {
+        std::cout << "  " << time.first << "  " << time.second << " sec" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,753 @@
+// Loads a metadata.bin written by the generator with the runtime's own reader (MetadataFormat.h),
+// checks that every table, entry, member and type encoding in it lies within the file and is
+// consistent, then prints the shape of the lookup tables and the best time of the lookups the
+// runtime does most: global names that exist, names that don't, walking the members of every
+// class and decoding their type encodings.
+//
+// Usage: metadata-reader-benchmark <metadata.bin> [runs (5)] [profile]
+//
+// With a profile (a metadata profile or usage trace, one name first on each line) it also counts
+// the pages of the file touched by resolving those names in order.
+//
+// Exits with 1 when the file has errors. References to declarations that are not in the file
+// (private or pruned ones) are only counted, since the runtime resolves those lazily.
+
+#include "MetadataFormat.h"
+#include "Utils/PhaseTimer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+using tns::ArrayCount;
+using tns::BinaryTypeEncodingType;
+
+const size_t MetaHeaderSize = 11; // names, top level module, flags, introduced
+const size_t BaseClassMetaSize = MetaHeaderSize + 5 * sizeof(int32_t) + sizeof(int16_t);
+const size_t ErrorsPrinted = 20;
+
+struct TableStats {
+    std::string name;
+    size_t buckets = 0;
+    size_t entries = 0;
+    size_t emptyBuckets = 0;
+    size_t longestBucket = 0;
+    // Comparisons made by findMeta: a hit stops at the entry, a miss scans the whole bucket
+    double meanHitProbes = 0;
+    double meanMissProbes = 0;
+};
+
+// Checks the file through offsets relative to its heap before the reader follows them, so that a
+// corrupt file is reported instead of read out of bounds.
+class MetadataValidator {
+public:
+    MetadataValidator(const std::vector<char>& file)
+        : _file(file)
+    {
+    }
+
+    size_t errorCount() const
+    {
+        return _errors;
+    }
+
+    size_t unresolvedReferences() const
+    {
+        return _unresolved;
+    }
+
+    const std::vector<TableStats>& tables() const
+    {
+        return _tables;
+    }
+
+    const std::vector<const tns::Meta*>& metas() const
+    {
+        return _metas;
+    }
+
+    bool validateLayout()
+    {
+        // Each table starts where the one before it ends, so its count has to be checked before
+        // the reader computes the next one's address
+        size_t offset = 0;
+        for (const char* table : { "JS names", "native protocols", "native interfaces", "modules", "pruned symbols" }) {
+            ArrayCount count;
+            if (offset + sizeof(count) > _file.size()) {
+                return error(std::string("the ") + table + " table is past the end of the file");
+            }
+            std::memcpy(&count, _file.data() + offset, sizeof(count));
+            if (count < 0 || offset + sizeof(count) + size_t(count) * sizeof(int32_t) > _file.size()) {
+                return error(std::string("the ") + table + " table has an invalid count " + std::to_string(count));
+            }
+            offset += sizeof(count) + size_t(count) * sizeof(int32_t);
+        }
+        _heap = static_cast<const char*>(tns::MetaFile::instance()->heap());
+        _heapSize = _file.size() - (_heap - _file.data());
+        return true;
+    }
+
+    void validate()
+    {
+        const tns::MetaFile* file = tns::MetaFile::instance();
+        validateModules(*file->topLevelModulesTable());
+        validateTable(*file->globalTableJs(), "JS names", [](const tns::Meta*) { return true; });
+        validateTable(*file->globalTableNativeProtocols(), "native protocols", [](const tns::Meta* meta) { return meta->type() == tns::ProtocolType; });
+        // The generator puts every native name that isn't a protocol's in the interfaces table
+        validateTable(*file->globalTableNativeInterfaces(), "native interfaces", [](const tns::Meta* meta) { return meta->type() != tns::ProtocolType; });
+
+        const tns::Array<tns::PrunedSymbol>& pruned = *file->prunedSymbols();
+        for (ArrayCount i = 0; i < pruned.count; i++) {
+            if (!isString(pruned[i].name.offset)) {
+                error("the pruned symbol at index " + std::to_string(i) + " has an invalid name");
+                break;
+            }
+            if (i > 0 && pruned[i - 1].hash > pruned[i].hash) {
+                error("the pruned symbols are not sorted at index " + std::to_string(i));
+                break;
+            }
+        }
+
+        // Global names are checked while walking the tables, so entries are validated once they
+        // are known to be readable
+        for (const tns::Meta* meta : _metas) {
+            validateMeta(meta);
+        }
+    }
+
+private:
+    bool error(const std::string& message)
+    {
+        if (_errors++ < ErrorsPrinted) {
+            std::cerr << "error: " << message << std::endl;
+        }
+        return false;
+    }
+
+    bool inHeap(int32_t offset, size_t size) const
+    {
+        return offset > 0 && size_t(offset) + size <= _heapSize;
+    }
+
+    template <class T>
+    bool inHeap(const T* pointer, size_t size) const
+    {
+        const char* bytes = reinterpret_cast<const char*>(pointer);
+        return bytes > _heap && bytes + size <= _heap + _heapSize;
+    }
+
+    bool isString(int32_t offset) const
+    {
+        return inHeap(offset, 1) && std::memchr(_heap + offset, 0, _heapSize - offset) != nullptr;
+    }
+
+    template <class T>
+    bool isArray(int32_t offset, size_t elementSize = sizeof(T)) const
+    {
+        if (!inHeap(offset, sizeof(ArrayCount))) {
+            return false;
+        }
+        ArrayCount count;
+        std::memcpy(&count, _heap + offset, sizeof(count));
+        return count >= 0 && inHeap(offset, sizeof(count) + size_t(count) * elementSize);
+    }
+
+    bool isStringArray(int32_t offset) const
+    {
+        if (!isArray<tns::String>(offset)) {
+            return false;
+        }
+        for (const tns::String& string : *reinterpret_cast<const tns::Array<tns::String>*>(_heap + offset)) {
+            if (!isString(string.offset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Reads the offsets a structure stores at \p at, which need not be aligned
+    bool readOffsets(const char* at, int32_t* offsets, size_t count) const
+    {
+        if (!inHeap(at, count * sizeof(int32_t))) {
+            return false;
+        }
+        std::memcpy(offsets, at, count * sizeof(int32_t));
+        return true;
+    }
+
+    bool validateNames(const tns::Meta* meta, const std::string& where)
+    {
+        int32_t names;
+        std::memcpy(&names, meta, sizeof(names));
+        if (!meta->hasName() && !meta->hasDemangledName()) {
+            return isString(names) || error(where + " has an invalid name");
+        }
+        size_t count = 1 + meta->hasName() + meta->hasDemangledName();
+        if (!inHeap(names, count * sizeof(tns::String))) {
+            return error(where + " has invalid names");
+        }
+        const tns::String* strings = reinterpret_cast<const tns::String*>(_heap + names);
+        for (size_t i = 0; i < count; i++) {
+            if (!isString(strings[i].offset)) {
+                return error(where + " has an invalid name");
+            }
+        }
+        return true;
+    }
+
+    // Returns the end of the encoding, or null when it leaves the heap or has an unknown type
+    const tns::TypeEncoding* walkEncoding(const tns::TypeEncoding* encoding, int depth = 0)
+    {
+        if (depth > 64 || !inHeap(encoding, 1) || encoding->type > BinaryTypeEncodingType::ExtVectorEncoding) {
+            return nullptr;
+        }
+        const tns::TypeEncodingDetails& details = encoding->details;
+        const char* afterType = reinterpret_cast<const char*>(&details);
+        switch (encoding->type) {
+        case BinaryTypeEncodingType::IdEncoding:
+            if (!inHeap(afterType, sizeof(details.idDetails)) || !isStringArray(details.idDetails._protocols.offset)) {
+                return nullptr;
+            }
+            return reinterpret_cast<const tns::TypeEncoding*>(afterType + sizeof(details.idDetails));
+        case BinaryTypeEncodingType::InterfaceDeclarationReference:
+            if (!inHeap(afterType, sizeof(details.interfaceDeclarationReference)) || !isString(details.interfaceDeclarationReference.name.offset) || !isStringArray(details.interfaceDeclarationReference._protocols.offset)) {
+                return nullptr;
+            }
+            resolve(details.interfaceDeclarationReference.name.valuePtr(), tns::Interface);
+            return reinterpret_cast<const tns::TypeEncoding*>(afterType + sizeof(details.interfaceDeclarationReference));
+        case BinaryTypeEncodingType::StructDeclarationReference:
+        case BinaryTypeEncodingType::UnionDeclarationReference:
+            if (!inHeap(afterType, sizeof(details.declarationReference)) || !isString(details.declarationReference.name.offset)) {
+                return nullptr;
+            }
+            resolve(details.declarationReference.name.valuePtr(), encoding->type == BinaryTypeEncodingType::StructDeclarationReference ? tns::Struct : tns::Union);
+            return reinterpret_cast<const tns::TypeEncoding*>(afterType + sizeof(details.declarationReference));
+        case BinaryTypeEncodingType::ConstantArrayEncoding:
+        case BinaryTypeEncodingType::ExtVectorEncoding:
+            if (!inHeap(afterType, sizeof(int32_t))) {
+                return nullptr;
+            }
+            return walkEncoding(reinterpret_cast<const tns::TypeEncoding*>(afterType + sizeof(int32_t)), depth + 1);
+        case BinaryTypeEncodingType::IncompleteArrayEncoding:
+        case BinaryTypeEncodingType::PointerEncoding:
+            return walkEncoding(reinterpret_cast<const tns::TypeEncoding*>(afterType), depth + 1);
+        case BinaryTypeEncodingType::BlockEncoding:
+        case BinaryTypeEncodingType::FunctionPointerEncoding: {
+            if (!inHeap(afterType, sizeof(uint8_t))) {
+                return nullptr;
+            }
+            const tns::TypeEncodingsList<uint8_t>& signature = details.block.signature;
+            return walkEncodings(signature.first(), signature.count, depth + 1);
+        }
+        case BinaryTypeEncodingType::AnonymousStructEncoding:
+        case BinaryTypeEncodingType::AnonymousUnionEncoding: {
+            if (!inHeap(afterType, sizeof(uint8_t)) || !inHeap(details.anonymousRecord.getFieldNames(), details.anonymousRecord.fieldsCount * sizeof(tns::String))) {
+                return nullptr;
+            }
+            for (uint8_t i = 0; i < details.anonymousRecord.fieldsCount; i++) {
+                if (!isString(details.anonymousRecord.getFieldNames()[i].offset)) {
+                    return nullptr;
+                }
+            }
+            return walkEncodings(details.anonymousRecord.getFieldsEncodings(), details.anonymousRecord.fieldsCount, depth + 1);
+        }
+        default:
+            return reinterpret_cast<const tns::TypeEncoding*>(afterType);
+        }
+    }
+
+    const tns::TypeEncoding* walkEncodings(const tns::TypeEncoding* encoding, int count, int depth = 0)
+    {
+        for (int i = 0; i < count && encoding != nullptr; i++) {
+            const tns::TypeEncoding* end = walkEncoding(encoding, depth);
+            // The runtime only has next() to step over an encoding, so it has to agree
+            if (end != nullptr && end != encoding->next()) {
+                return nullptr;
+            }
+            encoding = end;
+        }
+        return encoding;
+    }
+
+    bool validateEncodings(int32_t offset, ArrayCount minimumCount, const std::string& where)
+    {
+        if (!inHeap(offset, sizeof(ArrayCount))) {
+            return error(where + " has invalid type encodings");
+        }
+        const tns::TypeEncodingsList<ArrayCount>* encodings = reinterpret_cast<const tns::TypeEncodingsList<ArrayCount>*>(_heap + offset);
+        if (encodings->count < minimumCount) {
+            return error(where + " has " + std::to_string(encodings->count) + " type encodings");
+        }
+        return walkEncodings(encodings->first(), encodings->count) != nullptr || error(where + " has an invalid type encoding");
+    }
+
+    void resolve(const char* name, tns::MetaType type)
+    {
+        const tns::Meta* meta = tns::MetaFile::instance()->globalTableJs()->findMeta(name, false);
+        if (meta == nullptr || meta->type() != type) {
+            _unresolved++;
+        }
+    }
+
+    void validateModules(const tns::ModuleTable& table)
+    {
+        for (const tns::PtrTo<tns::ModuleMeta>& module : table.modules) {
+            if (!inHeap(module.offset, sizeof(tns::ModuleMeta)) || !isString(module->name.offset) || !isArray<tns::PtrTo<tns::LibraryMeta> >(module->libraries.offset)) {
+                error("module at " + std::to_string(module.offset) + " is invalid");
+                continue;
+            }
+            for (const tns::PtrTo<tns::LibraryMeta>& library : module->libraries.value()) {
+                if (!inHeap(library.offset, sizeof(tns::LibraryMeta)) || !isString(library->name.offset)) {
+                    error(std::string("module ") + module->getName() + " has an invalid library");
+                }
+            }
+        }
+    }
+
+    template <tns::GlobalTableType TYPE, class Predicate>
+    void validateTable(const tns::GlobalTable<TYPE>& table, const std::string& name, const Predicate& hasType)
+    {
+        TableStats stats;
+        stats.name = name;
+        stats.buckets = table.buckets.count;
+        size_t hitProbes = 0;
+        for (ArrayCount i = 0; i < table.buckets.count; i++) {
+            const tns::PtrTo<tns::ArrayOfPtrTo<tns::Meta> >& bucket = table.buckets[i];
+            if (bucket.isNull()) {
+                stats.emptyBuckets++;
+                continue;
+            }
+            if (!isArray<tns::PtrTo<tns::Meta> >(bucket.offset)) {
+                error("bucket " + std::to_string(i) + " of the " + name + " table is invalid");
+                continue;
+            }
+            size_t length = 0;
+            for (const tns::PtrTo<tns::Meta>& entry : bucket.value()) {
+                std::string where = "entry " + std::to_string(entry.offset) + " in bucket " + std::to_string(i) + " of the " + name + " table";
+                if (!inHeap(entry.offset, MetaHeaderSize) || !validateNames(entry.valuePtr(), where)) {
+                    error(where + " is invalid");
+                    continue;
+                }
+                const tns::Meta* meta = entry.valuePtr();
+                if (meta->type() == tns::Undefined || !hasType(meta)) {
+                    error(where + " has type " + meta->typeName());
+                    continue;
+                }
+                const char* key = TYPE == tns::ByJsName ? meta->jsName() : meta->name();
+                if (!inBucket(key, i, table.buckets.count) && !(TYPE == tns::ByNativeName && meta->hasDemangledName() && inBucket(meta->demangledName(), i, table.buckets.count))) {
+                    error(where + " (" + key + ") is in the wrong bucket");
+                }
+                if (TYPE == tns::ByJsName) {
+                    _metas.push_back(meta);
+                }
+                length++;
+                hitProbes += length;
+            }
+            stats.entries += length;
+            stats.emptyBuckets += length == 0;
+            stats.longestBucket = std::max(stats.longestBucket, length);
+        }
+        stats.meanHitProbes = stats.entries != 0 ? double(hitProbes) / stats.entries : 0;
+        stats.meanMissProbes = stats.buckets != 0 ? double(stats.entries) / stats.buckets : 0;
+        _tables.push_back(stats);
+    }
+
+    static bool inBucket(const char* name, ArrayCount bucket, ArrayCount buckets)
+    {
+        unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(name));
+        return ArrayCount(hash % buckets) == bucket;
+    }
+
+    template <class T>
+    bool validateMembers(const tns::PtrTo<tns::ArrayOfPtrTo<T> >& members, const std::string& where)
+    {
+        if (!isArray<tns::PtrTo<T> >(members.offset)) {
+            return error(where + " has an invalid members array");
+        }
+        for (const tns::PtrTo<T>& member : members.value()) {
+            validateMember(member, where);
+        }
+        return true;
+    }
+
+    void validateMember(const tns::PtrTo<tns::MethodMeta>& method, const std::string& where)
+    {
+        // The constructor tokens are only written when the method has them
+        if (!inHeap(method.offset, MetaHeaderSize + sizeof(int32_t)) || !validateNames(method.valuePtr(), where + " method")) {
+            error(where + " has an invalid method");
+            return;
+        }
+        std::string name = where + " method " + method->jsName();
+        int32_t fields[2];
+        bool hasConstructorTokens = method->flag(tns::MethodHasConstructorTokens);
+        if (!readOffsets(reinterpret_cast<const char*>(method.valuePtr()) + MetaHeaderSize, fields, hasConstructorTokens ? 2 : 1)) {
+            error(name + " is truncated");
+            return;
+        }
+        validateEncodings(fields[0], 1, name);
+        if (hasConstructorTokens && !isString(fields[1])) {
+            error(name + " has invalid constructor tokens");
+        }
+    }
+
+    void validateMember(const tns::PtrTo<tns::PropertyMeta>& property, const std::string& where)
+    {
+        if (!inHeap(property.offset, MetaHeaderSize) || !validateNames(property.valuePtr(), where + " property")) {
+            error(where + " has an invalid property");
+            return;
+        }
+        // Like the constructor tokens, only the accessors the property has are written
+        std::string name = where + " property " + property->jsName();
+        size_t accessors = property->hasGetter() + property->hasSetter();
+        if (!inHeap(property.offset, MetaHeaderSize + accessors * sizeof(int32_t))) {
+            error(name + " is truncated");
+            return;
+        }
+        for (size_t i = 0; i < accessors; i++) {
+            validateMember(i == 0 ? property->method1 : property->method2, name);
+        }
+    }
+
+    void validateMeta(const tns::Meta* meta)
+    {
+        std::string where = std::string(meta->typeName()) + " " + meta->jsName();
+        if (meta->topLevelModule() != nullptr && !inHeap(meta->topLevelModule(), sizeof(tns::ModuleMeta))) {
+            error(where + " has an invalid module");
+        }
+        const char* afterHeader = reinterpret_cast<const char*>(meta) + MetaHeaderSize;
+        int32_t fields[2];
+        switch (meta->type()) {
+        case tns::Struct:
+        case tns::Union: {
+            if (!readOffsets(afterHeader, fields, 2) || !isStringArray(fields[0])) {
+                error(where + " has invalid field names");
+                break;
+            }
+            const tns::RecordMeta* record = static_cast<const tns::RecordMeta*>(meta);
+            if (validateEncodings(fields[1], 0, where) && ArrayCount(record->fieldsCount()) != record->fieldsEncodings()->count) {
+                error(where + " has " + std::to_string(record->fieldsCount()) + " field names and " + std::to_string(record->fieldsEncodings()->count) + " field encodings");
+            }
+            break;
+        }
+        case tns::Function:
+            if (!readOffsets(afterHeader, fields, 1)) {
+                error(where + " is truncated");
+            } else {
+                validateEncodings(fields[0], 1, where);
+            }
+            break;
+        case tns::JsCode:
+            if (!readOffsets(afterHeader, fields, 1) || !isString(fields[0])) {
+                error(where + " has invalid code");
+            }
+            break;
+        case tns::Var:
+            if (!readOffsets(afterHeader, fields, 1) || walkEncodings(reinterpret_cast<const tns::TypeEncoding*>(_heap + fields[0]), 1) == nullptr) {
+                error(where + " has an invalid type encoding");
+            }
+            break;
+        case tns::Interface:
+        case tns::ProtocolType: {
+            size_t size = BaseClassMetaSize + (meta->type() == tns::Interface ? sizeof(int32_t) : 0);
+            if (!inHeap(meta, size)) {
+                error(where + " is truncated");
+                break;
+            }
+            const tns::BaseClassMeta* baseClass = static_cast<const tns::BaseClassMeta*>(meta);
+            bool membersValid = validateMembers(baseClass->instanceMethods, where) & validateMembers(baseClass->staticMethods, where);
+            validateMembers(baseClass->instanceProps, where);
+            validateMembers(baseClass->staticProps, where);
+            if (!isStringArray(baseClass->protocols.offset)) {
+                error(where + " has invalid protocols");
+            } else {
+                for (const tns::String& protocol : baseClass->protocols.value()) {
+                    resolve(protocol.valuePtr(), tns::ProtocolType);
+                }
+            }
+            if (membersValid && baseClass->initializersStartIndex != -1 && (baseClass->initializersStartIndex < 0 || baseClass->initializersStartIndex > baseClass->instanceMethods->count)) {
+                error(where + " has an invalid initializers index");
+            }
+            if (meta->type() == tns::Interface) {
+                int32_t baseName;
+                std::memcpy(&baseName, reinterpret_cast<const char*>(meta) + BaseClassMetaSize, sizeof(baseName));
+                if (baseName != 0 && !isString(baseName)) {
+                    error(where + " has an invalid base class name");
+                } else if (baseName != 0) {
+                    resolve(_heap + baseName, tns::Interface);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    const std::vector<char>& _file;
+    const char* _heap = nullptr;
+    size_t _heapSize = 0;
+    size_t _errors = 0;
+    size_t _unresolved = 0;
+    std::vector<TableStats> _tables;
+    std::vector<const tns::Meta*> _metas;
+};
+
+// Work that keeps the optimizer from dropping the lookups
+volatile uintptr_t sink;
+
+template <class Function>
+double bestOf(unsigned runs, const Function& function)
+{
+    double best = 0;
+    for (unsigned run = 0; run < runs; run++) {
+        utils::PhaseTimer timer;
+        timer.start("run");
+        function();
+        timer.stop();
+        best = run == 0 ? timer.times()[0].second : std::min(best, timer.times()[0].second);
+    }
+    return best;
+}
+
+void printRate(const std::string& name, size_t operations, double seconds)
+{
+    std::cout << "  " << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1) << std::setw(10) << seconds * 1e9 / operations << " ns/op" << std::setw(14) << std::setprecision(0) << operations / seconds << " ops/sec" << std::endl;
+}
+
+// Counts the pages of the file the runtime reads to resolve a list of names in order: the bucket
+// each name hashes to, the entries it compares on the way, and for classes and protocols their
+// members, member names and type encodings. An offline stand-in for the page faults of a launch,
+// to compare the layouts written with and without an access profile.
+class PageTracker {
+public:
+    static const size_t PageSize = 16 * 1024;
+
+    PageTracker(const std::vector<char>& file)
+        : _file(file)
+    {
+    }
+
+    size_t pagesTouched() const
+    {
+        return _pages.size();
+    }
+
+    // Returns whether the name was found
+    bool resolve(const std::string& name)
+    {
+        const tns::GlobalTable<tns::ByJsName>* table = tns::MetaFile::instance()->globalTableJs();
+        unsigned hash = WTF::StringHasher::computeHashAndMaskTop8Bits<LChar>(reinterpret_cast<const LChar*>(name.c_str()));
+        const tns::PtrTo<tns::ArrayOfPtrTo<tns::Meta> >& bucket = table->buckets[hash % table->buckets.count];
+        touch(&bucket, sizeof(bucket));
+        if (bucket.isNull()) {
+            return false;
+        }
+        touchArray(bucket.value());
+        for (const tns::PtrTo<tns::Meta>& entry : bucket.value()) {
+            const tns::Meta* meta = entry.valuePtr();
+            touch(meta, MetaHeaderSize);
+            touchString(meta->jsName());
+            if (name == meta->jsName()) {
+                touchMembers(meta);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    void touch(const void* pointer, size_t size)
+    {
+        size_t begin = static_cast<const char*>(pointer) - _file.data();
+        for (size_t page = begin / PageSize; page <= (begin + std::max<size_t>(size, 1) - 1) / PageSize; page++) {
+            _pages.insert(page);
+        }
+    }
+
+    void touchString(const char* string)
+    {
+        touch(string, std::strlen(string) + 1);
+    }
+
+    template <class T>
+    void touchArray(const tns::Array<T>& array)
+    {
+        touch(&array, sizeof(ArrayCount) + size_t(array.count) * sizeof(T));
+    }
+
+    void touchEncodings(const tns::TypeEncodingsList<ArrayCount>* encodings)
+    {
+        const tns::TypeEncoding* end = encodings->first();
+        for (ArrayCount i = 0; i < encodings->count; i++) {
+            end = end->next();
+        }
+        touch(encodings, reinterpret_cast<const char*>(end) - reinterpret_cast<const char*>(encodings));
+    }
+
+    void touchMembers(const tns::Meta* meta)
+    {
+        if (meta->type() != tns::Interface && meta->type() != tns::ProtocolType) {
+            return;
+        }
+        const tns::BaseClassMeta* baseClass = static_cast<const tns::BaseClassMeta*>(meta);
+        touch(baseClass, BaseClassMetaSize);
+        for (const tns::ArrayOfPtrTo<tns::MethodMeta>* methods : { &baseClass->instanceMethods.value(), &baseClass->staticMethods.value() }) {
+            touchArray(*methods);
+            for (const tns::PtrTo<tns::MethodMeta>& method : *methods) {
+                touch(method.valuePtr(), MetaHeaderSize + sizeof(int32_t));
+                touchString(method->jsName());
+                touchString(method->selectorAsString());
+                touchEncodings(method->encodings());
+            }
+        }
+        for (const tns::ArrayOfPtrTo<tns::PropertyMeta>* properties : { &baseClass->instanceProps.value(), &baseClass->staticProps.value() }) {
+            touchArray(*properties);
+            for (const tns::PtrTo<tns::PropertyMeta>& property : *properties) {
+                touch(property.valuePtr(), MetaHeaderSize);
+                touchString(property->jsName());
+            }
+        }
+    }
+
+    const std::vector<char>& _file;
+    std::set<size_t> _pages;
+};
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <metadata.bin> [runs] [profile]" << std::endl;
+        return 2;
+    }
+    unsigned runs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        std::cerr << "Unable to open '" << argv[1] << "'." << std::endl;
+        return 2;
+    }
+    std::vector<char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    tns::MetaFile::setInstance(file.data());
+
+    MetadataValidator validator(file);
+    if (!validator.validateLayout()) {
+        return 1;
+    }
+    validator.validate();
+    const tns::MetaFile* metaFile = tns::MetaFile::instance();
+    std::cout << argv[1] << ": " << file.size() << " bytes, " << validator.metas().size() << " declarations, " << metaFile->topLevelModulesTable()->modules.count << " modules, " << metaFile->prunedSymbols()->count << " pruned" << std::endl;
+    std::cout << "Validation: " << validator.errorCount() << " errors, " << validator.unresolvedReferences() << " references to declarations not in the file" << std::endl;
+
+    std::cout << "Tables:" << std::endl;
+    for (const TableStats& table : validator.tables()) {
+        std::cout << "  " << std::left << std::setw(18) << table.name << std::right << std::fixed << std::setprecision(2) << std::setw(7) << table.buckets << " buckets" << std::setw(7) << table.entries << " entries" << std::setw(7) << table.emptyBuckets << " empty" << "  load " << double(table.entries) / std::max<size_t>(table.buckets, 1) << "  longest " << table.longestBucket << "  probes hit " << table.meanHitProbes << " miss " << table.meanMissProbes << std::endl;
+    }
+    if (validator.errorCount() != 0) {
+        return 1;
+    }
+
+    // Lookups in a fixed random order, so that they don't walk the heap sequentially
+    std::vector<std::string> names;
+    std::vector<std::string> missingNames;
+    for (const tns::Meta* meta : validator.metas()) {
+        names.push_back(meta->jsName());
+        missingNames.push_back(std::string(meta->jsName()) + "$");
+    }
+    std::shuffle(names.begin(), names.end(), std::mt19937(42));
+    std::shuffle(missingNames.begin(), missingNames.end(), std::mt19937(43));
+    if (names.empty()) {
+        return 0;
+    }
+
+    const tns::GlobalTable<tns::ByJsName>* globalTable = metaFile->globalTableJs();
+    std::cout << "Best of " << runs << ":" << std::endl;
+    printRate("global lookup hit", names.size(), bestOf(runs, [&]() {
+        for (const std::string& name : names) {
+            sink = sink + reinterpret_cast<uintptr_t>(globalTable->findMeta(name.c_str()));
+        }
+    }));
+    printRate("global lookup miss", missingNames.size(), bestOf(runs, [&]() {
+        for (const std::string& name : missingNames) {
+            // What the runtime does for a global that isn't there
+            sink = sink + reinterpret_cast<uintptr_t>(globalTable->findMeta(name.c_str())) + metaFile->isPruned(name.c_str());
+        }
+    }));
+
+    size_t members = 0;
+    size_t encodings = 0;
+    double membersTime = bestOf(runs, [&]() {
+        members = 0;
+        for (const tns::Meta* meta : validator.metas()) {
+            if (meta->type() != tns::Interface && meta->type() != tns::ProtocolType) {
+                continue;
+            }
+            const tns::BaseClassMeta* baseClass = static_cast<const tns::BaseClassMeta*>(meta);
+            for (const tns::ArrayOfPtrTo<tns::MethodMeta>* methods : { &baseClass->instanceMethods.value(), &baseClass->staticMethods.value() }) {
+                for (const tns::PtrTo<tns::MethodMeta>& method : *methods) {
+                    sink = sink + reinterpret_cast<uintptr_t>(method->jsName()) + method->selectorAsString()[0];
+                    members++;
+                }
+            }
+            for (const tns::ArrayOfPtrTo<tns::PropertyMeta>* properties : { &baseClass->instanceProps.value(), &baseClass->staticProps.value() }) {
+                for (const tns::PtrTo<tns::PropertyMeta>& property : *properties) {
+                    sink = sink + reinterpret_cast<uintptr_t>(property->getter()) + reinterpret_cast<uintptr_t>(property->setter());
+                    members++;
+                }
+            }
+        }
+    });
+    printRate("member iteration", std::max<size_t>(members, 1), membersTime);
+
+    double encodingsTime = bestOf(runs, [&]() {
+        encodings = 0;
+        for (const tns::Meta* meta : validator.metas()) {
+            if (meta->type() != tns::Interface && meta->type() != tns::ProtocolType) {
+                continue;
+            }
+            const tns::BaseClassMeta* baseClass = static_cast<const tns::BaseClassMeta*>(meta);
+            for (const tns::ArrayOfPtrTo<tns::MethodMeta>* methods : { &baseClass->instanceMethods.value(), &baseClass->staticMethods.value() }) {
+                for (const tns::PtrTo<tns::MethodMeta>& method : *methods) {
+                    const tns::TypeEncoding* encoding = method->encodings()->first();
+                    for (ArrayCount i = 0; i < method->encodings()->count; i++) {
+                        sink = sink + encoding->type;
+                        encoding = encoding->next();
+                        encodings++;
+                    }
+                }
+            }
+        }
+    });
+    printRate("type encoding decode", std::max<size_t>(encodings, 1), encodingsTime);
+
+    if (argc > 3) {
+        std::ifstream profile(argv[3]);
+        if (!profile) {
+            std::cerr << "Unable to open '" << argv[3] << "'." << std::endl;
+            return 2;
+        }
+        PageTracker tracker(file);
+        size_t resolved = 0;
+        size_t missing = 0;
+        std::string line;
+        while (std::getline(profile, line)) {
+            std::string name = line.substr(0, line.find(' '));
+            if (name.empty()) {
+                continue;
+            }
+            tracker.resolve(name) ? resolved++ : missing++;
+        }
+        size_t filePages = (file.size() + PageTracker::PageSize - 1) / PageTracker::PageSize;
+        std::cout << "Profile: " << resolved << " names resolved (" << missing << " not in the file) touch " << tracker.pagesTouched() << " of " << filePages << " pages of " << PageTracker::PageSize / 1024 << " KB" << std::endl;
+    }
+    return 0;
+}
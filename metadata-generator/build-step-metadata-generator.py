@@ -114,6 +114,9 @@ docset_path = os.path.join(os.path.expanduser("~"),
                            .format(docset_platform))
 yaml_output_folder = env_or_none("NS_DEBUG_METADATA_PATH") or env_or_none("TNS_DEBUG_METADATA_PATH")
 strict_includes = env_or_none("NS_DEBUG_METADATA_STRICT_INCLUDES") or env_or_none("TNS_DEBUG_METADATA_STRICT_INCLUDES")
+cache_folder = env_or_none("NS_METADATA_CACHE_PATH")
+usage_manifest = env_or_none("NS_METADATA_USAGE_MANIFEST")
+access_profile = env_or_none("NS_METADATA_ACCESS_PROFILE")
 
 
 def save_stream_to_file(filename, stream):
@@ -133,6 +136,19 @@ def generate_metadata(arch):
     if strict_includes is not None:
         generator_call.extend(["-strict-includes={}".format(strict_includes)])
 
+    # optionally reuse a precompiled header of the SDK headers between builds
+    if cache_folder is not None:
+        generator_call.extend(["-cache-path", cache_folder])
+
+    # optionally keep only the metadata the app uses in the binary
+    if usage_manifest is not None:
+        generator_call.extend(["-usage-manifest", usage_manifest])
+        print("Pruning the binary metadata with the usage manifest: \"{}\"".format(usage_manifest))
+
+    if access_profile is not None:
+        generator_call.extend(["-access-profile", access_profile])
+        print("Ordering the binary metadata by the access profile: \"{}\"".format(access_profile))
+
     # optionally add typescript output folder
     if typescript_output_folder is not None:
         current_typescript_output_folder = os.path.join(typescript_output_folder, arch)
@@ -0,0 +1,51 @@
+#include "accessProfile.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+binary::AccessProfile::AccessProfile(const std::string& profileFile)
+{
+    std::ifstream file(profileFile);
+    if (!file) {
+        throw std::runtime_error("Unable to open the access profile '" + profileFile + "'.");
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        uint64_t count = 1;
+        if (!(fields >> name)) {
+            continue;
+        }
+        if (!(fields >> count)) {
+            count = 1;
+        }
+        auto inserted = _entries.emplace(name, Entry{ 0, _entries.size() });
+        inserted.first->second.count += count;
+    }
+}
+
+std::vector< ::Meta::Meta*> binary::AccessProfile::hotMetas(const std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container) const
+{
+    std::vector<std::pair< ::Meta::Meta*, const Entry*> > hot;
+    for (const std::pair<clang::Module*, std::vector< ::Meta::Meta*> >& module : container) {
+        for (::Meta::Meta* meta : module.second) {
+            auto it = _entries.find(meta->jsName);
+            if (it != _entries.end()) {
+                hot.emplace_back(meta, &it->second);
+            }
+        }
+    }
+    std::stable_sort(hot.begin(), hot.end(), [](const std::pair< ::Meta::Meta*, const Entry*>& a, const std::pair< ::Meta::Meta*, const Entry*>& b) {
+        return a.second->count != b.second->count ? a.second->count > b.second->count : a.second->first < b.second->first;
+    });
+
+    std::vector< ::Meta::Meta*> metas;
+    metas.reserve(hot.size());
+    for (const std::pair< ::Meta::Meta*, const Entry*>& entry : hot) {
+        metas.push_back(entry.first);
+    }
+    return metas;
+}
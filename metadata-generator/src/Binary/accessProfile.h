@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Meta/MetaEntities.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace binary {
+/*
+     * \class AccessProfile
+     * \brief How often an app read each metadata entry, as recorded by the runtime.
+     *
+     * Each line of the profile is a JS name, optionally followed by the number of times it was
+     * read. The runtime's "recordMetadataProfile" setting writes counts; a usage trace from
+     * "recordMetadataUsage" lists names only and counts each line once.
+     */
+class AccessProfile {
+public:
+    explicit AccessProfile(const std::string& profileFile);
+
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+    /*
+         * \brief Returns the metas of \p container that are in the profile, most read first.
+         * Entries read equally often keep the order in which the profile first lists them.
+         */
+    std::vector< ::Meta::Meta*> hotMetas(const std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container) const;
+
+private:
+    struct Entry {
+        uint64_t count;
+        size_t first;
+    };
+
+    std::unordered_map<std::string, Entry> _entries;
+};
+}
@@ -1,12 +1,9 @@
 #include "binaryHashtable.h"
-#include "Utils/StringHasher.h"
 #include "metaFile.h"
 
 unsigned int binary::BinaryHashtable::hash(std::string value)
 {
-    StringHasher hasher;
-    hasher.addCharactersAssumingAligned(value.c_str(), value.size());
-    return hasher.hashWithTop8BitsMasked();
+    return StringPool::hash(value);
 }
 
 void binary::BinaryHashtable::add(std::string jsName, binary::MetaFileOffset offset)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Utils/stream.h"
+#include <memory>
 
 namespace binary {
 class BinaryOperation {
@@ -8,6 +8,7 @@
 #include <llvm/Object/MachOUniversal.h>
 #include <llvm/Support/Path.h>
 #include <sstream>
+#include <unordered_set>
 
 uint8_t convertVersion(Meta::Version version)
 {
@@ -210,14 +211,66 @@ void binary::BinarySerializer::serializeRecord(::Meta::RecordMeta* meta, binary:
 void binary::BinarySerializer::serializeContainer(std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container)
 {
     this->start(container);
+    // Metas refer to each other by name, so they can be written in any order
+    std::unordered_set< ::Meta::Meta*> hot;
+    if (this->profile != nullptr) {
+        std::vector< ::Meta::Meta*> hotMetas = this->profile->hotMetas(container);
+        this->pushHotStrings(hotMetas);
+        for (::Meta::Meta* meta : hotMetas) {
+            meta->visit(this);
+        }
+        hot.insert(hotMetas.begin(), hotMetas.end());
+        this->hotMetasCount = hotMetas.size();
+        this->hotRegionEnd = this->heapWriter.currentPosition();
+    }
     for (std::pair<clang::Module*, std::vector< ::Meta::Meta*> >& module : container) {
         for (::Meta::Meta* meta : module.second) {
-            meta->visit(this);
+            if (hot.count(meta) == 0) {
+                meta->visit(this);
+            }
         }
     }
     this->finish(container);
 }
 
+// Strings are interned, so the names pushed here are the ones the hot metas point to. Pushing
+// them together first gives the names the runtime compares during lookups a region of their own,
+// instead of interleaving them with the metas' structures.
+void binary::BinarySerializer::pushHotStrings(const std::vector< ::Meta::Meta*>& hotMetas)
+{
+    auto pushNames = [this](const ::Meta::Meta* meta) {
+        this->heapWriter.push_string(meta->jsName);
+        this->heapWriter.push_string(meta->name);
+        if (!meta->demangledName.empty()) {
+            this->heapWriter.push_string(meta->demangledName);
+        }
+    };
+    for (const ::Meta::Meta* meta : hotMetas) {
+        pushNames(meta);
+    }
+    for (const ::Meta::Meta* meta : hotMetas) {
+        if (!meta->is(::Meta::MetaType::Interface) && !meta->is(::Meta::MetaType::Protocol)) {
+            continue;
+        }
+        const ::Meta::BaseClassMeta& baseClass = meta->as< ::Meta::BaseClassMeta>();
+        for (const std::vector< ::Meta::MethodMeta*>* methods : { &baseClass.instanceMethods, &baseClass.staticMethods }) {
+            for (const ::Meta::MethodMeta* method : *methods) {
+                pushNames(method);
+            }
+        }
+        for (const std::vector< ::Meta::PropertyMeta*>* properties : { &baseClass.instanceProperties, &baseClass.staticProperties }) {
+            for (const ::Meta::PropertyMeta* property : *properties) {
+                pushNames(property);
+                for (const ::Meta::MethodMeta* accessor : { property->getter, property->setter }) {
+                    if (accessor != nullptr) {
+                        pushNames(accessor);
+                    }
+                }
+            }
+        }
+    }
+}
+
 static llvm::ErrorOr<llvm::SmallString<128>> getFrameworkLib(clang::Module* framework, const std::string& library) {
     using namespace llvm;
     using namespace llvm::sys;
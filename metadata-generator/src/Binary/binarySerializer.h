@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Meta/MetaEntities.h"
+#include "accessProfile.h"
 #include "metaFile.h"
 #include "binaryTypeEncodingSerializer.h"
 #include <map>
@@ -32,16 +33,44 @@ private:
 
     void serializeLibrary(clang::Module::LinkLibrary* library, binary::LibraryMeta& binaryLib);
 
+    void pushHotStrings(const std::vector< ::Meta::Meta*>& hotMetas);
+
+    const AccessProfile* profile;
+    size_t hotMetasCount = 0;
+    MetaFileOffset hotRegionEnd = 0;
+
 public:
-    BinarySerializer(MetaFile* file)
+    /*
+         * \param profile When given, the metas it lists are written first, most read first, after
+         * the names they and their members use, so that the entries an app reads at startup share
+         * a few pages at the front of the heap. The rest follow in visitation order.
+         */
+    BinarySerializer(MetaFile* file, const AccessProfile* profile = nullptr)
         : heapWriter(file->heap_writer())
         , typeEncodingSerializer(heapWriter)
+        , profile(profile)
     {
         this->file = file;
     }
 
     void serializeContainer(std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container);
 
+    /*
+         * \brief The number of metas written ahead of the rest because the profile lists them.
+         */
+    size_t hotCount() const
+    {
+        return hotMetasCount;
+    }
+
+    /*
+         * \brief The size of the heap's front region that holds the hot metas and their names.
+         */
+    MetaFileOffset hotRegionSize() const
+    {
+        return hotRegionEnd;
+    }
+
     void start(std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container);
 
     void finish(std::vector<std::pair<clang::Module*, std::vector< ::Meta::Meta*> > >& container);
@@ -1,33 +1,40 @@
 #include "binaryWriter.h"
 
+uint8_t* binary::BinaryWriter::encode_number(uint8_t* buffer, long number, int bytesCount)
+{
+    for (int i = 0; i < bytesCount; i++) {
+        *buffer++ = (uint8_t)(number >> (8 * i));
+    }
+    return buffer;
+}
+
 binary::MetaFileOffset binary::BinaryWriter::push_number(long number, int bytesCount)
 {
     binary::MetaFileOffset offset = this->_stream->position();
 
-    for (int i = 0; i < bytesCount; i++) {
-        int pad = 8 * i;
-        uint8_t current = (uint8_t)((number & (255 << pad)) >> pad);
-        this->_stream->push_byte(current);
-    }
+    uint8_t buffer[sizeof(long)];
+    this->_stream->push_bytes(buffer, encode_number(buffer, number, bytesCount) - buffer);
 
     return offset;
 }
 
 binary::MetaFileOffset binary::BinaryWriter::push_string(const std::string& str, bool shouldIntern)
 {
-    if (shouldIntern && this->uniqueStrings.count(str)) {
-        return this->uniqueStrings[str];
+    unsigned hash = 0;
+    if (shouldIntern) {
+        hash = StringPool::hash(str);
+        if (const binary::MetaFileOffset* offset = this->uniqueStrings.find(str, hash)) {
+            return *offset;
+        }
     }
 
     binary::MetaFileOffset offset = this->_stream->position();
 
-    for (char c : str) {
-        this->_stream->push_byte((uint8_t)c); // ASCII
-    }
-    this->_stream->push_byte('\0'); // Null terminated
+    // ASCII, null terminated
+    this->_stream->push_bytes(reinterpret_cast<const uint8_t*>(str.c_str()), str.size() + 1);
 
     if (shouldIntern) {
-        this->uniqueStrings.emplace(str, offset);
+        this->uniqueStrings.add(str, hash, offset);
     }
 
     return offset;
@@ -53,10 +60,13 @@ binary::MetaFileOffset binary::BinaryWriter::push_binaryArray(std::vector<binary
   }
 
     binary::MetaFileOffset offset = this->_stream->position();
-    this->push_arrayCount((binary::MetaArrayCount)binaryArray.size());
+    std::vector<uint8_t>& buffer = this->arrayBuffer;
+    buffer.resize(sizeof(binary::MetaArrayCount) + binaryArray.size() * sizeof(binary::MetaFileOffset));
+    uint8_t* end = encode_number(buffer.data(), (binary::MetaArrayCount)binaryArray.size(), sizeof(binary::MetaArrayCount));
     for (binary::MetaFileOffset element : binaryArray) {
-        this->push_pointer(element);
+        end = encode_number(end, element, sizeof(binary::MetaFileOffset));
     }
+    this->_stream->push_bytes(buffer.data(), buffer.size());
 
     if (binaryArray.empty()) {
       this->emptyArrayOffset = offset;
@@ -3,7 +3,7 @@
 #include "Utils/stream.h"
 #include "binaryOperation.h"
 #include "binaryStructures.h"
-#include <map>
+#include "stringPool.h"
 #include <string>
 
 namespace binary {
@@ -13,11 +13,16 @@ namespace binary {
      */
 class BinaryWriter : public BinaryOperation {
 private:
-    std::map<std::string, MetaFileOffset> uniqueStrings;
+    StringPool uniqueStrings;
     MetaFileOffset emptyArrayOffset = 0;
+    // Reused by push_binaryArray to write an array with a single push_bytes
+    std::vector<uint8_t> arrayBuffer;
 
     MetaFileOffset push_number(long number, int bytesCount);
 
+    // Appends the low bytesCount bytes of number to buffer, least significant first
+    static uint8_t* encode_number(uint8_t* buffer, long number, int bytesCount);
+
 public:
     /*
          * \brief Constructs \c BinaryWriter for a given stream.
@@ -1,5 +1,7 @@
 #include "metaFile.h"
+#include "Utils/StringHasher.h"
 #include "Utils/fileStream.h"
+#include <algorithm>
 
 unsigned int binary::MetaFile::size()
 {
@@ -35,6 +37,15 @@ binary::MetaFileOffset binary::MetaFile::getFromTopLevelModulesTable(const std::
     return (it != this->_topLevelModules.end()) ? it->second : 0;
 }
 
+void binary::MetaFile::registerPrunedSymbol(const ::Meta::Meta& meta)
+{
+    // All 32 bits rather than the 24 the global tables use, so that the runtime seldom has to
+    // compare the name itself
+    StringHasher hasher;
+    hasher.addCharactersAssumingAligned(meta.jsName.c_str(), meta.jsName.size());
+    this->_prunedSymbols.emplace_back(hasher.hash(), meta.jsName);
+}
+
 binary::BinaryWriter binary::MetaFile::heap_writer()
 {
     return binary::BinaryWriter(this->_heap);
@@ -71,8 +82,15 @@ void binary::MetaFile::save(std::shared_ptr<utils::Stream> stream)
         modulesOffsets.push_back(pair.second);
     globalTableStreamWriter.push_binaryArray(modulesOffsets);
 
-    // dump heap
-    for (auto byteIter = this->_heap->begin(); byteIter != this->_heap->end(); ++byteIter) {
-        stream->push_byte(*byteIter);
+    // dump pruned symbols table, sorted by hash for a binary search, with the names in the heap
+    std::sort(this->_prunedSymbols.begin(), this->_prunedSymbols.end());
+    this->_prunedSymbols.erase(std::unique(this->_prunedSymbols.begin(), this->_prunedSymbols.end()), this->_prunedSymbols.end());
+    globalTableStreamWriter.push_arrayCount((binary::MetaArrayCount)this->_prunedSymbols.size());
+    for (const std::pair<uint32_t, std::string>& symbol : this->_prunedSymbols) {
+        globalTableStreamWriter.push_int(static_cast<int32_t>(symbol.first));
+        globalTableStreamWriter.push_pointer(heapWriter.push_string(symbol.second));
     }
+
+    // dump heap
+    stream->push_bytes(this->_heap->data(), this->_heap->size());
 }
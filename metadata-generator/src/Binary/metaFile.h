@@ -4,6 +4,7 @@
 #include "binaryHashtable.h"
 #include "binaryReader.h"
 #include "binaryWriter.h"
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,9 @@ private:
     std::unique_ptr<BinaryHashtable> _globalTableSymbolsNativeInterfaces;
 
     std::map<std::string, MetaFileOffset> _topLevelModules;
+    // Hashes and JS names of the metas left out by a usage manifest, so that the runtime can tell
+    // them apart from names that were never in the SDK
+    std::vector<std::pair<uint32_t, std::string> > _prunedSymbols;
     std::shared_ptr<utils::MemoryStream> _heap;
 
 public:
@@ -85,6 +89,13 @@ public:
          */
     binary::MetaFileOffset getFromTopLevelModulesTable(const std::string& moduleName);
 
+    /// pruned symbols table
+    /*
+         * \brief Records that a meta was left out of this file by a usage manifest
+         * \param meta The pruned meta
+         */
+    void registerPrunedSymbol(const ::Meta::Meta& meta);
+
     /// heap
     /*
          * \brief Creates a \c BinaryWriter for this file heap
@@ -0,0 +1,55 @@
+#include "stringPool.h"
+#include "Utils/StringHasher.h"
+#include <algorithm>
+
+unsigned binary::StringPool::hash(const std::string& value)
+{
+    StringHasher hasher;
+    hasher.addCharactersAssumingAligned(value.c_str(), value.size());
+    return hasher.hashWithTop8BitsMasked();
+}
+
+const binary::MetaFileOffset* binary::StringPool::find(const std::string& value, unsigned hash) const
+{
+    if (this->_slots.empty()) {
+        return nullptr;
+    }
+
+    size_t mask = this->_slots.size() - 1;
+    for (size_t slot = hash & mask; this->_slots[slot] != 0; slot = (slot + 1) & mask) {
+        const Entry& entry = this->_entries[this->_slots[slot] - 1];
+        if (entry.hash == hash && entry.value == value) {
+            return &entry.offset;
+        }
+    }
+
+    return nullptr;
+}
+
+void binary::StringPool::add(const std::string& value, unsigned hash, binary::MetaFileOffset offset)
+{
+    if ((this->_entries.size() + 1) * 2 > this->_slots.size()) {
+        this->rehash(std::max<size_t>(this->_slots.size() * 2, 1024));
+    }
+
+    this->_entries.push_back({ value, hash, offset });
+    size_t mask = this->_slots.size() - 1;
+    size_t slot = hash & mask;
+    while (this->_slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    this->_slots[slot] = (uint32_t)this->_entries.size();
+}
+
+void binary::StringPool::rehash(size_t slotsCount)
+{
+    this->_slots.assign(slotsCount, 0);
+    size_t mask = slotsCount - 1;
+    for (size_t i = 0; i < this->_entries.size(); i++) {
+        size_t slot = this->_entries[i].hash & mask;
+        while (this->_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        this->_slots[slot] = (uint32_t)(i + 1);
+    }
+}
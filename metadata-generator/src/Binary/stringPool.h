@@ -0,0 +1,58 @@
+#pragma once
+
+#include "binaryStructures.h"
+#include <string>
+#include <vector>
+
+namespace binary {
+/*
+     * \class StringPool
+     * \brief Maps the strings already written to a heap to their offsets.
+     *
+     * Strings are hashed once, with the hash the runtime's global tables bucket names by, and
+     * the hash is kept with each entry so that growing the pool or probing it compares hashes
+     * before strings.
+     */
+class StringPool {
+public:
+    /*
+         * \brief The hash of \p value in the runtime's global tables (JSCore \c StringHasher with
+         * the top 8 bits masked).
+         */
+    static unsigned hash(const std::string& value);
+
+    /*
+         * \brief Returns the offset of \p value, or null when it is not in the pool.
+         * \param value The string
+         * \param hash \c StringPool::hash of \p value
+         */
+    const MetaFileOffset* find(const std::string& value, unsigned hash) const;
+
+    /*
+         * \brief Adds \p value, which must not be in the pool yet, at \p offset.
+         * \param value The string
+         * \param hash \c StringPool::hash of \p value
+         * \param offset The offset of the string in the heap
+         */
+    void add(const std::string& value, unsigned hash, MetaFileOffset offset);
+
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+private:
+    struct Entry {
+        std::string value;
+        unsigned hash;
+        MetaFileOffset offset;
+    };
+
+    void rehash(size_t slotsCount);
+
+    std::vector<Entry> _entries;
+    // Open addressing with linear probing; each slot is an index into _entries plus one, or 0
+    // when it is empty. The number of slots is a power of two at least twice the entries.
+    std::vector<uint32_t> _slots;
+};
+}
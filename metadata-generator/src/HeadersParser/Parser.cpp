@@ -1,12 +1,16 @@
 #include "Parser.h"
 
+#include <clang/Basic/Version.h>
 #include <clang/Frontend/ASTUnit.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
 #include <clang/Lex/HeaderSearch.h>
 #include <clang/Lex/Preprocessor.h>
 #include <clang/Tooling/Tooling.h>
 #include <iostream>
 #include <sstream>
 #include <llvm/ADT/StringSwitch.h>
+#include <llvm/Support/MD5.h>
 #include <llvm/Support/Path.h>
 
 using namespace clang;
@@ -125,24 +129,51 @@ static std::error_code CreateUmbrellaHeaderForAmbientModules(const std::vector<s
     return std::error_code();
 }
 
-// Sort headers so that -Swift headers come last (see https://github.com/NativeScript/ios-runtime/issues/1153)
-int headerPriority(SmallString<256> h) {
+static std::string sdkRootPrefix(const std::string& sdkRoot)
+{
+    SmallString<256> root(sdkRoot);
+    fs::make_absolute(root);
+    path::remove_dots(root, /*remove_dot_dot*/ true);
+    std::string prefix = root.str().str();
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix += '/';
+    }
+    return prefix;
+}
+
+// Sort headers so that -Swift headers come last (see
+// https://github.com/NativeScript/ios-runtime/issues/1153) and, given the SDK
+// prefix, SDK headers first, which lets SplitUmbrellaHeader move all of them
+// into the precompiled header
+int headerPriority(const SmallString<256>& h, const std::string& sdkPrefix) {
     if (std::string::npos != h.find("-Swift")) {
-        return 1;
-    } else {
+        return 2;
+    } else if (!sdkPrefix.empty() && h.str().startswith(sdkPrefix)) {
         return 0;
+    } else {
+        return 1;
     }
 }
 
+std::string GetSdkRoot(const std::vector<std::string>& clangArgs)
+{
+    std::vector<std::string>::const_iterator it = std::find(clangArgs.begin(), clangArgs.end(), "-isysroot");
+    if (it != clangArgs.end() && ++it != clangArgs.end()) {
+        return *it;
+    }
+    return "";
+}
 
-std::string CreateUmbrellaHeader(const std::vector<std::string>& clangArgs, std::vector<std::string>& includePaths)
+std::string CreateUmbrellaHeader(const std::vector<std::string>& clangArgs, std::vector<std::string>& includePaths, bool sdkHeadersFirst)
 {
     // Generate umbrella header for all modules from the sdk
     std::vector<SmallString<256>> umbrellaHeaders;
     CreateUmbrellaHeaderForAmbientModules(clangArgs, umbrellaHeaders, includePaths);
 
-    std::stable_sort(umbrellaHeaders.begin(), umbrellaHeaders.end(), [](const SmallString<256>& h1, const SmallString<256>& h2) {
-        return headerPriority(h1) < headerPriority(h2);
+    std::string sdkRoot = GetSdkRoot(clangArgs);
+    std::string sdkPrefix = sdkRoot.empty() || !sdkHeadersFirst ? "" : sdkRootPrefix(sdkRoot);
+    std::stable_sort(umbrellaHeaders.begin(), umbrellaHeaders.end(), [&sdkPrefix](const SmallString<256>& h1, const SmallString<256>& h2) {
+        return headerPriority(h1, sdkPrefix) < headerPriority(h2, sdkPrefix);
     });
 
     std::stringstream umbrellaHeaderContents;
@@ -152,3 +183,98 @@ std::string CreateUmbrellaHeader(const std::vector<std::string>& clangArgs, std:
 
     return umbrellaHeaderContents.str();
 }
+
+void SplitUmbrellaHeader(const std::string& umbrella, const std::string& sdkRoot, std::string& sdkPart, std::string& rest)
+{
+    std::string importPrefix = "#import \"" + sdkRootPrefix(sdkRoot);
+    size_t end = 0;
+    while (end < umbrella.size()) {
+        size_t lineEnd = umbrella.find('\n', end);
+        lineEnd = lineEnd == std::string::npos ? umbrella.size() : lineEnd + 1;
+        if (umbrella.compare(end, importPrefix.size(), importPrefix) != 0) {
+            break;
+        }
+        end = lineEnd;
+    }
+    sdkPart = umbrella.substr(0, end);
+    rest = umbrella.substr(end);
+}
+
+// GeneratePCHAction writing to a fixed path; tooling runs every action as
+// -fsyntax-only, so there is no -o to take the output file from.
+class SdkPchAction : public clang::GeneratePCHAction {
+public:
+    SdkPchAction(std::string outputFile, bool suppressIncludeNotFound)
+        : _outputFile(std::move(outputFile))
+        , _suppressIncludeNotFound(suppressIncludeNotFound)
+    {
+    }
+
+protected:
+    bool BeginInvocation(clang::CompilerInstance& compiler) override
+    {
+        compiler.getFrontendOpts().OutputFile = _outputFile;
+        return clang::GeneratePCHAction::BeginInvocation(compiler);
+    }
+
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance& compiler, StringRef inFile) override
+    {
+        // Same include handling as the metadata pass, so both see the same declarations
+        compiler.getPreprocessor().SetSuppressIncludeNotFoundError(_suppressIncludeNotFound);
+        return clang::GeneratePCHAction::CreateASTConsumer(compiler, inFile);
+    }
+
+private:
+    std::string _outputFile;
+    bool _suppressIncludeNotFound;
+};
+
+std::string GetOrCreateSdkPch(const std::string& sdkUmbrella, const std::vector<std::string>& clangArgs, const std::string& cacheFolder, bool suppressIncludeNotFound, bool& reused)
+{
+    reused = false;
+
+    // The SDK is read-only, but an Xcode update replaces it at the same path;
+    // its settings file is rewritten with it.
+    llvm::MD5 hash;
+    hash.update(clang::getClangFullVersion());
+    for (const std::string& arg : clangArgs) {
+        hash.update(arg);
+        hash.update(StringRef("\0", 1));
+    }
+    hash.update(sdkUmbrella);
+    SmallString<256> sdkSettings(GetSdkRoot(clangArgs));
+    path::append(sdkSettings, "SDKSettings.json");
+    fs::file_status status;
+    if (!fs::status(sdkSettings, status)) {
+        hash.update(std::to_string(status.getLastModificationTime().time_since_epoch().count()));
+    }
+    llvm::MD5::MD5Result digest;
+    hash.final(digest);
+
+    SmallString<256> pchPath(cacheFolder);
+    path::append(pchPath, "sdk-" + digest.digest().str().str() + ".pch");
+    if (fs::exists(pchPath)) {
+        reused = true;
+        return pchPath.str().str();
+    }
+
+    if (std::error_code err = fs::create_directories(cacheFolder)) {
+        std::cerr << "Unable to create the PCH cache folder " << cacheFolder << ": " << err.message() << std::endl;
+        return "";
+    }
+
+    std::vector<std::string> pchArgs(clangArgs);
+    std::vector<std::string>::iterator language = std::find(pchArgs.begin(), pchArgs.end(), "-x");
+    if (language != pchArgs.end() && ++language != pchArgs.end()) {
+        *language = "objective-c-header";
+    }
+    pchArgs.insert(pchArgs.end(), { "-Xclang", "-fallow-pch-with-compiler-errors" });
+
+    // GeneratePCHAction writes through a temporary file and renames it into
+    // place, so a concurrent or interrupted run never leaves a partial PCH.
+    bool built = clang::tooling::runToolOnCodeWithArgs(std::make_unique<SdkPchAction>(pchPath.str().str(), suppressIncludeNotFound), sdkUmbrella, pchArgs, "umbrella-sdk.h", "objc-metadata-generator");
+    if (!built && !fs::exists(pchPath)) {
+        return "";
+    }
+    return pchPath.str().str();
+}
@@ -5,4 +5,22 @@
 
 std::vector<std::string> parsePaths(std::string& paths);
 
-std::string CreateUmbrellaHeader(const std::vector<std::string>& clangArgs, std::vector<std::string>& includePaths);
+// Imports every header of the modules clangArgs can see, -Swift headers last.
+// sdkHeadersFirst moves the SDK headers to the front, for SplitUmbrellaHeader;
+// the declarations then reach the metadata visitor in another order than
+// without it.
+std::string CreateUmbrellaHeader(const std::vector<std::string>& clangArgs, std::vector<std::string>& includePaths, bool sdkHeadersFirst);
+
+// The -isysroot value in clangArgs, or an empty string.
+std::string GetSdkRoot(const std::vector<std::string>& clangArgs);
+
+// Splits an umbrella header into its leading run of SDK header imports and the
+// rest. Only a prefix can be precompiled without changing the order in which
+// declarations reach the metadata visitor.
+void SplitUmbrellaHeader(const std::string& umbrella, const std::string& sdkRoot, std::string& sdkPart, std::string& rest);
+
+// Returns a precompiled header of sdkUmbrella in cacheFolder, building it
+// unless one for the same contents, clang arguments, clang version and SDK is
+// already there (`reused`). Returns an empty string if it could not be built;
+// the caller then parses the full umbrella header instead.
+std::string GetOrCreateSdkPch(const std::string& sdkUmbrella, const std::vector<std::string>& clangArgs, const std::string& cacheFolder, bool suppressIncludeNotFound, bool& reused);
@@ -1,5 +1,7 @@
 #include "RemoveDuplicateMembersFilter.h"
 #include "Meta/Utils.h"
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Meta {
 static bool areMethodsEqual(MethodMeta& method1, MethodMeta& method2)
@@ -20,61 +22,114 @@ static bool arePropertiesEqual(PropertyMeta& prop1, PropertyMeta& prop2)
     return false;
 }
 
-static void removeDuplicateMethods(std::vector<MethodMeta*>& from, std::vector<MethodMeta*>& duplicates)
-{
-    for (MethodMeta* dupMethod : duplicates) {
-        from.erase(std::remove_if(from.begin(),
-                       from.end(),
-                       [&](MethodMeta* method) {
-                           return areMethodsEqual(*method, *dupMethod);
-                       }),
-            from.end());
-    }
+namespace {
+template <class Member>
+using MembersByName = std::unordered_map<std::string, std::vector<Member*> >;
+
+// The members a class or protocol declares, methods by selector and properties by name
+struct MemberIndex {
+    MembersByName<MethodMeta> staticMethods;
+    MembersByName<MethodMeta> instanceMethods;
+    MembersByName<PropertyMeta> staticProperties;
+    MembersByName<PropertyMeta> instanceProperties;
+};
+
+struct ClassHierarchyIndex {
+    std::unordered_map<BaseClassMeta*, MemberIndex> members;
+    std::unordered_map<BaseClassMeta*, std::vector<const MemberIndex*> > ancestors;
+};
 }
 
-static void removeDuplicateProperties(std::vector<PropertyMeta*>& from, std::vector<PropertyMeta*>& duplicates)
+template <class Member>
+static void indexMembers(const std::vector<Member*>& members, MembersByName<Member>& index)
 {
-    for (PropertyMeta* dupProperty : duplicates) {
-        from.erase(std::remove_if(from.begin(),
-                       from.end(),
-                       [&](PropertyMeta* property) {
-                           return arePropertiesEqual(*property, *dupProperty);
-                       }),
-            from.end());
+    for (Member* member : members) {
+        index[member->name].push_back(member);
     }
 }
 
-static void removeDuplicateMembersFromChild(BaseClassMeta* child, BaseClassMeta* parent)
+static const MemberIndex& indexMembersOf(BaseClassMeta* meta, ClassHierarchyIndex& index)
 {
-    removeDuplicateMethods(child->staticMethods, parent->staticMethods);
-    removeDuplicateMethods(child->instanceMethods, parent->instanceMethods);
-    removeDuplicateProperties(child->instanceProperties, parent->instanceProperties);
-    removeDuplicateProperties(child->staticProperties, parent->staticProperties);
+    std::pair<std::unordered_map<BaseClassMeta*, MemberIndex>::iterator, bool> inserted = index.members.emplace(meta, MemberIndex());
+    MemberIndex& members = inserted.first->second;
+    if (inserted.second) {
+        indexMembers(meta->staticMethods, members.staticMethods);
+        indexMembers(meta->instanceMethods, members.instanceMethods);
+        indexMembers(meta->staticProperties, members.staticProperties);
+        indexMembers(meta->instanceProperties, members.instanceProperties);
+    }
+    return members;
 }
 
-static void processBaseClassAndHierarchyOf(BaseClassMeta* child, BaseClassMeta* parent)
+// Every protocol and base class reachable from child, once each
+static void collectAncestors(BaseClassMeta* child, BaseClassMeta* parent, std::unordered_set<BaseClassMeta*>& visited, ClassHierarchyIndex& index)
 {
+    if (!visited.insert(parent).second) {
+        return;
+    }
     if (child != parent) {
-        removeDuplicateMembersFromChild(child, parent);
+        index.ancestors[child].push_back(&indexMembersOf(parent, index));
     }
     for (ProtocolMeta* protocol : parent->protocols) {
-        processBaseClassAndHierarchyOf(child, protocol);
+        collectAncestors(child, protocol, visited, index);
     }
     if (parent->is(MetaType::Interface)) {
         InterfaceMeta* parentInterface = &parent->as<InterfaceMeta>();
         if (parentInterface->base != nullptr) {
-            processBaseClassAndHierarchyOf(child, parentInterface->base);
+            collectAncestors(child, parentInterface->base, visited, index);
         }
     }
 }
 
+template <class Member>
+static void removeDuplicates(std::vector<Member*>& from, const std::vector<const MemberIndex*>& ancestors, MembersByName<Member> MemberIndex::*list, bool (*areEqual)(Member&, Member&))
+{
+    from.erase(std::remove_if(from.begin(),
+                   from.end(),
+                   [&](Member* member) {
+                       for (const MemberIndex* ancestor : ancestors) {
+                           const MembersByName<Member>& byName = ancestor->*list;
+                           auto sameName = byName.find(member->name);
+                           if (sameName == byName.end()) {
+                               continue;
+                           }
+                           for (Member* duplicate : sameName->second) {
+                               if (areEqual(*member, *duplicate)) {
+                                   return true;
+                               }
+                           }
+                       }
+                       return false;
+                   }),
+        from.end());
+}
+
 void RemoveDuplicateMembersFilter::filter(std::list<Meta*>& container)
 {
+    // Every ancestor is indexed before any member is removed, so members are matched against the
+    // lists as declared. That removes the same members as matching against already filtered lists
+    // would: a member an ancestor loses equals a member of one of its own ancestors, which is an
+    // ancestor of the child too.
+    ClassHierarchyIndex index;
+    std::vector<BaseClassMeta*> classes;
     for (Meta* meta : container) {
         if (meta->is(MetaType::Interface) || meta->is(MetaType::Protocol)) {
             BaseClassMeta* baseClass = &meta->as<BaseClassMeta>();
-            processBaseClassAndHierarchyOf(baseClass, baseClass);
+            std::unordered_set<BaseClassMeta*> visited;
+            collectAncestors(baseClass, baseClass, visited, index);
+            classes.push_back(baseClass);
+        }
+    }
+
+    for (BaseClassMeta* baseClass : classes) {
+        const std::vector<const MemberIndex*>& ancestors = index.ancestors[baseClass];
+        if (ancestors.empty()) {
+            continue;
         }
+        removeDuplicates(baseClass->staticMethods, ancestors, &MemberIndex::staticMethods, &areMethodsEqual);
+        removeDuplicates(baseClass->instanceMethods, ancestors, &MemberIndex::instanceMethods, &areMethodsEqual);
+        removeDuplicates(baseClass->instanceProperties, ancestors, &MemberIndex::instanceProperties, &arePropertiesEqual);
+        removeDuplicates(baseClass->staticProperties, ancestors, &MemberIndex::staticProperties, &arePropertiesEqual);
     }
 }
-}
\ No newline at end of file
+}
@@ -58,9 +58,13 @@ void ResolveGlobalNamesCollisionsFilter::filter(std::list<Meta*>& container)
         }
     }
 
+    // Metas renamed to the same base name take consecutive indices. A name stays taken once added, so
+    // each base name's probing resumes after the last index tried instead of starting over from 1.
+    std::unordered_map<clang::Module*, std::unordered_map<std::string, int> > nextIndices;
     for (Meta* meta : conflictingMetas) {
-        int index = 1;
         std::string originalJsName = meta->jsName;
+        int& index = nextIndices[meta->module->getTopLevelModule()][MetaFactory::renameMeta(meta->type, originalJsName, 1)];
+        index = std::max(index, 1);
         do {
             meta->jsName = MetaFactory::renameMeta(meta->type, originalJsName, index);
             index++;
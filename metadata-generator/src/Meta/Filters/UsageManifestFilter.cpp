@@ -0,0 +1,243 @@
+#include "UsageManifestFilter.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace Meta {
+// Names the runtime needs whatever the app uses: every class hierarchy ends at NSObject, and the
+// runtime's own JavaScript (inline-functions.js, blob-url.js) constructs these.
+static const char* const runtimeNames[] = { "NSObject", "CGPoint", "CGRect", "CGSize", "UIEdgeInsets", "NSRange", "NSUUID" };
+
+static bool isIdentifierStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+
+static bool isIdentifierPart(char c)
+{
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+UsageManifestFilter::UsageManifestFilter(const std::string& manifestFile)
+{
+    std::ifstream file(manifestFile, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open the usage manifest '" + manifestFile + "'.");
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    for (size_t i = 0; i < content.size();) {
+        size_t start = i;
+        while (i < content.size() && isIdentifierPart(content[i])) {
+            i++;
+        }
+        if (i == start) {
+            i++;
+        } else if (isIdentifierStart(content[start])) {
+            // a token starting with a digit is a number (1e3, 0x1F), not a name
+            _usedNames.insert(content.substr(start, i - start));
+        }
+    }
+
+    for (const char* name : runtimeNames) {
+        _usedNames.insert(name);
+    }
+}
+
+static void addReferencedMetas(const Type* type, std::vector<Meta*>& referenced);
+
+static void addReferencedMetas(const std::vector<Type*>& types, std::vector<Meta*>& referenced)
+{
+    for (const Type* type : types) {
+        addReferencedMetas(type, referenced);
+    }
+}
+
+static void addReferencedMetas(const std::vector<RecordField>& fields, std::vector<Meta*>& referenced)
+{
+    for (const RecordField& field : fields) {
+        addReferencedMetas(field.encoding, referenced);
+    }
+}
+
+template <class T>
+static void addReferencedMetas(const std::vector<T*>& metas, std::vector<Meta*>& referenced)
+{
+    referenced.insert(referenced.end(), metas.begin(), metas.end());
+}
+
+// The declarations the binary serializer refers to by name when it writes a type
+static void addReferencedMetas(const Type* type, std::vector<Meta*>& referenced)
+{
+    if (type == nullptr) {
+        return;
+    }
+    switch (type->getType()) {
+    case TypeClass:
+        addReferencedMetas(type->as<ClassType>().protocols, referenced);
+        break;
+    case TypeId:
+        addReferencedMetas(type->as<IdType>().protocols, referenced);
+        break;
+    case TypeTypeArgument:
+        addReferencedMetas(type->as<TypeArgumentType>().protocols, referenced);
+        addReferencedMetas(type->as<TypeArgumentType>().underlyingType, referenced);
+        break;
+    case TypeInterface: {
+        const InterfaceType& interfaceType = type->as<InterfaceType>();
+        referenced.push_back(interfaceType.interface);
+        addReferencedMetas(interfaceType.protocols, referenced);
+        addReferencedMetas(interfaceType.typeArguments, referenced);
+        break;
+    }
+    case TypeBridgedInterface:
+        if (type->as<BridgedInterfaceType>().bridgedInterface != nullptr) {
+            referenced.push_back(type->as<BridgedInterfaceType>().bridgedInterface);
+        }
+        break;
+    case TypeConstantArray:
+        addReferencedMetas(type->as<ConstantArrayType>().innerType, referenced);
+        break;
+    case TypeIncompleteArray:
+        addReferencedMetas(type->as<IncompleteArrayType>().innerType, referenced);
+        break;
+    case TypeExtVector:
+        addReferencedMetas(type->as<ExtVectorType>().innerType, referenced);
+        break;
+    case TypePointer:
+        addReferencedMetas(type->as<PointerType>().innerType, referenced);
+        break;
+    case TypeBlock:
+        addReferencedMetas(type->as<BlockType>().signature, referenced);
+        break;
+    case TypeFunctionPointer:
+        addReferencedMetas(type->as<FunctionPointerType>().signature, referenced);
+        break;
+    case TypeStruct:
+        referenced.push_back(type->as<StructType>().structMeta);
+        break;
+    case TypeUnion:
+        referenced.push_back(type->as<UnionType>().unionMeta);
+        break;
+    case TypeAnonymousStruct:
+        addReferencedMetas(type->as<AnonymousStructType>().fields, referenced);
+        break;
+    case TypeAnonymousUnion:
+        addReferencedMetas(type->as<AnonymousUnionType>().fields, referenced);
+        break;
+    case TypeNullable:
+        addReferencedMetas(type->as<NullableType>().innerType, referenced);
+        break;
+    case TypeNonNullable:
+        addReferencedMetas(type->as<NonNullableType>().innerType, referenced);
+        break;
+    default:
+        // Enums are written as their underlying type and the rest are primitives
+        break;
+    }
+}
+
+static void addReferencedMetas(const MethodMeta* method, std::vector<Meta*>& referenced)
+{
+    if (method != nullptr) {
+        addReferencedMetas(method->signature, referenced);
+    }
+}
+
+static void addReferencedMetas(const Meta* meta, std::vector<Meta*>& referenced)
+{
+    if (meta->is(MetaType::Interface) || meta->is(MetaType::Protocol)) {
+        const BaseClassMeta& baseClass = meta->as<BaseClassMeta>();
+        addReferencedMetas(baseClass.protocols, referenced);
+        for (const std::vector<MethodMeta*>* methods : { &baseClass.instanceMethods, &baseClass.staticMethods }) {
+            for (const MethodMeta* method : *methods) {
+                addReferencedMetas(method, referenced);
+            }
+        }
+        for (const std::vector<PropertyMeta*>* properties : { &baseClass.instanceProperties, &baseClass.staticProperties }) {
+            for (const PropertyMeta* property : *properties) {
+                addReferencedMetas(property->getter, referenced);
+                addReferencedMetas(property->setter, referenced);
+            }
+        }
+        if (meta->is(MetaType::Interface) && meta->as<InterfaceMeta>().base != nullptr) {
+            referenced.push_back(meta->as<InterfaceMeta>().base);
+        }
+    } else if (meta->is(MetaType::Struct) || meta->is(MetaType::Union)) {
+        addReferencedMetas(meta->as<RecordMeta>().fields, referenced);
+    } else if (meta->is(MetaType::Function)) {
+        addReferencedMetas(meta->as<FunctionMeta>().signature, referenced);
+    } else if (meta->is(MetaType::Var)) {
+        addReferencedMetas(meta->as<VarMeta>().signature, referenced);
+    }
+}
+
+// JavaScript reaches most members through values whose class it never names (an `id` result, a
+// delegate argument), so a class or protocol is used when one of its members is
+static bool declaresUsedMember(const Meta* meta, const std::unordered_set<std::string>& usedNames)
+{
+    if (!meta->is(MetaType::Interface) && !meta->is(MetaType::Protocol)) {
+        return false;
+    }
+    const BaseClassMeta& baseClass = meta->as<BaseClassMeta>();
+    for (const std::vector<MethodMeta*>* methods : { &baseClass.instanceMethods, &baseClass.staticMethods }) {
+        for (const MethodMeta* method : *methods) {
+            if (usedNames.count(method->jsName) != 0) {
+                return true;
+            }
+        }
+    }
+    for (const std::vector<PropertyMeta*>* properties : { &baseClass.instanceProperties, &baseClass.staticProperties }) {
+        for (const PropertyMeta* property : *properties) {
+            if (usedNames.count(property->jsName) != 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+UsageManifestFilter::MetasByModules UsageManifestFilter::filter(const MetasByModules& metasByModules, std::vector<Meta*>& pruned) const
+{
+    std::unordered_set<const Meta*> kept;
+    std::vector<Meta*> pending;
+    auto keep = [&kept, &pending](Meta* meta) {
+        if (meta != nullptr && kept.insert(meta).second) {
+            pending.push_back(meta);
+        }
+    };
+
+    for (const std::pair<clang::Module*, std::vector<Meta*> >& module : metasByModules) {
+        for (Meta* meta : module.second) {
+            if (_usedNames.count(meta->jsName) != 0 || _usedNames.count(meta->name) != 0 || (!meta->demangledName.empty() && _usedNames.count(meta->demangledName) != 0) || declaresUsedMember(meta, _usedNames)) {
+                keep(meta);
+            }
+        }
+    }
+
+    std::vector<Meta*> referenced;
+    while (!pending.empty()) {
+        Meta* meta = pending.back();
+        pending.pop_back();
+        referenced.clear();
+        addReferencedMetas(meta, referenced);
+        for (Meta* reference : referenced) {
+            keep(reference);
+        }
+    }
+
+    MetasByModules result;
+    result.reserve(metasByModules.size());
+    for (const std::pair<clang::Module*, std::vector<Meta*> >& module : metasByModules) {
+        result.emplace_back(module.first, std::vector<Meta*>());
+        for (Meta* meta : module.second) {
+            if (kept.count(meta) != 0) {
+                result.back().second.push_back(meta);
+            } else {
+                pruned.push_back(meta);
+            }
+        }
+    }
+    return result;
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Meta/MetaEntities.h"
+#include "ResolveGlobalNamesCollisionsFilter.h"
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Meta {
+/*
+ * \class UsageManifestFilter
+ * \brief Keeps the declarations an app uses, as listed in a usage manifest, and the ones they depend on.
+ *
+ * Every identifier in the manifest counts as used, so the app's bundled JavaScript and a trace of the
+ * names the runtime looked up (one per line) can both be passed as they are. A declaration is kept when
+ * its JS or native name is used, when it is a class or protocol that declares a method or property whose
+ * JS name is used, or when a kept declaration refers to it by name in the binary metadata: base classes,
+ * adopted protocols and the interfaces, protocols, structs and unions in signatures and record fields.
+ */
+class UsageManifestFilter {
+public:
+    typedef ResolveGlobalNamesCollisionsFilter::MetasByModules MetasByModules;
+
+    explicit UsageManifestFilter(const std::string& manifestFile);
+
+    size_t usedNamesCount() const
+    {
+        return _usedNames.size();
+    }
+
+    /*
+     * \brief Returns the kept metas of every module, in the order they have in \p metasByModules.
+     * Modules keep their entry even when none of their metas is kept.
+     * \param pruned Receives the metas that are left out
+     */
+    MetasByModules filter(const MetasByModules& metasByModules, std::vector<Meta*>& pruned) const;
+
+private:
+    std::unordered_set<std::string> _usedNames;
+};
+}
@@ -188,6 +188,10 @@ public:
     std::vector<Type*> signature;
     std::string constructorTokens;
 
+    // The names of the parameters as declared, for the TypeScript writer
+    std::vector<std::string> parameterNames;
+    bool isInstanceMethod = true;
+
     virtual void visit(MetaVisitor* visitor) override;
 };
 
@@ -202,6 +206,8 @@ public:
     MethodMeta* getter = nullptr;
     MethodMeta* setter = nullptr;
 
+    bool isClassProperty = false;
+
     virtual void visit(MetaVisitor* visitor) override;
 };
 
@@ -245,6 +251,12 @@ public:
 
     InterfaceMeta* base;
 
+    // The type arguments of the superclass as written (NSArray<NSString*>)
+    std::vector<Type*> superClassTypeArguments;
+
+    // The names of the type parameters as written (NSArray<ObjectType>)
+    std::vector<std::string> typeParameterNames;
+
     virtual void visit(MetaVisitor* visitor) override;
 };
 
@@ -281,6 +293,9 @@ public:
     }
     std::vector<Type*> signature;
 
+    // The names of the parameters as declared, for the TypeScript writer
+    std::vector<std::string> parameterNames;
+
     virtual void visit(MetaVisitor* visitor) override;
 };
 
@@ -258,6 +258,7 @@ void MetaFactory::createFromFunction(const clang::FunctionDecl& function,
   for (clang::ParmVarDecl* param : function.parameters()) {
     functionMeta.signature.push_back(
         _typeFactory.create(param->getType()).get());
+    functionMeta.parameterNames.push_back(param->getNameAsString());
   }
 
   bool returnsRetained = function.hasAttr<clang::NSReturnsRetainedAttr>() ||
@@ -444,6 +445,15 @@ void MetaFactory::createFromInterface(const clang::ObjCInterfaceDecl& interface,
   }
 
   populateMetaFields(interface, interfaceMeta);
+
+  if (clang::ObjCTypeParamList* typeParameters =
+          interface.getTypeParamListAsWritten()) {
+    for (clang::ObjCTypeParamDecl* typeParameter : *typeParameters) {
+      interfaceMeta.typeParameterNames.push_back(
+          typeParameter->getNameAsString());
+    }
+  }
+
   populateBaseClassMetaFields(interface, interfaceMeta);
 
   // set base interface
@@ -452,6 +462,16 @@ void MetaFactory::createFromInterface(const clang::ObjCInterfaceDecl& interface,
       (super == nullptr || super->getDefinition() == nullptr)
           ? nullptr
           : &this->create(*super->getDefinition())->as<InterfaceMeta>();
+
+  // resolved here rather than in the TypeScript writer, which must not touch
+  // the type factory
+  if (interfaceMeta.base != nullptr) {
+    for (const clang::QualType& typeArg :
+         interface.getSuperClassType()->getTypeArgsAsWritten()) {
+      interfaceMeta.superClassTypeArguments.push_back(
+          _typeFactory.create(typeArg).get());
+    }
+  }
 }
 
 void MetaFactory::createFromProtocol(const clang::ObjCProtocolDecl& protocol,
@@ -479,6 +499,7 @@ void MetaFactory::createFromMethod(const clang::ObjCMethodDecl& method,
   populateMetaFields(method, methodMeta);
 
   methodMeta.setFlags(MetaFlags::MemberIsOptional, method.isOptional());
+  methodMeta.isInstanceMethod = method.isInstanceMethod();
   methodMeta.setFlags(MetaFlags::MethodIsVariadic,
                       method.isVariadic());  // set IsVariadic flag
 
@@ -601,6 +622,7 @@ void MetaFactory::createFromMethod(const clang::ObjCMethodDecl& method,
           : _typeFactory.create(method.getReturnType()).get());
   for (clang::ParmVarDecl* param : method.parameters()) {
     methodMeta.signature.push_back(_typeFactory.create(param->getType()).get());
+    methodMeta.parameterNames.push_back(param->getNameAsString());
   }
 }
 
@@ -609,6 +631,7 @@ void MetaFactory::createFromProperty(const clang::ObjCPropertyDecl& property,
   populateMetaFields(property, propertyMeta);
 
   propertyMeta.setFlags(MetaFlags::MemberIsOptional, property.isOptional());
+  propertyMeta.isClassProperty = property.isClassProperty();
 
   clang::ObjCMethodDecl* getter = property.getGetterMethodDecl();
   propertyMeta.getter = getter ? &create(*getter)->as<MethodMeta>() : nullptr;
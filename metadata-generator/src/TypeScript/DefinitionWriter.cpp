@@ -1,7 +1,5 @@
 #include "DefinitionWriter.h"
 
-#include <clang/AST/DeclObjC.h>
-
 #include <algorithm>
 #include <iterator>
 
@@ -19,8 +17,6 @@ static std::unordered_set<std::string> hiddenMethods = {
 static std::unordered_set<std::string> bannedIdentifiers = {"function",
                                                             "arguments", "in"};
 
-bool DefinitionWriter::applyManualChanges = false;
-
 static std::string sanitizeParameterName(const std::string& parameterName) {
   if (bannedIdentifiers.find(parameterName) != bannedIdentifiers.end()) {
     return "_" + parameterName;
@@ -29,50 +25,36 @@ static std::string sanitizeParameterName(const std::string& parameterName) {
   }
 }
 
+// Modules are written on several threads, so nothing here may touch the clang
+// AST, which deserializes declarations lazily from the precompiled modules:
+// MetaFactory copies out everything the writer needs.
 static std::string getTypeParametersStringOrEmpty(
-    const clang::ObjCInterfaceDecl* interfaceDecl) {
+    const InterfaceMeta* interface) {
   std::ostringstream output;
-  if (clang::ObjCTypeParamList* typeParameters =
-          interfaceDecl->getTypeParamListAsWritten()) {
-    if (typeParameters->size()) {
-      output << "<";
-      for (unsigned i = 0; i < typeParameters->size(); i++) {
-        clang::ObjCTypeParamDecl* typeParam = *(typeParameters->begin() + i);
-        output << typeParam->getNameAsString();
-        if (i < typeParameters->size() - 1) {
-          output << ", ";
-        }
+  const std::vector<std::string>& typeParameters =
+      interface->typeParameterNames;
+  if (!typeParameters.empty()) {
+    output << "<";
+    for (unsigned i = 0; i < typeParameters.size(); i++) {
+      output << typeParameters[i];
+      if (i < typeParameters.size() - 1) {
+        output << ", ";
       }
-      output << ">";
     }
+    output << ">";
   }
 
   return output.str();
 }
 
-static std::vector<std::string> getTypeParameterNames(
-    const clang::ObjCInterfaceDecl* interfaceDecl) {
-  std::vector<std::string> params;
-  if (clang::ObjCTypeParamList* typeParameters =
-          interfaceDecl->getTypeParamListAsWritten()) {
-    if (typeParameters->size()) {
-      for (unsigned i = 0; i < typeParameters->size(); i++) {
-        clang::ObjCTypeParamDecl* typeParam = *(typeParameters->begin() + i);
-        params.push_back(typeParam->getNameAsString());
-      }
-    }
-  }
-  return params;
-}
-
-std::string DefinitionWriter::getTypeArgumentsStringOrEmpty(
-    const clang::ObjCObjectType* objectType) {
+std::string DefinitionWriter::getSuperClassTypeArgumentsStringOrEmpty(
+    const InterfaceMeta* meta) const {
   std::ostringstream output;
-  llvm::ArrayRef<clang::QualType> typeArgs = objectType->getTypeArgsAsWritten();
+  const std::vector<Type*>& typeArgs = meta->superClassTypeArguments;
   if (!typeArgs.empty()) {
     output << "<";
     for (unsigned i = 0; i < typeArgs.size(); i++) {
-      output << tsifyType(*_typeFactory.create(typeArgs[i]));
+      output << tsifyType(*typeArgs[i]);
       if (i < typeArgs.size() - 1) {
         output << ", ";
       }
@@ -83,18 +65,17 @@ std::string DefinitionWriter::getTypeArgumentsStringOrEmpty(
      * @interface MyInterface<ObjectType1, ObjectType2>
      * @interface MyDerivedInterface : MyInterface
      */
-    if (clang::ObjCTypeParamList* typeParameters =
-            objectType->getInterface()->getTypeParamListAsWritten()) {
-      if (typeParameters->size()) {
-        output << "<";
-        for (unsigned i = 0; i < typeParameters->size(); i++) {
-          output << "NSObject";
-          if (i < typeParameters->size() - 1) {
-            output << ", ";
-          }
+    size_t typeParameters =
+        meta->base ? meta->base->typeParameterNames.size() : 0;
+    if (typeParameters) {
+      output << "<";
+      for (unsigned i = 0; i < typeParameters; i++) {
+        output << "NSObject";
+        if (i < typeParameters - 1) {
+          output << ", ";
         }
-        output << ">";
       }
+      output << ">";
     }
   }
 
@@ -151,10 +132,9 @@ void DefinitionWriter::visit(InterfaceMeta* meta) {
   }
 
   std::string metaJsName = meta->jsName;
-  std::string parametersString = getTypeParametersStringOrEmpty(
-      clang::cast<clang::ObjCInterfaceDecl>(meta->declaration));
+  std::string parametersString = getTypeParametersStringOrEmpty(meta);
 
-  if (DefinitionWriter::applyManualChanges) {
+  if (_applyManualChanges) {
     if (metaJsName == "UIEvent") {
       metaJsName = "_UIEvent";
     } else if (metaJsName == "HMMutableCharacteristicEvent") {
@@ -171,9 +151,7 @@ void DefinitionWriter::visit(InterfaceMeta* meta) {
           << metaJsName << parametersString;
   if (meta->base != nullptr) {
     _buffer << " extends " << localizeReference(*meta->base)
-            << getTypeArgumentsStringOrEmpty(
-                   clang::cast<clang::ObjCInterfaceDecl>(meta->declaration)
-                       ->getSuperClassType());
+            << getSuperClassTypeArgumentsStringOrEmpty(meta);
   }
 
   CompoundMemberMap<PropertyMeta> protocolInheritedStaticProperties;
@@ -314,8 +292,7 @@ void DefinitionWriter::writeProperty(
           << _docSet.getCommentFor(propertyMeta, owner).toString("\t");
   _buffer << "\t";
 
-  if (clang::cast<clang::ObjCPropertyDecl>(propertyMeta->declaration)
-          ->isClassProperty()) {
+  if (propertyMeta->isClassProperty) {
     _buffer << "static ";
   }
 
@@ -452,7 +429,7 @@ void DefinitionWriter::visit(ProtocolMeta* meta) {
 
   std::string metaName = meta->jsName;
 
-  if (DefinitionWriter::applyManualChanges) {
+  if (_applyManualChanges) {
     if (metaName == "AudioBuffer") {
       metaName = "_AudioBuffer";
     }
@@ -530,7 +507,7 @@ void DefinitionWriter::visit(ProtocolMeta* meta) {
 
 std::string DefinitionWriter::writeConstructor(
     const CompoundMemberMap<MethodMeta>::value_type& initializer,
-    const BaseClassMeta* owner) {
+    const BaseClassMeta* owner) const {
   MethodMeta* method = initializer.second.second;
   assert(method->getFlags(MethodIsInitializer));
 
@@ -580,23 +557,15 @@ void getClosedGenericsIfAny(Type& typeIn, std::vector<Type*>& params) {
 
 std::string DefinitionWriter::writeMethod(MethodMeta* meta,
                                           BaseClassMeta* owner,
-                                          bool canUseThisType) {
-  const clang::ObjCMethodDecl& methodDecl =
-      *clang::dyn_cast<clang::ObjCMethodDecl>(meta->declaration);
-  auto parameters = methodDecl.parameters();
-
-  std::vector<std::string> parameterNames;
+                                          bool canUseThisType) const {
+  std::vector<std::string> parameterNames = meta->parameterNames;
   std::vector<Type*> paramsGenerics;
   std::vector<std::string> ownerGenerics;
   if (owner->is(Interface)) {
-    ownerGenerics = getTypeParameterNames(clang::cast<clang::ObjCInterfaceDecl>(
-        static_cast<const InterfaceMeta*>(owner)->declaration));
+    ownerGenerics =
+        static_cast<const InterfaceMeta*>(owner)->typeParameterNames;
   }
 
-  std::transform(
-      parameters.begin(), parameters.end(), std::back_inserter(parameterNames),
-      [](clang::ParmVarDecl* param) { return param->getNameAsString(); });
-
   for (size_t i = 0; i < parameterNames.size(); i++) {
     getClosedGenericsIfAny(*meta->signature[i + 1], paramsGenerics);
     for (size_t n = 0; n < parameterNames.size(); n++) {
@@ -622,7 +591,7 @@ std::string DefinitionWriter::writeMethod(MethodMeta* meta,
   output << meta->jsName;
   bool skipGenerics = false;
 
-  if (DefinitionWriter::applyManualChanges) {
+  if (_applyManualChanges) {
     // HMMutableCharacteristicEvent constructors should not have generics.
     // Default export: static alloc<TriggerValueType>():
     // HMMutableCharacteristicEvent<TriggerValueType>;
@@ -634,13 +603,12 @@ std::string DefinitionWriter::writeMethod(MethodMeta* meta,
 
   const Type* retType = meta->signature[0];
 
-  if (!methodDecl.isInstanceMethod() && owner->is(MetaType::Interface)) {
+  if (!meta->isInstanceMethod && owner->is(MetaType::Interface)) {
     if ((retType->stripNullability()->is(TypeInstancetype) ||
          DefinitionWriter::hasClosedGenerics(*retType)) &&
         !skipGenerics) {
       output << getTypeParametersStringOrEmpty(
-          clang::cast<clang::ObjCInterfaceDecl>(
-              static_cast<const InterfaceMeta*>(owner)->declaration));
+          static_cast<const InterfaceMeta*>(owner));
     } else if (!paramsGenerics.empty()) {
       output << "<";
       for (size_t i = 0; i < paramsGenerics.size(); i++) {
@@ -655,8 +623,7 @@ std::string DefinitionWriter::writeMethod(MethodMeta* meta,
   }
 
   if ((owner->type == MetaType::Protocol &&
-       methodDecl.getImplementationControl() ==
-           clang::ObjCMethodDecl::ImplementationControl::Optional) ||
+       meta->getFlags(MemberIsOptional)) ||
       (owner->is(MetaType::Protocol) && meta->getFlags(MethodIsInitializer))) {
     output << "?";
   }
@@ -668,7 +635,7 @@ std::string DefinitionWriter::writeMethod(MethodMeta* meta,
           ? (meta->signature.size() - 1)
           : meta->signature.size();
 
-  if (DefinitionWriter::applyManualChanges) {
+  if (_applyManualChanges) {
     // Default export:
     // copy(sender: any): void;
     // ObjC interface:
@@ -713,7 +680,8 @@ std::string DefinitionWriter::writeMethod(MethodMeta* meta,
 
 std::string DefinitionWriter::writeMethod(
     CompoundMemberMap<MethodMeta>::value_type& methodPair, BaseClassMeta* owner,
-    const std::unordered_set<ProtocolMeta*>& protocols, bool canUseThisType) {
+    const std::unordered_set<ProtocolMeta*>& protocols,
+    bool canUseThisType) const {
   std::ostringstream output;
 
   BaseClassMeta* memberOwner = methodPair.second.first;
@@ -744,7 +712,7 @@ std::string DefinitionWriter::writeMethod(
 
 std::string DefinitionWriter::writeProperty(PropertyMeta* meta,
                                             BaseClassMeta* owner,
-                                            bool optOutTypeChecking) {
+                                            bool optOutTypeChecking) const {
   std::ostringstream output;
 
   if (hiddenMethods.find(meta->jsName) != hiddenMethods.end()) {
@@ -757,10 +725,7 @@ std::string DefinitionWriter::writeProperty(PropertyMeta* meta,
   }
 
   output << meta->jsName;
-  if (owner->is(MetaType::Protocol) &&
-      clang::dyn_cast<clang::ObjCPropertyDecl>(meta->declaration)
-              ->getPropertyImplementation() ==
-          clang::ObjCPropertyDecl::PropertyControl::Optional) {
+  if (owner->is(MetaType::Protocol) && meta->getFlags(MemberIsOptional)) {
     output << "?";
   }
 
@@ -777,13 +742,9 @@ std::string DefinitionWriter::writeProperty(PropertyMeta* meta,
 void DefinitionWriter::visit(CategoryMeta* meta) {}
 
 void DefinitionWriter::visit(FunctionMeta* meta) {
-  const clang::FunctionDecl& functionDecl =
-      *clang::dyn_cast<clang::FunctionDecl>(meta->declaration);
-
   std::ostringstream params;
   for (size_t i = 1; i < meta->signature.size(); i++) {
-    std::string name = sanitizeParameterName(
-        functionDecl.getParamDecl(i - 1)->getNameAsString());
+    std::string name = sanitizeParameterName(meta->parameterNames[i - 1]);
     params << (name.size() ? name : "p" + std::to_string(i)) << ": "
            << tsifyType(*meta->signature[i], true);
     if (i < meta->signature.size() - 1) {
@@ -814,7 +775,7 @@ void DefinitionWriter::visit(FunctionMeta* meta) {
 void DefinitionWriter::visit(StructMeta* meta) {
   std::string metaName = meta->jsName;
 
-  if (DefinitionWriter::applyManualChanges) {
+  if (_applyManualChanges) {
     if (metaName == "AudioBuffer") {
       metaName = "_AudioBuffer";
     }
@@ -895,7 +856,7 @@ void DefinitionWriter::visit(VarMeta* meta) {
 }
 
 std::string DefinitionWriter::writeFunctionProto(
-    const std::vector<Type*>& signature) {
+    const std::vector<Type*>& signature) const {
   std::ostringstream output;
   output << "(";
 
@@ -926,8 +887,8 @@ void DefinitionWriter::visit(EnumConstantMeta* meta) {
 }
 
 std::string DefinitionWriter::localizeReference(const std::string& jsName,
-                                                std::string moduleName) {
-  if (DefinitionWriter::applyManualChanges) {
+                                                std::string moduleName) const {
+  if (_applyManualChanges) {
     if (jsName == "AudioBuffer") {
       return "_AudioBuffer";
     } else if (jsName == "UIEvent") {
@@ -937,7 +898,8 @@ std::string DefinitionWriter::localizeReference(const std::string& jsName,
   return jsName;
 }
 
-std::string DefinitionWriter::localizeReference(const ::Meta::Meta& meta) {
+std::string DefinitionWriter::localizeReference(
+    const ::Meta::Meta& meta) const {
   return localizeReference(meta.jsName, meta.module->getFullModuleName());
 }
 
@@ -953,7 +915,7 @@ bool DefinitionWriter::hasClosedGenerics(const Type& typeIn) {
 
 std::string DefinitionWriter::tsifyType(const Type& type,
                                         const bool isFuncParam,
-                                        const bool suppressNull) {
+                                        const bool suppressNull) const {
   switch (type.getType()) {
     case TypeVoid:
       return "void";
@@ -1042,7 +1004,7 @@ std::string DefinitionWriter::tsifyType(const Type& type,
         return "Date";
       }
 
-      if (DefinitionWriter::applyManualChanges) {
+      if (_applyManualChanges) {
         if (interface.name == "UIEvent") {
           return "_UIEvent";
         }
@@ -1069,13 +1031,12 @@ std::string DefinitionWriter::tsifyType(const Type& type,
         output << ">";
       } else {
         // This also translates CFArray to NSArray<any>
-        if (auto typeParamList =
-                clang::dyn_cast<clang::ObjCInterfaceDecl>(interface.declaration)
-                    ->getTypeParamListAsWritten()) {
+        size_t typeParameters = interface.typeParameterNames.size();
+        if (typeParameters) {
           output << "<";
-          for (size_t i = 0; i < typeParamList->size(); i++) {
+          for (size_t i = 0; i < typeParameters; i++) {
             output << "any";
-            if (i < typeParamList->size() - 1) {
+            if (i < typeParameters - 1) {
               output << ", ";
             }
           }
@@ -1159,7 +1120,8 @@ std::string DefinitionWriter::tsifyType(const Type& type,
 }
 
 std::string DefinitionWriter::computeMethodReturnType(
-    const Type* retType, const BaseClassMeta* owner, bool instanceMember) {
+    const Type* retType, const BaseClassMeta* owner,
+    bool instanceMember) const {
   std::ostringstream output;
   if (retType->stripNullability()->is(TypeInstancetype)) {
     if (instanceMember) {
@@ -1167,7 +1129,7 @@ std::string DefinitionWriter::computeMethodReturnType(
     } else {
       std::string ownerJsName = owner->jsName;
 
-      if (DefinitionWriter::applyManualChanges) {
+      if (_applyManualChanges) {
         if (ownerJsName == "UIEvent") {
           ownerJsName = "_UIEvent";
         }
@@ -1176,8 +1138,7 @@ std::string DefinitionWriter::computeMethodReturnType(
       output << ownerJsName;
       if (owner->is(MetaType::Interface)) {
         output << getTypeParametersStringOrEmpty(
-            clang::cast<clang::ObjCInterfaceDecl>(
-                static_cast<const InterfaceMeta*>(owner)->declaration));
+            static_cast<const InterfaceMeta*>(owner));
       }
     }
   } else {
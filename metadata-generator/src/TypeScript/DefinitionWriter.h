@@ -1,7 +1,5 @@
 #pragma once
 
-#include <Meta/TypeFactory.h>
-
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -12,14 +10,16 @@
 namespace TypeScript {
 class DefinitionWriter : Meta::MetaVisitor {
  public:
+  // A writer only reads the metas and the AST, so writers for different
+  // modules can run on different threads.
   DefinitionWriter(std::pair<clang::Module*, std::vector<Meta::Meta*> >& module,
-                   Meta::TypeFactory& typeFactory, std::string docSetPath)
-      : _module(module), _typeFactory(typeFactory), _docSet(docSetPath) {}
+                   std::string docSetPath, bool applyManualChanges)
+      : _module(module),
+        _applyManualChanges(applyManualChanges),
+        _docSet(docSetPath) {}
 
   std::string write();
 
-  static bool applyManualChanges;
-
   virtual void visit(Meta::InterfaceMeta* meta) override;
 
   virtual void visit(Meta::ProtocolMeta* meta) override;
@@ -68,38 +68,36 @@ class DefinitionWriter : Meta::MetaVisitor {
       CompoundMemberMap<Meta::PropertyMeta>* instanceProperties,
       std::unordered_set<Meta::ProtocolMeta*>& visitedProtocols);
 
-  static std::string writeConstructor(
+  std::string writeConstructor(
       const CompoundMemberMap<Meta::MethodMeta>::value_type& initializer,
-      const Meta::BaseClassMeta* owner);
-  static std::string writeMethod(Meta::MethodMeta* meta,
-                                 Meta::BaseClassMeta* owner,
-                                 bool canUseThisType = false);
-  static std::string writeMethod(
+      const Meta::BaseClassMeta* owner) const;
+  std::string writeMethod(Meta::MethodMeta* meta, Meta::BaseClassMeta* owner,
+                          bool canUseThisType = false) const;
+  std::string writeMethod(
       CompoundMemberMap<Meta::MethodMeta>::value_type& method,
       Meta::BaseClassMeta* owner,
       const std::unordered_set<Meta::ProtocolMeta*>& protocols,
-      bool canUseThisType = false);
-  static std::string writeProperty(Meta::PropertyMeta* meta,
-                                   Meta::BaseClassMeta* owner,
-                                   bool optOutTypeChecking);
-  static std::string writeFunctionProto(
-      const std::vector<Meta::Type*>& signature);
-  static std::string localizeReference(const std::string& jsName,
-                                       std::string moduleName);
-  static std::string localizeReference(const Meta::Meta& meta);
-  static std::string tsifyType(const Meta::Type& type,
-                               const bool isParam = false,
-                               const bool suppressNull = false);
-  static std::string computeMethodReturnType(const Meta::Type* retType,
-                                             const Meta::BaseClassMeta* owner,
-                                             bool canUseThisType = false);
-  std::string getTypeArgumentsStringOrEmpty(
-      const clang::ObjCObjectType* objectType);
+      bool canUseThisType = false) const;
+  std::string writeProperty(Meta::PropertyMeta* meta,
+                            Meta::BaseClassMeta* owner,
+                            bool optOutTypeChecking) const;
+  std::string writeFunctionProto(
+      const std::vector<Meta::Type*>& signature) const;
+  std::string localizeReference(const std::string& jsName,
+                                std::string moduleName) const;
+  std::string localizeReference(const Meta::Meta& meta) const;
+  std::string tsifyType(const Meta::Type& type, const bool isParam = false,
+                        const bool suppressNull = false) const;
+  std::string computeMethodReturnType(const Meta::Type* retType,
+                                      const Meta::BaseClassMeta* owner,
+                                      bool canUseThisType = false) const;
+  std::string getSuperClassTypeArgumentsStringOrEmpty(
+      const Meta::InterfaceMeta* meta) const;
 
   static bool hasClosedGenerics(const Meta::Type& type);
 
   std::pair<clang::Module*, std::vector<Meta::Meta*> >& _module;
-  Meta::TypeFactory& _typeFactory;
+  bool _applyManualChanges;
   DocSetManager _docSet;
   std::unordered_set<std::string> _importedModules;
   std::ostringstream _buffer;
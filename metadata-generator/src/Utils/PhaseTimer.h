@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utils {
+/*
+ * \class PhaseTimer
+ * \brief Measures the wall time of the consecutive phases of a run. Starting a phase ends the one before it.
+ */
+class PhaseTimer {
+public:
+    void start(std::string phase)
+    {
+        stop();
+        _phase = std::move(phase);
+        _start = std::chrono::steady_clock::now();
+    }
+
+    void stop()
+    {
+        if (!_phase.empty()) {
+            _times.emplace_back(std::move(_phase), std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count());
+            _phase.clear();
+        }
+    }
+
+    /*
+     * \brief The finished phases in the order they ran, with their time in seconds.
+     */
+    const std::vector<std::pair<std::string, double> >& times() const
+    {
+        return _times;
+    }
+
+    void print(std::ostream& os) const
+    {
+        size_t width = 0;
+        for (const std::pair<std::string, double>& time : _times) {
+            width = std::max(width, time.first.size());
+        }
+        std::ios_base::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        for (const std::pair<std::string, double>& time : _times) {
+            os << "  " << std::left << std::setw(width) << time.first << "  " << std::right << std::fixed << std::setprecision(3) << std::setw(8) << time.second << " sec" << std::endl;
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+private:
+    std::string _phase;
+    std::chrono::steady_clock::time_point _start;
+    std::vector<std::pair<std::string, double> > _times;
+};
+}
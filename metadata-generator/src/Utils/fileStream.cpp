@@ -27,6 +27,11 @@ void utils::FileStream::push_byte(uint8_t b)
     this->file << b;
 }
 
+void utils::FileStream::push_bytes(const uint8_t* bytes, size_t count)
+{
+    this->file.write(reinterpret_cast<const char*>(bytes), count);
+}
+
 unsigned long utils::FileStream::position()
 {
     return this->file.tellp();
@@ -59,5 +59,10 @@ public:
          * \brief Writes a byte to the current position.
          */
     virtual void push_byte(uint8_t b) override;
+
+    /*
+         * \brief Writes \p count bytes to the current position.
+         */
+    virtual void push_bytes(const uint8_t* bytes, size_t count) override;
 };
 }
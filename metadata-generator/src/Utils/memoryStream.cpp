@@ -17,6 +17,12 @@ void utils::MemoryStream::push_byte(uint8_t b)
     this->_position++;
 }
 
+void utils::MemoryStream::push_bytes(const uint8_t* bytes, size_t count)
+{
+    this->_heap.insert(this->_heap.begin() + this->_position, bytes, bytes + count);
+    this->_position += count;
+}
+
 std::vector<uint8_t>::iterator utils::MemoryStream::begin()
 {
     return this->_heap.begin();
@@ -30,6 +30,19 @@ public:
          */
     virtual void push_byte(uint8_t b) override;
 
+    /*
+         * \brief Writes \p count bytes to the current position.
+         */
+    virtual void push_bytes(const uint8_t* bytes, size_t count) override;
+
+    /*
+         * \brief Returns the bytes of this stream, which are contiguous.
+         */
+    const uint8_t* data() const
+    {
+        return this->_heap.data();
+    }
+
     /*
          * \brief Returns an iterator pointing to the first element in this stream.
          */
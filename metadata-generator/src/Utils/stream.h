@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <vector>
 
@@ -50,6 +51,18 @@ public:
          */
     virtual void push_byte(uint8_t b) = 0;
 
+    /*
+         * \brief Writes \p count bytes to the current position.
+         *
+         * Streams that can append in bulk override this; by default it writes the bytes one by one.
+         */
+    virtual void push_bytes(const uint8_t* bytes, size_t count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            this->push_byte(bytes[i]);
+        }
+    }
+
     virtual void operator<<(uint8_t b)
     {
         this->push_byte(b);
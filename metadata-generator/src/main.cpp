@@ -7,16 +7,25 @@
 #include "Meta/Filters/ModulesBlacklist.h"
 #include "Meta/Filters/RemoveDuplicateMembersFilter.h"
 #include "Meta/Filters/ResolveGlobalNamesCollisionsFilter.h"
+#include "Meta/Filters/UsageManifestFilter.h"
 #include "TypeScript/DefinitionWriter.h"
 #include "TypeScript/DocSetManager.h"
+#include "Utils/PhaseTimer.h"
 #include "Yaml/YamlSerializer.h"
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Tooling/Tooling.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <functional>
+#include <iomanip>
+#include <libxml/parser.h>
 #include <llvm/Support/Debug.h>
 #include <llvm/Support/Path.h>
 #include <pwd.h>
 #include <sstream>
+#include <thread>
 
 // Command line parameters
 llvm::cl::opt<bool>   cla_verbose("verbose", llvm::cl::desc("Set verbose output mode"), llvm::cl::value_desc("bool"));
@@ -30,15 +39,53 @@ llvm::cl::opt<string> cla_outputDtsFolder("output-typescript", llvm::cl::desc("S
 llvm::cl::opt<string> cla_docSetFile("docset-path", llvm::cl::desc("Specify the path to the iOS SDK docset package"), llvm::cl::value_desc("<file_path>"));
 llvm::cl::opt<string> cla_blackListModuleRegexesFile("blacklist-modules-file", llvm::cl::desc("Specify the metadata entries blacklist file containing regexes of module names on each line"), llvm::cl::value_desc("file_path"));
 llvm::cl::opt<string> cla_whiteListModuleRegexesFile("whitelist-modules-file", llvm::cl::desc("Specify the metadata entries whitelist file containing regexes of module names on each line"), llvm::cl::value_desc("file_path"));
+llvm::cl::opt<string> cla_cacheFolder("cache-path", llvm::cl::desc("Specify a folder in which to keep a precompiled header of the SDK headers between runs"), llvm::cl::value_desc("<dir_path>"));
+llvm::cl::opt<string> cla_usageManifestFile("usage-manifest", llvm::cl::desc("Specify a file listing the symbols the app uses (its bundled JavaScript or a recorded runtime trace); the binary metadata keeps only these and the declarations they depend on"), llvm::cl::value_desc("file_path"));
+llvm::cl::opt<string> cla_accessProfileFile("access-profile", llvm::cl::desc("Specify a metadata access profile recorded by the runtime; the declarations it lists are placed at the front of the binary metadata heap, most read first"), llvm::cl::value_desc("file_path"));
+llvm::cl::opt<unsigned> cla_jobs("jobs", llvm::cl::desc("Specify how many threads write the yaml and .d.ts files (defaults to the number of cores)"), llvm::cl::init(0));
 llvm::cl::opt<bool>   cla_applyManualDtsChanges("apply-manual-dts-changes", llvm::cl::desc("Specify whether to disable manual adjustments to generated .d.ts files for specific erroneous cases in the iOS SDK"), llvm::cl::init(true));
 llvm::cl::opt<string> cla_clangArgumentsDelimiter(llvm::cl::Positional, llvm::cl::desc("Xclang"), llvm::cl::init("-"));
 llvm::cl::list<string> cla_clangArguments(llvm::cl::ConsumeAfter, llvm::cl::desc("<clang arguments>..."));
 
+// Calls work(0) ... work(count - 1) from up to `jobs` threads. Indices are handed
+// out one at a time, so a few large items do not hold the rest back. Once every
+// thread is done, the exception of the lowest index that threw is rethrown.
+static void parallelFor(size_t count, unsigned jobs, const std::function<void(size_t)>& work)
+{
+    std::vector<std::exception_ptr> exceptions(count);
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                work(i);
+            } catch (...) {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min<size_t>(jobs, count); i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (std::exception_ptr& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
 class MetaGenerationConsumer : public clang::ASTConsumer {
 public:
-    explicit MetaGenerationConsumer(clang::SourceManager& sourceManager, clang::HeaderSearch& headerSearch, Meta::ModulesBlacklist& modulesBlacklist)
+    explicit MetaGenerationConsumer(clang::SourceManager& sourceManager, clang::HeaderSearch& headerSearch, Meta::ModulesBlacklist& modulesBlacklist, utils::PhaseTimer& phaseTimer)
         : _headerSearch(headerSearch)
         , _visitor(sourceManager, _headerSearch, cla_verbose, modulesBlacklist)
+        , _phaseTimer(phaseTimer)
     {
     }
 
@@ -47,18 +94,25 @@ public:
         Context.getDiagnostics().Reset();
         llvm::SmallVector<clang::Module*, 64> modules;
         _headerSearch.collectAllModules(modules);
+        _phaseTimer.start("visit");
         std::list<Meta::Meta*>& metaContainer = _visitor.generateMetadata(Context.getTranslationUnitDecl());
 
         // Filters
+        _phaseTimer.start("filter HandleExceptionalMetas");
         Meta::HandleExceptionalMetasFilter().filter(metaContainer);
+        _phaseTimer.start("filter MergeCategories");
         Meta::MergeCategoriesFilter().filter(metaContainer);
+        _phaseTimer.start("filter RemoveDuplicateMembers");
         Meta::RemoveDuplicateMembersFilter().filter(metaContainer);
+        _phaseTimer.start("filter HandleMethodsAndPropertiesWithSameName");
         Meta::HandleMethodsAndPropertiesWithSameNameFilter(_visitor.getMetaFactory()).filter(metaContainer);
+        _phaseTimer.start("filter ResolveGlobalNamesCollisions");
         Meta::ResolveGlobalNamesCollisionsFilter filter = Meta::ResolveGlobalNamesCollisionsFilter();
         filter.filter(metaContainer);
         std::unique_ptr<std::pair<Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules, Meta::ResolveGlobalNamesCollisionsFilter::InterfacesByName> > result = filter.getResult();
         Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules& metasByModules = result->first;
         Meta::ResolveGlobalNamesCollisionsFilter::InterfacesByName& interfacesByName = result->second;
+        _phaseTimer.start("resolve bridged types");
         _visitor.getMetaFactory().getTypeFactory().resolveCachedBridgedInterfaceTypes(interfacesByName);
 
         // Log statistic for parsed Meta objects
@@ -66,6 +120,7 @@ public:
 
         // Dump module maps
         if (!cla_outputModuleMapsFolder.empty()) {
+            _phaseTimer.start("emit module maps");
             llvm::sys::fs::create_directories(cla_outputModuleMapsFolder);
             for (clang::Module*& module : modules) {
                 std::string filePath = std::string(cla_outputModuleMapsFolder) + std::string("/") + module->getFullModuleName() + ".modulemap";
@@ -80,59 +135,166 @@ public:
             }
         }
 
-        // Serialize Meta objects to Yaml
-        if (!cla_outputYamlFolder.empty()) {
-            if (!llvm::sys::fs::exists(cla_outputYamlFolder)) {
-                DEBUG_WITH_TYPE("yaml", llvm::dbgs() << "Creating YAML output directory: " << cla_outputYamlFolder << "\n");
-                llvm::sys::fs::create_directories(cla_outputYamlFolder);
+        // Serialize Meta objects to binary metadata
+        if (!cla_outputBinFile.empty()) {
+            std::unique_ptr<binary::AccessProfile> profile;
+            if (!cla_accessProfileFile.empty()) {
+                profile.reset(new binary::AccessProfile(cla_accessProfileFile));
             }
-
-            for (std::pair<clang::Module*, std::vector<Meta::Meta*> >& modulePair : metasByModules) {
-                std::string yamlFileName = modulePair.first->getFullModuleName() + ".yaml";
-                DEBUG_WITH_TYPE("yaml", llvm::dbgs() << "Generating: " << yamlFileName << "\n");
-                Yaml::YamlSerializer::serialize<std::pair<clang::Module*, std::vector<Meta::Meta*> > >(cla_outputYamlFolder + "/" + yamlFileName, modulePair);
+            if (cla_usageManifestFile.empty()) {
+                _phaseTimer.start("serialize binary");
+                binary::MetaFile file(metaContainer.size() / 10); // Average number of hash collisions: 10 per bucket
+                binary::BinarySerializer serializer(&file, profile.get());
+                serializer.serializeContainer(metasByModules);
+                file.save(cla_outputBinFile);
+                printHotRegion(serializer, profile.get());
+            } else {
+                serializePrunedBinary(metasByModules, metaContainer.size(), profile.get());
             }
         }
 
-        // Serialize Meta objects to binary metadata
-        if (!cla_outputBinFile.empty()) {
-            binary::MetaFile file(metaContainer.size() / 10); // Average number of hash collisions: 10 per bucket
-            binary::BinarySerializer serializer(&file);
-            serializer.serializeContainer(metasByModules);
-            file.save(cla_outputBinFile);
+        // Serialize Meta objects to Yaml and generate TypeScript definitions
+        if (!cla_outputYamlFolder.empty() || !cla_outputDtsFolder.empty()) {
+            _phaseTimer.start("emit yaml and .d.ts");
+            writeModuleFiles(metasByModules);
         }
+        _phaseTimer.stop();
+    }
 
-        // Generate TypeScript definitions
-        if (!cla_outputDtsFolder.empty()) {
+private:
+    // Only the binary is pruned: the yaml and .d.ts files still describe the whole SDK, so that
+    // code using a symbol for the first time type checks before the manifest lists it.
+    void serializePrunedBinary(Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules& metasByModules, size_t declarationsCount, const binary::AccessProfile* profile)
+    {
+        _phaseTimer.start("prune by usage manifest");
+        Meta::UsageManifestFilter usageFilter(cla_usageManifestFile);
+        std::vector<Meta::Meta*> pruned;
+        Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules usedMetasByModules = usageFilter.filter(metasByModules, pruned);
+
+        _phaseTimer.start("serialize binary");
+        size_t keptCount = 0;
+        for (const std::pair<clang::Module*, std::vector<Meta::Meta*> >& module : usedMetasByModules) {
+            keptCount += module.second.size();
+        }
+        binary::MetaFile file(keptCount / 10);
+        for (Meta::Meta* meta : pruned) {
+            file.registerPrunedSymbol(*meta);
+        }
+        binary::BinarySerializer serializer(&file, profile);
+        serializer.serializeContainer(usedMetasByModules);
+        file.save(cla_outputBinFile);
+        printHotRegion(serializer, profile);
+
+        // The whole SDK is serialized again, in memory, only to report what pruning saved
+        _phaseTimer.start("measure unpruned binary");
+        binary::MetaFile fullFile(declarationsCount / 10);
+        binary::BinarySerializer fullSerializer(&fullFile);
+        fullSerializer.serializeContainer(metasByModules);
+        std::shared_ptr<utils::MemoryStream> fullStream = std::make_shared<utils::MemoryStream>();
+        fullFile.save(fullStream);
+
+        std::cout << "Usage manifest: " << usageFilter.usedNamesCount() << " names, " << keptCount << " of " << keptCount + pruned.size() << " declarations kept" << std::endl;
+        uint64_t prunedSize = 0;
+        llvm::sys::fs::file_size(cla_outputBinFile, prunedSize);
+        std::cout << "Binary metadata: " << prunedSize << " bytes instead of " << fullStream->size() << " (" << std::fixed << std::setprecision(1) << 100.0 * prunedSize / std::max<unsigned long>(fullStream->size(), 1) << "%)" << std::defaultfloat << std::endl;
+    }
+
+    static void printHotRegion(const binary::BinarySerializer& serializer, const binary::AccessProfile* profile)
+    {
+        if (profile == nullptr) {
+            return;
+        }
+        // arm64 iOS maps files in 16 KB pages
+        const binary::MetaFileOffset pageSize = 16 * 1024;
+        std::cout << "Access profile: " << profile->size() << " names, " << serializer.hotCount() << " declarations in the first " << serializer.hotRegionSize() << " bytes of the heap (" << (serializer.hotRegionSize() + pageSize - 1) / pageSize << " pages)" << std::endl;
+    }
+
+    // Each module's yaml and .d.ts files are written by one task. Past this
+    // point the metas and the types are only read, and neither writer touches
+    // the AST, whose declarations deserialize lazily and not thread-safely, so
+    // the tasks run in parallel and every file comes out as a serial run would
+    // write it.
+    void writeModuleFiles(Meta::ResolveGlobalNamesCollisionsFilter::MetasByModules& metasByModules)
+    {
+        bool writeYaml = !cla_outputYamlFolder.empty();
+        bool writeDts = !cla_outputDtsFolder.empty();
+        bool applyManualDtsChanges = cla_applyManualDtsChanges;
+        std::string docSetPath = cla_docSetFile.empty() ? "" : cla_docSetFile.getValue();
+
+        if (writeYaml && !llvm::sys::fs::exists(cla_outputYamlFolder)) {
+            DEBUG_WITH_TYPE("yaml", llvm::dbgs() << "Creating YAML output directory: " << cla_outputYamlFolder << "\n");
+            llvm::sys::fs::create_directories(cla_outputYamlFolder);
+        }
+        if (writeDts) {
             llvm::sys::fs::create_directories(cla_outputDtsFolder);
-            std::string docSetPath = cla_docSetFile.empty() ? "" : cla_docSetFile.getValue();
-            for (std::pair<clang::Module*, std::vector<Meta::Meta*> >& modulePair : metasByModules) {
-                TypeScript::DefinitionWriter definitionWriter(modulePair, _visitor.getMetaFactory().getTypeFactory(), docSetPath);
+            // libxml2 must be initialized once before DocSetManagers parse on several threads
+            xmlInitParser();
+        }
 
+        size_t count = metasByModules.size();
+        std::vector<std::string> yamlPaths(count);
+        std::vector<std::string> dtsPaths(count);
+        std::vector<std::string> errors(count);
+        for (size_t i = 0; i < count; i++) {
+            std::string moduleName = metasByModules[i].first->getFullModuleName();
+            if (writeYaml) {
+                yamlPaths[i] = cla_outputYamlFolder + "/" + moduleName + ".yaml";
+                DEBUG_WITH_TYPE("yaml", llvm::dbgs() << "Generating: " << moduleName << ".yaml\n");
+            }
+            if (writeDts) {
                 llvm::SmallString<128> path;
-                llvm::sys::path::append(path, cla_outputDtsFolder, "objc!" + modulePair.first->getFullModuleName() + ".d.ts");
+                llvm::sys::path::append(path, cla_outputDtsFolder, "objc!" + moduleName + ".d.ts");
+                dtsPaths[i] = path.str().str();
+            }
+        }
+
+        // Largest modules first, so that the last task to finish is a small one
+        std::vector<size_t> order(count);
+        for (size_t i = 0; i < count; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&metasByModules](size_t a, size_t b) {
+            return metasByModules[a].second.size() > metasByModules[b].second.size();
+        });
+
+        unsigned jobs = cla_jobs != 0 ? cla_jobs.getValue() : std::max(1u, std::thread::hardware_concurrency());
+        parallelFor(count, jobs, [&](size_t taskIndex) {
+            size_t i = order[taskIndex];
+            std::pair<clang::Module*, std::vector<Meta::Meta*> >& modulePair = metasByModules[i];
+
+            if (writeYaml) {
+                Yaml::YamlSerializer::serialize<std::pair<clang::Module*, std::vector<Meta::Meta*> > >(yamlPaths[i], modulePair);
+            }
+
+            if (writeDts) {
+                TypeScript::DefinitionWriter definitionWriter(modulePair, docSetPath, applyManualDtsChanges);
                 std::error_code error;
-                llvm::raw_fd_ostream file(path.str(), error, llvm::sys::fs::OF_Text);
+                llvm::raw_fd_ostream file(dtsPaths[i], error, llvm::sys::fs::OF_Text);
                 if (error) {
-                    std::cout << error.message();
+                    errors[i] = error.message();
                     return;
                 }
 
                 file << definitionWriter.write();
                 file.close();
             }
+        });
+
+        for (const std::string& error : errors) {
+            std::cout << error;
         }
     }
 
-private:
     clang::HeaderSearch& _headerSearch;
     Meta::DeclarationConverterVisitor _visitor;
+    utils::PhaseTimer& _phaseTimer;
 };
 
 class MetaGenerationFrontendAction : public clang::ASTFrontendAction {
 public:
-    MetaGenerationFrontendAction(Meta::ModulesBlacklist& modulesBlacklist)
+    MetaGenerationFrontendAction(Meta::ModulesBlacklist& modulesBlacklist, utils::PhaseTimer& phaseTimer)
         : _modulesBlacklist(modulesBlacklist)
+        , _phaseTimer(phaseTimer)
     {
     }
 
@@ -143,11 +305,14 @@ public:
         // here we set this explicitly in order to keep the same behavior
         Compiler.getPreprocessor().SetSuppressIncludeNotFoundError(!cla_strictIncludes);
 
-        return std::unique_ptr<clang::ASTConsumer>(new MetaGenerationConsumer(Compiler.getASTContext().getSourceManager(), Compiler.getPreprocessor().getHeaderSearchInfo(), _modulesBlacklist));
+        // the source is parsed once the consumer exists
+        _phaseTimer.start("parse");
+        return std::unique_ptr<clang::ASTConsumer>(new MetaGenerationConsumer(Compiler.getASTContext().getSourceManager(), Compiler.getPreprocessor().getHeaderSearchInfo(), _modulesBlacklist, _phaseTimer));
     }
 
 private:
     Meta::ModulesBlacklist& _modulesBlacklist;
+    utils::PhaseTimer& _phaseTimer;
 };
 
 std::string replaceString(std::string subject, const std::string& search, const std::string& replace)
@@ -160,6 +325,11 @@ std::string replaceString(std::string subject, const std::string& search, const
     return subject;
 }
 
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
 static void dumpArgs(std::ostream& os, int argc, const char **argv) {
     os << "Metadata Generator Arguments: " << std::endl;
     for (int i = 0; i < argc; ++i) {
@@ -173,6 +343,7 @@ int main(int argc, const char** argv)
 {
     try {
         std::clock_t begin = clock();
+        std::chrono::steady_clock::time_point wallBegin = std::chrono::steady_clock::now();
 
         llvm::cl::ParseCommandLineOptions(argc, argv);
         assert(cla_clangArgumentsDelimiter.getValue() == "Xclang");
@@ -181,8 +352,6 @@ int main(int argc, const char** argv)
         dumpArgs(std::cout, argc, argv);
         dumpArgs(std::cerr, argc, argv);
 
-        TypeScript::DefinitionWriter::applyManualChanges = cla_applyManualDtsChanges;
-
         std::vector<std::string> clangArgs{
             "-v",
             "-x", "objective-c",
@@ -202,14 +371,12 @@ int main(int argc, const char** argv)
         }
         std::cout << std::endl;
 
-        std::string isysroot;
-        std::vector<string>::const_iterator it = std::find(clangArgs.begin(), clangArgs.end(), "-isysroot");
-        if (it != clangArgs.end() && ++it != clangArgs.end()) {
-            isysroot = *it;
-        }
+        std::string isysroot = GetSdkRoot(clangArgs);
 
         std::vector<std::string> includePaths;
-        std::string umbrellaContent = CreateUmbrellaHeader(clangArgs, includePaths);
+        // Without a cache folder the headers keep the order they always had, so
+        // that the outputs do not change
+        std::string umbrellaContent = CreateUmbrellaHeader(clangArgs, includePaths, !cla_cacheFolder.empty());
 
         if (!cla_inputUmbrellaHeaderFile.empty()) {
             std::ifstream fs(cla_inputUmbrellaHeaderFile);
@@ -228,13 +395,40 @@ int main(int argc, const char** argv)
                 umbrellaFileStream.close();
             }
         }
+        // The SDK headers at the front of the umbrella header come from a
+        // precompiled header when a cache folder is given; only the rest is
+        // parsed. Declarations reach the visitor in the same order whether the
+        // precompiled header is built, reused or could not be built.
+        std::string parsedContent = umbrellaContent;
+        if (!cla_cacheFolder.empty() && !isysroot.empty()) {
+            std::string sdkContent, restContent;
+            SplitUmbrellaHeader(umbrellaContent, isysroot, sdkContent, restContent);
+            if (!sdkContent.empty()) {
+                std::chrono::steady_clock::time_point pchBegin = std::chrono::steady_clock::now();
+                bool reused = false;
+                std::string pchPath = GetOrCreateSdkPch(sdkContent, clangArgs, cla_cacheFolder, !cla_strictIncludes, reused);
+                if (!pchPath.empty()) {
+                    clangArgs.insert(clangArgs.end(), { "-Xclang", "-fallow-pch-with-compiler-errors", "-include-pch", pchPath });
+                    parsedContent = restContent;
+                    std::cout << "SDK precompiled header " << (reused ? "reused" : "built") << ": " << pchPath << " (" << secondsSince(pchBegin) << " sec)" << std::endl;
+                } else {
+                    std::cout << "SDK precompiled header could not be built, parsing all headers" << std::endl;
+                }
+            }
+        }
+
         // generate metadata for the intermediate sdk header
+        std::chrono::steady_clock::time_point parseBegin = std::chrono::steady_clock::now();
         Meta::ModulesBlacklist modulesBlacklist(cla_whiteListModuleRegexesFile, cla_blackListModuleRegexesFile);
-        clang::tooling::runToolOnCodeWithArgs(std::unique_ptr<MetaGenerationFrontendAction>(new MetaGenerationFrontendAction(/*r*/modulesBlacklist)), umbrellaContent, clangArgs, "umbrella.h", "objc-metadata-generator");
+        utils::PhaseTimer phaseTimer;
+        clang::tooling::runToolOnCodeWithArgs(std::unique_ptr<MetaGenerationFrontendAction>(new MetaGenerationFrontendAction(/*r*/modulesBlacklist, phaseTimer)), parsedContent, clangArgs, "umbrella.h", "objc-metadata-generator");
+        phaseTimer.stop();
+        std::cout << "Parsing and generation time: " << secondsSince(parseBegin) << " sec" << std::endl;
+        phaseTimer.print(std::cout);
 
         std::clock_t end = clock();
         double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
-        std::cout << "Done! Running time: " << elapsed_secs << " sec " << std::endl;
+        std::cout << "Done! Running time: " << elapsed_secs << " sec (wall " << secondsSince(wallBegin) << " sec)" << std::endl;
 
         return 0;
     } catch (const std::exception& e) {
@@ -10,7 +10,7 @@ const USAGE = `usage: node tools/js2c.mjs --out-dir <dir> [--minify] [--filelist
 
 Generates <dir>/RuntimeBuiltins.h and <dir>/RuntimeBuiltins.cpp from the given
 builtin JavaScript sources. Builtin ids and script-origin names derive from the
-file names (promise-proxy.js -> BuiltinId::kPromiseProxy, "internal/promise-proxy.js").
+file names (structured-clone.js -> BuiltinId::kStructuredClone, "internal/structured-clone.js").
 
 options:
   --out-dir <dir>        output directory for the generated files (required)
@@ -116,7 +116,7 @@ ${ids}
 };
 
 struct BuiltinSource {
-  const char* name;    // script origin, e.g. "internal/promise-proxy.js"
+  const char* name;    // script origin, e.g. "internal/structured-clone.js"
   const char* source;  // NUL-terminated UTF-8
   size_t length;       // bytes, excluding the NUL
 };
@@ -2,7 +2,7 @@
 // .d.ts per module, mirroring @types/node's layout and the "one module, one
 // source file" rule in docs/ns-builtin-modules.md. The declared surfaces must
 // stay in sync with that document (NsRuntimeTests.js / NsUtilTests.js /
-// HttpEsmLoaderTests.js assert the export sets at runtime).
+// NsPerfTests.js / HttpEsmLoaderTests.js assert the export sets at runtime).
 //
 // `ns:` is not a resolvable package specifier, so these are ambient
 // declarations: they apply program-wide once this file is in the TypeScript
@@ -26,5 +26,6 @@
 // then conflict.
 
 /// <reference path="./ns-module.d.ts" />
+/// <reference path="./ns-perf.d.ts" />
 /// <reference path="./ns-runtime.d.ts" />
 /// <reference path="./ns-util.d.ts" />
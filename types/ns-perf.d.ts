@@ -0,0 +1,148 @@
+declare module "ns:perf" {
+  /**
+   * Experimental, iOS-only. Profiles and snapshots are written to absolute
+   * paths in the formats Chrome DevTools loads directly, and are per isolate:
+   * a worker profiles its own JS thread and snapshots its own heap.
+   */
+
+  export interface CpuProfileOptions {
+    /** Target sampling interval, overriding the engine's default. */
+    samplingIntervalMicros?: number;
+  }
+
+  export interface HeapSamplingOptions {
+    /** Average number of bytes allocated between samples. Default: `524288`. */
+    samplingInterval?: number;
+    /** Maximum number of stack frames recorded per sample. Default: `16`. */
+    stackDepth?: number;
+  }
+
+  export interface TraceOptions {
+    /**
+     * Trace categories to record. Default: `"v8"` plus every runtime
+     * category (`ns.module`, `ns.interop`, `ns.gc`, `ns.eventloop`,
+     * `ns.worker`).
+     */
+    categories?: string[];
+  }
+
+  /** Key names follow Node's `v8.getHeapStatistics()`. */
+  export interface HeapStatistics {
+    total_heap_size: number;
+    total_heap_size_executable: number;
+    total_physical_size: number;
+    total_available_size: number;
+    used_heap_size: number;
+    heap_size_limit: number;
+    malloced_memory: number;
+    peak_malloced_memory: number;
+    does_zap_garbage: number;
+    number_of_native_contexts: number;
+    number_of_detached_contexts: number;
+    total_global_handles_size: number;
+    used_global_handles_size: number;
+    external_memory: number;
+  }
+
+  /** Key names follow Node's `v8.getHeapSpaceStatistics()`. */
+  export interface HeapSpaceStatistics {
+    space_name: string;
+    space_size: number;
+    space_used_size: number;
+    space_available_size: number;
+    physical_space_size: number;
+  }
+
+  /** Process-wide memory, in bytes, as the OS accounts for it. */
+  export interface ProcessMemory {
+    residentSize: number;
+    /** What the OS charges the app against its memory limit. */
+    footprint: number;
+    /** The highest `footprint` since the process started. */
+    peakFootprint: number;
+  }
+
+  /**
+   * Starts a sampling CPU profile identified by `title`, which must be a
+   * non-empty string. Several profiles may run at once under different
+   * titles; starting one whose title is already running throws.
+   */
+  export function startCpuProfile(
+    title: string,
+    options?: CpuProfileOptions
+  ): void;
+
+  /**
+   * Stops the profile started under `title` and writes it to `path` as
+   * `.cpuprofile` JSON. Returns `path`. Throws when no such profile is
+   * running or the file cannot be written.
+   */
+  export function stopCpuProfile(title: string, path: string): string;
+
+  /**
+   * Takes a full heap snapshot and streams it to `path` as `.heapsnapshot`
+   * JSON. Returns `path`.
+   */
+  export function writeHeapSnapshot(path: string): string;
+
+  /** Starts the sampling heap profiler. Throws if it is already running. */
+  export function startHeapSampling(options?: HeapSamplingOptions): void;
+
+  /**
+   * Stops the sampling heap profiler and writes what it recorded to `path` as
+   * `.heapprofile` JSON. Returns `path`.
+   */
+  export function stopHeapSampling(path: string): string;
+
+  /**
+   * Starts a process-wide trace streamed to `path` as Chrome trace JSON.
+   * Throws when a trace is already running, including one started from
+   * DevTools.
+   */
+  export function startTrace(path: string, options?: TraceOptions): void;
+
+  /** Stops the trace started with `startTrace` and returns its path. */
+  export function stopTrace(): string;
+
+  /** The calling isolate's heap statistics, in bytes. */
+  export function getHeapStatistics(): HeapStatistics;
+
+  /** One entry per heap space of the calling isolate. */
+  export function getHeapSpaceStatistics(): HeapSpaceStatistics[];
+
+  /** The whole process's memory, not just the calling isolate's heap. */
+  export function getProcessMemory(): ProcessMemory;
+
+  /** One `[lowerBoundNanos, count]` pair per non-empty bucket, ascending. */
+  export type InteropHistogram = [number, number][];
+
+  export interface InteropCallStats {
+    /** `"objc"` entries are keyed by selector, `"c"` entries by function. */
+    kind: "objc" | "c";
+    name: string;
+    count: number;
+    marshalNanos: number;
+    nativeNanos: number;
+    marshalHistogram: InteropHistogram;
+    nativeHistogram: InteropHistogram;
+  }
+
+  export interface InteropStats {
+    enabled: boolean;
+    structAllocations: number;
+    numberBoxings: number;
+    /** Heaviest first. */
+    calls: InteropCallStats[];
+  }
+
+  /**
+   * The `*InteropStats` functions exist only in builds compiled with
+   * `NATIVESCRIPT_INTEROP_STATS`; check for `getInteropStats` before use.
+   */
+  export const enableInteropStats: (() => void) | undefined;
+  export const disableInteropStats: (() => void) | undefined;
+  export const getInteropStats: (() => InteropStats) | undefined;
+  export const resetInteropStats: (() => void) | undefined;
+  /** Writes `getInteropStats()` to `path` as JSON. Returns `path`. */
+  export const writeInteropStats: ((path: string) => string) | undefined;
+}